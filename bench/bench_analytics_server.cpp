@@ -0,0 +1,136 @@
+#include "bench_harness.hpp"
+#include "cli/analytics_server.hpp"
+#include "utils/timestamp.hpp"
+
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace
+{
+    Universe makeUniverse(size_t tickers, size_t days)
+    {
+        std::vector<std::string> dates(days);
+        for (size_t t = 0; t < days; ++t)
+            dates[t] = Timestamp::formatIsoMillis((18000 + static_cast<int64_t>(t)) * 86400000LL,
+                                                  Timestamp::Format::DateOnly);
+        std::mt19937_64 rng(17);
+        std::normal_distribution<double> step(0.0003, 0.015);
+        Universe u;
+        u.reserve(tickers);
+        char name[16];
+        for (size_t i = 0; i < tickers; ++i)
+        {
+            std::vector<double> prices(days);
+            double p = 100.0;
+            for (double &v : prices)
+            {
+                v = p;
+                p *= std::exp(step(rng));
+            }
+            std::snprintf(name, sizeof(name), "T%zu", i);
+            u.insert(PriceSeries(name, dates, std::move(prices)));
+        }
+        return u;
+    }
+
+    // Sends one request and reads until its terminating empty line.
+    std::string roundTrip(int fd, const std::string &request)
+    {
+        if (::write(fd, request.data(), request.size()) != static_cast<ssize_t>(request.size()))
+            return {};
+        std::string response;
+        char buf[1 << 16];
+        while (response.size() < 2 || response.compare(response.size() - 2, 2, "\n\n") != 0)
+        {
+            const ssize_t n = ::read(fd, buf, sizeof(buf));
+            if (n <= 0)
+                break;
+            response.append(buf, static_cast<size_t>(n));
+        }
+        return response;
+    }
+}
+
+// 500 tickers x 1260 days kept warm: building the columns once, then query
+// latency over the Unix socket, uncached and cached, for one ticker and for
+// the whole universe in one request.
+TRADEIQ_BENCH(QueryServer)
+{
+    const size_t tickers = 500, days = 1260, queries = 2000;
+    Universe universe = makeUniverse(tickers, days);
+
+    Bench::Timer build;
+    QueryEngine engine(universe);
+    Bench::report("build columns", build.seconds(), static_cast<double>(tickers), "ticker");
+
+    const std::string path = (std::filesystem::temp_directory_path() / "tradeiq_bench_server.sock").string();
+    AnalyticsServer server(engine, path);
+    std::thread loop([&] { server.run(); });
+
+    const int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    std::snprintf(addr.sun_path, sizeof(addr.sun_path), "%s", path.c_str());
+    if (fd < 0 || ::connect(fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) != 0)
+    {
+        std::fprintf(stderr, "  cannot connect to %s\n", path.c_str());
+        server.stop();
+        loop.join();
+        return;
+    }
+
+    // Each uncached query asks for a different one-year window of one ticker.
+    std::vector<std::string> cold(queries), warm(queries);
+    std::vector<std::string> dates(days);
+    for (size_t t = 0; t < days; ++t)
+        dates[t] = Timestamp::formatIsoMillis((18000 + static_cast<int64_t>(t)) * 86400000LL, Timestamp::Format::DateOnly);
+    for (size_t q = 0; q < queries; ++q)
+    {
+        const size_t start = q % (days - 252);
+        cold[q] = "sharpe,volatility,max_drawdown T" + std::to_string(q % tickers) + " " + dates[start] + " " +
+                  dates[start + 251] + "\n";
+        warm[q] = "sharpe,volatility,max_drawdown T" + std::to_string(q % 8) + " " + dates[0] + " " + dates[251] + "\n";
+    }
+
+    size_t bytes = 0;
+    {
+        Bench::Timer timer;
+        for (const auto &q : cold)
+            bytes += roundTrip(fd, q).size();
+        Bench::report("socket query, uncached (1 ticker, 1y)", timer.seconds(), static_cast<double>(queries), "query");
+    }
+    {
+        Bench::Timer timer;
+        for (const auto &q : warm)
+            bytes += roundTrip(fd, q).size();
+        Bench::report("socket query, cached", timer.seconds(), static_cast<double>(queries), "query");
+    }
+
+    std::string all = "* ";
+    for (size_t i = 0; i < tickers; ++i)
+        all += (i ? "," : "") + universe.symbol(static_cast<Universe::Id>(i));
+    {
+        Bench::Timer timer;
+        bytes += roundTrip(fd, all + " " + dates[days - 252] + "\n").size();
+        Bench::report("socket query, 500 tickers uncached", timer.seconds(), static_cast<double>(tickers), "ticker");
+    }
+    {
+        Bench::Timer timer;
+        bytes += roundTrip(fd, all + " " + dates[days - 252] + "\n").size();
+        Bench::report("socket query, 500 tickers cached", timer.seconds(), static_cast<double>(tickers), "ticker");
+    }
+    Bench::doNotOptimize(bytes);
+
+    ::close(fd);
+    server.stop();
+    loop.join();
+}
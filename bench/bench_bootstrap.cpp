@@ -0,0 +1,23 @@
+#include "bench_harness.hpp"
+#include "stats/bootstrap.hpp"
+
+#include <cmath>
+
+// Stationary bootstrap, 200 strategies x 2,000 resamples x 1,260 days.
+TRADEIQ_BENCH(Bootstrap)
+{
+    const size_t strategies = 200, days = 1260;
+    std::vector<std::vector<double>> panel(strategies, std::vector<double>(days));
+    for (size_t s = 0; s < strategies; ++s)
+        for (size_t t = 0; t < days; ++t)
+            panel[s][t] = 0.0003 + 0.01 * std::sin(static_cast<double>(t * (s + 3)) * 0.61 + static_cast<double>(s));
+
+    Stats::Bootstrap::Options options;
+    options.resamples = 2000;
+
+    Bench::Timer timer;
+    auto ci = Stats::Bootstrap::bootstrapRatios(panel, options);
+    Bench::doNotOptimize(ci.back().sharpe.upper);
+    Bench::report("fused ratios (200 x 2000 x 1260)", timer.seconds(),
+                  static_cast<double>(strategies * options.resamples * days), "obs");
+}
@@ -0,0 +1,47 @@
+#include "bench_harness.hpp"
+#include "core/broker_sim.hpp"
+
+#include <cmath>
+
+using namespace BrokerSim;
+
+// 50 symbols x 20,000 five-minute bars (~1 year), an order every 10 bars.
+TRADEIQ_BENCH(BrokerSimReplay)
+{
+    const uint32_t symbols = 50;
+    const size_t barsPerSymbol = 20000;
+
+    FillModel model;
+    model.slippageBps = 1.0;
+    model.commissionPerShare = 0.005;
+    Simulator sim(1e7, model);
+
+    for (uint32_t s = 0; s < symbols; ++s)
+    {
+        std::vector<Bar> bars(barsPerSymbol);
+        double px = 100.0 + s;
+        for (size_t i = 0; i < barsPerSymbol; ++i)
+        {
+            px *= 1.0 + 0.001 * std::sin(static_cast<double>(i * (s + 1)));
+            bars[i] = Bar{static_cast<int64_t>(i) * 300000, px, px * 1.001, px * 0.999, px, 1e5};
+        }
+        sim.addSymbol("S" + std::to_string(s), std::move(bars));
+    }
+
+    size_t counter = 0;
+    Bench::Timer timer;
+    sim.run([&](Simulator &sm, uint32_t symbol, const Bar &bar) {
+        if (++counter % 10 != 0)
+            return;
+        Side side = (counter / 10) % 2 ? Side::Buy : Side::Sell;
+        if (counter % 20 == 0)
+            sm.submitOrder(symbol, side, 10.0);
+        else
+            sm.submitOrder(symbol, side, 10.0, OrderType::Limit, bar.close);
+    });
+    double elapsed = timer.seconds();
+
+    Bench::report("events (" + std::to_string(sim.eventsProcessed()) + ")", elapsed,
+                  static_cast<double>(sim.eventsProcessed()), "ev");
+    Bench::doNotOptimize(sim.ledger().cash());
+}
@@ -0,0 +1,74 @@
+#include "bench_harness.hpp"
+#include "stats/correlation.hpp"
+#include "stats/moments.hpp"
+#include "stats/ratios.hpp"
+#include "stats/volatility.hpp"
+#include "utils/cpu_dispatch.hpp"
+
+#include <cmath>
+#include <string>
+
+// The dispatched kernels at every level this machine supports.
+TRADEIQ_BENCH(CpuDispatchKernels)
+{
+    const size_t assets = 200, days = 2520;
+    std::vector<std::vector<double>> r(assets, std::vector<double>(days));
+    for (size_t a = 0; a < assets; ++a)
+        for (size_t t = 0; t < days; ++t)
+            r[a][t] = 0.0003 + 0.01 * std::sin(static_cast<double>(t * (a + 3)) * 0.29 + static_cast<double>(a));
+    std::vector<float> rf(r[0].begin(), r[0].end());
+    rf.resize(1 << 14, 0.001f);
+
+    const size_t n = 1000;
+    std::vector<std::vector<double>> cov(n, std::vector<double>(n));
+    for (size_t i = 0; i < n; ++i)
+        for (size_t j = 0; j < n; ++j)
+            cov[i][j] = std::cos(static_cast<double>(i * j) * 0.01) * 1e-4;
+    std::vector<double> weights(n, 1.0 / static_cast<double>(n));
+
+    for (auto isa : {CpuDispatch::Isa::Baseline, CpuDispatch::Isa::AVX2, CpuDispatch::Isa::AVX512})
+    {
+        if (!CpuDispatch::supported(isa))
+            continue;
+        CpuDispatch::ScopedIsa scoped(isa);
+        const std::string level = CpuDispatch::name(isa);
+        {
+            Bench::Timer timer;
+            double sink = 0.0;
+            for (const auto &series : r)
+                sink += Stats::Moments::summarize<4>(series).m4;
+            Bench::doNotOptimize(sink);
+            Bench::report(level + " moments<4> double", timer.seconds(), static_cast<double>(assets * days), "obs");
+        }
+        {
+            Bench::Timer timer;
+            float sink = 0.0f;
+            for (int rep = 0; rep < 30; ++rep)
+                sink += Stats::Moments::summarize<4>(rf).m4;
+            Bench::doNotOptimize(sink);
+            Bench::report(level + " moments<4> float", timer.seconds(), 30.0 * static_cast<double>(rf.size()), "obs");
+        }
+        {
+            Bench::Timer timer;
+            auto c = Stats::Correlation::computeCovarianceMatrix(r);
+            Bench::doNotOptimize(c);
+            Bench::report(level + " covariance 200x2520", timer.seconds(), static_cast<double>(assets * assets / 2), "pair");
+        }
+        {
+            Bench::Timer timer;
+            double sink = 0.0;
+            for (int rep = 0; rep < 20; ++rep)
+                sink += Stats::Ratios::computePortfolioVariance(cov, weights);
+            Bench::doNotOptimize(sink);
+            Bench::report(level + " portfolio variance 1000", timer.seconds(), 20.0 * static_cast<double>(n * n), "term");
+        }
+        {
+            Bench::Timer timer;
+            double sink = 0.0;
+            for (const auto &series : r)
+                sink += Stats::Volatility::computeRollingVolatility(series, 63).back();
+            Bench::doNotOptimize(sink);
+            Bench::report(level + " rolling vol w=63", timer.seconds(), static_cast<double>(assets * days), "obs");
+        }
+    }
+}
@@ -0,0 +1,55 @@
+#include "bench_harness.hpp"
+#include "cli/exporters.hpp"
+
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+
+namespace fs = std::filesystem;
+
+// 3,000 x 3,000 covariance-sized matrix: iostream baseline vs the exporters.
+TRADEIQ_BENCH(ExportMatrix)
+{
+    const size_t n = 3000;
+    std::vector<std::vector<double>> m(n, std::vector<double>(n));
+    for (size_t i = 0; i < n; ++i)
+        for (size_t j = 0; j < n; ++j)
+            m[i][j] = std::sin(static_cast<double>(i * n + j)) * 1e-4;
+
+    fs::path dir = fs::temp_directory_path() / "tradeiq_bench_export";
+    fs::create_directories(dir);
+    const double cells = static_cast<double>(n * n);
+
+    {
+        Bench::Timer timer;
+        std::ofstream out(dir / "iostream.txt");
+        for (const auto &row : m)
+        {
+            for (double v : row)
+                out << std::setw(10) << std::fixed << std::setprecision(4) << v << " ";
+            out << "\n";
+        }
+        out.close();
+        Bench::report("iostream setw/setprecision(4)", timer.seconds(), cells, "cell");
+    }
+    {
+        Bench::Timer timer;
+        Export::CsvOptions opts;
+        opts.precision = 4;
+        Export::writeCsv((dir / "fixed.csv").string(), m, {}, opts);
+        Bench::report("csv to_chars fixed(4)", timer.seconds(), cells, "cell");
+    }
+    {
+        Bench::Timer timer;
+        Export::writeCsv((dir / "exact.csv").string(), m);
+        Bench::report("csv to_chars shortest round-trip", timer.seconds(), cells, "cell");
+    }
+    {
+        Bench::Timer timer;
+        Export::writeColumnar((dir / "m.tiqc").string(), m);
+        Bench::report("columnar binary", timer.seconds(), cells, "cell");
+    }
+
+    fs::remove_all(dir);
+}
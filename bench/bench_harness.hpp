@@ -0,0 +1,59 @@
+#pragma once
+
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Minimal self-registering benchmark harness; no external dependencies.
+namespace Bench
+{
+    struct Case
+    {
+        std::string name;
+        std::function<void()> run;
+    };
+
+    inline std::vector<Case> &registry()
+    {
+        static std::vector<Case> cases;
+        return cases;
+    }
+
+    struct Registrar
+    {
+        Registrar(const char *name, std::function<void()> fn) { registry().push_back({name, std::move(fn)}); }
+    };
+
+    class Timer
+    {
+    public:
+        Timer() : start_(std::chrono::steady_clock::now()) {}
+        double seconds() const
+        {
+            return std::chrono::duration<double>(std::chrono::steady_clock::now() - start_).count();
+        }
+
+    private:
+        std::chrono::steady_clock::time_point start_;
+    };
+
+    // Prints wall time and throughput in millions of `unit` per second.
+    inline void report(const std::string &label, double seconds, double items, const char *unit)
+    {
+        std::printf("  %-44s %10.3f ms %10.2f M%s/s\n", label.c_str(), seconds * 1e3, items / seconds / 1e6, unit);
+    }
+
+    template <typename T>
+    inline void doNotOptimize(const T &value)
+    {
+        asm volatile("" : : "r,m"(value) : "memory");
+    }
+}
+
+#define TRADEIQ_BENCH(name)                                        \
+    static void name();                                            \
+    static ::Bench::Registrar name##_registrar(#name, &name);      \
+    static void name()
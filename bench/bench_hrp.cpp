@@ -0,0 +1,32 @@
+#include "bench_harness.hpp"
+#include "stats/hrp.hpp"
+
+#include <cmath>
+
+// 5,000 assets in 50 sectors: nearest-neighbour-chain linkage plus bisection.
+TRADEIQ_BENCH(HRP)
+{
+    const size_t n = 5000, sectors = 50;
+    std::vector<std::vector<double>> corr(n, std::vector<double>(n));
+    for (size_t i = 0; i < n; ++i)
+        for (size_t j = 0; j < n; ++j)
+            corr[i][j] = i == j ? 1.0
+                                : (i % sectors == j % sectors ? 0.6 : 0.2) +
+                                      0.1 * std::sin(static_cast<double>(i * 31 + j * 31 + (i * j) % 97));
+
+    std::vector<std::vector<double>> cov(n, std::vector<double>(n));
+    for (size_t i = 0; i < n; ++i)
+        for (size_t j = 0; j < n; ++j)
+            cov[i][j] = corr[i][j] * 0.01 * (1.0 + 0.3 * std::cos(static_cast<double>(i))) * 0.01 *
+                        (1.0 + 0.3 * std::cos(static_cast<double>(j)));
+
+    for (auto linkage : {Stats::HRP::Linkage::Single, Stats::HRP::Linkage::Average})
+    {
+        Bench::Timer timer;
+        auto w = Stats::HRP::computeHRPWeights(cov, corr, linkage);
+        Bench::doNotOptimize(w.back());
+        Bench::report(linkage == Stats::HRP::Linkage::Single ? "HRP single linkage (5000 assets)"
+                                                             : "HRP average linkage (5000 assets)",
+                      timer.seconds(), n, "asset");
+    }
+}
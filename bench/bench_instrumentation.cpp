@@ -0,0 +1,40 @@
+#include "bench_harness.hpp"
+#include "utils/instrumentation.hpp"
+
+// Per-probe cost with recording off (the default) and on.
+TRADEIQ_BENCH(InstrumentationOverhead)
+{
+    const size_t iterations = 2000000;
+    Instrumentation::reset();
+
+    Instrumentation::setEnabled(false);
+    {
+        Bench::Timer timer;
+        for (size_t i = 0; i < iterations; ++i)
+        {
+            Instrumentation::ScopedTimer t("bench.scope");
+            Bench::doNotOptimize(i);
+        }
+        Bench::report("scoped timer, disabled", timer.seconds(), static_cast<double>(iterations), "probe");
+    }
+
+    Instrumentation::setEnabled(true);
+    {
+        Bench::Timer timer;
+        for (size_t i = 0; i < iterations; ++i)
+        {
+            Instrumentation::ScopedTimer t("bench.scope");
+            Bench::doNotOptimize(i);
+        }
+        Bench::report("scoped timer, enabled", timer.seconds(), static_cast<double>(iterations), "probe");
+    }
+    {
+        Bench::Timer timer;
+        for (size_t i = 0; i < iterations; ++i)
+            Instrumentation::addCounter("bench.counter", 1);
+        Bench::report("counter, enabled", timer.seconds(), static_cast<double>(iterations), "probe");
+    }
+
+    Instrumentation::setEnabled(false);
+    Instrumentation::reset();
+}
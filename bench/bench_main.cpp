@@ -0,0 +1,16 @@
+#include "bench_harness.hpp"
+#include <cstring>
+
+// Usage: benchmarks [substring-filter]
+int main(int argc, char **argv)
+{
+    const char *filter = argc > 1 ? argv[1] : "";
+    for (const auto &c : Bench::registry())
+    {
+        if (std::strstr(c.name.c_str(), filter) == nullptr)
+            continue;
+        std::printf("%s\n", c.name.c_str());
+        c.run();
+    }
+    return 0;
+}
@@ -0,0 +1,127 @@
+#include "bench_harness.hpp"
+#include "core/metric_graph.hpp"
+#include "stats/correlation.hpp"
+#include "stats/drawdowns.hpp"
+#include "stats/volatility.hpp"
+
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+    std::vector<std::string> symbols(size_t n)
+    {
+        std::vector<std::string> out(n);
+        char buf[16];
+        for (size_t i = 0; i < n; ++i)
+        {
+            std::snprintf(buf, sizeof(buf), "T%zu", i);
+            out[i] = buf;
+        }
+        return out;
+    }
+
+    // closes[t][i]: a random walk per ticker.
+    std::vector<std::vector<double>> walk(size_t tickers, size_t days)
+    {
+        std::mt19937_64 rng(9);
+        std::normal_distribution<double> step(0.0003, 0.015);
+        std::vector<std::vector<double>> closes(days, std::vector<double>(tickers));
+        for (size_t i = 0; i < tickers; ++i)
+        {
+            double p = 100.0;
+            for (size_t t = 0; t < days; ++t)
+            {
+                closes[t][i] = p;
+                p *= std::exp(step(rng));
+            }
+        }
+        return closes;
+    }
+}
+
+// One new bar for 5,000 tickers with five years of history: recomputing
+// returns, wealth, drawdown and two rolling vols from scratch vs appending
+// to the metric graph; then covariance for 500 tickers the same two ways.
+TRADEIQ_BENCH(IncrementalUpdate)
+{
+    const size_t tickers = 5000, days = 1260;
+    const auto closes = walk(tickers, days + 1);
+
+    MetricGraph::Graph graph = MetricGraph::Graph::standard(symbols(tickers), {21, 63});
+    for (size_t t = 0; t < days; ++t)
+        graph.append(static_cast<int64_t>(t), closes[t]);
+
+    {
+        Bench::Timer timer;
+        double sink = 0.0;
+        std::vector<double> prices(days + 1), wealth(days + 1);
+        for (size_t i = 0; i < tickers; ++i)
+        {
+            for (size_t t = 0; t <= days; ++t)
+                prices[t] = closes[t][i];
+            std::vector<double> returns(days);
+            wealth[0] = 1.0;
+            for (size_t t = 0; t < days; ++t)
+            {
+                returns[t] = (prices[t + 1] - prices[t]) / prices[t];
+                wealth[t + 1] = wealth[t] * (1.0 + returns[t]);
+            }
+            sink += Stats::Drawdowns::computeMaxDrawdown(wealth);
+            sink += Stats::Volatility::computeRollingVolatility(returns, 21).back();
+            sink += Stats::Volatility::computeRollingVolatility(returns, 63).back();
+        }
+        Bench::doNotOptimize(sink);
+        Bench::report("full recompute, 5000 x 1261 bars", timer.seconds(), static_cast<double>(tickers), "ticker");
+    }
+    {
+        Bench::Timer timer;
+        graph.append(static_cast<int64_t>(days), closes[days]);
+        Bench::doNotOptimize(graph.values("rolling_vol_63").data());
+        Bench::report("graph append, 1 bar", timer.seconds(), static_cast<double>(tickers), "ticker");
+    }
+
+    const std::string path = (std::filesystem::temp_directory_path() / "tradeiq_bench_metric_graph.ckpt").string();
+    {
+        Bench::Timer timer;
+        graph.saveCheckpoint(path);
+        Bench::report("saveCheckpoint", timer.seconds(), static_cast<double>(tickers), "ticker");
+    }
+    {
+        MetricGraph::Graph restored = MetricGraph::Graph::standard(symbols(tickers), {21, 63});
+        Bench::Timer timer;
+        restored.loadCheckpoint(path);
+        Bench::report("loadCheckpoint", timer.seconds(), static_cast<double>(tickers), "ticker");
+    }
+    std::filesystem::remove(path);
+
+    const size_t assets = 500;
+    MetricGraph::Graph covGraph(symbols(assets));
+    covGraph.emplace<MetricGraph::Returns>();
+    covGraph.emplace<MetricGraph::Covariance>();
+    std::vector<std::vector<double>> sub(days + 1, std::vector<double>(assets));
+    for (size_t t = 0; t <= days; ++t)
+        std::copy(closes[t].begin(), closes[t].begin() + assets, sub[t].begin());
+    for (size_t t = 0; t < days; ++t)
+        covGraph.append(static_cast<int64_t>(t), sub[t]);
+    {
+        Bench::Timer timer;
+        std::vector<std::vector<double>> returns(assets, std::vector<double>(days));
+        for (size_t i = 0; i < assets; ++i)
+            for (size_t t = 0; t < days; ++t)
+                returns[i][t] = (sub[t + 1][i] - sub[t][i]) / sub[t][i];
+        auto cov = Stats::Correlation::computeCovarianceMatrix(returns, true);
+        Bench::doNotOptimize(cov[0].data());
+        Bench::report("covariance recompute, 500 x 1260 returns", timer.seconds(), static_cast<double>(assets), "ticker");
+    }
+    {
+        Bench::Timer timer;
+        covGraph.append(static_cast<int64_t>(days), sub[days]);
+        Bench::doNotOptimize(covGraph.values("covariance").data());
+        Bench::report("covariance graph append, 1 bar", timer.seconds(), static_cast<double>(assets), "ticker");
+    }
+}
@@ -0,0 +1,33 @@
+#include "bench_harness.hpp"
+#include "stats/distribution.hpp"
+#include "stats/moments.hpp"
+
+#include <cmath>
+#include <unordered_set>
+
+// 10^6 returns: the previous hash-set constant check alone vs the whole statistic.
+TRADEIQ_BENCH(SkewnessMillion)
+{
+    const size_t n = 1000000;
+    std::vector<double> returns(n);
+    for (size_t i = 0; i < n; ++i)
+        returns[i] = 0.01 * std::sin(static_cast<double>(i) * 0.7);
+
+    {
+        Bench::Timer timer;
+        std::unordered_set<double> s(returns.begin(), returns.end());
+        Bench::doNotOptimize(s.size());
+        Bench::report("unordered_set constant check (old)", timer.seconds(), n, "elem");
+    }
+    {
+        Bench::Timer timer;
+        Bench::doNotOptimize(Stats::Distribution::computeSkewness(returns));
+        Bench::report("Distribution::computeSkewness", timer.seconds(), n, "elem");
+    }
+    {
+        Bench::Timer timer;
+        auto m = Stats::Moments::summarize<4>(returns);
+        Bench::doNotOptimize(Stats::Moments::excessKurtosis(m, Stats::Moments::Estimator::Unbiased));
+        Bench::report("Moments::summarize<4> + kurtosis", timer.seconds(), n, "elem");
+    }
+}
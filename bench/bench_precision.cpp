@@ -0,0 +1,38 @@
+#include "bench_harness.hpp"
+#include "stats/distribution.hpp"
+#include "stats/volatility.hpp"
+#include "utils/math_utils.hpp"
+
+#include <cmath>
+
+// Same kernels instantiated for double and for float (compensated sums).
+template <typename T>
+static void runPrecision(const char *mean, const char *skew, const char *rolling)
+{
+    const size_t n = 10000000;
+    std::vector<T> returns(n);
+    for (size_t i = 0; i < n; ++i)
+        returns[i] = static_cast<T>(0.01 * std::sin(static_cast<double>(i) * 0.7));
+
+    {
+        Bench::Timer timer;
+        Bench::doNotOptimize(MathUtils::mean(returns));
+        Bench::report(mean, timer.seconds(), n, "elem");
+    }
+    {
+        Bench::Timer timer;
+        Bench::doNotOptimize(Stats::Distribution::computeSkewness(returns));
+        Bench::report(skew, timer.seconds(), n, "elem");
+    }
+    {
+        Bench::Timer timer;
+        Bench::doNotOptimize(Stats::Volatility::computeRollingVolatility(returns, 20).back());
+        Bench::report(rolling, timer.seconds(), n, "window");
+    }
+}
+
+TRADEIQ_BENCH(FloatVsDouble)
+{
+    runPrecision<double>("double MathUtils::mean", "double computeSkewness", "double rolling vol (20)");
+    runPrecision<float>("float  MathUtils::mean", "float  computeSkewness", "float  rolling vol (20)");
+}
@@ -0,0 +1,42 @@
+#include "bench_harness.hpp"
+#include "stats/quantiles.hpp"
+#include "utils/math_utils.hpp"
+
+#include <cmath>
+
+// Rolling 1-year 5% quantile: copy-and-sort per window vs the rank Fenwick tree.
+TRADEIQ_BENCH(RollingQuantile)
+{
+    const size_t assets = 100, days = 2520, window = 252;
+    std::vector<std::vector<double>> r(assets, std::vector<double>(days));
+    for (size_t a = 0; a < assets; ++a)
+        for (size_t t = 0; t < days; ++t)
+            r[a][t] = 0.01 * std::sin(static_cast<double>(t * (a + 7)) * 0.113 + static_cast<double>(a));
+
+    const double steps = static_cast<double>(assets * (days - window + 1));
+    {
+        Bench::Timer timer;
+        double sink = 0.0;
+        for (const auto &series : r)
+            for (size_t i = 0; i + window <= days; ++i)
+                sink += MathUtils::percentile(std::vector<double>(series.begin() + i, series.begin() + i + window), 5.0);
+        Bench::doNotOptimize(sink);
+        Bench::report("percentile per window (copy + sort)", timer.seconds(), steps, "step");
+    }
+    {
+        Bench::Timer timer;
+        double sink = 0.0;
+        for (const auto &series : r)
+            sink += Stats::Quantiles::computeRollingQuantile(series, window, 5.0).back();
+        Bench::doNotOptimize(sink);
+        Bench::report("rank Fenwick tree", timer.seconds(), steps, "step");
+    }
+    {
+        Bench::Timer timer;
+        double sink = 0.0;
+        for (const auto &series : r)
+            sink += Stats::Quantiles::computeRollingQuantiles(series, window, {1.0, 5.0, 50.0, 95.0, 99.0})[4].back();
+        Bench::doNotOptimize(sink);
+        Bench::report("rank Fenwick tree, 5 quantiles", timer.seconds(), steps, "step");
+    }
+}
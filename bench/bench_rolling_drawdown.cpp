@@ -0,0 +1,46 @@
+#include "bench_harness.hpp"
+#include "stats/drawdowns.hpp"
+
+#include <cmath>
+
+// Trailing 252-day max drawdown, 500 assets x 10 years.
+TRADEIQ_BENCH(RollingDrawdown)
+{
+    const size_t assets = 500, days = 2520, window = 252;
+    std::vector<std::vector<double>> wealth(assets, std::vector<double>(days));
+    for (size_t a = 0; a < assets; ++a)
+    {
+        double w = 1.0;
+        for (size_t t = 0; t < days; ++t)
+        {
+            w *= 1.0 + 0.0003 + 0.012 * std::sin(static_cast<double>(t * (a + 5)) * 0.173 + static_cast<double>(a));
+            wealth[a][t] = w;
+        }
+    }
+    const double steps = static_cast<double>(assets * (days - window + 1));
+
+    {
+        Bench::Timer timer;
+        double sink = 0.0;
+        for (const auto &series : wealth)
+            for (size_t i = 0; i + window <= days; ++i)
+                sink += Stats::Drawdowns::computeMaxDrawdown(
+                    std::vector<double>(series.begin() + i, series.begin() + i + window));
+        Bench::doNotOptimize(sink);
+        Bench::report("recompute per window", timer.seconds(), steps, "step");
+    }
+    {
+        Bench::Timer timer;
+        double sink = 0.0;
+        for (const auto &series : wealth)
+            sink += Stats::Drawdowns::computeRollingMaxDrawdown(series, window).back();
+        Bench::doNotOptimize(sink);
+        Bench::report("block prefix/suffix, per series", timer.seconds(), steps, "step");
+    }
+    {
+        Bench::Timer timer;
+        auto mdd = Stats::Drawdowns::computeRollingMaxDrawdown(wealth, window);
+        Bench::doNotOptimize(mdd.back().back());
+        Bench::report("block prefix/suffix, panel", timer.seconds(), steps, "step");
+    }
+}
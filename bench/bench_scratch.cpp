@@ -0,0 +1,51 @@
+#include "bench_harness.hpp"
+#include "stats/correlation.hpp"
+#include "stats/volatility.hpp"
+#include "utils/arena.hpp"
+
+#include <cmath>
+
+// Repeated metric sweeps: heap-allocating entry points vs a reused ScratchArena.
+TRADEIQ_BENCH(ScratchArenaSweep)
+{
+    const size_t assets = 100;
+    const size_t days = 1000;
+    const int rounds = 20;
+
+    std::vector<PriceSeries> universe;
+    std::vector<double> returns(days);
+    for (size_t a = 0; a < assets; ++a)
+    {
+        std::vector<double> prices(days + 1, 100.0);
+        for (size_t i = 1; i <= days; ++i)
+            prices[i] = prices[i - 1] * (1.0 + 0.01 * std::sin(static_cast<double>(i * (a + 3))));
+        universe.emplace_back("S" + std::to_string(a), std::vector<std::string>(days + 1), prices);
+    }
+    for (size_t i = 0; i < days; ++i)
+        returns[i] = 0.01 * std::sin(static_cast<double>(i));
+
+    {
+        Bench::Timer timer;
+        for (int r = 0; r < rounds; ++r)
+        {
+            auto corr = Stats::Correlation::computeCorrelationMatrix(universe);
+            for (size_t a = 0; a < assets; ++a)
+                Bench::doNotOptimize(Stats::Volatility::computeRollingSharpe(returns, 20, 0.0).back());
+            Bench::doNotOptimize(corr[0][1]);
+        }
+        Bench::report("heap", timer.seconds(), rounds * assets * assets / 2.0, "pair");
+    }
+    {
+        ScratchArena arena(1 << 20);
+        Bench::Timer timer;
+        for (int r = 0; r < rounds; ++r)
+        {
+            arena.reset();
+            auto corr = Stats::Correlation::computeCorrelationMatrix(universe, &arena);
+            for (size_t a = 0; a < assets; ++a)
+                Bench::doNotOptimize(Stats::Volatility::computeRollingSharpe(returns, 20, 0.0, &arena).back());
+            Bench::doNotOptimize(corr[0][1]);
+        }
+        Bench::report("scratch arena", timer.seconds(), rounds * assets * assets / 2.0, "pair");
+    }
+}
@@ -0,0 +1,60 @@
+#include "bench_harness.hpp"
+#include "core/series.hpp"
+#include "stats/returns.hpp"
+#include "stats/volatility.hpp"
+
+#include <cmath>
+
+// Excess returns -> 20-day volatility and wealth curve, eager vs fused, 500 series x 10 years.
+TRADEIQ_BENCH(SeriesFusion)
+{
+    const size_t assets = 500, days = 2520;
+    const double rf = 0.0001;
+    std::vector<PriceSeries> universe;
+    for (size_t a = 0; a < assets; ++a)
+    {
+        std::vector<double> prices(days);
+        double p = 100.0;
+        for (size_t t = 0; t < days; ++t)
+        {
+            p *= 1.0 + 0.0003 + 0.01 * std::sin(static_cast<double>(t * (a + 3)) * 0.29 + static_cast<double>(a));
+            prices[t] = p;
+        }
+        universe.emplace_back("A" + std::to_string(a), prices);
+    }
+    const double points = static_cast<double>(assets * days);
+
+    {
+        Bench::Timer timer;
+        double sink = 0.0;
+        for (const auto &ps : universe)
+        {
+            auto r = Stats::Returns::computeDailyReturns(ps);
+            std::vector<double> excess(r.size());
+            for (size_t i = 0; i < r.size(); ++i)
+                excess[i] = r[i] - rf;
+            auto vol = Stats::Volatility::computeRollingVolatility(excess, 20);
+            std::vector<double> gross(r.size());
+            for (size_t i = 0; i < r.size(); ++i)
+                gross[i] = 1.0 + r[i];
+            std::vector<double> wealth(gross.size());
+            double w = 1.0;
+            for (size_t i = 0; i < gross.size(); ++i)
+                wealth[i] = w *= gross[i];
+            sink += vol.back() + wealth.back();
+        }
+        Bench::doNotOptimize(sink);
+        Bench::report("eager vectors", timer.seconds(), points, "obs");
+    }
+    {
+        Bench::Timer timer;
+        double sink = 0.0;
+        for (const auto &ps : universe)
+        {
+            auto vol = (Series::returns(ps) - rf).rolling(20).stddev().collect();
+            sink += vol.back() + (1.0 + Series::returns(ps)).cumprod().last();
+        }
+        Bench::doNotOptimize(sink);
+        Bench::report("fused expressions", timer.seconds(), points, "obs");
+    }
+}
@@ -0,0 +1,64 @@
+#include "bench_harness.hpp"
+#include "stats/volatility.hpp"
+#include "utils/summation.hpp"
+
+#include <cmath>
+#include <numeric>
+
+// Robust summation against the naive forms it replaced.
+TRADEIQ_BENCH(RobustSummation)
+{
+    const size_t n = 10000000;
+    std::vector<double> returns(n);
+    for (size_t i = 0; i < n; ++i)
+        returns[i] = 0.0005 + 0.01 * std::sin(static_cast<double>(i) * 0.7);
+
+    {
+        Bench::Timer timer;
+        Bench::doNotOptimize(std::accumulate(returns.begin(), returns.end(), 0.0));
+        Bench::report("std::accumulate", timer.seconds(), n, "elem");
+    }
+    {
+        Bench::Timer timer;
+        Bench::doNotOptimize(Summation::sum(std::span<const double>(returns)));
+        Bench::report("Summation::sum (pairwise)", timer.seconds(), n, "elem");
+    }
+    {
+        Bench::Timer timer;
+        Summation::KahanSum<double> acc;
+        for (double x : returns)
+            acc.add(x);
+        Bench::doNotOptimize(acc.value());
+        Bench::report("KahanSum (streaming)", timer.seconds(), n, "elem");
+    }
+    {
+        Bench::Timer timer;
+        Bench::doNotOptimize(Summation::variance(std::span<const double>(returns), true));
+        Bench::report("Summation::variance (two-pass)", timer.seconds(), n, "elem");
+    }
+
+    const size_t w = 20;
+    {
+        Bench::Timer timer;
+        std::vector<double> out;
+        out.reserve(n - w + 1);
+        for (size_t i = 0; i + w <= n; ++i)
+        {
+            double sum = 0.0, sumSq = 0.0;
+            for (size_t j = 0; j < w; ++j)
+            {
+                sum += returns[i + j];
+                sumSq += returns[i + j] * returns[i + j];
+            }
+            double mean = sum / w;
+            out.push_back(std::sqrt((sumSq - w * mean * mean) / (w - 1)));
+        }
+        Bench::doNotOptimize(out.back());
+        Bench::report("rolling vol, sumSq - n*mean^2 (old)", timer.seconds(), n - w + 1, "window");
+    }
+    {
+        Bench::Timer timer;
+        Bench::doNotOptimize(Stats::Volatility::computeRollingVolatility(returns, w).back());
+        Bench::report("computeRollingVolatility (shifted, sliding)", timer.seconds(), n - w + 1, "window");
+    }
+}
@@ -0,0 +1,41 @@
+#include "bench_harness.hpp"
+#include "stats/correlation.hpp"
+#include "stats/volatility.hpp"
+#include "utils/execution.hpp"
+#include "utils/task_scheduler.hpp"
+
+#include <cmath>
+#include <string>
+
+// Covariance of 300 assets x 10 years and rolling volatility per asset, under
+// each execution policy on the global pool (TRADEIQ_THREADS sets its width).
+TRADEIQ_BENCH(TaskScheduler)
+{
+    const size_t assets = 300, days = 2520;
+    std::vector<std::vector<double>> r(assets, std::vector<double>(days));
+    for (size_t a = 0; a < assets; ++a)
+        for (size_t t = 0; t < days; ++t)
+            r[a][t] = 0.0003 + 0.01 * std::sin(static_cast<double>(t * (a + 3)) * 0.29 + static_cast<double>(a));
+    const double pairs = static_cast<double>(assets * (assets + 1) / 2);
+    const std::string threads = std::to_string(Tasks::TaskScheduler::global().concurrency()) + " threads ";
+
+    auto run = [&](const std::string &label, auto policy)
+    {
+        {
+            Bench::Timer timer;
+            auto cov = Stats::Correlation::computeCovarianceMatrix(policy, r);
+            Bench::doNotOptimize(cov[assets - 1][0]);
+            Bench::report(threads + label + " covariance", timer.seconds(), pairs, "pair");
+        }
+        {
+            Bench::Timer timer;
+            auto vol = Stats::Volatility::computeRollingVolatility(policy, r, size_t{63});
+            Bench::doNotOptimize(vol[assets - 1].back());
+            Bench::report(threads + label + " rolling volatility", timer.seconds(), static_cast<double>(assets * days),
+                          "obs");
+        }
+    };
+    run("seq", Execution::seq);
+    run("par", Execution::par);
+    run("par_unseq", Execution::par_unseq);
+}
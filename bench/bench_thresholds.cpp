@@ -0,0 +1,42 @@
+#include "bench_harness.hpp"
+#include "stats/ratios.hpp"
+#include "stats/thresholds.hpp"
+
+#include <cmath>
+
+// Omega and Sortino over 201 MAR levels, 200 assets x 10 years.
+TRADEIQ_BENCH(ThresholdCurves)
+{
+    const size_t assets = 200, days = 2520;
+    std::vector<std::vector<double>> r(assets, std::vector<double>(days));
+    for (size_t a = 0; a < assets; ++a)
+        for (size_t t = 0; t < days; ++t)
+            r[a][t] = 0.0003 + 0.01 * std::sin(static_cast<double>(t * (a + 3)) * 0.29 + static_cast<double>(a));
+
+    std::vector<double> grid;
+    for (int i = -100; i <= 100; ++i)
+        grid.push_back(0.0002 * i);
+    const double points = static_cast<double>(assets * grid.size());
+
+    {
+        Bench::Timer timer;
+        double sink = 0.0;
+        for (const auto &series : r)
+            for (double tau : grid)
+                sink += Stats::Ratios::computeOmegaRatio(series, tau) + Stats::Ratios::computeSortinoRatio(0.0003, tau, series);
+        Bench::doNotOptimize(sink);
+        Bench::report("full scan per threshold", timer.seconds(), points, "point");
+    }
+    {
+        Bench::Timer timer;
+        double sink = 0.0;
+        for (const auto &series : r)
+        {
+            Stats::Thresholds::ReturnThresholds<double> curve(series);
+            for (double tau : grid)
+                sink += curve.omega(tau) + curve.sortino(0.0003, tau);
+        }
+        Bench::doNotOptimize(sink);
+        Bench::report("sort once + prefix sums", timer.seconds(), points, "point");
+    }
+}
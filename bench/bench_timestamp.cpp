@@ -0,0 +1,83 @@
+#include "bench_harness.hpp"
+#include "core/trading_calendar.hpp"
+#include "utils/timestamp.hpp"
+
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace
+{
+    // The checks Tiingo input used to get: substr + stoi per field.
+    int64_t legacyParseDays(const std::string &s)
+    {
+        if (s.size() < 10 || s[4] != '-' || s[7] != '-')
+            throw std::invalid_argument(s);
+        const int year = std::stoi(s.substr(0, 4));
+        const int month = std::stoi(s.substr(5, 2));
+        const int day = std::stoi(s.substr(8, 2));
+        if (month < 1 || month > 12 || day < 1 || day > 31)
+            throw std::invalid_argument(s);
+        return Timestamp::daysFromCivil(year, static_cast<unsigned>(month), static_cast<unsigned>(day));
+    }
+}
+
+// Parsing 1M Tiingo timestamps, and stepping 1M random session offsets.
+TRADEIQ_BENCH(TimestampCalendar)
+{
+    const size_t n = 1 << 20;
+    std::mt19937_64 rng(5);
+    std::uniform_int_distribution<int64_t> pick(Timestamp::daysFromCivil(1995, 1, 1), Timestamp::daysFromCivil(2060, 1, 1));
+    std::vector<std::string> text(n);
+    std::vector<int64_t> days(n);
+    for (size_t i = 0; i < n; ++i)
+    {
+        days[i] = pick(rng);
+        text[i] = Timestamp::formatIsoMillis(days[i] * 86400000LL);
+    }
+
+    {
+        Bench::Timer timer;
+        int64_t sink = 0;
+        for (const auto &s : text)
+            sink += legacyParseDays(s);
+        Bench::doNotOptimize(sink);
+        Bench::report("substr + stoi (date only)", timer.seconds(), static_cast<double>(n), "ts");
+    }
+    {
+        Bench::Timer timer;
+        int64_t sink = 0;
+        for (const auto &s : text)
+        {
+            int64_t ms = 0;
+            Timestamp::tryParseIsoMillis(s, ms);
+            sink += ms;
+        }
+        Bench::doNotOptimize(sink);
+        Bench::report("SWAR tryParseIsoMillis (full)", timer.seconds(), static_cast<double>(n), "ts");
+    }
+
+    const TradingCalendar &nyse = TradingCalendar::nyse();
+    {
+        Bench::Timer timer;
+        int64_t sink = 0;
+        for (size_t i = 0; i < n; ++i)
+        {
+            int64_t d = days[i], left = static_cast<int64_t>(i % 64) + 1;
+            while (left > 0)
+                left -= nyse.isSession(++d);
+            sink += d;
+        }
+        Bench::doNotOptimize(sink);
+        Bench::report("add 1..64 sessions, day-by-day walk", timer.seconds(), static_cast<double>(n), "op");
+    }
+    {
+        Bench::Timer timer;
+        int64_t sink = 0;
+        for (size_t i = 0; i < n; ++i)
+            sink += nyse.addSessions(days[i], static_cast<int64_t>(i % 64) + 1);
+        Bench::doNotOptimize(sink);
+        Bench::report("add 1..64 sessions, addSessions", timer.seconds(), static_cast<double>(n), "op");
+    }
+}
@@ -0,0 +1,99 @@
+#include "bench_harness.hpp"
+#include "core/universe.hpp"
+
+#include <cstdio>
+#include <map>
+#include <string>
+#include <vector>
+
+#ifdef __linux__
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+    constexpr size_t kTickers = 5000, kDays = 252;
+
+    // What the Tiingo parser hands back for one ticker: ISO dates and closes.
+    void parsed(size_t t, std::vector<std::string> &dates, std::vector<double> &prices)
+    {
+        dates.clear();
+        prices.clear();
+        for (size_t d = 0; d < kDays; ++d)
+        {
+            char date[32];
+            std::snprintf(date, sizeof date, "2023-%02zu-%02zuT00:00:00.000Z", 1 + d / 28 % 12, 1 + d % 28);
+            dates.emplace_back(date);
+            prices.push_back(100.0 + static_cast<double>(t) + 0.01 * static_cast<double>(d));
+        }
+    }
+
+    // Old path: PriceSeries copied the parser's vectors, then the map insert
+    // copied the series again.
+    size_t loadIntoMap()
+    {
+        std::map<std::string, PriceSeries> result;
+        for (size_t t = 0; t < kTickers; ++t)
+        {
+            std::vector<std::string> dates;
+            std::vector<double> prices;
+            parsed(t, dates, prices);
+            const std::string ticker = "T" + std::to_string(t);
+            PriceSeries ps(ticker, dates, prices);
+            result.insert({ticker, ps});
+        }
+        return result.size();
+    }
+
+    size_t loadIntoUniverse()
+    {
+        Universe result;
+        result.reserve(kTickers);
+        for (size_t t = 0; t < kTickers; ++t)
+        {
+            std::vector<std::string> dates;
+            std::vector<double> prices;
+            parsed(t, dates, prices);
+            result.insert(PriceSeries("T" + std::to_string(t), std::move(dates), std::move(prices)));
+        }
+        return result.size();
+    }
+
+    // Runs fn in a child process so its peak RSS is measured on its own.
+    template <typename Fn>
+    void measure(const std::string &label, Fn fn)
+    {
+#ifdef __linux__
+        std::fflush(stdout);
+        const pid_t pid = fork();
+        if (pid == 0)
+        {
+            Bench::Timer timer;
+            Bench::doNotOptimize(fn());
+            Bench::report(label, timer.seconds(), static_cast<double>(kTickers), "ticker");
+            std::fflush(stdout);
+            _exit(0);
+        }
+        int status = 0;
+        rusage usage{};
+        if (pid > 0 && wait4(pid, &status, 0, &usage) == pid)
+            std::printf("  %-44s %10.1f MB peak RSS\n", (label + " (child)").c_str(),
+                        static_cast<double>(usage.ru_maxrss) / 1024.0);
+#else
+        Bench::Timer timer;
+        Bench::doNotOptimize(fn());
+        Bench::report(label, timer.seconds(), static_cast<double>(kTickers), "ticker");
+#endif
+    }
+}
+
+// Loading 5,000 tickers x 1 year of daily closes: copying into
+// std::map<std::string, PriceSeries> against moving into a Universe.
+TRADEIQ_BENCH(UniverseLoad)
+{
+    measure("baseline (no load)", [] { return size_t{0}; });
+    measure("std::map + copies", loadIntoMap);
+    measure("Universe + moves", loadIntoUniverse);
+}
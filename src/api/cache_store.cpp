@@ -0,0 +1,476 @@
+#include "api/cache_store.hpp"
+#include "../utils/codec.hpp"
+#include "../utils/instrumentation.hpp"
+#include "../utils/timestamp.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace fs = std::filesystem;
+
+namespace
+{
+    constexpr uint32_t kManifestMagic = 0x4D514954; // "TIQM"
+    // v2 adds the block kind byte; v3 keys carry the frequency, so entries
+    // from older manifests, which may be daily or intraday, are dropped.
+    constexpr uint32_t kManifestVersion = 3;
+
+    constexpr uint8_t kBlockSeries = 0;  // adjusted closes
+    constexpr uint8_t kBlockHistory = 1; // raw closes + corporate actions
+
+    constexpr uint8_t kIsoMillis = static_cast<uint8_t>(Timestamp::Format::IsoMillis);
+
+    int64_t parseTimestampMillis(const std::string &s, uint8_t &format)
+    {
+        Timestamp::Format f;
+        int64_t ms = Timestamp::parseIsoMillis(s, &f);
+        format = static_cast<uint8_t>(f);
+        return ms;
+    }
+
+    std::string formatTimestampMillis(int64_t ms, uint8_t format)
+    {
+        return Timestamp::formatIsoMillis(ms, static_cast<Timestamp::Format>(format));
+    }
+
+    template <typename T>
+    void writePod(std::ostream &out, const T &value)
+    {
+        out.write(reinterpret_cast<const char *>(&value), sizeof(T));
+    }
+
+    template <typename T>
+    T readPod(std::istream &in)
+    {
+        T value{};
+        in.read(reinterpret_cast<char *>(&value), sizeof(T));
+        if (!in)
+            throw std::runtime_error("Cache manifest is truncated");
+        return value;
+    }
+}
+
+// Read-only mmap of a segment file as of the time it was opened.
+class ShardedCacheStore::MappedSegment
+{
+public:
+    explicit MappedSegment(const std::string &path)
+    {
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+            return;
+        struct stat st;
+        if (::fstat(fd, &st) == 0 && st.st_size > 0)
+        {
+            void *addr = ::mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+            if (addr != MAP_FAILED)
+            {
+                data_ = static_cast<const uint8_t *>(addr);
+                size_ = static_cast<size_t>(st.st_size);
+            }
+        }
+        ::close(fd);
+    }
+
+    ~MappedSegment()
+    {
+        if (data_)
+            ::munmap(const_cast<uint8_t *>(data_), size_);
+    }
+
+    const uint8_t *data() const { return data_; }
+    size_t size() const { return size_; }
+
+private:
+    const uint8_t *data_ = nullptr;
+    size_t size_ = 0;
+};
+
+ShardedCacheStore::ShardedCacheStore(const std::string &directory, uint32_t numShards)
+    : directory_(directory), numShards_(numShards == 0 ? 1 : numShards)
+{
+    fs::create_directories(directory_);
+    loadManifest();
+
+    segments_.resize(numShards_);
+    segmentSizes_.resize(numShards_, 0);
+    for (uint32_t s = 0; s < numShards_; ++s)
+    {
+        std::error_code ec;
+        auto size = fs::file_size(segmentPath(s), ec);
+        segmentSizes_[s] = ec ? 0 : size;
+    }
+}
+
+ShardedCacheStore::~ShardedCacheStore()
+{
+    try
+    {
+        flush();
+    }
+    catch (...)
+    {
+    }
+}
+
+std::string ShardedCacheStore::makeKey(const std::string &ticker,
+                                       const std::string &startDate,
+                                       const std::string &endDate,
+                                       const std::string &frequency)
+{
+    return ticker + "_" + startDate + "_" + endDate + "_" + frequency;
+}
+
+uint32_t ShardedCacheStore::shardFor(const std::string &ticker) const
+{
+    return static_cast<uint32_t>(Codec::checksum(ticker.data(), ticker.size()) % numShards_);
+}
+
+std::string ShardedCacheStore::segmentPath(uint32_t shard) const
+{
+    char name[32];
+    std::snprintf(name, sizeof(name), "segment-%02u.seg", shard);
+    return (fs::path(directory_) / name).string();
+}
+
+std::string ShardedCacheStore::manifestPath() const
+{
+    return (fs::path(directory_) / "manifest.idx").string();
+}
+
+void ShardedCacheStore::loadManifest()
+{
+    std::ifstream in(manifestPath(), std::ios::binary);
+    if (!in)
+        return;
+
+    if (readPod<uint32_t>(in) != kManifestMagic)
+        throw std::runtime_error("Not a TradeIQ cache manifest: " + manifestPath());
+    uint32_t version = readPod<uint32_t>(in);
+    if (version < 1 || version > kManifestVersion)
+        throw std::runtime_error("Unsupported cache manifest version");
+
+    // Shard count is a property of the data on disk, not of the caller.
+    numShards_ = readPod<uint32_t>(in);
+    uint32_t count = readPod<uint32_t>(in);
+    manifest_.reserve(count);
+
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        uint16_t keyLen = readPod<uint16_t>(in);
+        std::string key(keyLen, '\0');
+        in.read(key.data(), keyLen);
+
+        CacheManifestEntry e;
+        e.shard = readPod<uint32_t>(in);
+        e.offset = readPod<uint64_t>(in);
+        e.length = readPod<uint32_t>(in);
+        e.count = readPod<uint32_t>(in);
+        e.firstTimestamp = readPod<int64_t>(in);
+        e.lastTimestamp = readPod<int64_t>(in);
+        e.checksum = readPod<uint64_t>(in);
+        e.dateFormat = readPod<uint8_t>(in);
+        e.kind = version >= 2 ? readPod<uint8_t>(in) : kBlockSeries;
+        if (version >= 3)
+            manifest_.emplace(std::move(key), e);
+        else
+            dirty_ = true;
+    }
+}
+
+void ShardedCacheStore::flush()
+{
+    TRADEIQ_TIMED_SCOPE("cache_store.flush");
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!dirty_)
+        return;
+
+    std::string tmp = manifestPath() + ".tmp";
+    {
+        std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+        if (!out)
+            throw std::runtime_error("Cannot write cache manifest: " + tmp);
+
+        writePod(out, kManifestMagic);
+        writePod(out, kManifestVersion);
+        writePod(out, numShards_);
+        writePod(out, static_cast<uint32_t>(manifest_.size()));
+        for (const auto &[key, e] : manifest_)
+        {
+            writePod(out, static_cast<uint16_t>(key.size()));
+            out.write(key.data(), static_cast<std::streamsize>(key.size()));
+            writePod(out, e.shard);
+            writePod(out, e.offset);
+            writePod(out, e.length);
+            writePod(out, e.count);
+            writePod(out, e.firstTimestamp);
+            writePod(out, e.lastTimestamp);
+            writePod(out, e.checksum);
+            writePod(out, e.dateFormat);
+            writePod(out, e.kind);
+        }
+    }
+    fs::rename(tmp, manifestPath());
+    dirty_ = false;
+}
+
+const ShardedCacheStore::MappedSegment &ShardedCacheStore::segment(uint32_t shard)
+{
+    auto &seg = segments_[shard];
+    if (!seg || seg->size() < segmentSizes_[shard])
+        seg = std::make_unique<MappedSegment>(segmentPath(shard));
+    return *seg;
+}
+
+bool ShardedCacheStore::contains(const std::string &ticker,
+                                 const std::string &startDate,
+                                 const std::string &endDate,
+                                 const std::string &frequency) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return manifest_.count(makeKey(ticker, startDate, endDate, frequency)) > 0;
+}
+
+std::optional<CacheManifestEntry> ShardedCacheStore::describe(const std::string &ticker,
+                                                              const std::string &startDate,
+                                                              const std::string &endDate,
+                                                              const std::string &frequency) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = manifest_.find(makeKey(ticker, startDate, endDate, frequency));
+    if (it == manifest_.end())
+        return std::nullopt;
+    return it->second;
+}
+
+size_t ShardedCacheStore::size() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return manifest_.size();
+}
+
+void ShardedCacheStore::appendBlock(const std::string &key,
+                                    const std::string &ticker,
+                                    const std::vector<std::string> &dates,
+                                    const std::vector<double> &values,
+                                    uint8_t kind,
+                                    const std::string &extra)
+{
+    TRADEIQ_TIMED_SCOPE("cache_store.write");
+    std::vector<int64_t> timestamps;
+    timestamps.reserve(dates.size());
+    uint8_t format = kIsoMillis;
+    for (size_t i = 0; i < dates.size(); ++i)
+    {
+        uint8_t f;
+        timestamps.push_back(parseTimestampMillis(dates[i], f));
+        if (i > 0 && f != format)
+            throw std::invalid_argument("Mixed timestamp formats in series " + ticker);
+        format = f;
+    }
+
+    std::string ts = Codec::encodeTimestamps(timestamps);
+    std::string px = Codec::encodeDoubles(values);
+
+    // Block: [u32 tsLen][u32 pxLen]([u32 extraLen])[ts][px]([extra])
+    std::string block;
+    block.reserve(3 * sizeof(uint32_t) + ts.size() + px.size() + extra.size());
+    uint32_t tsLen = static_cast<uint32_t>(ts.size());
+    uint32_t pxLen = static_cast<uint32_t>(px.size());
+    block.append(reinterpret_cast<const char *>(&tsLen), sizeof(tsLen));
+    block.append(reinterpret_cast<const char *>(&pxLen), sizeof(pxLen));
+    if (kind == kBlockHistory)
+    {
+        uint32_t extraLen = static_cast<uint32_t>(extra.size());
+        block.append(reinterpret_cast<const char *>(&extraLen), sizeof(extraLen));
+    }
+    block += ts;
+    block += px;
+    block += extra;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    uint32_t shard = shardFor(ticker);
+    {
+        std::ofstream out(segmentPath(shard), std::ios::binary | std::ios::app);
+        if (!out)
+            throw std::runtime_error("Cannot append to cache segment " + segmentPath(shard));
+        out.write(block.data(), static_cast<std::streamsize>(block.size()));
+    }
+
+    CacheManifestEntry e;
+    e.shard = shard;
+    e.offset = segmentSizes_[shard];
+    e.length = static_cast<uint32_t>(block.size());
+    e.count = static_cast<uint32_t>(timestamps.size());
+    e.firstTimestamp = timestamps.empty() ? 0 : timestamps.front();
+    e.lastTimestamp = timestamps.empty() ? 0 : timestamps.back();
+    e.checksum = Codec::checksum(block.data(), block.size());
+    e.dateFormat = format;
+    e.kind = kind;
+
+    segmentSizes_[shard] += block.size();
+    manifest_[key] = e;
+    dirty_ = true;
+}
+
+bool ShardedCacheStore::readBlock(const std::string &key,
+                                  std::vector<std::string> &dates,
+                                  std::vector<double> &values,
+                                  std::string *extra)
+{
+    TRADEIQ_TIMED_SCOPE("cache_store.read");
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = manifest_.find(key);
+    if (it == manifest_.end())
+    {
+        TRADEIQ_COUNTER("cache_store.misses", 1);
+        return false;
+    }
+    TRADEIQ_COUNTER("cache_store.hits", 1);
+
+    const CacheManifestEntry &e = it->second;
+    const MappedSegment &seg = segment(e.shard);
+    if (!seg.data() || e.offset + e.length > seg.size())
+        throw std::runtime_error("Cache segment is shorter than its manifest entry");
+
+    const uint8_t *block = seg.data() + e.offset;
+    if (Codec::checksum(block, e.length) != e.checksum)
+        throw std::runtime_error("Cache block checksum mismatch for " + key);
+
+    uint32_t tsLen, pxLen, extraLen = 0;
+    std::memcpy(&tsLen, block, sizeof(uint32_t));
+    std::memcpy(&pxLen, block + sizeof(uint32_t), sizeof(uint32_t));
+    size_t header = 2 * sizeof(uint32_t);
+    if (e.kind == kBlockHistory)
+    {
+        std::memcpy(&extraLen, block + header, sizeof(uint32_t));
+        header += sizeof(uint32_t);
+    }
+    const uint8_t *tsData = block + header;
+    const uint8_t *pxData = tsData + tsLen;
+
+    auto timestamps = Codec::decodeTimestamps(tsData, tsLen, e.count);
+    values = Codec::decodeDoubles(pxData, pxLen, e.count);
+
+    dates.clear();
+    dates.reserve(e.count);
+    for (int64_t ts : timestamps)
+        dates.push_back(formatTimestampMillis(ts, e.dateFormat));
+
+    if (extra)
+        extra->assign(reinterpret_cast<const char *>(pxData + pxLen), extraLen);
+    return true;
+}
+
+std::optional<PriceSeries> ShardedCacheStore::get(const std::string &ticker,
+                                                  const std::string &startDate,
+                                                  const std::string &endDate,
+                                                  const std::string &frequency)
+{
+    std::vector<std::string> dates;
+    std::vector<double> prices;
+    if (!readBlock(makeKey(ticker, startDate, endDate, frequency), dates, prices, nullptr))
+        return std::nullopt;
+    return PriceSeries(ticker, std::move(dates), std::move(prices));
+}
+
+void ShardedCacheStore::put(const std::string &ticker,
+                            const std::string &startDate,
+                            const std::string &endDate,
+                            const PriceSeries &series,
+                            const std::string &frequency)
+{
+    appendBlock(makeKey(ticker, startDate, endDate, frequency), ticker, series.getDates(), series.getPrices(), kBlockSeries, {});
+}
+
+std::optional<AdjustedHistory> ShardedCacheStore::getHistory(const std::string &ticker,
+                                                             const std::string &startDate,
+                                                             const std::string &endDate)
+{
+    std::vector<std::string> dates;
+    std::vector<double> closes;
+    std::string events;
+    if (!readBlock(makeKey(ticker, startDate, endDate) + "#raw", dates, closes, &events))
+        return std::nullopt;
+
+    // Events: varint count, then (varint index delta, f64 dividend, f64 split).
+    const auto *cursor = reinterpret_cast<const uint8_t *>(events.data());
+    const auto *end = cursor + events.size();
+    uint64_t count = Codec::readVarint(cursor, end);
+
+    std::vector<CorporateAction> actions;
+    actions.reserve(count);
+    size_t index = 0;
+    for (uint64_t i = 0; i < count; ++i)
+    {
+        index += Codec::readVarint(cursor, end);
+        if (end - cursor < static_cast<std::ptrdiff_t>(2 * sizeof(double)))
+            throw std::runtime_error("Truncated corporate-action block for " + ticker);
+        CorporateAction a;
+        a.index = index;
+        std::memcpy(&a.dividend, cursor, sizeof(double));
+        std::memcpy(&a.splitFactor, cursor + sizeof(double), sizeof(double));
+        cursor += 2 * sizeof(double);
+        actions.push_back(a);
+    }
+
+    return AdjustedHistory(ticker, std::move(dates), std::move(closes), std::move(actions));
+}
+
+void ShardedCacheStore::putHistory(const std::string &startDate,
+                                   const std::string &endDate,
+                                   const AdjustedHistory &history)
+{
+    std::string events;
+    Codec::appendVarint(events, history.getActions().size());
+    size_t prevIndex = 0;
+    for (const auto &a : history.getActions())
+    {
+        Codec::appendVarint(events, a.index - prevIndex);
+        events.append(reinterpret_cast<const char *>(&a.dividend), sizeof(double));
+        events.append(reinterpret_cast<const char *>(&a.splitFactor), sizeof(double));
+        prevIndex = a.index;
+    }
+
+    const std::string &ticker = history.getTicker();
+    appendBlock(makeKey(ticker, startDate, endDate) + "#raw", ticker, history.getDates(), history.getRawCloses(),
+                kBlockHistory, events);
+}
+
+std::optional<AdjustedHistory> ShardedCacheStore::latestHistory(const std::string &ticker,
+                                                                const std::string &startDate,
+                                                                const std::string &endDate,
+                                                                std::string *storedEnd)
+{
+    // History keys are makeKey(ticker, startDate, end, "daily") + "#raw".
+    const std::string prefix = ticker + "_" + startDate + "_";
+    const std::string suffix = "_daily#raw";
+    std::string best;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (const auto &[key, e] : manifest_)
+        {
+            if (e.kind != kBlockHistory || key.size() <= prefix.size() + suffix.size() ||
+                key.compare(0, prefix.size(), prefix) != 0 ||
+                key.compare(key.size() - suffix.size(), suffix.size(), suffix) != 0)
+                continue;
+            std::string end = key.substr(prefix.size(), key.size() - prefix.size() - suffix.size());
+            // YYYY-MM-DD orders as text.
+            if (end < endDate && end > best)
+                best = std::move(end);
+        }
+    }
+    if (best.empty())
+        return std::nullopt;
+    if (storedEnd)
+        *storedEnd = best;
+    return getHistory(ticker, startDate, best);
+}
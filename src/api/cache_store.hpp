@@ -0,0 +1,131 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "core/corporate_actions.hpp"
+#include "core/price_series.hpp"
+
+// Manifest entry describing one cached (ticker, start, end, frequency) block.
+struct CacheManifestEntry
+{
+    uint32_t shard = 0;
+    uint64_t offset = 0;
+    uint32_t length = 0;
+    uint32_t count = 0;
+    int64_t firstTimestamp = 0; // epoch milliseconds
+    int64_t lastTimestamp = 0;
+    uint64_t checksum = 0;
+    uint8_t dateFormat = 0;
+    uint8_t kind = 0; // 0 = adjusted series, 1 = raw history + corporate actions
+};
+
+// Sharded, compressed replacement for the one-JSON-file-per-request `.cache/`.
+//
+// Layout under `directory`:
+//   manifest.idx      key -> (shard, offset, length, date range, checksum);
+//                     the key is ticker, start, end and frequency
+//   segment-NN.seg    append-only column blocks for every ticker hashed to NN
+//
+// Each block stores the timestamp column delta-of-delta encoded and the price
+// column XOR (Gorilla) encoded. Opening the store reads the manifest once and
+// mmaps each segment, so lookups never touch the filesystem metadata.
+class ShardedCacheStore
+{
+public:
+    explicit ShardedCacheStore(const std::string &directory, uint32_t numShards = 16);
+    ~ShardedCacheStore();
+
+    ShardedCacheStore(const ShardedCacheStore &) = delete;
+    ShardedCacheStore &operator=(const ShardedCacheStore &) = delete;
+
+    // Daily and intraday series for the same range are separate entries.
+    static std::string makeKey(const std::string &ticker,
+                               const std::string &startDate,
+                               const std::string &endDate,
+                               const std::string &frequency = "daily");
+
+    bool contains(const std::string &ticker,
+                  const std::string &startDate,
+                  const std::string &endDate,
+                  const std::string &frequency = "daily") const;
+
+    std::optional<PriceSeries> get(const std::string &ticker,
+                                   const std::string &startDate,
+                                   const std::string &endDate,
+                                   const std::string &frequency = "daily");
+
+    // Appends a block to the ticker's segment. A later put for the same key
+    // supersedes the earlier block in the manifest.
+    void put(const std::string &ticker,
+             const std::string &startDate,
+             const std::string &endDate,
+             const PriceSeries &series,
+             const std::string &frequency = "daily");
+
+    // Raw daily closes plus corporate-action events, stored alongside (not
+    // instead of) the adjusted daily series for the same range.
+    std::optional<AdjustedHistory> getHistory(const std::string &ticker,
+                                              const std::string &startDate,
+                                              const std::string &endDate);
+
+    void putHistory(const std::string &startDate,
+                    const std::string &endDate,
+                    const AdjustedHistory &history);
+
+    // Of the histories stored for `ticker` from `startDate`, the one with the
+    // latest end date before `endDate`, so a longer request can append to it
+    // instead of refetching. `storedEnd` receives that end date.
+    std::optional<AdjustedHistory> latestHistory(const std::string &ticker,
+                                                 const std::string &startDate,
+                                                 const std::string &endDate,
+                                                 std::string *storedEnd = nullptr);
+
+    // Persists the manifest (write to temp file + rename).
+    void flush();
+
+    std::optional<CacheManifestEntry> describe(const std::string &ticker,
+                                               const std::string &startDate,
+                                               const std::string &endDate,
+                                               const std::string &frequency = "daily") const;
+
+    size_t size() const;
+    uint32_t numShards() const { return numShards_; }
+    const std::string &directory() const { return directory_; }
+
+private:
+    class MappedSegment;
+
+    uint32_t shardFor(const std::string &ticker) const;
+    std::string segmentPath(uint32_t shard) const;
+    std::string manifestPath() const;
+
+    void loadManifest();
+    void appendBlock(const std::string &key,
+                     const std::string &ticker,
+                     const std::vector<std::string> &dates,
+                     const std::vector<double> &values,
+                     uint8_t kind,
+                     const std::string &extra);
+    bool readBlock(const std::string &key,
+                   std::vector<std::string> &dates,
+                   std::vector<double> &values,
+                   std::string *extra);
+    const MappedSegment &segment(uint32_t shard);
+
+    std::string directory_;
+    uint32_t numShards_;
+    bool dirty_ = false;
+
+    std::unordered_map<std::string, CacheManifestEntry> manifest_;
+    std::vector<std::unique_ptr<MappedSegment>> segments_;
+    std::vector<uint64_t> segmentSizes_;
+
+    mutable std::mutex mutex_;
+};
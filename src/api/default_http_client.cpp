@@ -2,11 +2,15 @@
 #include <stdexcept>
 
 #include "api/default_http_client.hpp"
+#include "../utils/instrumentation.hpp"
 
 std::string DefaultHttpClient::get(const std::string& url) {
+    TRADEIQ_TIMED_SCOPE("http.get");
     auto response = cpr::Get(cpr::Url{url}, cpr::Timeout{5000});
+    TRADEIQ_COUNTER("http.requests", 1);
     if (response.status_code != 200) {
         throw std::runtime_error("HTTP request failed: " + std::to_string(response.status_code));
     }
+    TRADEIQ_COUNTER("http.bytes", static_cast<int64_t>(response.text.size()));
     return response.text;
 }
@@ -0,0 +1,158 @@
+#include "api/price_cache.hpp"
+#include "../utils/instrumentation.hpp"
+
+PriceCache::PriceCache(size_t maxBytes) : maxBytes_(maxBytes) {}
+
+std::string PriceCache::makeKey(const std::string &ticker,
+                                const std::string &startDate,
+                                const std::string &endDate,
+                                const std::string &frequency)
+{
+    return ticker + "|" + startDate + "|" + endDate + "|" + frequency;
+}
+
+size_t PriceCache::estimateBytes(const PriceSeries &series)
+{
+    size_t bytes = sizeof(PriceSeries) + series.getTicker().capacity();
+    bytes += series.getPrices().capacity() * sizeof(double);
+    for (const auto &date : series.getDates())
+        bytes += sizeof(std::string) + date.capacity();
+    return bytes;
+}
+
+PriceCache::SeriesPtr PriceCache::getOrLoad(const std::string &key, const Loader &loader)
+{
+    std::shared_ptr<InFlight> flight;
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+
+        auto it = index_.find(key);
+        if (it != index_.end())
+        {
+            lru_.splice(lru_.begin(), lru_, it->second);
+            ++hits_;
+            return it->second->series;
+        }
+
+        auto pending = inFlight_.find(key);
+        if (pending != inFlight_.end())
+        {
+            // Someone else is already loading this key; wait for their result.
+            auto shared = pending->second;
+            ++coalesced_;
+            shared->cv.wait(lock, [&] { return shared->done; });
+            if (shared->error)
+                std::rethrow_exception(shared->error);
+            return shared->result;
+        }
+
+        ++misses_;
+        flight = std::make_shared<InFlight>();
+        inFlight_.emplace(key, flight);
+    }
+
+    // Run the loader without holding the lock so other keys stay available.
+    SeriesPtr result;
+    std::exception_ptr error;
+    try
+    {
+        TRADEIQ_TIMED_SCOPE("price_cache.load");
+        result = std::make_shared<const PriceSeries>(loader());
+    }
+    catch (...)
+    {
+        error = std::current_exception();
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!error)
+            insertLocked(key, result);
+        inFlight_.erase(key);
+        flight->done = true;
+        flight->result = result;
+        flight->error = error;
+    }
+    flight->cv.notify_all();
+
+    if (error)
+        std::rethrow_exception(error);
+    return result;
+}
+
+PriceCache::SeriesPtr PriceCache::find(const std::string &key)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = index_.find(key);
+    if (it == index_.end())
+    {
+        ++misses_;
+        return nullptr;
+    }
+    lru_.splice(lru_.begin(), lru_, it->second);
+    ++hits_;
+    return it->second->series;
+}
+
+void PriceCache::erase(const std::string &key)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = index_.find(key);
+    if (it == index_.end())
+        return;
+    bytes_ -= it->second->bytes;
+    lru_.erase(it->second);
+    index_.erase(it);
+}
+
+void PriceCache::clear()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    lru_.clear();
+    index_.clear();
+    bytes_ = 0;
+}
+
+PriceCacheStats PriceCache::stats() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    PriceCacheStats s;
+    s.hits = hits_;
+    s.misses = misses_;
+    s.coalesced = coalesced_;
+    s.evictions = evictions_;
+    s.entries = index_.size();
+    s.bytes = bytes_;
+    return s;
+}
+
+void PriceCache::insertLocked(const std::string &key, SeriesPtr series)
+{
+    size_t bytes = estimateBytes(*series);
+
+    auto existing = index_.find(key);
+    if (existing != index_.end())
+    {
+        bytes_ -= existing->second->bytes;
+        lru_.erase(existing->second);
+        index_.erase(existing);
+    }
+
+    lru_.push_front(Entry{key, std::move(series), bytes});
+    index_[key] = lru_.begin();
+    bytes_ += bytes;
+    evictLocked();
+}
+
+void PriceCache::evictLocked()
+{
+    // Always keep the most recent entry, even if it alone exceeds the budget.
+    while (bytes_ > maxBytes_ && lru_.size() > 1)
+    {
+        Entry &victim = lru_.back();
+        bytes_ -= victim.bytes;
+        index_.erase(victim.key);
+        lru_.pop_back();
+        ++evictions_;
+    }
+}
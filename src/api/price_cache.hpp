@@ -0,0 +1,92 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "core/price_series.hpp"
+
+// Snapshot of cache counters, safe to export after the fact.
+struct PriceCacheStats
+{
+    size_t hits = 0;      // served from memory
+    size_t misses = 0;    // caller ran the loader
+    size_t coalesced = 0; // caller waited on another caller's in-flight load
+    size_t evictions = 0;
+    size_t entries = 0;
+    size_t bytes = 0;
+};
+
+// In-process LRU of parsed price series keyed by (ticker, start, end, frequency).
+// Concurrent requests for the same key are coalesced: one caller runs the loader,
+// the others block until it finishes and share the result (or its exception).
+class PriceCache
+{
+public:
+    using SeriesPtr = std::shared_ptr<const PriceSeries>;
+    using Loader = std::function<PriceSeries()>;
+
+    explicit PriceCache(size_t maxBytes = 256 * 1024 * 1024);
+
+    static std::string makeKey(const std::string &ticker,
+                               const std::string &startDate,
+                               const std::string &endDate,
+                               const std::string &frequency = "daily");
+
+    // Approximate heap footprint of a series, used for the size bound.
+    static size_t estimateBytes(const PriceSeries &series);
+
+    // Returns the cached series, or runs `loader` exactly once across all
+    // concurrent callers asking for the same key.
+    SeriesPtr getOrLoad(const std::string &key, const Loader &loader);
+
+    // Lookup only; counts as a hit or a miss.
+    SeriesPtr find(const std::string &key);
+
+    void erase(const std::string &key);
+    void clear();
+
+    size_t maxBytes() const { return maxBytes_; }
+    PriceCacheStats stats() const;
+
+private:
+    struct Entry
+    {
+        std::string key;
+        SeriesPtr series;
+        size_t bytes;
+    };
+
+    struct InFlight
+    {
+        bool done = false;
+        SeriesPtr result;
+        std::exception_ptr error;
+        std::condition_variable cv;
+    };
+
+    using LruList = std::list<Entry>;
+
+    void insertLocked(const std::string &key, SeriesPtr series);
+    void evictLocked();
+
+    size_t maxBytes_;
+    size_t bytes_ = 0;
+
+    LruList lru_; // front = most recently used
+    std::unordered_map<std::string, LruList::iterator> index_;
+    std::unordered_map<std::string, std::shared_ptr<InFlight>> inFlight_;
+
+    size_t hits_ = 0;
+    size_t misses_ = 0;
+    size_t coalesced_ = 0;
+    size_t evictions_ = 0;
+
+    mutable std::mutex mutex_;
+};
@@ -12,31 +12,12 @@
 #include "api/tiingo_client.hpp"
 #include "api/http_client.hpp"
 #include "api/default_http_client.hpp"
+#include "../utils/instrumentation.hpp"
+#include "../utils/timestamp.hpp"
 
 using json = nlohmann::json;
 namespace fs = std::filesystem;
 
-bool isValidDate(const std::string &dateStr)
-{
-    if (dateStr.size() != 10 || dateStr[4] != '-' || dateStr[7] != '-')
-        return false;
-    try
-    {
-        int year = std::stoi(dateStr.substr(0, 4));
-        int month = std::stoi(dateStr.substr(5, 2));
-        int day = std::stoi(dateStr.substr(8, 2));
-        if (month < 1 || month > 12)
-            return false;
-        if (day < 1 || day > 31)
-            return false;
-        return true;
-    }
-    catch (...)
-    {
-        return false;
-    }
-}
-
 TiingoClient::TiingoClient()
 {
     fs::path envPath = fs::current_path() / ".env";
@@ -65,18 +46,106 @@ TiingoClient::TiingoClient(const std::string &key, std::shared_ptr<HttpClient> c
 
 void TiingoClient::setOfflineMode(bool flag) { offlineMode_ = flag; }
 void TiingoClient::setVerbosity(bool verbose) { verbose_ = verbose; }
+void TiingoClient::setPriceCache(std::shared_ptr<PriceCache> cache) { priceCache_ = std::move(cache); }
+std::shared_ptr<PriceCache> TiingoClient::getPriceCache() const { return priceCache_; }
+void TiingoClient::setCacheStore(std::shared_ptr<ShardedCacheStore> store) { cacheStore_ = std::move(store); }
+std::shared_ptr<ShardedCacheStore> TiingoClient::getCacheStore() const { return cacheStore_; }
 
 PriceSeries TiingoClient::fetchDailyPrices(const std::string &ticker,
                                            const std::string &startDate,
                                            const std::string &endDate,
                                            const std::string &frequency)
 {
-    std::string cached = tryCachedResponse(ticker, startDate, endDate);
+    if (!priceCache_)
+        return loadDailyPrices(ticker, startDate, endDate, frequency);
+    return *fetchDailyPricesShared(ticker, startDate, endDate, frequency);
+}
+
+std::shared_ptr<const PriceSeries> TiingoClient::fetchDailyPricesShared(const std::string &ticker,
+                                                                        const std::string &startDate,
+                                                                        const std::string &endDate,
+                                                                        const std::string &frequency)
+{
+    if (!priceCache_)
+        return std::make_shared<const PriceSeries>(loadDailyPrices(ticker, startDate, endDate, frequency));
+
+    std::string key = PriceCache::makeKey(ticker, startDate, endDate, frequency);
+    return priceCache_->getOrLoad(key, [&]
+                                  { return loadDailyPrices(ticker, startDate, endDate, frequency); });
+}
+
+PriceSeries TiingoClient::loadDailyPrices(const std::string &ticker,
+                                          const std::string &startDate,
+                                          const std::string &endDate,
+                                          const std::string &frequency)
+{
+    if (cacheStore_)
+    {
+        if (auto stored = cacheStore_->get(ticker, startDate, endDate, frequency))
+        {
+            if (verbose_)
+                std::cout << "[Cache hit] " << ticker << std::endl;
+            return std::move(*stored);
+        }
+    }
+
+    // Legacy JSON files are still read, but only written when no store is set.
+    std::string body = fetchResponseBody(ticker, startDate, endDate, frequency, !cacheStore_);
+    PriceSeries series = parseResponse(ticker, body);
+    if (cacheStore_)
+        cacheStore_->put(ticker, startDate, endDate, series, frequency);
+    return series;
+}
+
+AdjustedHistory TiingoClient::fetchAdjustedHistory(const std::string &ticker,
+                                                   const std::string &startDate,
+                                                   const std::string &endDate)
+{
+    if (cacheStore_)
+    {
+        if (auto stored = cacheStore_->getHistory(ticker, startDate, endDate))
+        {
+            if (verbose_)
+                std::cout << "[Cache hit] " << ticker << " (raw)" << std::endl;
+            return std::move(*stored);
+        }
+        if (auto stored = cacheStore_->latestHistory(ticker, startDate, endDate); stored && !stored->getDates().empty())
+        {
+            extendHistory(*stored, endDate);
+            cacheStore_->putHistory(startDate, endDate, *stored);
+            return std::move(*stored);
+        }
+    }
+
+    std::string body = fetchResponseBody(ticker, startDate, endDate, "daily", !cacheStore_);
+    AdjustedHistory history = parseHistoryResponse(ticker, body);
+    if (cacheStore_)
+        cacheStore_->putHistory(startDate, endDate, history);
+    return history;
+}
+
+std::vector<Bar> TiingoClient::fetchBars(const std::string &ticker,
+                                         const std::string &startDate,
+                                         const std::string &endDate,
+                                         const std::string &frequency)
+{
+    // OHLCV is only kept in the JSON responses, so always go through them.
+    std::string body = fetchResponseBody(ticker, startDate, endDate, frequency, true);
+    return parseBarsResponse(body);
+}
+
+std::string TiingoClient::fetchResponseBody(const std::string &ticker,
+                                            const std::string &startDate,
+                                            const std::string &endDate,
+                                            const std::string &frequency,
+                                            bool writeJsonCache)
+{
+    std::string cached = tryCachedResponse(ticker, startDate, endDate, frequency);
     if (!cached.empty())
     {
         if (verbose_)
             std::cout << "[Cache hit] " << ticker << std::endl;
-        return parseResponse(ticker, cached);
+        return cached;
     }
 
     if (offlineMode_)
@@ -101,28 +170,30 @@ PriceSeries TiingoClient::fetchDailyPrices(const std::string &ticker,
         }
         catch (const std::runtime_error &e)
         {
+            TRADEIQ_COUNTER("tiingo.http_retries", 1);
             if (retries == 0)
                 throw;
             std::this_thread::sleep_for(std::chrono::seconds(2));
         }
     }
 
-    cacheResponse(ticker, startDate, endDate, responseBody);
-    return parseResponse(ticker, responseBody);
+    if (writeJsonCache)
+        cacheResponse(ticker, startDate, endDate, frequency, responseBody);
+    return responseBody;
 }
 
-std::map<std::string, PriceSeries> TiingoClient::fetchMultipleDailyPrices(const std::vector<std::string> &tickers,
-                                                                          const std::string &startDate,
-                                                                          const std::string &endDate,
-                                                                          const std::string &frequency)
+Universe TiingoClient::fetchMultipleDailyPrices(const std::vector<std::string> &tickers,
+                                                const std::string &startDate,
+                                                const std::string &endDate,
+                                                const std::string &frequency)
 {
-    std::map<std::string, PriceSeries> result;
+    Universe result;
+    result.reserve(tickers.size());
     for (const auto &ticker : tickers)
     {
         try
         {
-            auto ps = fetchDailyPrices(ticker, startDate, endDate, frequency);
-            result.insert({ticker, ps});
+            result.insert(fetchDailyPrices(ticker, startDate, endDate, frequency));
         }
         catch (const std::exception &e)
         {
@@ -146,7 +217,7 @@ std::string TiingoClient::buildUrl(const std::string &ticker,
     else if (frequency == "intraday")
     {
         return "https://api.tiingo.com/iex/" + ticker + "?startDate=" + startDate +
-               "&endDate=" + endDate + "&resampleFreq=5min&columns=open,close&token=" + apiKey_;
+               "&endDate=" + endDate + "&resampleFreq=5min&columns=open,high,low,close,volume&token=" + apiKey_;
     }
     else
     {
@@ -163,7 +234,7 @@ void TiingoClient::validateInputs(const std::string &ticker,
         throw std::invalid_argument("Ticker and dates must not be empty.");
     }
 
-    if (!isValidDate(startDate) || !isValidDate(endDate))
+    if (!Timestamp::isValidDate(startDate) || !Timestamp::isValidDate(endDate))
     {
         throw std::invalid_argument("Dates must be valid and in YYYY-MM-DD format.");
     }
@@ -171,6 +242,7 @@ void TiingoClient::validateInputs(const std::string &ticker,
 
 PriceSeries TiingoClient::parseResponse(const std::string &ticker, const std::string &responseBody)
 {
+    TRADEIQ_TIMED_SCOPE("tiingo.parse");
     json data = json::parse(responseBody);
     if (!data.is_array() || data.empty())
     {
@@ -188,24 +260,127 @@ PriceSeries TiingoClient::parseResponse(const std::string &ticker, const std::st
         prices.push_back(row["adjClose"]);
     }
 
-    return PriceSeries(ticker, dates, prices);
+    return PriceSeries(ticker, std::move(dates), std::move(prices));
+}
+
+AdjustedHistory TiingoClient::parseHistoryResponse(const std::string &ticker, const std::string &responseBody)
+{
+    json data = json::parse(responseBody);
+    if (!data.is_array() || data.empty())
+    {
+        throw std::runtime_error("Tiingo returned no data.");
+    }
+
+    std::vector<std::string> dates;
+    std::vector<double> closes;
+    std::vector<CorporateAction> actions;
+
+    for (const auto &row : data)
+    {
+        if (!row.contains("date") || !row.contains("close"))
+            continue;
+
+        double dividend = row.value("divCash", 0.0);
+        double split = row.value("splitFactor", 1.0);
+        if (dividend != 0.0 || split != 1.0)
+            actions.push_back(CorporateAction{closes.size(), dividend, split});
+
+        dates.push_back(row["date"]);
+        closes.push_back(row["close"]);
+    }
+
+    return AdjustedHistory(ticker, std::move(dates), std::move(closes), std::move(actions));
+}
+
+void TiingoClient::extendHistory(AdjustedHistory &history, const std::string &endDate)
+{
+    // Refetch from the last stored day; rows up to and including it are skipped.
+    const std::string &last = history.getDates().back();
+    const int64_t lastMillis = Timestamp::parseIsoMillis(last);
+    const std::string from = last.substr(0, 10);
+    if (verbose_)
+        std::cout << "[Extending] " << history.getTicker() << " from " << from << std::endl;
+
+    json data = json::parse(fetchResponseBody(history.getTicker(), from, endDate, "daily", !cacheStore_));
+    if (!data.is_array())
+        throw std::runtime_error("Tiingo returned no data.");
+
+    for (const auto &row : data)
+    {
+        if (!row.contains("date") || !row.contains("close"))
+            continue;
+        const std::string date = row["date"];
+        if (Timestamp::parseIsoMillis(date) <= lastMillis)
+            continue;
+        history.appendBar(date, row["close"], row.value("divCash", 0.0), row.value("splitFactor", 1.0));
+    }
+}
+
+std::vector<Bar> TiingoClient::parseBarsResponse(const std::string &responseBody)
+{
+    TRADEIQ_TIMED_SCOPE("tiingo.parse_bars");
+    json data = json::parse(responseBody);
+    if (!data.is_array() || data.empty())
+    {
+        throw std::runtime_error("Tiingo returned no data.");
+    }
+
+    std::vector<Bar> bars;
+    bars.reserve(data.size());
+    for (const auto &row : data)
+    {
+        if (!row.contains("date") || !row.contains("close"))
+            continue;
+
+        Bar bar;
+        bar.timestamp = Timestamp::parseIsoMillis(row["date"].get<std::string>());
+        bar.close = row["close"];
+        bar.open = row.value("open", bar.close);
+        bar.high = row.value("high", std::max(bar.open, bar.close));
+        bar.low = row.value("low", std::min(bar.open, bar.close));
+        bar.volume = row.value("volume", 0.0);
+        bars.push_back(bar);
+    }
+    return bars;
+}
+
+// Daily responses keep the original file name so existing caches still hit.
+std::string TiingoClient::jsonCachePath(const std::string &ticker,
+                                        const std::string &startDate,
+                                        const std::string &endDate,
+                                        const std::string &frequency)
+{
+    std::string name = ticker + "_" + startDate + "_" + endDate;
+    if (frequency != "daily")
+        name += "_" + frequency;
+    return ".cache/" + name + ".json";
 }
 
-std::string TiingoClient::tryCachedResponse(const std::string &ticker, const std::string &startDate, const std::string &endDate)
+std::string TiingoClient::tryCachedResponse(const std::string &ticker,
+                                            const std::string &startDate,
+                                            const std::string &endDate,
+                                            const std::string &frequency)
 {
-    std::string cachePath = ".cache/" + ticker + "_" + startDate + "_" + endDate + ".json";
+    TRADEIQ_TIMED_SCOPE("cache.json_read");
+    std::string cachePath = jsonCachePath(ticker, startDate, endDate, frequency);
     if (fs::exists(cachePath))
     {
+        TRADEIQ_COUNTER("cache.json_hits", 1);
         std::ifstream file(cachePath);
         return std::string((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
     }
     return "";
 }
 
-void TiingoClient::cacheResponse(const std::string &ticker, const std::string &startDate, const std::string &endDate, const std::string &body)
+void TiingoClient::cacheResponse(const std::string &ticker,
+                                 const std::string &startDate,
+                                 const std::string &endDate,
+                                 const std::string &frequency,
+                                 const std::string &body)
 {
+    TRADEIQ_TIMED_SCOPE("cache.json_write");
     fs::create_directories(".cache");
-    std::string cachePath = ".cache/" + ticker + "_" + startDate + "_" + endDate + ".json";
+    std::string cachePath = jsonCachePath(ticker, startDate, endDate, frequency);
     std::ofstream out(cachePath);
     out << body;
 }
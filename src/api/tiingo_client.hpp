@@ -2,11 +2,15 @@
 
 #include <string>
 #include <vector>
-#include <map>
 #include <memory>
 
+#include "core/bar.hpp"
 #include "core/price_series.hpp"
+#include "core/universe.hpp"
+#include "core/corporate_actions.hpp"
 #include "api/http_client.hpp" 
+#include "api/price_cache.hpp"
+#include "api/cache_store.hpp"
 #include "api/default_http_client.hpp"
 
 class TiingoClient {
@@ -17,15 +21,45 @@ public:
     void setOfflineMode(bool flag);
     void setVerbosity(bool verbose);
 
+    // Share an in-memory LRU between clients/callers; nullptr disables it.
+    void setPriceCache(std::shared_ptr<PriceCache> cache);
+    std::shared_ptr<PriceCache> getPriceCache() const;
+
+    // Use a sharded segment store instead of one JSON file per request.
+    // Existing `.cache/*.json` hits are migrated into the store on first read.
+    void setCacheStore(std::shared_ptr<ShardedCacheStore> store);
+    std::shared_ptr<ShardedCacheStore> getCacheStore() const;
+
     PriceSeries fetchDailyPrices(const std::string& ticker,
                                  const std::string& startDate,
                                  const std::string& endDate,
                                  const std::string& frequency = "daily");
 
-    std::map<std::string, PriceSeries> fetchMultipleDailyPrices(const std::vector<std::string>& tickers,
-                                                                 const std::string& startDate,
-                                                                 const std::string& endDate,
-                                                                 const std::string& frequency = "daily");
+    // Same as fetchDailyPrices but hands out the cached instance without copying.
+    std::shared_ptr<const PriceSeries> fetchDailyPricesShared(const std::string& ticker,
+                                                              const std::string& startDate,
+                                                              const std::string& endDate,
+                                                              const std::string& frequency = "daily");
+
+    // Raw closes plus divCash/splitFactor events; adjust locally via
+    // AdjustedHistory::toPriceSeries() instead of trusting cached adjClose.
+    // With a cache store, a request that only moves `endDate` later fetches
+    // the bars after the stored history and appends them.
+    AdjustedHistory fetchAdjustedHistory(const std::string& ticker,
+                                         const std::string& startDate,
+                                         const std::string& endDate);
+
+    // Raw OHLCV bars (daily or 5-minute intraday) for the broker simulator.
+    std::vector<Bar> fetchBars(const std::string& ticker,
+                               const std::string& startDate,
+                               const std::string& endDate,
+                               const std::string& frequency = "daily");
+
+    // Tickers that fail to load are skipped (and logged when verbose).
+    Universe fetchMultipleDailyPrices(const std::vector<std::string>& tickers,
+                                      const std::string& startDate,
+                                      const std::string& endDate,
+                                      const std::string& frequency = "daily");
 
 private:
     std::string apiKey_;
@@ -33,6 +67,13 @@ private:
     bool verbose_ = false;
 
     std::shared_ptr<HttpClient> http_; // ✅ make sure this is declared
+    std::shared_ptr<PriceCache> priceCache_;
+    std::shared_ptr<ShardedCacheStore> cacheStore_;
+
+    PriceSeries loadDailyPrices(const std::string& ticker,
+                                const std::string& startDate,
+                                const std::string& endDate,
+                                const std::string& frequency);
 
     std::string buildUrl(const std::string& ticker,
                          const std::string& startDate,
@@ -43,7 +84,20 @@ private:
                         const std::string& startDate,
                         const std::string& endDate) const;
 
+    std::string fetchResponseBody(const std::string& ticker,
+                                  const std::string& startDate,
+                                  const std::string& endDate,
+                                  const std::string& frequency,
+                                  bool writeJsonCache);
+
     PriceSeries parseResponse(const std::string& ticker, const std::string& responseBody);
-    std::string tryCachedResponse(const std::string& ticker, const std::string& startDate, const std::string& endDate);
-    void cacheResponse(const std::string& ticker, const std::string& startDate, const std::string& endDate, const std::string& body);
+    AdjustedHistory parseHistoryResponse(const std::string& ticker, const std::string& responseBody);
+    void extendHistory(AdjustedHistory& history, const std::string& endDate);
+    std::vector<Bar> parseBarsResponse(const std::string& responseBody);
+    static std::string jsonCachePath(const std::string& ticker, const std::string& startDate,
+                                     const std::string& endDate, const std::string& frequency);
+    std::string tryCachedResponse(const std::string& ticker, const std::string& startDate, const std::string& endDate,
+                                  const std::string& frequency);
+    void cacheResponse(const std::string& ticker, const std::string& startDate, const std::string& endDate,
+                       const std::string& frequency, const std::string& body);
 };
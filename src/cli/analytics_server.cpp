@@ -0,0 +1,561 @@
+#include "cli/analytics_server.hpp"
+#include "cli/batch_runner.hpp"
+#include "../utils/instrumentation.hpp"
+#include "../utils/task_scheduler.hpp"
+#include "../utils/timestamp.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace
+{
+    constexpr int kTradingDays = 252;
+    constexpr size_t kMaxRequestBytes = 1 << 20; // per line; longer input drops the client
+    constexpr size_t kMaxPendingBytes = 1 << 22; // unsent responses; past this a client's input is left unread
+
+    std::vector<std::string_view> split(std::string_view text, char sep)
+    {
+        std::vector<std::string_view> parts;
+        size_t start = 0;
+        while (start <= text.size())
+        {
+            size_t end = text.find(sep, start);
+            if (end == std::string_view::npos)
+                end = text.size();
+            if (end > start)
+                parts.push_back(text.substr(start, end - start));
+            start = end + 1;
+        }
+        return parts;
+    }
+
+    std::vector<std::string_view> tokens(std::string_view line)
+    {
+        std::vector<std::string_view> out;
+        size_t i = 0;
+        while (i < line.size())
+        {
+            while (i < line.size() && (line[i] == ' ' || line[i] == '\t' || line[i] == '\r'))
+                ++i;
+            size_t j = i;
+            while (j < line.size() && line[j] != ' ' && line[j] != '\t' && line[j] != '\r')
+                ++j;
+            if (j > i)
+                out.push_back(line.substr(i, j - i));
+            i = j;
+        }
+        return out;
+    }
+
+    int64_t parseDay(std::string_view text)
+    {
+        const std::string s(text);
+        if (!Timestamp::isValidDate(s))
+            throw std::invalid_argument("Invalid date: " + s);
+        return Timestamp::parseEpochDays(s);
+    }
+
+    void appendNumber(std::string &out, double v)
+    {
+        if (std::isnan(v))
+        {
+            out += "nan";
+            return;
+        }
+        char buf[32];
+        const int n = std::snprintf(buf, sizeof(buf), "%.17g", v);
+        out.append(buf, static_cast<size_t>(n));
+    }
+
+    std::string errorResponse(const std::string &message)
+    {
+        return "error: " + message + "\n\n";
+    }
+
+    void closeFd(int &fd)
+    {
+        if (fd >= 0)
+            ::close(fd);
+        fd = -1;
+    }
+}
+
+// ---- QueryEngine ------------------------------------------------------------
+
+QueryEngine::QueryEngine(const Universe &universe, QueryEngineOptions options) : options_(options)
+{
+    TRADEIQ_TIMED_SCOPE("server.columns");
+    size_t total = 0;
+    for (const auto &series : universe)
+        total += series.getPrices().size();
+    reserveColumns(universe.size(), total);
+    for (const auto &series : universe)
+        addSeries(series);
+    offsets_.push_back(days_.size());
+}
+
+QueryEngine::QueryEngine(const std::vector<std::shared_ptr<const PriceSeries>> &series, QueryEngineOptions options)
+    : options_(options)
+{
+    TRADEIQ_TIMED_SCOPE("server.columns");
+    size_t tickers = 0, total = 0;
+    for (const auto &s : series)
+    {
+        if (!s)
+            continue;
+        ++tickers;
+        total += s->getPrices().size();
+    }
+    reserveColumns(tickers, total);
+    for (const auto &s : series)
+        if (s && !ids_.count(s->getTicker()))
+            addSeries(*s);
+    offsets_.push_back(days_.size());
+}
+
+void QueryEngine::reserveColumns(size_t tickers, size_t bars)
+{
+    if (bars >= std::numeric_limits<uint32_t>::max())
+        throw std::invalid_argument("Query engine holds at most 2^32 - 1 bars.");
+    symbols_.reserve(tickers);
+    ids_.reserve(tickers);
+    offsets_.reserve(tickers + 1);
+    days_.reserve(bars);
+    closes_.reserve(bars);
+}
+
+// Appends one ticker's columns; the caller closes offsets_ after the last.
+void QueryEngine::addSeries(const PriceSeries &series)
+{
+    const auto &dates = series.getDates();
+    const auto &prices = series.getPrices();
+    if (dates.size() != prices.size())
+        throw std::invalid_argument(series.getTicker() + ": dates and prices differ in length");
+
+    offsets_.push_back(days_.size());
+    for (size_t t = 0; t < prices.size(); ++t)
+    {
+        const int64_t day = Timestamp::parseEpochDays(dates[t]);
+        if (days_.size() > offsets_.back() && day <= days_.back())
+            throw std::invalid_argument(series.getTicker() + ": dates must be strictly increasing");
+        days_.push_back(day);
+        closes_.push_back(prices[t]);
+    }
+    ids_.emplace(series.getTicker(), static_cast<uint32_t>(symbols_.size()));
+    symbols_.push_back(series.getTicker());
+}
+
+ServerQuery QueryEngine::parse(std::string_view line)
+{
+    const auto parts = tokens(line);
+    if (parts.size() < 2 || parts.size() > 4)
+        throw std::invalid_argument("expected: <metrics> <tickers> [start [end]]");
+
+    ServerQuery query;
+    const auto &known = BatchRunner::availableMetrics();
+    for (std::string_view m : split(parts[0], ','))
+    {
+        if (m == "*")
+        {
+            for (size_t i = 0; i < known.size(); ++i)
+                query.metrics.push_back(i);
+            continue;
+        }
+        auto it = std::find(known.begin(), known.end(), m);
+        if (it == known.end())
+            throw std::invalid_argument("Unknown metric: " + std::string(m));
+        query.metrics.push_back(static_cast<size_t>(it - known.begin()));
+    }
+    for (std::string_view t : split(parts[1], ','))
+        query.tickers.emplace_back(t);
+    if (query.metrics.empty() || query.tickers.empty())
+        throw std::invalid_argument("expected: <metrics> <tickers> [start [end]]");
+
+    if (parts.size() > 2)
+        query.firstDay = parseDay(parts[2]);
+    if (parts.size() > 3)
+        query.lastDay = parseDay(parts[3]);
+    if (query.firstDay > query.lastDay)
+        throw std::invalid_argument("start is after end");
+    return query;
+}
+
+size_t QueryEngine::RangeHash::operator()(const Range &r) const
+{
+    uint64_t h = (static_cast<uint64_t>(r.ticker) << 32) ^ (static_cast<uint64_t>(r.first) << 16) ^ r.last;
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    return static_cast<size_t>(h);
+}
+
+QueryEngine::Range QueryEngine::resolve(uint32_t ticker, int64_t firstDay, int64_t lastDay) const
+{
+    const auto begin = days_.begin() + static_cast<std::ptrdiff_t>(offsets_[ticker]);
+    const auto end = days_.begin() + static_cast<std::ptrdiff_t>(offsets_[ticker + 1]);
+    const auto lo = std::lower_bound(begin, end, firstDay);
+    const auto hi = std::upper_bound(lo, end, lastDay);
+    return {ticker, static_cast<uint32_t>(lo - days_.begin()), static_cast<uint32_t>(hi - days_.begin())};
+}
+
+std::vector<double> QueryEngine::compute(const Range &range) const
+{
+    const size_t metrics = BatchRunner::availableMetrics().size();
+    std::vector<double> nan(metrics, std::numeric_limits<double>::quiet_NaN());
+    if (range.last - range.first < 2)
+    {
+        nan[0] = 0.0; // observations
+        return nan;
+    }
+
+    int periodsPerYear = kTradingDays;
+    const int64_t from = days_[range.first], to = days_[range.last - 1];
+    if (options_.calendar && from >= options_.calendar->firstDay() && to <= options_.calendar->lastDay())
+        periodsPerYear = static_cast<int>(std::lround(options_.calendar->sessionsPerYear(from, to)));
+
+    PriceSeries slice(symbols_[range.ticker],
+                      std::vector<double>(closes_.begin() + range.first, closes_.begin() + range.last));
+    try
+    {
+        return BatchCli::metricValues(slice, options_.riskFreeRate, periodsPerYear);
+    }
+    catch (const std::exception &)
+    {
+        return nan;
+    }
+}
+
+const std::vector<double> *QueryEngine::cached(const Range &range)
+{
+    auto it = cache_.find(range);
+    if (it == cache_.end())
+        return nullptr;
+    lru_.splice(lru_.begin(), lru_, it->second);
+    ++hits_;
+    return &it->second->second;
+}
+
+void QueryEngine::remember(const Range &range, std::vector<double> values)
+{
+    if (options_.cacheEntries == 0 || cache_.count(range))
+        return;
+    if (cache_.size() >= options_.cacheEntries)
+    {
+        cache_.erase(lru_.back().first);
+        lru_.pop_back();
+    }
+    lru_.emplace_front(range, std::move(values));
+    cache_.emplace(range, lru_.begin());
+}
+
+QueryEngine::CacheStats QueryEngine::cacheStats() const
+{
+    return {hits_, misses_, cache_.size()};
+}
+
+std::string QueryEngine::format(const ServerQuery &query, const std::vector<const std::vector<double> *> &rows) const
+{
+    const auto &known = BatchRunner::availableMetrics();
+    std::string out = "ticker";
+    for (size_t m : query.metrics)
+    {
+        out += ',';
+        out += known[m];
+    }
+    out += '\n';
+    for (size_t i = 0; i < rows.size(); ++i)
+    {
+        out += query.tickers[i];
+        for (size_t m : query.metrics)
+        {
+            out += ',';
+            appendNumber(out, (*rows[i])[m]);
+        }
+        out += '\n';
+    }
+    out += '\n';
+    return out;
+}
+
+std::string QueryEngine::answer(std::string_view line)
+{
+    return answerBatch({std::string(line)}).front();
+}
+
+std::vector<std::string> QueryEngine::answerBatch(const std::vector<std::string> &lines)
+{
+    TRADEIQ_TIMED_SCOPE("server.batch");
+    std::vector<std::string> responses(lines.size());
+
+    struct Pending
+    {
+        size_t line;
+        ServerQuery query;
+        std::vector<const std::vector<double> *> rows; // null until computed
+        std::vector<size_t> todo;                      // per row: index into `misses`, when rows[i] is null
+    };
+    std::vector<Pending> pending;
+    std::vector<Range> misses;
+    std::unordered_map<Range, size_t, RangeHash> missIndex;
+
+    for (size_t l = 0; l < lines.size(); ++l)
+    {
+        const auto parts = tokens(lines[l]);
+        if (parts.size() == 1 && parts[0] == "ping")
+        {
+            responses[l] = "pong\n\n";
+            continue;
+        }
+        if (parts.size() == 1 && parts[0] == "stats")
+        {
+            std::string out = "tickers,bars,cache_entries,cache_hits,cache_misses\n";
+            out += std::to_string(tickers()) + ',' + std::to_string(bars()) + ',' + std::to_string(cache_.size()) + ',' +
+                   std::to_string(hits_) + ',' + std::to_string(misses_) + "\n\n";
+            responses[l] = std::move(out);
+            continue;
+        }
+
+        Pending p{l, {}, {}, {}};
+        try
+        {
+            p.query = parse(lines[l]);
+        }
+        catch (const std::exception &e)
+        {
+            responses[l] = errorResponse(e.what());
+            continue;
+        }
+
+        std::vector<Range> ranges;
+        ranges.reserve(p.query.tickers.size());
+        std::string unknown;
+        for (const auto &t : p.query.tickers)
+        {
+            auto it = ids_.find(t);
+            if (it == ids_.end())
+            {
+                unknown = t;
+                break;
+            }
+            ranges.push_back(resolve(it->second, p.query.firstDay, p.query.lastDay));
+        }
+        if (!unknown.empty())
+        {
+            responses[l] = errorResponse("Unknown ticker: " + unknown);
+            continue;
+        }
+
+        p.rows.resize(ranges.size(), nullptr);
+        p.todo.resize(ranges.size(), 0);
+        for (size_t i = 0; i < ranges.size(); ++i)
+        {
+            if ((p.rows[i] = cached(ranges[i])))
+                continue;
+            auto [it, inserted] = missIndex.emplace(ranges[i], misses.size());
+            if (inserted)
+                misses.push_back(ranges[i]);
+            p.todo[i] = it->second;
+        }
+        pending.push_back(std::move(p));
+    }
+
+    std::vector<std::vector<double>> fresh(misses.size());
+    Tasks::TaskScheduler::global().parallelFor(misses.size(), [&](size_t i) { fresh[i] = compute(misses[i]); });
+    misses_ += misses.size();
+
+    // Format before caching the fresh rows: inserting may evict entries that
+    // rows above still point at.
+    for (auto &p : pending)
+    {
+        for (size_t i = 0; i < p.rows.size(); ++i)
+            if (!p.rows[i])
+                p.rows[i] = &fresh[p.todo[i]];
+        responses[p.line] = format(p.query, p.rows);
+    }
+    for (size_t i = 0; i < misses.size(); ++i)
+        remember(misses[i], std::move(fresh[i]));
+    return responses;
+}
+
+// ---- AnalyticsServer --------------------------------------------------------
+
+AnalyticsServer::AnalyticsServer(QueryEngine &engine, std::string socketPath)
+    : engine_(engine), socketPath_(std::move(socketPath))
+{
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    if (socketPath_.empty() || socketPath_.size() >= sizeof(addr.sun_path))
+        throw std::runtime_error("Invalid socket path: " + socketPath_);
+    std::memcpy(addr.sun_path, socketPath_.c_str(), socketPath_.size() + 1);
+
+    struct stat st;
+    if (::lstat(socketPath_.c_str(), &st) == 0)
+    {
+        if (!S_ISSOCK(st.st_mode))
+            throw std::runtime_error("Refusing to replace non-socket file: " + socketPath_);
+        ::unlink(socketPath_.c_str());
+    }
+
+    listenFd_ = ::socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (listenFd_ < 0 || ::bind(listenFd_, reinterpret_cast<const sockaddr *>(&addr), sizeof(addr)) != 0 ||
+        ::listen(listenFd_, SOMAXCONN) != 0 || ::pipe2(wakeFds_, O_NONBLOCK | O_CLOEXEC) != 0)
+    {
+        const std::string reason = std::strerror(errno);
+        closeFd(listenFd_);
+        ::unlink(socketPath_.c_str());
+        throw std::runtime_error("Cannot listen on " + socketPath_ + ": " + reason);
+    }
+}
+
+AnalyticsServer::~AnalyticsServer()
+{
+    closeFd(listenFd_);
+    closeFd(wakeFds_[0]);
+    closeFd(wakeFds_[1]);
+    ::unlink(socketPath_.c_str());
+}
+
+void AnalyticsServer::stop()
+{
+    const char byte = 1;
+    [[maybe_unused]] ssize_t n = ::write(wakeFds_[1], &byte, 1);
+}
+
+void AnalyticsServer::run()
+{
+    std::vector<Client> clients;
+    std::vector<pollfd> fds;
+    std::vector<std::string> lines;
+    std::vector<size_t> owners; // client index per line
+
+    for (;;)
+    {
+        fds.clear();
+        fds.push_back({wakeFds_[0], POLLIN, 0});
+        fds.push_back({listenFd_, POLLIN, 0});
+        for (const auto &c : clients)
+        {
+            const bool reading = !c.closing && c.out.size() < kMaxPendingBytes;
+            fds.push_back({c.fd, static_cast<short>((reading ? POLLIN : 0) | (c.out.empty() ? 0 : POLLOUT)), 0});
+        }
+
+        if (::poll(fds.data(), fds.size(), -1) < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            throw std::runtime_error(std::string("poll failed: ") + std::strerror(errno));
+        }
+        if (fds[0].revents)
+            break;
+
+        if (fds[1].revents & POLLIN)
+        {
+            for (;;)
+            {
+                const int fd = ::accept4(listenFd_, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+                if (fd < 0)
+                    break;
+                clients.push_back({fd, {}, {}, false});
+            }
+        }
+
+        // Read whatever arrived, then answer every complete line as one batch.
+        lines.clear();
+        owners.clear();
+        for (size_t c = 0; c + 2 < fds.size() && c < clients.size(); ++c)
+        {
+            Client &client = clients[c];
+            if (client.closing || client.out.size() >= kMaxPendingBytes ||
+                !(fds[c + 2].revents & (POLLIN | POLLHUP | POLLERR)))
+                continue;
+            char buf[1 << 16];
+            for (;;)
+            {
+                const ssize_t n = ::read(client.fd, buf, sizeof(buf));
+                if (n > 0)
+                {
+                    client.in.append(buf, static_cast<size_t>(n));
+                    continue;
+                }
+                if (n == 0 || (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR))
+                    client.closing = true;
+                if (n < 0 && errno == EINTR)
+                    continue;
+                break;
+            }
+
+            size_t start = 0, newline;
+            while ((newline = client.in.find('\n', start)) != std::string::npos)
+            {
+                lines.emplace_back(client.in, start, newline - start);
+                owners.push_back(c);
+                start = newline + 1;
+            }
+            client.in.erase(0, start);
+            if (client.in.size() > kMaxRequestBytes)
+            {
+                client.in.clear();
+                client.out.clear();
+                client.closing = true;
+            }
+        }
+
+        if (!lines.empty())
+        {
+            std::vector<std::string> responses = engine_.answerBatch(lines);
+            for (size_t i = 0; i < responses.size(); ++i)
+                clients[owners[i]].out += responses[i];
+            served_ += lines.size();
+        }
+
+        for (auto &client : clients)
+        {
+            while (!client.out.empty())
+            {
+                const ssize_t n = ::send(client.fd, client.out.data(), client.out.size(), MSG_NOSIGNAL);
+                if (n > 0)
+                {
+                    client.out.erase(0, static_cast<size_t>(n));
+                    continue;
+                }
+                if (n < 0 && errno == EINTR)
+                    continue;
+                if (n < 0 && errno != EAGAIN && errno != EWOULDBLOCK)
+                {
+                    client.out.clear();
+                    client.closing = true;
+                }
+                break;
+            }
+        }
+
+        clients.erase(std::remove_if(clients.begin(), clients.end(),
+                                     [](Client &c)
+                                     {
+                                         if (!c.closing || !c.out.empty())
+                                             return false;
+                                         closeFd(c.fd);
+                                         return true;
+                                     }),
+                      clients.end());
+    }
+
+    char drain[64];
+    while (::read(wakeFds_[0], drain, sizeof(drain)) > 0)
+    {
+    }
+    for (auto &c : clients)
+        closeFd(c.fd);
+}
@@ -0,0 +1,162 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "core/trading_calendar.hpp"
+#include "core/universe.hpp"
+
+// Long-lived query service behind `main_exec --serve SOCKET`.
+//
+// QueryEngine copies a universe into flat columns (epoch days and closes,
+// one contiguous run per ticker) once, then answers metric queries over any
+// date range by binary search plus the batch metric code, so results match
+// `main_exec` for the same range. Results are kept in an LRU cache keyed by
+// ticker and resolved bar range.
+//
+// Protocol: one request per line, one response per request, in order.
+//
+//   <metrics> <tickers> [start [end]]   e.g. "sharpe,volatility AAPL,MSFT 2023-01-01 2023-12-31"
+//   ping | stats
+//
+// Lists are comma separated; "*" selects every metric; dates are YYYY-MM-DD
+// and inclusive, defaulting to the whole history. A response is CSV (header
+// "ticker,<metrics>", one row per ticker, "nan" where a ticker has fewer
+// than two closes in range) or a single "error: ..." line, and always ends
+// with an empty line.
+struct ServerQuery
+{
+    std::vector<size_t> metrics; // indices into BatchRunner::availableMetrics()
+    std::vector<std::string> tickers;
+    int64_t firstDay = INT64_MIN;
+    int64_t lastDay = INT64_MAX;
+};
+
+struct QueryEngineOptions
+{
+    double riskFreeRate = 0.01;
+    size_t cacheEntries = 1 << 16;           // 0 disables the result cache
+    const TradingCalendar *calendar = nullptr; // annualize by sessions in range, as --calendar does
+};
+
+class QueryEngine
+{
+public:
+    struct CacheStats
+    {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        size_t entries = 0;
+    };
+
+    // Throws std::invalid_argument when a series has dates that do not parse
+    // or are not strictly increasing.
+    explicit QueryEngine(const Universe &universe, QueryEngineOptions options = {});
+
+    // Same, straight from loaded series with no Universe copy in between.
+    // Null entries (failed loads) are skipped; a repeated ticker keeps its
+    // first series.
+    explicit QueryEngine(const std::vector<std::shared_ptr<const PriceSeries>> &series,
+                         QueryEngineOptions options = {});
+
+    // Throws std::invalid_argument on a malformed request.
+    static ServerQuery parse(std::string_view line);
+
+    // The response to one request line, terminating empty line included.
+    std::string answer(std::string_view line);
+
+    // Responses to several request lines, in order. Every distinct uncached
+    // (ticker, range) among them is computed once, in parallel on the shared
+    // task pool. Not thread-safe: one caller at a time.
+    std::vector<std::string> answerBatch(const std::vector<std::string> &lines);
+
+    size_t tickers() const { return symbols_.size(); }
+    size_t bars() const { return days_.size(); }
+    CacheStats cacheStats() const;
+
+private:
+    struct Range
+    {
+        uint32_t ticker;
+        uint32_t first; // bar offsets into the columns, [first, last)
+        uint32_t last;
+        bool operator==(const Range &) const = default;
+    };
+
+    struct RangeHash
+    {
+        size_t operator()(const Range &r) const;
+    };
+
+    using Lru = std::list<std::pair<Range, std::vector<double>>>;
+
+    void reserveColumns(size_t tickers, size_t bars);
+    void addSeries(const PriceSeries &series);
+
+    Range resolve(uint32_t ticker, int64_t firstDay, int64_t lastDay) const;
+    std::vector<double> compute(const Range &range) const;
+    const std::vector<double> *cached(const Range &range);
+    void remember(const Range &range, std::vector<double> values);
+    std::string format(const ServerQuery &query, const std::vector<const std::vector<double> *> &rows) const;
+
+    QueryEngineOptions options_;
+    std::vector<std::string> symbols_;
+    std::unordered_map<std::string, uint32_t> ids_;
+    std::vector<size_t> offsets_; // ticker i owns bars [offsets_[i], offsets_[i + 1])
+    std::vector<int64_t> days_;
+    std::vector<double> closes_;
+
+    Lru lru_; // most recent first
+    std::unordered_map<Range, Lru::iterator, RangeHash> cache_;
+    uint64_t hits_ = 0;
+    uint64_t misses_ = 0;
+};
+
+// Single-threaded poll() loop on a Unix domain socket. Each wakeup gathers
+// the complete request lines from every client and answers them as one
+// QueryEngine::answerBatch, so concurrent and pipelined requests share work.
+// A client that pipelines requests without reading its responses stops being
+// read once a few MiB of responses are pending, so the kernel's socket buffer,
+// not the server, holds the backlog.
+class AnalyticsServer
+{
+public:
+    // Binds and listens; replaces a stale socket file at `socketPath`.
+    // Throws std::runtime_error when the socket cannot be set up.
+    AnalyticsServer(QueryEngine &engine, std::string socketPath);
+    ~AnalyticsServer();
+
+    AnalyticsServer(const AnalyticsServer &) = delete;
+    AnalyticsServer &operator=(const AnalyticsServer &) = delete;
+
+    // Serves until stop(); closes every client before returning.
+    void run();
+
+    // Safe from other threads and from signal handlers.
+    void stop();
+
+    const std::string &socketPath() const { return socketPath_; }
+    uint64_t requestsServed() const { return served_.load(); }
+
+private:
+    struct Client
+    {
+        int fd = -1;
+        std::string in;
+        std::string out;
+        bool closing = false; // peer finished sending; close once `out` drains
+    };
+
+    QueryEngine &engine_;
+    std::string socketPath_;
+    int listenFd_ = -1;
+    int wakeFds_[2] = {-1, -1};
+    std::atomic<uint64_t> served_{0};
+};
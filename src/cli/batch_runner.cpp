@@ -0,0 +1,507 @@
+#include "cli/batch_runner.hpp"
+#include "core/trading_calendar.hpp"
+#include "stats/correlation.hpp"
+#include "stats/drawdowns.hpp"
+#include "stats/ratios.hpp"
+#include "stats/returns.hpp"
+#include "stats/volatility.hpp"
+#include "../utils/instrumentation.hpp"
+#include "../utils/math_utils.hpp"
+#include "../utils/task_scheduler.hpp"
+#include "../utils/timestamp.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <functional>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+
+namespace
+{
+    constexpr int kTradingDays = 252;
+
+    class StageClock
+    {
+    public:
+        StageClock(std::vector<StageTiming> &timings, std::string stage)
+            : timings_(timings), stage_(std::move(stage)), start_(std::chrono::steady_clock::now()) {}
+
+        ~StageClock()
+        {
+            timings_.push_back({stage_, std::chrono::duration<double>(std::chrono::steady_clock::now() - start_).count()});
+        }
+
+    private:
+        std::vector<StageTiming> &timings_;
+        std::string stage_;
+        std::chrono::steady_clock::time_point start_;
+    };
+
+    std::vector<std::string> splitList(const std::string &text)
+    {
+        std::vector<std::string> items;
+        std::stringstream ss(text);
+        std::string item;
+        while (std::getline(ss, item, ','))
+        {
+            item.erase(0, item.find_first_not_of(" \t\r"));
+            item.erase(item.find_last_not_of(" \t\r") + 1);
+            if (!item.empty())
+                items.push_back(item);
+        }
+        return items;
+    }
+
+    bool isNumeric(const std::string &text)
+    {
+        try
+        {
+            size_t used = 0;
+            std::stod(text, &used);
+            return used == text.size();
+        }
+        catch (const std::exception &)
+        {
+            return false;
+        }
+    }
+
+    struct TickerMetrics
+    {
+        bool ok = false;
+        std::string error;
+        int64_t observations = 0;
+        double values[8] = {};
+    };
+
+    // Order matches availableMetrics() after "observations".
+    TickerMetrics computeMetrics(const PriceSeries &series, double riskFreeRate, int periodsPerYear)
+    {
+        TickerMetrics m;
+        std::vector<double> returns = Stats::Returns::computeDailyReturns(series);
+
+        std::vector<double> wealth;
+        wealth.reserve(returns.size() + 1);
+        double cum = 1.0;
+        wealth.push_back(cum);
+        for (double r : returns)
+        {
+            cum *= 1.0 + r;
+            wealth.push_back(cum);
+        }
+
+        const double dailyRiskFree = riskFreeRate / periodsPerYear;
+        const double annualizer = std::sqrt(static_cast<double>(periodsPerYear));
+        double mean = Stats::Returns::meanReturns(returns);
+        double variance = returns.size() > 1 ? MathUtils::variance(returns, true) : 0.0;
+        double total = Stats::Returns::computeTotalReturn(series);
+        double annual = Stats::Returns::computeAnnualizedReturn(total, static_cast<int>(returns.size()), periodsPerYear);
+        double mdd = Stats::Drawdowns::computeMaxDrawdown(wealth);
+
+        m.observations = static_cast<int64_t>(returns.size());
+        m.values[0] = mean;
+        m.values[1] = Stats::Volatility::computeAnnualizedVolatility(returns, periodsPerYear);
+        m.values[2] = Stats::Ratios::computeSharpeRatio(mean, variance, dailyRiskFree) * annualizer;
+        m.values[3] = Stats::Ratios::computeSortinoRatio(mean, dailyRiskFree, returns) * annualizer;
+        m.values[4] = mdd;
+        m.values[5] = total;
+        m.values[6] = annual;
+        m.values[7] = Stats::Ratios::computeCalmarRatio(annual, mdd);
+        m.ok = true;
+        return m;
+    }
+
+    struct SessionInfo
+    {
+        int periodsPerYear = kTradingDays;
+        int64_t missingSessions = 0;
+    };
+
+    // Annualization factor and missing sessions from the calendar; the fixed
+    // kTradingDays when the dates do not parse, are unordered or fall outside it.
+    SessionInfo sessionInfo(const PriceSeries &series, const TradingCalendar &calendar)
+    {
+        SessionInfo info;
+        std::vector<int64_t> days;
+        days.reserve(series.getDates().size());
+        for (const auto &date : series.getDates())
+        {
+            int64_t ms;
+            if (!Timestamp::tryParseIsoMillis(date, ms))
+                return info;
+            days.push_back(ms / 86400000LL);
+        }
+        if (days.size() < 2 || days.front() < calendar.firstDay() || days.back() > calendar.lastDay() ||
+            std::adjacent_find(days.begin(), days.end(), std::greater_equal<>()) != days.end())
+            return info;
+
+        info.periodsPerYear = static_cast<int>(std::lround(calendar.sessionsPerYear(days.front(), days.back())));
+        for (const auto &gap : calendar.findGaps(days))
+            info.missingSessions += gap.missing;
+        return info;
+    }
+
+    std::vector<std::string> intersectDates(const std::vector<std::shared_ptr<const PriceSeries>> &series)
+    {
+        std::vector<std::string> common;
+        bool first = true;
+        for (const auto &s : series)
+        {
+            if (!s)
+                continue;
+            std::vector<std::string> dates = s->getDates();
+            std::sort(dates.begin(), dates.end());
+            if (first)
+            {
+                common = std::move(dates);
+                first = false;
+                continue;
+            }
+            std::vector<std::string> next;
+            next.reserve(std::min(common.size(), dates.size()));
+            std::set_intersection(common.begin(), common.end(), dates.begin(), dates.end(), std::back_inserter(next));
+            common.swap(next);
+        }
+        common.erase(std::unique(common.begin(), common.end()), common.end());
+        return common;
+    }
+
+    PriceSeries alignTo(const PriceSeries &series, const std::vector<std::string> &common)
+    {
+        const auto &dates = series.getDates();
+        const auto &prices = series.getPrices();
+
+        std::vector<size_t> order(dates.size());
+        for (size_t i = 0; i < order.size(); ++i)
+            order[i] = i;
+        if (!std::is_sorted(dates.begin(), dates.end()))
+            std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b)
+                             { return dates[a] < dates[b]; });
+
+        std::vector<double> aligned;
+        aligned.reserve(common.size());
+        size_t j = 0;
+        for (const auto &d : common)
+        {
+            while (j < order.size() && dates[order[j]] < d)
+                ++j;
+            aligned.push_back(prices[order[j]]);
+        }
+        return PriceSeries(series.getTicker(), common, std::move(aligned));
+    }
+}
+
+namespace BatchCli
+{
+    std::string usage()
+    {
+        std::string metrics;
+        for (const auto &m : BatchRunner::availableMetrics())
+            metrics += (metrics.empty() ? "" : ",") + m;
+
+        return "Usage: main_exec [options]\n"
+               "  --universe FILE        tickers, one per line or comma separated\n"
+               "  --tickers A,B,C        tickers on the command line (default: AAPL)\n"
+               "  --start YYYY-MM-DD     start date (default: 2023-01-01)\n"
+               "  --end YYYY-MM-DD       end date (default: 2023-12-31)\n"
+               "  --metrics LIST         subset of " + metrics + "\n"
+               "  --threads N            worker threads (default: TRADEIQ_THREADS or all cores)\n"
+               "  --format FMT           table | csv | columnar (default: table)\n"
+               "  --out PATH             output file (default: stdout; required for columnar)\n"
+               "  --correlation PATH     also write the aligned correlation matrix\n"
+               "  --risk-free RATE       annual risk-free rate (default: 0.01)\n"
+               "  --calendar nyse        annualize by actual NYSE sessions and report missing ones\n"
+               "  --serve SOCKET         load the universe once, then answer queries on a Unix socket\n"
+               "  --trace PATH           write a Chrome trace-event JSON of instrumented spans\n"
+               "  --profile              print timer/counter summary to stderr\n"
+               "  --cache-dir DIR        sharded price store (default: .cache/store; \"\" for JSON files)\n"
+               "  --offline              only use cached data\n"
+               "  --verbose              log cache hits and per-ticker failures\n"
+               "  --help                 show this message\n";
+    }
+
+    BatchConfig parseArgs(const std::vector<std::string> &args)
+    {
+        BatchConfig config;
+        auto value = [&](size_t &i) -> const std::string &
+        {
+            if (i + 1 >= args.size())
+                throw std::invalid_argument("Missing value for " + args[i]);
+            return args[++i];
+        };
+
+        for (size_t i = 0; i < args.size(); ++i)
+        {
+            const std::string &arg = args[i];
+            if (arg == "--universe")
+                config.universeFile = value(i);
+            else if (arg == "--tickers")
+                config.tickers = splitList(value(i));
+            else if (arg == "--start")
+                config.startDate = value(i);
+            else if (arg == "--end")
+                config.endDate = value(i);
+            else if (arg == "--metrics")
+                config.metrics = splitList(value(i));
+            else if (arg == "--format")
+                config.format = value(i);
+            else if (arg == "--out")
+                config.output = value(i);
+            else if (arg == "--correlation")
+                config.correlationOutput = value(i);
+            else if (arg == "--calendar")
+                config.calendar = value(i);
+            else if (arg == "--serve")
+                config.serveSocket = value(i);
+            else if (arg == "--cache-dir")
+                config.cacheDir = value(i);
+            else if (arg == "--trace")
+                config.traceOutput = value(i);
+            else if (arg == "--profile")
+                config.profile = true;
+            else if (arg == "--offline")
+                config.offline = true;
+            else if (arg == "--verbose")
+                config.verbose = true;
+            else if (arg == "--help" || arg == "-h")
+                config.showHelp = true;
+            else if (arg == "--threads")
+            {
+                const std::string &v = value(i);
+                if (v.empty() || v.find_first_not_of("0123456789") != std::string::npos)
+                    throw std::invalid_argument("--threads expects a non-negative integer");
+                config.threads = static_cast<unsigned>(std::stoul(v));
+            }
+            else if (arg == "--risk-free")
+            {
+                const std::string &v = value(i);
+                if (!isNumeric(v))
+                    throw std::invalid_argument("--risk-free expects a number");
+                config.riskFreeRate = std::stod(v);
+            }
+            else
+                throw std::invalid_argument("Unknown option: " + arg);
+        }
+
+        if (config.format != "table" && config.format != "csv" && config.format != "columnar")
+            throw std::invalid_argument("Unsupported format: " + config.format);
+        if (config.format == "columnar" && config.output.empty())
+            throw std::invalid_argument("--format columnar requires --out");
+        if (!config.calendar.empty() && config.calendar != "nyse")
+            throw std::invalid_argument("Unsupported calendar: " + config.calendar);
+
+        const auto &known = BatchRunner::availableMetrics();
+        for (const auto &m : config.metrics)
+        {
+            if (std::find(known.begin(), known.end(), m) == known.end())
+                throw std::invalid_argument("Unknown metric: " + m);
+        }
+
+        if (!config.universeFile.empty())
+        {
+            auto fromFile = readUniverse(config.universeFile);
+            config.tickers.insert(config.tickers.end(), fromFile.begin(), fromFile.end());
+        }
+        if (config.tickers.empty())
+            config.tickers = {"AAPL"};
+
+        return config;
+    }
+
+    BatchConfig parseArgs(int argc, char **argv)
+    {
+        std::vector<std::string> args;
+        for (int i = 1; i < argc; ++i)
+            args.emplace_back(argv[i]);
+        return parseArgs(args);
+    }
+
+    std::vector<std::string> readUniverse(const std::string &path)
+    {
+        std::ifstream in(path);
+        if (!in)
+            throw std::runtime_error("Cannot open universe file: " + path);
+
+        std::vector<std::string> tickers;
+        std::string line;
+        while (std::getline(in, line))
+        {
+            auto hash = line.find('#');
+            if (hash != std::string::npos)
+                line.erase(hash);
+            for (auto &t : splitList(line))
+                tickers.push_back(std::move(t));
+        }
+        return tickers;
+    }
+
+    std::vector<double> metricValues(const PriceSeries &series, double riskFreeRate, int periodsPerYear)
+    {
+        const TickerMetrics m = computeMetrics(series, riskFreeRate, periodsPerYear);
+        std::vector<double> values = {static_cast<double>(m.observations)};
+        values.insert(values.end(), std::begin(m.values), std::end(m.values));
+        return values;
+    }
+}
+
+BatchRunner::BatchRunner(BatchConfig config, SeriesLoader loader)
+    : config_(std::move(config)), loader_(std::move(loader))
+{
+    if (!loader_)
+        throw std::invalid_argument("BatchRunner needs a series loader");
+    if (config_.threads == 0)
+        config_.threads = Tasks::TaskScheduler::global().concurrency();
+    if (config_.metrics.empty())
+        config_.metrics = availableMetrics();
+}
+
+const std::vector<std::string> &BatchRunner::availableMetrics()
+{
+    static const std::vector<std::string> metrics = {
+        "observations", "mean_return", "volatility", "sharpe", "sortino",
+        "max_drawdown", "total_return", "annualized_return", "calmar"};
+    return metrics;
+}
+
+BatchResult BatchRunner::run()
+{
+    BatchResult result;
+    const auto &tickers = config_.tickers;
+    const size_t n = tickers.size();
+
+    std::optional<Tasks::TaskScheduler> ownPool;
+    if (config_.threads != Tasks::TaskScheduler::global().concurrency())
+        ownPool.emplace(Tasks::SchedulerOptions{config_.threads});
+    Tasks::TaskScheduler &pool = ownPool ? *ownPool : Tasks::TaskScheduler::global();
+
+    std::vector<std::shared_ptr<const PriceSeries>> series(n);
+    std::vector<std::string> errors(n);
+    {
+        StageClock clock(result.timings, "load");
+        TRADEIQ_TIMED_SCOPE("batch.load");
+        pool.parallelFor(n, [&](size_t i)
+                         {
+            try
+            {
+                series[i] = loader_(tickers[i]);
+                if (!series[i])
+                    errors[i] = "no data";
+            }
+            catch (const std::exception &e)
+            {
+                errors[i] = e.what();
+            } });
+    }
+
+    bool wantCorrelation = !config_.correlationOutput.empty();
+    std::vector<PriceSeries> aligned;
+    {
+        StageClock clock(result.timings, "align");
+        TRADEIQ_TIMED_SCOPE("batch.align");
+        if (wantCorrelation)
+        {
+            result.commonDates = intersectDates(series);
+            aligned.reserve(n);
+            for (size_t i = 0; i < n; ++i)
+            {
+                if (series[i])
+                    aligned.push_back(alignTo(*series[i], result.commonDates));
+            }
+        }
+    }
+
+    std::vector<TickerMetrics> metrics(n);
+    std::vector<int64_t> missingSessions(n, 0);
+    {
+        StageClock clock(result.timings, "compute");
+        TRADEIQ_TIMED_SCOPE("batch.compute");
+        const TradingCalendar *calendar = config_.calendar.empty() ? nullptr : &TradingCalendar::nyse();
+        pool.parallelFor(n, [&](size_t i)
+                         {
+            if (!series[i])
+                return;
+            try
+            {
+                TRADEIQ_TIMED_SCOPE("batch.compute_ticker");
+                const SessionInfo info = calendar ? sessionInfo(*series[i], *calendar) : SessionInfo{};
+                metrics[i] = computeMetrics(*series[i], config_.riskFreeRate, info.periodsPerYear);
+                missingSessions[i] = info.missingSessions;
+            }
+            catch (const std::exception &e)
+            {
+                errors[i] = e.what();
+            } });
+    }
+
+    if (wantCorrelation)
+    {
+        StageClock clock(result.timings, "correlation");
+        TRADEIQ_TIMED_SCOPE("batch.correlation");
+        result.correlation = Stats::Correlation::computeCorrelationMatrix(aligned);
+        for (const auto &s : aligned)
+            result.labels.push_back(s.getTicker());
+    }
+
+    std::vector<std::string> names;
+    std::vector<std::vector<double>> columns(8);
+    std::vector<int64_t> observations;
+    for (size_t i = 0; i < n; ++i)
+    {
+        if (!metrics[i].ok)
+        {
+            result.failed.push_back(tickers[i] + ": " + (errors[i].empty() ? "no data" : errors[i]));
+            continue;
+        }
+        names.push_back(tickers[i]);
+        if (missingSessions[i] > 0)
+            result.gaps.push_back(tickers[i] + ": " + std::to_string(missingSessions[i]) + " missing sessions");
+        observations.push_back(metrics[i].observations);
+        for (size_t c = 0; c < columns.size(); ++c)
+            columns[c].push_back(metrics[i].values[c]);
+    }
+
+    const auto &known = availableMetrics();
+    result.metrics.addColumn("ticker", std::move(names));
+    for (const auto &m : config_.metrics)
+    {
+        size_t index = static_cast<size_t>(std::find(known.begin(), known.end(), m) - known.begin());
+        if (index == 0)
+            result.metrics.addColumn(m, observations);
+        else
+            result.metrics.addColumn(m, columns[index - 1]);
+    }
+    return result;
+}
+
+void BatchRunner::write(BatchResult &result)
+{
+    StageClock clock(result.timings, "export");
+    TRADEIQ_TIMED_SCOPE("batch.export");
+
+    if (config_.format == "columnar")
+    {
+        Export::writeColumnar(config_.output, result.metrics);
+    }
+    else
+    {
+        std::unique_ptr<Export::BufferedWriter> out =
+            config_.output.empty() ? std::make_unique<Export::BufferedWriter>(stdout)
+                                   : std::make_unique<Export::BufferedWriter>(config_.output);
+        if (config_.format == "csv")
+            Export::writeCsv(*out, result.metrics);
+        else
+            Export::writeTable(*out, result.metrics);
+        out->close();
+    }
+
+    if (!config_.correlationOutput.empty())
+    {
+        if (config_.format == "columnar")
+            Export::writeColumnar(config_.correlationOutput, result.correlation, result.labels);
+        else
+            Export::writeCsv(config_.correlationOutput, result.correlation, result.labels);
+    }
+}
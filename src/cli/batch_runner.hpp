@@ -0,0 +1,87 @@
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "cli/exporters.hpp"
+#include "core/price_series.hpp"
+
+// Multi-ticker batch pipeline behind the main executable:
+// load -> align -> compute -> export, with per-stage wall-clock timings.
+struct BatchConfig
+{
+    std::vector<std::string> tickers;
+    std::string universeFile;
+    std::string startDate = "2023-01-01";
+    std::string endDate = "2023-12-31";
+    std::vector<std::string> metrics; // empty = all of BatchRunner::availableMetrics()
+    unsigned threads = 0;             // 0 = shared task pool (TRADEIQ_THREADS or all cores)
+    std::string format = "table";     // table | csv | columnar
+    std::string output;               // empty = stdout (not allowed for columnar)
+    std::string correlationOutput;    // optional; written in `format` (table -> csv)
+    std::string traceOutput;          // Chrome trace-event JSON of instrumented spans
+    bool profile = false;             // print the instrumentation summary to stderr
+    double riskFreeRate = 0.01;       // annual; converted to a per-day rate
+    std::string calendar;             // "nyse": annualize by real session counts and report gaps
+    std::string serveSocket;          // non-empty: load once, then answer queries on this Unix socket
+    std::string cacheDir = ".cache/store"; // sharded price store; empty = one .cache/*.json per request
+    bool offline = false;
+    bool verbose = false;
+    bool showHelp = false;
+};
+
+struct StageTiming
+{
+    std::string stage;
+    double seconds = 0.0;
+};
+
+struct BatchResult
+{
+    Export::ResultTable metrics;                  // one row per successfully loaded ticker
+    std::vector<std::string> labels;              // tickers, in universe order
+    std::vector<std::string> commonDates;         // dates shared by every loaded ticker
+    std::vector<std::vector<double>> correlation; // over commonDates; empty unless requested
+    std::vector<std::string> failed;              // "TICKER: reason"
+    std::vector<std::string> gaps;                // "TICKER: N missing sessions"; needs a calendar
+    std::vector<StageTiming> timings;
+};
+
+namespace BatchCli
+{
+    // Throws std::invalid_argument on unknown flags or malformed values.
+    BatchConfig parseArgs(const std::vector<std::string> &args);
+    BatchConfig parseArgs(int argc, char **argv);
+    std::string usage();
+
+    // One ticker per line or comma separated; blank lines and '#' comments ignored.
+    std::vector<std::string> readUniverse(const std::string &path);
+
+    // Every entry of BatchRunner::availableMetrics() for one series, in that
+    // order, as the batch computes them. Throws std::invalid_argument with
+    // fewer than two prices.
+    std::vector<double> metricValues(const PriceSeries &series, double riskFreeRate, int periodsPerYear = 252);
+}
+
+class BatchRunner
+{
+public:
+    using SeriesLoader = std::function<std::shared_ptr<const PriceSeries>(const std::string &ticker)>;
+
+    BatchRunner(BatchConfig config, SeriesLoader loader);
+
+    static const std::vector<std::string> &availableMetrics();
+
+    BatchResult run();
+
+    // Writes metrics (and the correlation matrix if requested) in the configured format.
+    void write(BatchResult &result);
+
+    const BatchConfig &config() const { return config_; }
+
+private:
+    BatchConfig config_;
+    SeriesLoader loader_;
+};
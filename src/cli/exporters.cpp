@@ -0,0 +1,552 @@
+#include "cli/exporters.hpp"
+#include "../external/json.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <charconv>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+
+using json = nlohmann::json;
+
+static_assert(std::endian::native == std::endian::little, "Columnar export assumes a little-endian host");
+
+namespace Export
+{
+    namespace
+    {
+        constexpr char kMagic[8] = {'T', 'I', 'Q', 'C', 'O', 'L', '1', '\0'};
+        constexpr uint64_t kAlignment = 64;
+
+        uint64_t alignUp(uint64_t value) { return (value + kAlignment - 1) & ~(kAlignment - 1); }
+
+        const char *dtypeName(ColumnType type)
+        {
+            switch (type)
+            {
+            case ColumnType::Float64:
+                return "<f8";
+            case ColumnType::Int64:
+                return "<i8";
+            default:
+                return "utf8";
+            }
+        }
+
+        void writeCsvField(BufferedWriter &out, const std::string &text, char delimiter)
+        {
+            if (text.find_first_of(std::string{delimiter, '"', '\n', '\r'}) == std::string::npos)
+            {
+                out.write(text);
+                return;
+            }
+            out.put('"');
+            for (char c : text)
+            {
+                if (c == '"')
+                    out.put('"');
+                out.put(c);
+            }
+            out.put('"');
+        }
+
+        std::vector<double> flatten(const std::vector<std::vector<double>> &matrix, size_t &cols)
+        {
+            cols = matrix.empty() ? 0 : matrix[0].size();
+            std::vector<double> flat;
+            flat.reserve(matrix.size() * cols);
+            for (const auto &row : matrix)
+            {
+                if (row.size() != cols)
+                    throw std::invalid_argument("Matrix rows must all have the same length");
+                flat.insert(flat.end(), row.begin(), row.end());
+            }
+            return flat;
+        }
+
+        // Lays out buffers after the header and writes header + data in one pass.
+        void writeBlocks(const std::string &path, json header, const ResultTable &table)
+        {
+            struct Layout
+            {
+                uint64_t offsets = 0;
+                uint64_t data = 0;
+                uint64_t length = 0;
+            };
+
+            // The header length depends on the offsets it contains, so size it with
+            // placeholder offsets wide enough for any real value, then pad.
+            const size_t rows = table.rows();
+            std::vector<Layout> layout(table.columns().size());
+            json columns = json::array();
+            for (const auto &col : table.columns())
+            {
+                json desc = {{"name", col.name}, {"dtype", dtypeName(col.type)},
+                             {"offset", UINT64_MAX}, {"length", UINT64_MAX}};
+                if (col.type == ColumnType::Utf8)
+                    desc["offsets_offset"] = UINT64_MAX;
+                columns.push_back(desc);
+            }
+            header["rows"] = rows;
+            header["columns"] = columns;
+            uint64_t cursor = alignUp(16 + header.dump().size());
+
+            for (size_t c = 0; c < table.columns().size(); ++c)
+            {
+                const Column &col = table.columns()[c];
+                json &desc = header["columns"][c];
+                if (col.type == ColumnType::Utf8)
+                {
+                    layout[c].offsets = cursor;
+                    cursor = alignUp(cursor + (rows + 1) * sizeof(int64_t));
+                    uint64_t bytes = 0;
+                    for (const auto &s : col.text)
+                        bytes += s.size();
+                    layout[c].length = bytes;
+                    desc["offsets_offset"] = layout[c].offsets;
+                }
+                else
+                {
+                    layout[c].length = rows * sizeof(double);
+                }
+                layout[c].data = cursor;
+                cursor = alignUp(cursor + layout[c].length);
+                desc["offset"] = layout[c].data;
+                desc["length"] = layout[c].length;
+            }
+
+            std::string text = header.dump();
+            BufferedWriter out(path);
+            out.write(std::string_view(kMagic, sizeof(kMagic)));
+            uint64_t headerLength = text.size();
+            out.write(std::string_view(reinterpret_cast<const char *>(&headerLength), sizeof(headerLength)));
+            out.write(text);
+
+            for (size_t c = 0; c < table.columns().size(); ++c)
+            {
+                const Column &col = table.columns()[c];
+                if (col.type == ColumnType::Utf8)
+                {
+                    out.pad(layout[c].offsets - out.bytesWritten());
+                    int64_t offset = 0;
+                    out.write(std::string_view(reinterpret_cast<const char *>(&offset), sizeof(offset)));
+                    for (const auto &s : col.text)
+                    {
+                        offset += static_cast<int64_t>(s.size());
+                        out.write(std::string_view(reinterpret_cast<const char *>(&offset), sizeof(offset)));
+                    }
+                }
+                out.pad(layout[c].data - out.bytesWritten());
+                if (col.type == ColumnType::Float64)
+                    out.write(std::string_view(reinterpret_cast<const char *>(col.f64.data()), layout[c].length));
+                else if (col.type == ColumnType::Int64)
+                    out.write(std::string_view(reinterpret_cast<const char *>(col.i64.data()), layout[c].length));
+                else
+                    for (const auto &s : col.text)
+                        out.write(s);
+            }
+            out.close();
+        }
+
+        struct Loaded
+        {
+            std::string bytes;
+            json header;
+        };
+
+        Loaded load(const std::string &path)
+        {
+            std::ifstream in(path, std::ios::binary);
+            if (!in)
+                throw std::runtime_error("Cannot open columnar file: " + path);
+            Loaded file;
+            file.bytes.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+
+            if (file.bytes.size() < 16 || std::memcmp(file.bytes.data(), kMagic, sizeof(kMagic)) != 0)
+                throw std::runtime_error("Not a TradeIQ columnar file: " + path);
+            uint64_t headerLength;
+            std::memcpy(&headerLength, file.bytes.data() + 8, sizeof(headerLength));
+            if (headerLength > file.bytes.size() - 16)
+                throw std::runtime_error("Columnar header is truncated: " + path);
+            file.header = json::parse(file.bytes.substr(16, headerLength));
+            return file;
+        }
+
+        template <typename T>
+        std::vector<T> readArray(const std::string &bytes, uint64_t offset, uint64_t count)
+        {
+            if (offset > bytes.size() || count > (bytes.size() - offset) / sizeof(T))
+                throw std::runtime_error("Columnar buffer is out of bounds");
+            std::vector<T> values(count);
+            if (count)
+                std::memcpy(values.data(), bytes.data() + offset, count * sizeof(T));
+            return values;
+        }
+    }
+
+    size_t Column::size() const
+    {
+        switch (type)
+        {
+        case ColumnType::Float64:
+            return f64.size();
+        case ColumnType::Int64:
+            return i64.size();
+        default:
+            return text.size();
+        }
+    }
+
+    void ResultTable::append(Column column)
+    {
+        if (!columns_.empty() && column.size() != rows_)
+            throw std::invalid_argument("Column " + column.name + " has " + std::to_string(column.size()) +
+                                        " rows, expected " + std::to_string(rows_));
+        rows_ = column.size();
+        columns_.push_back(std::move(column));
+    }
+
+    void ResultTable::addColumn(const std::string &name, std::vector<double> values)
+    {
+        Column col;
+        col.name = name;
+        col.type = ColumnType::Float64;
+        col.f64 = std::move(values);
+        append(std::move(col));
+    }
+
+    void ResultTable::addColumn(const std::string &name, std::vector<int64_t> values)
+    {
+        Column col;
+        col.name = name;
+        col.type = ColumnType::Int64;
+        col.i64 = std::move(values);
+        append(std::move(col));
+    }
+
+    void ResultTable::addColumn(const std::string &name, std::vector<std::string> values)
+    {
+        Column col;
+        col.name = name;
+        col.type = ColumnType::Utf8;
+        col.text = std::move(values);
+        append(std::move(col));
+    }
+
+    const Column &ResultTable::column(const std::string &name) const
+    {
+        for (const auto &col : columns_)
+        {
+            if (col.name == name)
+                return col;
+        }
+        throw std::out_of_range("No column named " + name);
+    }
+
+    BufferedWriter::BufferedWriter(const std::string &path, size_t bufferSize)
+        : file_(std::fopen(path.c_str(), "wb")), buffer_(bufferSize < 64 ? 64 : bufferSize), path_(path)
+    {
+        if (!file_)
+            throw std::runtime_error("Cannot open for writing: " + path);
+    }
+
+    BufferedWriter::BufferedWriter(std::FILE *stream, size_t bufferSize)
+        : file_(stream), owned_(false), buffer_(bufferSize < 64 ? 64 : bufferSize), path_("<stream>")
+    {
+        if (!file_)
+            throw std::invalid_argument("BufferedWriter needs an open stream");
+    }
+
+    BufferedWriter::~BufferedWriter()
+    {
+        try
+        {
+            close();
+        }
+        catch (...)
+        {
+        }
+    }
+
+    void BufferedWriter::flush()
+    {
+        if (used_ == 0 || !file_)
+            return;
+        if (std::fwrite(buffer_.data(), 1, used_, file_) != used_)
+            throw std::runtime_error("Write failed: " + path_);
+        written_ += used_;
+        used_ = 0;
+    }
+
+    void BufferedWriter::close()
+    {
+        if (!file_)
+            return;
+        flush();
+        bool ok = owned_ ? std::fclose(file_) == 0 : std::fflush(file_) == 0;
+        file_ = nullptr;
+        if (!ok)
+            throw std::runtime_error("Write failed: " + path_);
+    }
+
+    void BufferedWriter::write(std::string_view text)
+    {
+        if (text.size() > buffer_.size() - used_)
+        {
+            flush();
+            if (text.size() >= buffer_.size())
+            {
+                if (std::fwrite(text.data(), 1, text.size(), file_) != text.size())
+                    throw std::runtime_error("Write failed: " + path_);
+                written_ += text.size();
+                return;
+            }
+        }
+        std::memcpy(buffer_.data() + used_, text.data(), text.size());
+        used_ += text.size();
+    }
+
+    void BufferedWriter::put(char c)
+    {
+        if (used_ == buffer_.size())
+            flush();
+        buffer_[used_++] = c;
+    }
+
+    void BufferedWriter::writeDouble(double value, int precision)
+    {
+        // Longest fixed output is bounded by the exponent (~310 digits) plus precision.
+        if (buffer_.size() - used_ < 400)
+            flush();
+        char *first = buffer_.data() + used_;
+        char *last = buffer_.data() + buffer_.size();
+        auto result = precision < 0 ? std::to_chars(first, last, value)
+                                    : std::to_chars(first, last, value, std::chars_format::fixed, precision);
+        if (result.ec != std::errc())
+            throw std::runtime_error("Cannot format value for " + path_);
+        used_ = static_cast<size_t>(result.ptr - buffer_.data());
+    }
+
+    void BufferedWriter::writeInt(int64_t value)
+    {
+        if (buffer_.size() - used_ < 24)
+            flush();
+        auto result = std::to_chars(buffer_.data() + used_, buffer_.data() + buffer_.size(), value);
+        used_ = static_cast<size_t>(result.ptr - buffer_.data());
+    }
+
+    void BufferedWriter::pad(size_t count, char fill)
+    {
+        for (; count > 0; --count)
+            put(fill);
+    }
+
+    void writeCsv(const std::string &path, const ResultTable &table, const CsvOptions &options)
+    {
+        BufferedWriter out(path);
+        writeCsv(out, table, options);
+        out.close();
+    }
+
+    void writeCsv(BufferedWriter &out, const ResultTable &table, const CsvOptions &options)
+    {
+        const auto &cols = table.columns();
+        for (size_t c = 0; c < cols.size(); ++c)
+        {
+            if (c)
+                out.put(options.delimiter);
+            writeCsvField(out, cols[c].name, options.delimiter);
+        }
+        out.put('\n');
+
+        for (size_t r = 0; r < table.rows(); ++r)
+        {
+            for (size_t c = 0; c < cols.size(); ++c)
+            {
+                if (c)
+                    out.put(options.delimiter);
+                const Column &col = cols[c];
+                if (col.type == ColumnType::Float64)
+                    out.writeDouble(col.f64[r], options.precision);
+                else if (col.type == ColumnType::Int64)
+                    out.writeInt(col.i64[r]);
+                else
+                    writeCsvField(out, col.text[r], options.delimiter);
+            }
+            out.put('\n');
+        }
+    }
+
+    void writeTable(BufferedWriter &out, const ResultTable &table, int precision)
+    {
+        const auto &cols = table.columns();
+        std::vector<std::vector<std::string>> cells(cols.size());
+        std::vector<size_t> widths(cols.size());
+        char buf[64];
+        for (size_t c = 0; c < cols.size(); ++c)
+        {
+            const Column &col = cols[c];
+            widths[c] = col.name.size();
+            cells[c].reserve(table.rows());
+            for (size_t r = 0; r < table.rows(); ++r)
+            {
+                std::string cell;
+                if (col.type == ColumnType::Utf8)
+                {
+                    cell = col.text[r];
+                }
+                else
+                {
+                    auto res = col.type == ColumnType::Float64
+                                   ? std::to_chars(buf, buf + sizeof(buf), col.f64[r], std::chars_format::fixed, precision)
+                                   : std::to_chars(buf, buf + sizeof(buf), col.i64[r]);
+                    cell = res.ec == std::errc() ? std::string(buf, res.ptr) : std::string("#");
+                }
+                widths[c] = std::max(widths[c], cell.size());
+                cells[c].push_back(std::move(cell));
+            }
+        }
+
+        // Text columns are left-aligned, numbers right-aligned.
+        auto emit = [&](size_t c, const std::string &text)
+        {
+            if (c)
+                out.write("  ");
+            bool left = cols[c].type == ColumnType::Utf8;
+            if (!left)
+                out.pad(widths[c] - text.size(), ' ');
+            out.write(text);
+            if (left && c + 1 < cols.size())
+                out.pad(widths[c] - text.size(), ' ');
+        };
+
+        for (size_t c = 0; c < cols.size(); ++c)
+            emit(c, cols[c].name);
+        out.put('\n');
+        for (size_t r = 0; r < table.rows(); ++r)
+        {
+            for (size_t c = 0; c < cols.size(); ++c)
+                emit(c, cells[c][r]);
+            out.put('\n');
+        }
+    }
+
+    void writeCsv(const std::string &path, const std::vector<std::vector<double>> &matrix,
+                  const std::vector<std::string> &labels, const CsvOptions &options)
+    {
+        if (!labels.empty() && labels.size() != matrix.size())
+            throw std::invalid_argument("Need one label per matrix row");
+
+        BufferedWriter out(path);
+        if (!labels.empty())
+        {
+            for (const auto &label : labels)
+            {
+                out.put(options.delimiter);
+                writeCsvField(out, label, options.delimiter);
+            }
+            out.put('\n');
+        }
+
+        for (size_t r = 0; r < matrix.size(); ++r)
+        {
+            if (!labels.empty())
+            {
+                writeCsvField(out, labels[r], options.delimiter);
+                out.put(options.delimiter);
+            }
+            const auto &row = matrix[r];
+            if (row.size() != matrix[0].size())
+                throw std::invalid_argument("Matrix rows must all have the same length");
+            for (size_t c = 0; c < row.size(); ++c)
+            {
+                if (c)
+                    out.put(options.delimiter);
+                out.writeDouble(row[c], options.precision);
+            }
+            out.put('\n');
+        }
+        out.close();
+    }
+
+    void writeColumnar(const std::string &path, const ResultTable &table)
+    {
+        writeBlocks(path, json::object(), table);
+    }
+
+    void writeColumnar(const std::string &path, const std::vector<std::vector<double>> &matrix,
+                       const std::vector<std::string> &labels)
+    {
+        if (!labels.empty() && labels.size() != matrix.size())
+            throw std::invalid_argument("Need one label per matrix row");
+
+        size_t cols = 0;
+        ResultTable table;
+        table.addColumn("matrix", flatten(matrix, cols));
+
+        json header = json::object();
+        header["shape"] = {matrix.size(), cols};
+        header["labels"] = labels;
+        writeBlocks(path, header, table);
+    }
+
+    ResultTable readColumnar(const std::string &path)
+    {
+        Loaded file = load(path);
+        uint64_t rows = file.header.at("rows").get<uint64_t>();
+
+        ResultTable table;
+        for (const auto &desc : file.header.at("columns"))
+        {
+            std::string name = desc.at("name").get<std::string>();
+            std::string dtype = desc.at("dtype").get<std::string>();
+            uint64_t offset = desc.at("offset").get<uint64_t>();
+
+            if (dtype == "<f8")
+            {
+                table.addColumn(name, readArray<double>(file.bytes, offset, rows));
+            }
+            else if (dtype == "<i8")
+            {
+                table.addColumn(name, readArray<int64_t>(file.bytes, offset, rows));
+            }
+            else if (dtype == "utf8")
+            {
+                auto offsets = readArray<int64_t>(file.bytes, desc.at("offsets_offset").get<uint64_t>(), rows + 1);
+                uint64_t length = desc.at("length").get<uint64_t>();
+                if (offset > file.bytes.size() || length > file.bytes.size() - offset)
+                    throw std::runtime_error("Columnar buffer is out of bounds");
+                std::vector<std::string> text(rows);
+                for (size_t r = 0; r < rows; ++r)
+                {
+                    if (offsets[r] < 0 || offsets[r] > offsets[r + 1] || static_cast<uint64_t>(offsets[r + 1]) > length)
+                        throw std::runtime_error("Corrupt string offsets in column " + name);
+                    text[r] = file.bytes.substr(offset + offsets[r], offsets[r + 1] - offsets[r]);
+                }
+                table.addColumn(name, std::move(text));
+            }
+            else
+            {
+                throw std::runtime_error("Unsupported column dtype: " + dtype);
+            }
+        }
+        return table;
+    }
+
+    Matrix readColumnarMatrix(const std::string &path)
+    {
+        Loaded file = load(path);
+        if (!file.header.contains("shape"))
+            throw std::runtime_error("Columnar file does not hold a matrix: " + path);
+
+        Matrix m;
+        m.rows = file.header["shape"][0].get<size_t>();
+        m.cols = file.header["shape"][1].get<size_t>();
+        m.labels = file.header.value("labels", std::vector<std::string>{});
+        const auto &desc = file.header.at("columns").at(0);
+        m.values = readArray<double>(file.bytes, desc.at("offset").get<uint64_t>(), m.rows * m.cols);
+        return m;
+    }
+}
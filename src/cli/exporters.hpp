@@ -0,0 +1,126 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// File exporters for results that are too large to print.
+//
+// CSV uses std::to_chars through a single buffered writer. The columnar format
+// (".tiqc") is a small documented layout meant for zero-copy mmap from Python:
+//
+//   offset 0   char[8]  magic "TIQCOL1\0"
+//   offset 8   u64      header length H (little-endian)
+//   offset 16  char[H]  UTF-8 JSON header:
+//                         {"rows": N,
+//                          "shape": [r, c],            (matrices only)
+//                          "labels": [...],            (matrices only)
+//                          "columns": [{"name", "dtype", "offset", "length", ...}]}
+//   ...        column data, every buffer starts on a 64-byte boundary
+//
+// dtype is "<f8" or "<i8" (raw little-endian arrays of `rows` values) or
+// "utf8" (an "<i8" offsets array of rows+1 entries at "offsets_offset", then the
+// concatenated bytes at "offset"). Matrices are one "<f8" column in row-major
+// order, so `np.frombuffer(mm, "<f8", r * c, offset).reshape(r, c)` is a view.
+namespace Export
+{
+    enum class ColumnType : uint8_t
+    {
+        Float64,
+        Int64,
+        Utf8
+    };
+
+    struct Column
+    {
+        std::string name;
+        ColumnType type = ColumnType::Float64;
+        std::vector<double> f64;
+        std::vector<int64_t> i64;
+        std::vector<std::string> text;
+
+        size_t size() const;
+    };
+
+    // Named, equal-length columns (a metrics sweep, a price panel, ...).
+    class ResultTable
+    {
+    public:
+        void addColumn(const std::string &name, std::vector<double> values);
+        void addColumn(const std::string &name, std::vector<int64_t> values);
+        void addColumn(const std::string &name, std::vector<std::string> values);
+
+        size_t rows() const { return rows_; }
+        const std::vector<Column> &columns() const { return columns_; }
+        const Column &column(const std::string &name) const;
+
+    private:
+        void append(Column column);
+
+        std::vector<Column> columns_;
+        size_t rows_ = 0;
+    };
+
+    struct Matrix
+    {
+        size_t rows = 0;
+        size_t cols = 0;
+        std::vector<double> values; // row-major
+        std::vector<std::string> labels;
+    };
+
+    struct CsvOptions
+    {
+        char delimiter = ',';
+        int precision = -1; // < 0: shortest round-trip representation
+    };
+
+    // Appends into a fixed buffer and hands full chunks to fwrite.
+    class BufferedWriter
+    {
+    public:
+        explicit BufferedWriter(const std::string &path, size_t bufferSize = 1 << 20);
+        // Borrows an open stream (e.g. stdout); close() flushes but does not fclose it.
+        explicit BufferedWriter(std::FILE *stream, size_t bufferSize = 1 << 20);
+        ~BufferedWriter();
+
+        BufferedWriter(const BufferedWriter &) = delete;
+        BufferedWriter &operator=(const BufferedWriter &) = delete;
+
+        void write(std::string_view text);
+        void put(char c);
+        void writeDouble(double value, int precision = -1);
+        void writeInt(int64_t value);
+        void pad(size_t count, char fill = '\0');
+
+        uint64_t bytesWritten() const { return written_ + used_; }
+        void flush();
+        void close();
+
+    private:
+        std::FILE *file_;
+        bool owned_ = true;
+        std::vector<char> buffer_;
+        size_t used_ = 0;
+        uint64_t written_ = 0;
+        std::string path_;
+    };
+
+    void writeCsv(const std::string &path, const ResultTable &table, const CsvOptions &options = {});
+    void writeCsv(BufferedWriter &out, const ResultTable &table, const CsvOptions &options = {});
+    void writeCsv(const std::string &path, const std::vector<std::vector<double>> &matrix,
+                  const std::vector<std::string> &labels = {}, const CsvOptions &options = {});
+
+    // Space-aligned text for terminals; doubles use `precision` fixed digits.
+    void writeTable(BufferedWriter &out, const ResultTable &table, int precision = 4);
+
+    void writeColumnar(const std::string &path, const ResultTable &table);
+    void writeColumnar(const std::string &path, const std::vector<std::vector<double>> &matrix,
+                       const std::vector<std::string> &labels = {});
+
+    ResultTable readColumnar(const std::string &path);
+    Matrix readColumnarMatrix(const std::string &path);
+}
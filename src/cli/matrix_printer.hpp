@@ -2,15 +2,15 @@
 
 #include <iostream>
 #include <iomanip>
-#include <map>
 #include <string>
 #include <vector>
 
 #include "../core/price_series.hpp"
+#include "../core/universe.hpp"
 
 class MatrixPrinter {
 public:
-    static void print(const std::map<std::string, PriceSeries>& data);
+    static void print(const Universe& data);
 
     static void print(const std::vector<std::vector<double>>& matrix) {
         for (const auto& row : matrix) {
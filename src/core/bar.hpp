@@ -0,0 +1,14 @@
+#pragma once
+
+#include <cstdint>
+
+// One OHLCV bar. `timestamp` is epoch milliseconds (see utils/timestamp.hpp).
+struct Bar
+{
+    int64_t timestamp = 0;
+    double open = 0.0;
+    double high = 0.0;
+    double low = 0.0;
+    double close = 0.0;
+    double volume = 0.0;
+};
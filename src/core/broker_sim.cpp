@@ -0,0 +1,264 @@
+#include "core/broker_sim.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace BrokerSim
+{
+    double FillModel::executionPrice(Side side, double reference) const
+    {
+        double slip = reference * slippageBps / 10000.0;
+        return side == Side::Buy ? reference + slip : reference - slip;
+    }
+
+    double FillModel::commission(double quantity) const
+    {
+        if (quantity <= 0.0)
+            return 0.0;
+        return std::max(minCommission, quantity * commissionPerShare);
+    }
+
+    void Ledger::resize(size_t symbols)
+    {
+        positions_.resize(symbols, 0.0);
+        avgCost_.resize(symbols, 0.0);
+    }
+
+    void Ledger::apply(const Fill &fill)
+    {
+        double signedQty = fill.side == Side::Buy ? fill.quantity : -fill.quantity;
+        double &pos = positions_[fill.symbol];
+        double &avg = avgCost_[fill.symbol];
+
+        if (pos == 0.0 || (pos > 0.0) == (signedQty > 0.0))
+        {
+            // Opening or adding: blend the average cost.
+            double total = std::abs(pos) + fill.quantity;
+            avg = (std::abs(pos) * avg + fill.quantity * fill.price) / total;
+            pos += signedQty;
+        }
+        else
+        {
+            // Reducing, closing or flipping.
+            double closing = std::min(fill.quantity, std::abs(pos));
+            realized_ += closing * (fill.price - avg) * (pos > 0.0 ? 1.0 : -1.0);
+            double before = pos;
+            pos += signedQty;
+            if (pos == 0.0)
+                avg = 0.0;
+            else if ((pos > 0.0) != (before > 0.0))
+                avg = fill.price;
+        }
+
+        cash_ -= signedQty * fill.price + fill.commission;
+        commissions_ += fill.commission;
+    }
+
+    double Ledger::equity(const std::vector<double> &marks) const
+    {
+        double value = cash_;
+        for (size_t i = 0; i < positions_.size() && i < marks.size(); ++i)
+            value += positions_[i] * marks[i];
+        return value;
+    }
+
+    Simulator::Simulator(double initialCash, FillModel model)
+        : model_(model), ledger_(initialCash) {}
+
+    uint32_t Simulator::addSymbol(const std::string &ticker, std::vector<Bar> bars)
+    {
+        for (size_t i = 1; i < bars.size(); ++i)
+        {
+            if (bars[i].timestamp < bars[i - 1].timestamp)
+                throw std::invalid_argument("Bars for " + ticker + " must be sorted by timestamp.");
+        }
+
+        uint32_t id = static_cast<uint32_t>(tickers_.size());
+        tickers_.push_back(ticker);
+        bars_.push_back(std::move(bars));
+        cursors_.push_back(0);
+        marks_.push_back(0.0);
+        working_.push_back(nullptr);
+        ledger_.resize(tickers_.size());
+        return id;
+    }
+
+    void Simulator::schedule(int64_t time, EventType type, uint32_t symbol, Order *order)
+    {
+        queue_.push(Event{time, seq_++, type, symbol, order});
+    }
+
+    void Simulator::scheduleNextBar(uint32_t symbol)
+    {
+        const auto &bars = bars_[symbol];
+        size_t cursor = cursors_[symbol];
+        if (cursor < bars.size())
+            schedule(bars[cursor].timestamp, EventType::Bar, symbol, nullptr);
+    }
+
+    uint64_t Simulator::submitOrder(uint32_t symbol, Side side, double quantity, OrderType type, double limitPrice)
+    {
+        if (symbol >= tickers_.size())
+            throw std::out_of_range("Unknown symbol id.");
+        if (!(quantity > 0.0))
+            throw std::invalid_argument("Order quantity must be positive.");
+        if (type == OrderType::Limit && !(limitPrice > 0.0))
+            throw std::invalid_argument("Limit orders need a positive limit price.");
+
+        Order *order = pool_.acquire();
+        order->id = ordersById_.size() + 1;
+        order->symbol = symbol;
+        order->side = side;
+        order->type = type;
+        order->quantity = quantity;
+        order->limitPrice = limitPrice;
+        order->submitted = now_;
+        ordersById_.push_back(order);
+
+        schedule(now_ + model_.latency, EventType::OrderSubmit, symbol, order);
+        return order->id;
+    }
+
+    bool Simulator::cancelOrder(uint64_t orderId)
+    {
+        if (orderId == 0 || orderId > ordersById_.size())
+            return false;
+        Order *order = ordersById_[orderId - 1];
+        if (!order)
+            return false;
+
+        ordersById_[orderId - 1] = nullptr;
+        if (order->status == OrderStatus::Pending)
+        {
+            // Still referenced by its OrderSubmit event; released when that pops.
+            order->status = OrderStatus::Cancelled;
+            return true;
+        }
+
+        unlinkWorking(order);
+        retire(order, OrderStatus::Cancelled);
+        return true;
+    }
+
+    void Simulator::unlinkWorking(Order *order)
+    {
+        Order **link = &working_[order->symbol];
+        while (*link && *link != order)
+            link = &(*link)->nextWorking;
+        if (*link)
+            *link = order->nextWorking;
+        order->nextWorking = nullptr;
+    }
+
+    void Simulator::retire(Order *order, OrderStatus status)
+    {
+        order->status = status;
+        pool_.release(order);
+    }
+
+    bool Simulator::tryFill(Order &order, const Bar &bar)
+    {
+        double price;
+        if (order.type == OrderType::Market)
+        {
+            price = model_.executionPrice(order.side, bar.open);
+        }
+        else if (order.side == Side::Buy)
+        {
+            if (bar.low > order.limitPrice)
+                return false;
+            price = std::min(model_.executionPrice(order.side, std::min(bar.open, order.limitPrice)), order.limitPrice);
+        }
+        else
+        {
+            if (bar.high < order.limitPrice)
+                return false;
+            price = std::max(model_.executionPrice(order.side, std::max(bar.open, order.limitPrice)), order.limitPrice);
+        }
+
+        Fill fill;
+        fill.orderId = order.id;
+        fill.symbol = order.symbol;
+        fill.side = order.side;
+        fill.quantity = order.quantity;
+        fill.price = price;
+        fill.commission = model_.commission(order.quantity);
+        fill.timestamp = bar.timestamp;
+
+        ledger_.apply(fill);
+        fills_.push_back(fill);
+        return true;
+    }
+
+    void Simulator::matchWorking(uint32_t symbol, const Bar &bar)
+    {
+        Order **link = &working_[symbol];
+        while (*link)
+        {
+            Order *order = *link;
+            if (tryFill(*order, bar))
+            {
+                *link = order->nextWorking;
+                ordersById_[order->id - 1] = nullptr;
+                retire(order, OrderStatus::Filled);
+            }
+            else
+            {
+                link = &order->nextWorking;
+            }
+        }
+    }
+
+    void Simulator::run(const Strategy &onBar)
+    {
+        for (uint32_t s = 0; s < tickers_.size(); ++s)
+            scheduleNextBar(s);
+
+        while (!queue_.empty())
+        {
+            Event ev = queue_.pop();
+            now_ = ev.time;
+            ++eventsProcessed_;
+
+            if (ev.type == EventType::Bar)
+            {
+                const Bar &bar = bars_[ev.symbol][cursors_[ev.symbol]++];
+                matchWorking(ev.symbol, bar);
+                marks_[ev.symbol] = bar.close;
+                if (onBar)
+                    onBar(*this, ev.symbol, bar);
+                scheduleNextBar(ev.symbol);
+            }
+            else
+            {
+                Order *order = ev.order;
+                if (order->status == OrderStatus::Cancelled)
+                {
+                    pool_.release(order);
+                    continue;
+                }
+
+                // Append so orders on a symbol are matched in submission order.
+                order->status = OrderStatus::Working;
+                Order **link = &working_[order->symbol];
+                while (*link)
+                    link = &(*link)->nextWorking;
+                *link = order;
+            }
+        }
+    }
+
+    std::vector<Bar> barsFromCloses(const std::vector<int64_t> &timestamps, const std::vector<double> &closes)
+    {
+        if (timestamps.size() != closes.size())
+            throw std::invalid_argument("Timestamps and closes must have the same length");
+
+        std::vector<Bar> bars(closes.size());
+        for (size_t i = 0; i < closes.size(); ++i)
+        {
+            bars[i].timestamp = timestamps[i];
+            bars[i].open = bars[i].high = bars[i].low = bars[i].close = closes[i];
+        }
+        return bars;
+    }
+}
@@ -0,0 +1,170 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "core/bar.hpp"
+#include "core/event_queue.hpp"
+#include "core/object_pool.hpp"
+
+// Discrete-event paper-trading simulator driven by OHLCV bars.
+//
+// Bars for every symbol are merged through one event queue (one pending bar
+// per symbol, so the heap stays the size of the universe). Orders submitted
+// from the strategy callback become OrderSubmit events, rest on their symbol,
+// and are matched against that symbol's subsequent bars.
+namespace BrokerSim
+{
+    enum class Side : uint8_t
+    {
+        Buy,
+        Sell
+    };
+
+    enum class OrderType : uint8_t
+    {
+        Market,
+        Limit
+    };
+
+    enum class OrderStatus : uint8_t
+    {
+        Pending, // submitted, not yet live (latency)
+        Working,
+        Filled,
+        Cancelled
+    };
+
+    struct Order
+    {
+        uint64_t id = 0;
+        uint32_t symbol = 0;
+        Side side = Side::Buy;
+        OrderType type = OrderType::Market;
+        OrderStatus status = OrderStatus::Pending;
+        double quantity = 0.0;
+        double limitPrice = 0.0;
+        int64_t submitted = 0;
+        Order *nextWorking = nullptr; // intrusive per-symbol list
+    };
+
+    struct Fill
+    {
+        uint64_t orderId = 0;
+        uint32_t symbol = 0;
+        Side side = Side::Buy;
+        double quantity = 0.0;
+        double price = 0.0;
+        double commission = 0.0;
+        int64_t timestamp = 0;
+    };
+
+    struct FillModel
+    {
+        double slippageBps = 0.0;        // applied against the trader
+        double commissionPerShare = 0.0;
+        double minCommission = 0.0;
+        int64_t latency = 0;             // ms between submit and the order going live
+
+        double executionPrice(Side side, double reference) const;
+        double commission(double quantity) const;
+    };
+
+    // Cash and per-symbol positions with average cost and realized P&L.
+    class Ledger
+    {
+    public:
+        explicit Ledger(double initialCash = 0.0) : cash_(initialCash) {}
+
+        void resize(size_t symbols);
+        void apply(const Fill &fill);
+
+        double cash() const { return cash_; }
+        double position(uint32_t symbol) const { return positions_[symbol]; }
+        double averageCost(uint32_t symbol) const { return avgCost_[symbol]; }
+        double realizedPnl() const { return realized_; }
+        double commissions() const { return commissions_; }
+
+        // Cash plus positions marked at `marks[symbol]`.
+        double equity(const std::vector<double> &marks) const;
+
+    private:
+        double cash_;
+        double realized_ = 0.0;
+        double commissions_ = 0.0;
+        std::vector<double> positions_;
+        std::vector<double> avgCost_;
+    };
+
+    class Simulator
+    {
+    public:
+        using Strategy = std::function<void(Simulator &, uint32_t symbol, const Bar &)>;
+
+        explicit Simulator(double initialCash, FillModel model = {});
+
+        uint32_t addSymbol(const std::string &ticker, std::vector<Bar> bars);
+
+        uint64_t submitOrder(uint32_t symbol, Side side, double quantity,
+                             OrderType type = OrderType::Market, double limitPrice = 0.0);
+        bool cancelOrder(uint64_t orderId);
+
+        void run(const Strategy &onBar);
+
+        int64_t now() const { return now_; }
+        const Ledger &ledger() const { return ledger_; }
+        const std::vector<Fill> &fills() const { return fills_; }
+        const std::vector<double> &marks() const { return marks_; }
+        const std::string &ticker(uint32_t symbol) const { return tickers_[symbol]; }
+        size_t symbolCount() const { return tickers_.size(); }
+        size_t workingOrders() const { return pool_.live(); }
+        uint64_t eventsProcessed() const { return eventsProcessed_; }
+
+    private:
+        enum class EventType : uint8_t
+        {
+            Bar,
+            OrderSubmit
+        };
+
+        struct Event
+        {
+            int64_t time;
+            uint64_t seq;
+            EventType type;
+            uint32_t symbol;
+            Order *order;
+        };
+
+        void schedule(int64_t time, EventType type, uint32_t symbol, Order *order);
+        void scheduleNextBar(uint32_t symbol);
+        void matchWorking(uint32_t symbol, const Bar &bar);
+        bool tryFill(Order &order, const Bar &bar);
+        void unlinkWorking(Order *order);
+        void retire(Order *order, OrderStatus status);
+
+        FillModel model_;
+        Ledger ledger_;
+
+        std::vector<std::string> tickers_;
+        std::vector<std::vector<Bar>> bars_;
+        std::vector<size_t> cursors_;
+        std::vector<double> marks_;
+        std::vector<Order *> working_; // head of each symbol's working list
+
+        EventQueue<Event> queue_;
+        ObjectPool<Order> pool_;
+        std::vector<Order *> ordersById_; // null once filled/cancelled
+        std::vector<Fill> fills_;
+
+        int64_t now_ = 0;
+        uint64_t seq_ = 0;
+        uint64_t eventsProcessed_ = 0;
+    };
+
+    // Convenience for daily close-only data (open = high = low = close).
+    std::vector<Bar> barsFromCloses(const std::vector<int64_t> &timestamps, const std::vector<double> &closes);
+}
@@ -0,0 +1,152 @@
+#include "core/corporate_actions.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+namespace CorporateActions
+{
+    double eventMultiplier(double previousClose, const CorporateAction &action)
+    {
+        if (action.splitFactor <= 0.0)
+            throw std::invalid_argument("Split factor must be positive.");
+
+        double multiplier = 1.0 / action.splitFactor;
+        if (action.dividend != 0.0)
+        {
+            // Dividend is paid per post-split share, so compare against the
+            // split-adjusted previous close.
+            double adjustedPrev = previousClose / action.splitFactor;
+            if (adjustedPrev <= 0.0)
+                throw std::invalid_argument("Previous close must be positive to adjust for a dividend.");
+            multiplier *= 1.0 - action.dividend / adjustedPrev;
+        }
+        return multiplier;
+    }
+
+    std::vector<double> computeAdjustmentFactors(const std::vector<double> &rawCloses,
+                                                 const std::vector<CorporateAction> &actions)
+    {
+        const size_t n = rawCloses.size();
+        std::vector<double> factors(n, 1.0);
+        if (n == 0)
+            return factors;
+
+        // multipliers[t] is applied to every bar strictly before t.
+        std::vector<double> multipliers(n, 1.0);
+        for (const auto &a : actions)
+        {
+            if (a.index >= n)
+                throw std::out_of_range("Corporate action index beyond series length.");
+            if (a.index == 0)
+                continue; // nothing earlier to adjust
+            multipliers[a.index] *= eventMultiplier(rawCloses[a.index - 1], a);
+        }
+
+        for (size_t i = n - 1; i-- > 0;)
+            factors[i] = factors[i + 1] * multipliers[i + 1];
+
+        return factors;
+    }
+}
+
+AdjustedHistory::AdjustedHistory(const std::string &ticker) : ticker_(ticker) {}
+
+AdjustedHistory::AdjustedHistory(const std::string &ticker,
+                                 std::vector<std::string> dates,
+                                 std::vector<double> rawCloses,
+                                 std::vector<CorporateAction> actions)
+    : ticker_(ticker), dates_(std::move(dates)), rawCloses_(std::move(rawCloses)), actions_(std::move(actions))
+{
+    if (dates_.size() != rawCloses_.size())
+        throw std::invalid_argument("Dates and prices must have the same length");
+
+    std::sort(actions_.begin(), actions_.end(),
+              [](const CorporateAction &a, const CorporateAction &b) { return a.index < b.index; });
+    recompute();
+}
+
+void AdjustedHistory::recompute()
+{
+    factors_ = CorporateActions::computeAdjustmentFactors(rawCloses_, actions_);
+}
+
+void AdjustedHistory::appendBar(const std::string &date, double rawClose, double dividend, double splitFactor)
+{
+    const bool isEvent = dividend != 0.0 || splitFactor != 1.0;
+    const CorporateAction action{rawCloses_.size(), dividend, splitFactor};
+
+    // Validate before touching any member, so a rejected event leaves the
+    // history as it was.
+    double m = 1.0;
+    if (isEvent)
+    {
+        if (splitFactor <= 0.0)
+            throw std::invalid_argument("Split factor must be positive.");
+        if (action.index > 0)
+            m = CorporateActions::eventMultiplier(rawCloses_.back(), action);
+    }
+
+    dates_.push_back(date);
+    rawCloses_.push_back(rawClose);
+    factors_.push_back(1.0);
+    if (!isEvent)
+        return;
+    actions_.push_back(action);
+
+    // Only bars before the new event change, and all by the same multiplier.
+    for (size_t i = 0; i < action.index; ++i)
+        factors_[i] *= m;
+}
+
+void AdjustedHistory::setAction(size_t index, double dividend, double splitFactor)
+{
+    if (index >= rawCloses_.size())
+        throw std::out_of_range("Corporate action index beyond series length.");
+
+    auto it = std::lower_bound(actions_.begin(), actions_.end(), index,
+                               [](const CorporateAction &a, size_t i) { return a.index < i; });
+    bool isEvent = dividend != 0.0 || splitFactor != 1.0;
+    if (isEvent)
+    {
+        if (splitFactor <= 0.0)
+            throw std::invalid_argument("Split factor must be positive.");
+        if (index > 0)
+            CorporateActions::eventMultiplier(rawCloses_[index - 1], CorporateAction{index, dividend, splitFactor});
+    }
+
+    if (it != actions_.end() && it->index == index)
+    {
+        if (isEvent)
+        {
+            it->dividend = dividend;
+            it->splitFactor = splitFactor;
+        }
+        else
+        {
+            actions_.erase(it);
+        }
+    }
+    else if (isEvent)
+    {
+        actions_.insert(it, CorporateAction{index, dividend, splitFactor});
+    }
+
+    recompute();
+}
+
+std::vector<double> AdjustedHistory::getAdjustedCloses() const
+{
+    std::vector<double> adjusted(rawCloses_.size());
+    for (size_t i = 0; i < rawCloses_.size(); ++i)
+        adjusted[i] = rawCloses_[i] * factors_[i];
+    return adjusted;
+}
+
+PriceSeries AdjustedHistory::toPriceSeries() const
+{
+    return PriceSeries(ticker_, dates_, getAdjustedCloses());
+}
+
+PriceSeries AdjustedHistory::toRawPriceSeries() const
+{
+    return PriceSeries(ticker_, dates_, rawCloses_);
+}
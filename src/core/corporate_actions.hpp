@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "core/price_series.hpp"
+
+// A dividend and/or split taking effect on bar `index` (the ex-date).
+struct CorporateAction
+{
+    size_t index = 0;
+    double dividend = 0.0;    // Tiingo `divCash`
+    double splitFactor = 1.0; // Tiingo `splitFactor`
+};
+
+namespace CorporateActions
+{
+    // Backward cumulative adjustment factors: adjusted[i] = raw[i] * factors[i].
+    // One pass builds the per-bar multipliers, a reverse scan turns them into a
+    // suffix product, so cost is O(n) regardless of how many events there are.
+    std::vector<double> computeAdjustmentFactors(const std::vector<double> &rawCloses,
+                                                 const std::vector<CorporateAction> &actions);
+
+    // Multiplier an event applies to every bar before it.
+    double eventMultiplier(double previousClose, const CorporateAction &action);
+}
+
+// Raw (unadjusted) closes plus the corporate actions reported alongside them.
+// Adjusted prices are derived locally, so a new dividend or a revised split is
+// an event append and an O(n) rescale instead of a full re-download.
+class AdjustedHistory
+{
+public:
+    explicit AdjustedHistory(const std::string &ticker = "");
+    AdjustedHistory(const std::string &ticker,
+                    std::vector<std::string> dates,
+                    std::vector<double> rawCloses,
+                    std::vector<CorporateAction> actions = {});
+
+    // Appends a bar; a dividend or split on it rescales all earlier factors.
+    void appendBar(const std::string &date, double rawClose, double dividend = 0.0, double splitFactor = 1.0);
+
+    // Records (or revises) the event on an existing bar and recomputes factors.
+    void setAction(size_t index, double dividend, double splitFactor);
+
+    const std::string &getTicker() const { return ticker_; }
+    const std::vector<std::string> &getDates() const { return dates_; }
+    const std::vector<double> &getRawCloses() const { return rawCloses_; }
+    const std::vector<CorporateAction> &getActions() const { return actions_; }
+    const std::vector<double> &getAdjustmentFactors() const { return factors_; }
+
+    std::vector<double> getAdjustedCloses() const;
+    PriceSeries toPriceSeries() const;
+    PriceSeries toRawPriceSeries() const;
+
+    size_t size() const { return rawCloses_.size(); }
+
+private:
+    void recompute();
+
+    std::string ticker_;
+    std::vector<std::string> dates_;
+    std::vector<double> rawCloses_;
+    std::vector<CorporateAction> actions_; // sorted by index
+    std::vector<double> factors_;
+};
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cstddef>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+// Binary min-heap stored in one flat vector, ordered by (time, seq).
+// `seq` breaks ties so events at the same timestamp pop in insertion order,
+// which keeps simulations deterministic.
+template <typename Event>
+class EventQueue
+{
+public:
+    void reserve(size_t n) { heap_.reserve(n); }
+    bool empty() const { return heap_.empty(); }
+    size_t size() const { return heap_.size(); }
+    void clear() { heap_.clear(); }
+
+    const Event &top() const
+    {
+        if (heap_.empty())
+            throw std::out_of_range("EventQueue is empty");
+        return heap_.front();
+    }
+
+    void push(const Event &event)
+    {
+        heap_.push_back(event);
+        siftUp(heap_.size() - 1);
+    }
+
+    Event pop()
+    {
+        if (heap_.empty())
+            throw std::out_of_range("EventQueue is empty");
+        Event result = heap_.front();
+        heap_.front() = heap_.back();
+        heap_.pop_back();
+        if (!heap_.empty())
+            siftDown(0);
+        return result;
+    }
+
+private:
+    static bool before(const Event &a, const Event &b)
+    {
+        return a.time < b.time || (a.time == b.time && a.seq < b.seq);
+    }
+
+    void siftUp(size_t i)
+    {
+        Event moving = heap_[i];
+        while (i > 0)
+        {
+            size_t parent = (i - 1) / 2;
+            if (!before(moving, heap_[parent]))
+                break;
+            heap_[i] = heap_[parent];
+            i = parent;
+        }
+        heap_[i] = moving;
+    }
+
+    void siftDown(size_t i)
+    {
+        const size_t n = heap_.size();
+        Event moving = heap_[i];
+        while (true)
+        {
+            size_t child = 2 * i + 1;
+            if (child >= n)
+                break;
+            if (child + 1 < n && before(heap_[child + 1], heap_[child]))
+                ++child;
+            if (!before(heap_[child], moving))
+                break;
+            heap_[i] = heap_[child];
+            i = child;
+        }
+        heap_[i] = moving;
+    }
+
+    std::vector<Event> heap_;
+};
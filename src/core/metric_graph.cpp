@@ -0,0 +1,538 @@
+#include "core/metric_graph.hpp"
+#include "../utils/codec.hpp"
+#include "../utils/instrumentation.hpp"
+#include "../utils/timestamp.hpp"
+
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <limits>
+
+namespace fs = std::filesystem;
+
+namespace MetricGraph
+{
+    namespace
+    {
+        constexpr uint32_t kCheckpointMagic = 0x47514954; // "TIQG"
+        constexpr uint32_t kCheckpointVersion = 1;
+
+        constexpr double kNaN = std::numeric_limits<double>::quiet_NaN();
+    }
+
+    void Writer::string(std::string_view s)
+    {
+        pod(static_cast<uint16_t>(s.size()));
+        out_.append(s.data(), s.size());
+    }
+
+    void Reader::take(void *dst, size_t size)
+    {
+        if (static_cast<size_t>(end_ - cursor_) < size)
+            throw std::runtime_error("Metric graph checkpoint is truncated");
+        if (size)
+            std::memcpy(dst, cursor_, size);
+        cursor_ += size;
+    }
+
+    std::string Reader::string()
+    {
+        std::string s(pod<uint16_t>(), '\0');
+        take(s.data(), s.size());
+        return s;
+    }
+
+    Node::Node(std::string name, std::vector<std::string> inputs) : name_(std::move(name)), inputs_(std::move(inputs))
+    {
+        if (name_.empty())
+            throw std::invalid_argument("Metric graph node needs a name.");
+    }
+
+    // ---- nodes --------------------------------------------------------------
+
+    void Prices::bind(const Graph &graph)
+    {
+        values_.assign(graph.tickers().size(), kNaN);
+    }
+
+    Returns::Returns(std::string name, std::string prices) : Node(std::move(name), {std::move(prices)}) {}
+
+    void Returns::bind(const Graph &graph)
+    {
+        prices_ = &graph.node(inputs()[0]);
+        values_.assign(graph.tickers().size(), kNaN);
+        previous_.assign(graph.tickers().size(), kNaN);
+    }
+
+    void Returns::append()
+    {
+        if (!prices_->ready())
+            return;
+        const std::vector<double> &p = prices_->values();
+        if (havePrevious_)
+        {
+            for (size_t i = 0; i < p.size(); ++i)
+                values_[i] = (p[i] - previous_[i]) / previous_[i];
+            ready_ = true;
+        }
+        previous_ = p;
+        havePrevious_ = true;
+    }
+
+    void Returns::save(Writer &out) const
+    {
+        out.pod(static_cast<uint8_t>(havePrevious_));
+        out.vector(previous_);
+    }
+
+    void Returns::load(Reader &in)
+    {
+        havePrevious_ = in.pod<uint8_t>() != 0;
+        in.vector(previous_, values_.size());
+    }
+
+    WealthIndex::WealthIndex(std::string name, std::string returns) : Node(std::move(name), {std::move(returns)}) {}
+
+    void WealthIndex::bind(const Graph &graph)
+    {
+        returns_ = &graph.node(inputs()[0]);
+        values_.assign(graph.tickers().size(), 1.0);
+        ready_ = true;
+    }
+
+    void WealthIndex::append()
+    {
+        if (!returns_->ready())
+            return;
+        const std::vector<double> &r = returns_->values();
+        for (size_t i = 0; i < r.size(); ++i)
+            values_[i] *= 1.0 + r[i];
+    }
+
+    RollingVolatility::RollingVolatility(std::string name, size_t window, std::string returns)
+        : Node(std::move(name), {std::move(returns)}), window_(window)
+    {
+        if (window < 2)
+            throw std::invalid_argument("Rolling volatility needs a window of at least 2.");
+    }
+
+    void RollingVolatility::bind(const Graph &graph)
+    {
+        returns_ = &graph.node(inputs()[0]);
+        tickers_ = graph.tickers().size();
+        values_.assign(tickers_, kNaN);
+        ring_.assign(window_ * tickers_, 0.0);
+        shift_.assign(tickers_, 0.0);
+        s1_.assign(tickers_, 0.0);
+        s2_.assign(tickers_, 0.0);
+    }
+
+    void RollingVolatility::rebuild()
+    {
+        // Oldest row first, so the sums round like the batch kernel.
+        std::fill(shift_.begin(), shift_.end(), 0.0);
+        for (size_t j = 0, k = head_; j < window_; ++j, k = k + 1 == window_ ? 0 : k + 1)
+            for (size_t i = 0; i < tickers_; ++i)
+                shift_[i] += ring_[k * tickers_ + i];
+        for (size_t i = 0; i < tickers_; ++i)
+            shift_[i] /= static_cast<double>(window_);
+
+        std::fill(s1_.begin(), s1_.end(), 0.0);
+        std::fill(s2_.begin(), s2_.end(), 0.0);
+        for (size_t j = 0, k = head_; j < window_; ++j, k = k + 1 == window_ ? 0 : k + 1)
+            for (size_t i = 0; i < tickers_; ++i)
+            {
+                const double d = ring_[k * tickers_ + i] - shift_[i];
+                s1_[i] += d;
+                s2_[i] += d * d;
+            }
+        untilRebuild_ = window_ - 1;
+    }
+
+    void RollingVolatility::append()
+    {
+        if (!returns_->ready())
+            return;
+        const std::vector<double> &r = returns_->values();
+        double *row = ring_.data() + head_ * tickers_;
+
+        // Slide the sums before the oldest row is overwritten, except on the
+        // bar that fills the window and every `window` bars after it, which
+        // rebuild them from the ring instead.
+        const bool full = filled_ + 1 >= window_;
+        const bool slide = filled_ >= window_ && untilRebuild_ > 0;
+        if (slide)
+            for (size_t i = 0; i < tickers_; ++i)
+            {
+                const double added = r[i] - shift_[i], gone = row[i] - shift_[i];
+                s1_[i] += added - gone;
+                s2_[i] += (added - gone) * (added + gone);
+            }
+        std::copy(r.begin(), r.end(), row);
+        head_ = head_ + 1 == window_ ? 0 : head_ + 1;
+        ++filled_;
+        if (!full)
+            return;
+        if (slide)
+            --untilRebuild_;
+        else
+            rebuild();
+
+        const double width = static_cast<double>(window_);
+        for (size_t i = 0; i < tickers_; ++i)
+        {
+            const double m2 = s2_[i] - s1_[i] * s1_[i] / width;
+            values_[i] = std::sqrt((m2 > 0.0 ? m2 : 0.0) / (width - 1.0));
+        }
+        ready_ = true;
+    }
+
+    void RollingVolatility::save(Writer &out) const
+    {
+        out.pod(static_cast<uint64_t>(window_));
+        out.pod(head_);
+        out.pod(filled_);
+        out.pod(untilRebuild_);
+        out.vector(ring_);
+        out.vector(shift_);
+        out.vector(s1_);
+        out.vector(s2_);
+    }
+
+    void RollingVolatility::load(Reader &in)
+    {
+        if (in.pod<uint64_t>() != window_)
+            throw std::runtime_error("Metric graph checkpoint has another window for " + name());
+        head_ = in.pod<uint64_t>();
+        filled_ = in.pod<uint64_t>();
+        untilRebuild_ = in.pod<uint64_t>();
+        if (head_ >= window_ || untilRebuild_ >= window_)
+            throw std::runtime_error("Metric graph checkpoint is corrupt");
+        in.vector(ring_, window_ * tickers_);
+        in.vector(shift_, tickers_);
+        in.vector(s1_, tickers_);
+        in.vector(s2_, tickers_);
+    }
+
+    DrawdownState::DrawdownState(std::string name, std::string wealth) : Node(std::move(name), {std::move(wealth)}) {}
+
+    void DrawdownState::bind(const Graph &graph)
+    {
+        wealth_ = &graph.node(inputs()[0]);
+        values_.assign(graph.tickers().size(), kNaN);
+        peak_.assign(graph.tickers().size(), kNaN);
+        current_.assign(graph.tickers().size(), kNaN);
+    }
+
+    void DrawdownState::append()
+    {
+        if (!wealth_->ready())
+            return;
+        const std::vector<double> &w = wealth_->values();
+        if (!ready_)
+        {
+            peak_ = w;
+            std::fill(current_.begin(), current_.end(), 0.0);
+            std::fill(values_.begin(), values_.end(), 0.0);
+            ready_ = true;
+            return;
+        }
+        for (size_t i = 0; i < w.size(); ++i)
+        {
+            if (w[i] > peak_[i])
+                peak_[i] = w[i];
+            current_[i] = (peak_[i] - w[i]) / peak_[i];
+            if (current_[i] > values_[i])
+                values_[i] = current_[i];
+        }
+    }
+
+    void DrawdownState::save(Writer &out) const
+    {
+        out.vector(peak_);
+        out.vector(current_);
+    }
+
+    void DrawdownState::load(Reader &in)
+    {
+        in.vector(peak_, values_.size());
+        in.vector(current_, values_.size());
+    }
+
+    Covariance::Covariance(std::string name, std::string returns, bool sample)
+        : Node(std::move(name), {std::move(returns)}), sample_(sample)
+    {
+    }
+
+    void Covariance::bind(const Graph &graph)
+    {
+        returns_ = &graph.node(inputs()[0]);
+        tickers_ = graph.tickers().size();
+        values_.assign(tickers_, kNaN);
+        mean_.assign(tickers_, 0.0);
+        delta_.assign(tickers_, 0.0);
+        comoment_.assign(tickers_ * (tickers_ + 1) / 2, 0.0);
+    }
+
+    void Covariance::append()
+    {
+        if (!returns_->ready())
+            return;
+        const std::vector<double> &r = returns_->values();
+        ++count_;
+        const double n = static_cast<double>(count_);
+        // C_ij += (x_i - old mean_i) * (x_j - new mean_j)
+        for (size_t i = 0; i < tickers_; ++i)
+        {
+            delta_[i] = r[i] - mean_[i];
+            mean_[i] += delta_[i] / n;
+        }
+        double *c = comoment_.data();
+        for (size_t i = 0; i < tickers_; ++i)
+        {
+            const double di = delta_[i];
+            for (size_t j = i; j < tickers_; ++j)
+                *c++ += di * (r[j] - mean_[j]);
+        }
+
+        const uint64_t minimum = sample_ ? 2 : 1;
+        if (count_ < minimum)
+            return;
+        const double denom = sample_ ? n - 1.0 : n;
+        size_t diag = 0;
+        for (size_t i = 0; i < tickers_; ++i)
+        {
+            values_[i] = comoment_[diag] / denom;
+            diag += tickers_ - i;
+        }
+        ready_ = true;
+    }
+
+    std::vector<std::vector<double>> Covariance::matrix() const
+    {
+        std::vector<std::vector<double>> result(tickers_, std::vector<double>(tickers_, kNaN));
+        if (!ready_)
+            return result;
+        const double denom = static_cast<double>(sample_ ? count_ - 1 : count_);
+        const double *c = comoment_.data();
+        for (size_t i = 0; i < tickers_; ++i)
+            for (size_t j = i; j < tickers_; ++j)
+                result[i][j] = result[j][i] = *c++ / denom;
+        return result;
+    }
+
+    void Covariance::save(Writer &out) const
+    {
+        out.pod(static_cast<uint8_t>(sample_));
+        out.pod(count_);
+        out.vector(mean_);
+        out.vector(comoment_);
+    }
+
+    void Covariance::load(Reader &in)
+    {
+        if ((in.pod<uint8_t>() != 0) != sample_)
+            throw std::runtime_error("Metric graph checkpoint has another estimator for " + name());
+        count_ = in.pod<uint64_t>();
+        in.vector(mean_, tickers_);
+        in.vector(comoment_, tickers_ * (tickers_ + 1) / 2);
+    }
+
+    // ---- graph --------------------------------------------------------------
+
+    Graph::Graph(std::vector<std::string> tickers) : tickers_(std::move(tickers))
+    {
+        if (tickers_.empty())
+            throw std::invalid_argument("Metric graph needs at least one ticker.");
+        prices_ = &emplace<Prices>();
+    }
+
+    Graph Graph::standard(std::vector<std::string> tickers, const std::vector<size_t> &volWindows, bool covariance)
+    {
+        Graph graph(std::move(tickers));
+        graph.emplace<Returns>();
+        graph.emplace<WealthIndex>();
+        graph.emplace<DrawdownState>();
+        for (size_t w : volWindows)
+            graph.emplace<RollingVolatility>("rolling_vol_" + std::to_string(w), w);
+        if (covariance)
+            graph.emplace<Covariance>();
+        return graph;
+    }
+
+    Node &Graph::add(std::unique_ptr<Node> node)
+    {
+        if (!node)
+            throw std::invalid_argument("Metric graph cannot add a null node.");
+        if (bars_ > 0)
+            throw std::invalid_argument("Metric graph nodes must be added before the first bar.");
+        for (const auto &existing : nodes_)
+            if (existing->name() == node->name())
+                throw std::invalid_argument("Metric graph already has a node named " + node->name());
+        for (const auto &input : node->inputs())
+            this->node(input); // throws on an input that is not in the graph yet
+
+        node->bind(*this);
+        nodes_.push_back(std::move(node));
+        return *nodes_.back();
+    }
+
+    const Node &Graph::node(std::string_view name) const
+    {
+        for (const auto &n : nodes_)
+            if (n->name() == name)
+                return *n;
+        throw std::invalid_argument("Metric graph has no node named " + std::string(name));
+    }
+
+    void Graph::append(int64_t day, const std::vector<double> &closes)
+    {
+        if (closes.size() != tickers_.size())
+            throw std::invalid_argument("Metric graph bar needs one close per ticker.");
+        if (bars_ > 0 && day <= lastDay_)
+            throw std::invalid_argument("Metric graph bars must be appended in date order.");
+        for (double p : closes)
+            if (!(p > 0.0) || !std::isfinite(p))
+                throw std::invalid_argument("Metric graph closes must be positive and finite.");
+
+        prices_->values_ = closes;
+        prices_->ready_ = true;
+        for (size_t i = 1; i < nodes_.size(); ++i)
+            nodes_[i]->append();
+        ++bars_;
+        lastDay_ = day;
+    }
+
+    size_t Graph::update(const std::vector<PriceSeries> &aligned)
+    {
+        TRADEIQ_TIMED_SCOPE("metric_graph.update");
+        if (aligned.size() != tickers_.size())
+            throw std::invalid_argument("Metric graph update needs one series per ticker.");
+        const size_t length = aligned[0].getPrices().size();
+        for (size_t i = 0; i < aligned.size(); ++i)
+            if (aligned[i].getTicker() != tickers_[i] || aligned[i].getPrices().size() != length ||
+                aligned[i].getDates().size() != length)
+                throw std::invalid_argument("Metric graph update needs dated series aligned to the graph's tickers.");
+
+        const auto &dates = aligned[0].getDates();
+        size_t appended = 0;
+        std::vector<double> closes(tickers_.size());
+        for (size_t t = 0; t < length; ++t)
+        {
+            const int64_t day = Timestamp::parseEpochDays(dates[t]);
+            if (bars_ > 0 && day <= lastDay_)
+                continue;
+            for (size_t i = 0; i < aligned.size(); ++i)
+                closes[i] = aligned[i].getPrices()[t];
+            append(day, closes);
+            ++appended;
+        }
+        return appended;
+    }
+
+    void Graph::writeState(Writer &out) const
+    {
+        out.pod(static_cast<uint32_t>(tickers_.size()));
+        for (const auto &ticker : tickers_)
+            out.string(ticker);
+        out.pod(static_cast<uint64_t>(bars_));
+        out.pod(lastDay_);
+        out.pod(static_cast<uint32_t>(nodes_.size()));
+        for (const auto &n : nodes_)
+        {
+            out.string(n->name());
+            out.string(n->kind());
+            out.pod(static_cast<uint8_t>(n->ready_));
+            out.vector(n->values_);
+            n->save(out);
+        }
+    }
+
+    void Graph::readState(Reader &in)
+    {
+        if (in.pod<uint32_t>() != tickers_.size())
+            throw std::runtime_error("Metric graph checkpoint has other tickers");
+        for (const auto &ticker : tickers_)
+            if (in.string() != ticker)
+                throw std::runtime_error("Metric graph checkpoint has other tickers");
+        const uint64_t bars = in.pod<uint64_t>();
+        const int64_t lastDay = in.pod<int64_t>();
+        if (in.pod<uint32_t>() != nodes_.size())
+            throw std::runtime_error("Metric graph checkpoint has other nodes");
+        for (const auto &n : nodes_)
+        {
+            if (in.string() != n->name() || in.string() != n->kind())
+                throw std::runtime_error("Metric graph checkpoint has other nodes");
+            n->ready_ = in.pod<uint8_t>() != 0;
+            in.vector(n->values_, tickers_.size());
+            n->load(in);
+        }
+        if (!in.done())
+            throw std::runtime_error("Metric graph checkpoint has trailing data");
+        bars_ = static_cast<size_t>(bars);
+        lastDay_ = lastDay;
+    }
+
+    void Graph::saveCheckpoint(const std::string &path) const
+    {
+        TRADEIQ_TIMED_SCOPE("metric_graph.save");
+        std::string bytes;
+        Writer out(bytes);
+        out.pod(kCheckpointMagic);
+        out.pod(kCheckpointVersion);
+        writeState(out);
+        out.pod(Codec::checksum(bytes.data(), bytes.size()));
+
+        const std::string tmp = path + ".tmp";
+        {
+            std::ofstream file(tmp, std::ios::binary | std::ios::trunc);
+            if (!file)
+                throw std::runtime_error("Cannot write metric graph checkpoint: " + tmp);
+            file.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+            if (!file)
+                throw std::runtime_error("Cannot write metric graph checkpoint: " + tmp);
+        }
+        fs::rename(tmp, path);
+    }
+
+    void Graph::loadCheckpoint(const std::string &path)
+    {
+        TRADEIQ_TIMED_SCOPE("metric_graph.load");
+        std::ifstream file(path, std::ios::binary);
+        if (!file)
+            throw std::runtime_error("Cannot read metric graph checkpoint: " + path);
+        const std::string bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+        constexpr size_t kHeader = 2 * sizeof(uint32_t), kTrailer = sizeof(uint64_t);
+        if (bytes.size() < kHeader + kTrailer)
+            throw std::runtime_error("Metric graph checkpoint is truncated");
+        Reader header(bytes.data(), kHeader);
+        if (header.pod<uint32_t>() != kCheckpointMagic)
+            throw std::runtime_error("Not a metric graph checkpoint: " + path);
+        if (header.pod<uint32_t>() != kCheckpointVersion)
+            throw std::runtime_error("Unsupported metric graph checkpoint version: " + path);
+        const size_t body = bytes.size() - kTrailer;
+        Reader trailer(bytes.data() + body, kTrailer);
+        if (trailer.pod<uint64_t>() != Codec::checksum(bytes.data(), body))
+            throw std::runtime_error("Metric graph checkpoint is corrupt: " + path);
+
+        // Nodes are validated as they load; keep the current state to put back
+        // if a later one does not match.
+        std::string backup;
+        Writer saved(backup);
+        writeState(saved);
+        try
+        {
+            Reader in(bytes.data() + kHeader, body - kHeader);
+            readState(in);
+        }
+        catch (...)
+        {
+            Reader restore(backup.data(), backup.size());
+            readState(restore);
+            throw;
+        }
+    }
+}
@@ -0,0 +1,332 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "core/price_series.hpp"
+
+// Derived metrics over a fixed panel of tickers, maintained one bar at a time.
+//
+// A Graph holds nodes that each derive per-ticker state from the nodes they
+// name as inputs: prices -> returns -> wealth index -> drawdown state, and
+// returns -> rolling volatility / covariance. A node can only be added once
+// its inputs exist, so insertion order is a topological order and cycles
+// cannot be built. append() pushes one cross-section of closes through every
+// node in that order. Nodes keep running state rather than history, so a bar
+// costs O(N) for N tickers however long the panel already is (O(N^2) for
+// covariance, which has N^2 outputs).
+//
+// saveCheckpoint() writes the state of every node to one file and
+// loadCheckpoint() restores it into a graph built the same way, so a restart
+// continues from the next bar instead of replaying the history.
+namespace MetricGraph
+{
+    class Graph;
+
+    // Checkpoint byte stream: raw PODs and length-prefixed vectors.
+    class Writer
+    {
+    public:
+        explicit Writer(std::string &out) : out_(out) {}
+
+        template <typename T>
+        void pod(const T &value)
+        {
+            out_.append(reinterpret_cast<const char *>(&value), sizeof(T));
+        }
+
+        template <typename T>
+        void vector(const std::vector<T> &values)
+        {
+            pod(static_cast<uint64_t>(values.size()));
+            out_.append(reinterpret_cast<const char *>(values.data()), values.size() * sizeof(T));
+        }
+
+        void string(std::string_view s);
+
+    private:
+        std::string &out_;
+    };
+
+    // Throws std::runtime_error when the stream is truncated or a vector does
+    // not have the size the reader expects.
+    class Reader
+    {
+    public:
+        Reader(const char *data, size_t size) : cursor_(data), end_(data + size) {}
+
+        template <typename T>
+        T pod()
+        {
+            T value{};
+            take(&value, sizeof(T));
+            return value;
+        }
+
+        template <typename T>
+        void vector(std::vector<T> &values, size_t expected)
+        {
+            if (pod<uint64_t>() != expected)
+                throw std::runtime_error("Metric graph checkpoint does not match the graph");
+            values.resize(expected);
+            take(values.data(), expected * sizeof(T));
+        }
+
+        std::string string();
+        bool done() const { return cursor_ == end_; }
+
+    private:
+        void take(void *dst, size_t size);
+
+        const char *cursor_;
+        const char *end_;
+    };
+
+    class Node
+    {
+    public:
+        Node(std::string name, std::vector<std::string> inputs);
+        virtual ~Node() = default;
+
+        Node(const Node &) = delete;
+        Node &operator=(const Node &) = delete;
+
+        const std::string &name() const { return name_; }
+        const std::vector<std::string> &inputs() const { return inputs_; }
+
+        // Type tag stored in checkpoints.
+        virtual const char *kind() const = 0;
+
+        // Latest output, one value per ticker; NaN until ready().
+        const std::vector<double> &values() const { return values_; }
+        bool ready() const { return ready_; }
+
+    protected:
+        friend class Graph;
+
+        // Resolves inputs through Graph::node and sizes the state for the
+        // graph's tickers. Called once, when the node is added.
+        virtual void bind(const Graph &graph) = 0;
+
+        // Consumes the inputs' current values. Inputs have already been
+        // updated for this bar.
+        virtual void append() = 0;
+
+        // Node-specific state; values() and ready() are saved by the graph.
+        virtual void save(Writer &) const {}
+        virtual void load(Reader &) {}
+
+        std::vector<double> values_;
+        bool ready_ = false;
+
+    private:
+        std::string name_;
+        std::vector<std::string> inputs_;
+    };
+
+    // The source node: the closes passed to Graph::append.
+    class Prices : public Node
+    {
+    public:
+        Prices() : Node("prices", {}) {}
+        const char *kind() const override { return "prices"; }
+
+    protected:
+        void bind(const Graph &graph) override;
+        void append() override {}
+    };
+
+    // Simple returns (p[t] - p[t-1]) / p[t-1], as PriceSeries::getDailyReturns.
+    // Ready from the second bar.
+    class Returns : public Node
+    {
+    public:
+        explicit Returns(std::string name = "returns", std::string prices = "prices");
+        const char *kind() const override { return "returns"; }
+
+    protected:
+        void bind(const Graph &graph) override;
+        void append() override;
+        void save(Writer &out) const override;
+        void load(Reader &in) override;
+
+    private:
+        const Node *prices_ = nullptr;
+        std::vector<double> previous_;
+        bool havePrevious_ = false;
+    };
+
+    // Growth of one unit: starts at 1 and compounds each return.
+    class WealthIndex : public Node
+    {
+    public:
+        explicit WealthIndex(std::string name = "wealth", std::string returns = "returns");
+        const char *kind() const override { return "wealth"; }
+
+    protected:
+        void bind(const Graph &graph) override;
+        void append() override;
+
+    private:
+        const Node *returns_ = nullptr;
+    };
+
+    // Sample standard deviation of the last `window` returns, ready once the
+    // window is full; matches Stats::Volatility::computeRollingVolatility.
+    // Keeps the window in a ring and shifted sums that are rebuilt from the
+    // ring every `window` bars, the scheme Kernels::rollingMoments uses, so
+    // rounding error cannot build up over a long history.
+    class RollingVolatility : public Node
+    {
+    public:
+        RollingVolatility(std::string name, size_t window, std::string returns = "returns");
+        const char *kind() const override { return "rolling_volatility"; }
+        size_t window() const { return window_; }
+
+    protected:
+        void bind(const Graph &graph) override;
+        void append() override;
+        void save(Writer &out) const override;
+        void load(Reader &in) override;
+
+    private:
+        void rebuild();
+
+        const Node *returns_ = nullptr;
+        size_t window_;
+        size_t tickers_ = 0;
+        std::vector<double> ring_; // window x tickers, one row per bar
+        std::vector<double> shift_, s1_, s2_;
+        uint64_t head_ = 0, filled_ = 0, untilRebuild_ = 0;
+    };
+
+    // Running peak of a wealth index and the drawdowns from it. values() is
+    // the maximum drawdown so far, as Stats::Drawdowns::computeMaxDrawdown
+    // over the whole index; current() is the drawdown at the latest bar.
+    class DrawdownState : public Node
+    {
+    public:
+        explicit DrawdownState(std::string name = "drawdown", std::string wealth = "wealth");
+        const char *kind() const override { return "drawdown"; }
+
+        const std::vector<double> &peak() const { return peak_; }
+        const std::vector<double> &current() const { return current_; }
+
+    protected:
+        void bind(const Graph &graph) override;
+        void append() override;
+        void save(Writer &out) const override;
+        void load(Reader &in) override;
+
+    private:
+        const Node *wealth_ = nullptr;
+        std::vector<double> peak_, current_;
+    };
+
+    // Expanding-window covariance of returns, updated with Welford's online
+    // co-moments: a bar costs O(N^2) whatever the history length. values()
+    // holds the variances; matrix() the full N x N matrix, matching
+    // Stats::Correlation::computeCovarianceMatrix on the returns so far.
+    // Ready from the second return when `sample`, else from the first.
+    class Covariance : public Node
+    {
+    public:
+        explicit Covariance(std::string name = "covariance", std::string returns = "returns", bool sample = true);
+        const char *kind() const override { return "covariance"; }
+
+        std::vector<std::vector<double>> matrix() const;
+        uint64_t count() const { return count_; }
+
+    protected:
+        void bind(const Graph &graph) override;
+        void append() override;
+        void save(Writer &out) const override;
+        void load(Reader &in) override;
+
+    private:
+        const Node *returns_ = nullptr;
+        bool sample_;
+        size_t tickers_ = 0;
+        uint64_t count_ = 0;
+        std::vector<double> mean_, delta_;
+        std::vector<double> comoment_; // upper triangle, row-major
+    };
+
+    class Graph
+    {
+    public:
+        // Creates the graph with its "prices" source node.
+        explicit Graph(std::vector<std::string> tickers);
+
+        Graph(Graph &&) noexcept = default;
+        Graph &operator=(Graph &&) noexcept = default;
+
+        // prices, returns, wealth, drawdown and one rolling_vol_<w> per window,
+        // plus covariance when asked (it is quadratic in the ticker count).
+        static Graph standard(std::vector<std::string> tickers, const std::vector<size_t> &volWindows = {21, 63},
+                              bool covariance = false);
+
+        // Throws std::invalid_argument on a duplicate name or an input that is
+        // not in the graph yet.
+        Node &add(std::unique_ptr<Node> node);
+
+        template <typename N, typename... Args>
+        N &emplace(Args &&...args)
+        {
+            return static_cast<N &>(add(std::make_unique<N>(std::forward<Args>(args)...)));
+        }
+
+        const std::vector<std::string> &tickers() const { return tickers_; }
+        const std::vector<std::unique_ptr<Node>> &nodes() const { return nodes_; }
+
+        // Throws std::invalid_argument when there is no such node (or, for
+        // get, when it has another type).
+        const Node &node(std::string_view name) const;
+        const std::vector<double> &values(std::string_view name) const { return node(name).values(); }
+
+        template <typename N>
+        const N &get(std::string_view name) const
+        {
+            const N *typed = dynamic_cast<const N *>(&node(name));
+            if (!typed)
+                throw std::invalid_argument("Metric graph node has the wrong type: " + std::string(name));
+            return *typed;
+        }
+
+        size_t bars() const { return bars_; }
+        int64_t lastDay() const { return lastDay_; } // epoch day; meaningless before the first bar
+
+        // One bar: a positive close per ticker, in tickers() order, on a day
+        // after lastDay(). Throws std::invalid_argument otherwise, before any
+        // node has changed.
+        void append(int64_t day, const std::vector<double> &closes);
+
+        // Appends the bars of `aligned` (one series per ticker, in tickers()
+        // order, sharing dates) dated after lastDay(), and returns how many.
+        size_t update(const std::vector<PriceSeries> &aligned);
+
+        // Written to a temporary file and renamed over `path`.
+        void saveCheckpoint(const std::string &path) const;
+
+        // The graph must have the tickers and nodes (names, kinds and
+        // parameters) it had when saved; throws std::runtime_error otherwise
+        // or on a damaged file. The graph is unchanged when loading throws.
+        void loadCheckpoint(const std::string &path);
+
+    private:
+        void writeState(Writer &out) const;
+        void readState(Reader &in);
+
+        std::vector<std::string> tickers_;
+        std::vector<std::unique_ptr<Node>> nodes_;
+        Prices *prices_ = nullptr;
+        size_t bars_ = 0;
+        int64_t lastDay_ = 0;
+    };
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+// Fixed-type pool: objects are carved out of large chunks and recycled through
+// an intrusive free list, so steady-state acquire/release never hits malloc.
+// Pointers stay valid until released (chunks are never moved or freed early).
+// Objects still live when the pool is destroyed are not destructed.
+template <typename T, size_t ChunkSize = 4096>
+class ObjectPool
+{
+public:
+    ObjectPool() = default;
+    ObjectPool(const ObjectPool &) = delete;
+    ObjectPool &operator=(const ObjectPool &) = delete;
+
+    template <typename... Args>
+    T *acquire(Args &&...args)
+    {
+        if (!freeList_)
+            grow();
+        Slot *slot = freeList_;
+        freeList_ = slot->next;
+        ++live_;
+        return ::new (static_cast<void *>(slot->storage)) T(std::forward<Args>(args)...);
+    }
+
+    void release(T *object)
+    {
+        object->~T();
+        Slot *slot = reinterpret_cast<Slot *>(object);
+        slot->next = freeList_;
+        freeList_ = slot;
+        --live_;
+    }
+
+    size_t live() const { return live_; }
+    size_t capacity() const { return chunks_.size() * ChunkSize; }
+
+private:
+    union Slot
+    {
+        Slot *next;
+        alignas(T) unsigned char storage[sizeof(T)];
+    };
+
+    void grow()
+    {
+        chunks_.emplace_back(new Slot[ChunkSize]);
+        Slot *chunk = chunks_.back().get();
+        for (size_t i = ChunkSize; i-- > 0;)
+        {
+            chunk[i].next = freeList_;
+            freeList_ = &chunk[i];
+        }
+    }
+
+    std::vector<std::unique_ptr<Slot[]>> chunks_;
+    Slot *freeList_ = nullptr;
+    size_t live_ = 0;
+};
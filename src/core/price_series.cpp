@@ -1,10 +1,10 @@
 #include "core/price_series.hpp"
 #include <stdexcept>
 
-PriceSeries::PriceSeries(const std::string& ticker,
-                         const std::vector<std::string>& dates,
-                         const std::vector<double>& prices)
-    : ticker_(ticker), dates_(dates), prices_(prices) {
+PriceSeries::PriceSeries(std::string ticker,
+                         std::vector<std::string> dates,
+                         std::vector<double> prices)
+    : ticker_(std::move(ticker)), dates_(std::move(dates)), prices_(std::move(prices)) {
     if (dates_.size() != prices_.size()) {
         throw std::invalid_argument("Dates and prices must have the same length");
     }
@@ -25,6 +25,7 @@ const std::vector<double>& PriceSeries::getPrices() const {
 std::vector<double> PriceSeries::getDailyReturns() const {
     std::vector<double> returns;
     if (prices_.size() < 2) return returns;
+    returns.reserve(prices_.size() - 1);
 
     for (size_t i = 1; i < prices_.size(); ++i) {
         double ret = (prices_[i] - prices_[i - 1]) / prices_[i - 1];
@@ -1,22 +1,24 @@
 #pragma once
 
 #include <string>
+#include <utility>
 #include <vector>
 
 class PriceSeries
 {
 public:
-    // Existing full constructor
-    PriceSeries(const std::string &ticker,
-                const std::vector<std::string> &dates,
-                const std::vector<double> &prices);
+    // Existing full constructor; arguments are sinks, so pass temporaries
+    // or std::move to hand the buffers over without copying.
+    PriceSeries(std::string ticker,
+                std::vector<std::string> dates,
+                std::vector<double> prices);
 
     // ➕ New constructor for tests (assumes dummy dates)
-    PriceSeries(const std::string &ticker,
-                const std::vector<double> &prices)
-        : ticker_(ticker), prices_(prices)
+    PriceSeries(std::string ticker,
+                std::vector<double> prices)
+        : ticker_(std::move(ticker)), prices_(std::move(prices))
     {
-        dates_.resize(prices.size(), ""); // fill with empty strings
+        dates_.resize(prices_.size(), ""); // fill with empty strings
     }
 
     const std::string &getTicker() const;
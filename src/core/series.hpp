@@ -0,0 +1,559 @@
+#pragma once
+
+#include "core/price_series.hpp"
+#include "../utils/summation.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+// Lazy series expressions.
+//
+//   auto wealth = (1.0 + Series::returns(ps)).cumprod();
+//   auto vol = (Series::returns(ps) - rf).rolling(20).stddev();
+//   std::vector<double> v = vol.collect();
+//
+// Each operation returns a small value type describing the computation; no
+// data is touched until collect() or a reduction runs. Evaluation pulls values
+// through a chain of cursors, one per node, each a concrete type known at
+// compile time, so the whole tree inlines into a single loop with no
+// intermediate vectors and no virtual calls. Stateful nodes (returns,
+// cumulative scans, rolling windows) keep their state in their cursor.
+//
+// Sources are views: the vector or PriceSeries must outlive the expression.
+// Binary operations need operands of equal size and throw
+// std::invalid_argument otherwise. Rolling outputs have one value per full
+// window (size - window + 1), as in Stats::Volatility; drop() realigns a
+// longer operand.
+namespace Series
+{
+
+    template <typename E>
+    concept Expression = requires(const E &e) {
+        typename E::IsSeriesExpression;
+        { e.size() } -> std::convertible_to<size_t>;
+        { e.cursor().next() } -> std::convertible_to<double>;
+    };
+
+    // Sample variance (n - 1); 0 for a single value.
+    struct Moments
+    {
+        size_t count = 0;
+        double mean = 0.0;
+        double variance = 0.0;
+    };
+
+    template <typename E, typename F>
+    class Map;
+    template <typename E, bool Product>
+    class Scan;
+    template <typename E>
+    class Drop;
+    template <typename E>
+    class Rolling;
+
+    template <typename Derived>
+    class Expr
+    {
+    public:
+        using IsSeriesExpression = void;
+
+        template <typename F>
+        Map<Derived, F> map(F f) const;
+        Scan<Derived, true> cumprod() const;
+        Scan<Derived, false> cumsum() const;
+        Drop<Derived> drop(size_t count) const;
+        Rolling<Derived> rolling(size_t window) const;
+
+        std::vector<double> collect() const;
+
+        // Reductions run in one pass and throw std::invalid_argument when empty.
+        double sum() const;
+        double mean() const;
+        Moments moments() const;
+        double variance() const;
+        double stddev() const;
+        double min() const;
+        double max() const;
+        double last() const;
+
+    private:
+        const Derived &self() const { return static_cast<const Derived &>(*this); }
+
+        template <typename Fold>
+        void fold(Fold f) const;
+    };
+
+    // ---- sources ------------------------------------------------------------
+
+    class View : public Expr<View>
+    {
+    public:
+        explicit View(std::span<const double> data) : data_(data) {}
+
+        size_t size() const { return data_.size(); }
+
+        struct Cursor
+        {
+            const double *p;
+            double next() { return *p++; }
+        };
+        Cursor cursor() const { return {data_.data()}; }
+
+    private:
+        std::span<const double> data_;
+    };
+
+    // Simple returns (p[i] - p[i - 1]) / p[i - 1], as Stats::Returns::computeDailyReturns.
+    class Returns : public Expr<Returns>
+    {
+    public:
+        explicit Returns(std::span<const double> prices) : prices_(prices) {}
+
+        size_t size() const { return prices_.size() < 2 ? 0 : prices_.size() - 1; }
+
+        struct Cursor
+        {
+            const double *p;
+            double next()
+            {
+                const double prev = p[0], curr = p[1];
+                ++p;
+                if (prev == 0.0)
+                    throw std::invalid_argument("Encountered zero price, cannot compute return.");
+                return (curr - prev) / prev;
+            }
+        };
+        Cursor cursor() const { return {prices_.data()}; }
+
+    private:
+        std::span<const double> prices_;
+    };
+
+    class Constant : public Expr<Constant>
+    {
+    public:
+        Constant(double value, size_t size) : value_(value), size_(size) {}
+
+        size_t size() const { return size_; }
+
+        struct Cursor
+        {
+            double value;
+            double next() const { return value; }
+        };
+        Cursor cursor() const { return {value_}; }
+
+    private:
+        double value_;
+        size_t size_;
+    };
+
+    inline View view(const std::vector<double> &data) { return View(data); }
+    inline View prices(const PriceSeries &series) { return View(series.getPrices()); }
+    inline Returns returns(const PriceSeries &series) { return Returns(series.getPrices()); }
+    inline Returns returns(const std::vector<double> &prices) { return Returns(prices); }
+
+    // ---- element-wise nodes -------------------------------------------------
+
+    template <typename E, typename F>
+    class Map : public Expr<Map<E, F>>
+    {
+    public:
+        Map(E e, F f) : e_(std::move(e)), f_(std::move(f)) {}
+
+        size_t size() const { return e_.size(); }
+
+        struct Cursor
+        {
+            decltype(std::declval<const E &>().cursor()) c;
+            F f;
+            double next() { return f(c.next()); }
+        };
+        Cursor cursor() const { return {e_.cursor(), f_}; }
+
+    private:
+        E e_;
+        F f_;
+    };
+
+    template <typename L, typename R, typename Op>
+    class Binary : public Expr<Binary<L, R, Op>>
+    {
+    public:
+        Binary(L l, R r) : l_(std::move(l)), r_(std::move(r))
+        {
+            if (l_.size() != r_.size())
+                throw std::invalid_argument("Series operands must have the same size.");
+        }
+
+        size_t size() const { return l_.size(); }
+
+        struct Cursor
+        {
+            decltype(std::declval<const L &>().cursor()) l;
+            decltype(std::declval<const R &>().cursor()) r;
+            double next()
+            {
+                const double a = l.next();
+                return Op{}(a, r.next());
+            }
+        };
+        Cursor cursor() const { return {l_.cursor(), r_.cursor()}; }
+
+    private:
+        L l_;
+        R r_;
+    };
+
+    // ---- stateful nodes -----------------------------------------------------
+
+    // Running product or compensated running sum.
+    template <typename E, bool Product>
+    class Scan : public Expr<Scan<E, Product>>
+    {
+    public:
+        explicit Scan(E e) : e_(std::move(e)) {}
+
+        size_t size() const { return e_.size(); }
+
+        struct Cursor
+        {
+            decltype(std::declval<const E &>().cursor()) c;
+            double product = 1.0;
+            Summation::Accumulator<double> sum{};
+            double next()
+            {
+                if constexpr (Product)
+                {
+                    product *= c.next();
+                    return product;
+                }
+                else
+                {
+                    sum.add(c.next());
+                    return sum.value();
+                }
+            }
+        };
+        Cursor cursor() const { return {e_.cursor()}; }
+
+    private:
+        E e_;
+    };
+
+    template <typename E>
+    class Drop : public Expr<Drop<E>>
+    {
+    public:
+        Drop(E e, size_t count) : e_(std::move(e)), count_(std::min(count, e_.size())) {}
+
+        size_t size() const { return e_.size() - count_; }
+
+        auto cursor() const
+        {
+            auto c = e_.cursor();
+            for (size_t i = 0; i < count_; ++i)
+                c.next();
+            return c;
+        }
+
+    private:
+        E e_;
+        size_t count_;
+    };
+
+    enum class WindowStat
+    {
+        Sum,
+        Mean,
+        Variance,
+        StdDev
+    };
+
+    // One value per full window. Keeps the last `window` inputs in a ring and
+    // sums shifted by the mean at the last rebuild, rebuilt every `window`
+    // steps as in Kernels::rollingMoments; a run of `window` equal inputs
+    // reports exactly zero variance.
+    template <typename E, WindowStat Stat>
+    class RollingStat : public Expr<RollingStat<E, Stat>>
+    {
+    public:
+        RollingStat(E e, size_t window) : e_(std::move(e)), window_(window) {}
+
+        size_t size() const { return e_.size() < window_ ? 0 : e_.size() - window_ + 1; }
+
+        class Cursor
+        {
+        public:
+            Cursor(decltype(std::declval<const E &>().cursor()) c, size_t w, size_t available)
+                : c_(std::move(c)), ring_(w), w_(w)
+            {
+                for (size_t i = 0; i + 1 < w && i < available; ++i)
+                    push(c_.next());
+            }
+
+            double next()
+            {
+                const double removed = ring_[head_];
+                push(c_.next());
+                if (untilRebuild_-- == 0)
+                {
+                    // Oldest first, so the rebuild rounds like the eager kernel.
+                    double total = 0.0;
+                    for (size_t j = 0, k = head_; j < w_; ++j, k = k + 1 == w_ ? 0 : k + 1)
+                        total += ring_[k];
+                    shift_ = total / static_cast<double>(w_);
+                    untilRebuild_ = w_ - 1;
+                    s1_ = s2_ = 0.0;
+                    for (size_t j = 0, k = head_; j < w_; ++j, k = k + 1 == w_ ? 0 : k + 1)
+                    {
+                        const double d = ring_[k] - shift_;
+                        s1_ += d;
+                        s2_ += d * d;
+                    }
+                }
+                else
+                {
+                    const double added = last_ - shift_, gone = removed - shift_;
+                    s1_ += added - gone;
+                    s2_ += (added - gone) * (added + gone);
+                }
+                return value();
+            }
+
+        private:
+            void push(double v)
+            {
+                run_ = filled_ > 0 && v == last_ ? run_ + 1 : 1;
+                last_ = v;
+                ring_[head_] = v;
+                head_ = head_ + 1 == w_ ? 0 : head_ + 1;
+                ++filled_;
+            }
+
+            double value() const
+            {
+                const double width = static_cast<double>(w_);
+                if constexpr (Stat == WindowStat::Sum)
+                    return shift_ * width + s1_;
+                else if constexpr (Stat == WindowStat::Mean)
+                    return run_ >= w_ ? last_ : shift_ + s1_ / width;
+                else
+                {
+                    double m2 = run_ >= w_ ? 0.0 : s2_ - s1_ * s1_ / width;
+                    double variance = (m2 > 0.0 ? m2 : 0.0) / (width - 1.0);
+                    if constexpr (Stat == WindowStat::Variance)
+                        return variance;
+                    else
+                        return std::sqrt(variance);
+                }
+            }
+
+            decltype(std::declval<const E &>().cursor()) c_;
+            std::vector<double> ring_;
+            size_t w_;
+            size_t head_ = 0, filled_ = 0, run_ = 0, untilRebuild_ = 0;
+            double last_ = 0.0, shift_ = 0.0, s1_ = 0.0, s2_ = 0.0;
+        };
+
+        Cursor cursor() const { return Cursor(e_.cursor(), window_, e_.size()); }
+
+    private:
+        E e_;
+        size_t window_;
+    };
+
+    // Builder returned by Expr::rolling(); each statistic is an expression.
+    template <typename E>
+    class Rolling
+    {
+    public:
+        Rolling(E e, size_t window) : e_(std::move(e)), window_(window)
+        {
+            if (window == 0)
+                throw std::invalid_argument("Rolling window must be positive.");
+        }
+
+        RollingStat<E, WindowStat::Sum> sum() const { return {e_, window_}; }
+        RollingStat<E, WindowStat::Mean> mean() const { return {e_, window_}; }
+        RollingStat<E, WindowStat::Variance> variance() const { return {e_, checkedForVariance()}; }
+        RollingStat<E, WindowStat::StdDev> stddev() const { return {e_, checkedForVariance()}; }
+
+    private:
+        size_t checkedForVariance() const
+        {
+            if (window_ < 2)
+                throw std::invalid_argument("Rolling variance needs a window of at least 2.");
+            return window_;
+        }
+
+        E e_;
+        size_t window_;
+    };
+
+    // ---- operators ----------------------------------------------------------
+
+#define TRADEIQ_SERIES_OPERATOR(op, Fn)                                                        \
+    template <Expression L, Expression R>                                                      \
+    Binary<L, R, Fn> operator op(const L &l, const R &r)                                       \
+    {                                                                                          \
+        return {l, r};                                                                         \
+    }                                                                                          \
+    template <Expression L>                                                                    \
+    Binary<L, Constant, Fn> operator op(const L &l, double r)                                  \
+    {                                                                                          \
+        return {l, Constant(r, l.size())};                                                     \
+    }                                                                                          \
+    template <Expression R>                                                                    \
+    Binary<Constant, R, Fn> operator op(double l, const R &r)                                  \
+    {                                                                                          \
+        return {Constant(l, r.size()), r};                                                     \
+    }
+
+    TRADEIQ_SERIES_OPERATOR(+, std::plus<>)
+    TRADEIQ_SERIES_OPERATOR(-, std::minus<>)
+    TRADEIQ_SERIES_OPERATOR(*, std::multiplies<>)
+    TRADEIQ_SERIES_OPERATOR(/, std::divides<>)
+
+#undef TRADEIQ_SERIES_OPERATOR
+
+    template <Expression E>
+    Map<E, std::negate<>> operator-(const E &e)
+    {
+        return {e, std::negate<>{}};
+    }
+
+    // ---- Expr members -------------------------------------------------------
+
+    template <typename Derived>
+    template <typename F>
+    Map<Derived, F> Expr<Derived>::map(F f) const
+    {
+        return {self(), std::move(f)};
+    }
+
+    template <typename Derived>
+    Scan<Derived, true> Expr<Derived>::cumprod() const
+    {
+        return Scan<Derived, true>(self());
+    }
+
+    template <typename Derived>
+    Scan<Derived, false> Expr<Derived>::cumsum() const
+    {
+        return Scan<Derived, false>(self());
+    }
+
+    template <typename Derived>
+    Drop<Derived> Expr<Derived>::drop(size_t count) const
+    {
+        return Drop<Derived>(self(), count);
+    }
+
+    template <typename Derived>
+    Rolling<Derived> Expr<Derived>::rolling(size_t window) const
+    {
+        return Rolling<Derived>(self(), window);
+    }
+
+    template <typename Derived>
+    std::vector<double> Expr<Derived>::collect() const
+    {
+        const size_t n = self().size();
+        std::vector<double> out(n);
+        auto c = self().cursor();
+        for (size_t i = 0; i < n; ++i)
+            out[i] = c.next();
+        return out;
+    }
+
+    template <typename Derived>
+    template <typename Fold>
+    void Expr<Derived>::fold(Fold f) const
+    {
+        const size_t n = self().size();
+        if (n == 0)
+            throw std::invalid_argument("Data is empty.");
+        auto c = self().cursor();
+        for (size_t i = 0; i < n; ++i)
+            f(c.next());
+    }
+
+    template <typename Derived>
+    double Expr<Derived>::sum() const
+    {
+        Summation::Accumulator<double> acc;
+        fold([&](double x) { acc.add(x); });
+        return acc.value();
+    }
+
+    template <typename Derived>
+    double Expr<Derived>::mean() const
+    {
+        return sum() / static_cast<double>(self().size());
+    }
+
+    // Shifted by the first value so the sums stay on the scale of the spread.
+    template <typename Derived>
+    Moments Expr<Derived>::moments() const
+    {
+        Summation::Accumulator<double> s1, s2;
+        double shift = 0.0;
+        size_t count = 0;
+        fold([&](double x) {
+            if (count++ == 0)
+                shift = x;
+            const double d = x - shift;
+            s1.add(d);
+            s2.add(d * d);
+        });
+
+        const double n = static_cast<double>(count);
+        const double m2 = s2.value() - s1.value() * s1.value() / n;
+        return {count, shift + s1.value() / n, count > 1 ? std::max(m2, 0.0) / (n - 1.0) : 0.0};
+    }
+
+    template <typename Derived>
+    double Expr<Derived>::variance() const
+    {
+        return moments().variance;
+    }
+
+    template <typename Derived>
+    double Expr<Derived>::stddev() const
+    {
+        return std::sqrt(moments().variance);
+    }
+
+    template <typename Derived>
+    double Expr<Derived>::min() const
+    {
+        double m = std::numeric_limits<double>::infinity();
+        fold([&](double x) { m = std::min(m, x); });
+        return m;
+    }
+
+    template <typename Derived>
+    double Expr<Derived>::max() const
+    {
+        double m = -std::numeric_limits<double>::infinity();
+        fold([&](double x) { m = std::max(m, x); });
+        return m;
+    }
+
+    template <typename Derived>
+    double Expr<Derived>::last() const
+    {
+        double v = 0.0;
+        fold([&](double x) { v = x; });
+        return v;
+    }
+
+}
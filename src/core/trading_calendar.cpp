@@ -0,0 +1,232 @@
+#include "core/trading_calendar.hpp"
+#include "../utils/timestamp.hpp"
+
+#include <stdexcept>
+
+namespace
+{
+    using Timestamp::daysFromCivil;
+
+    enum Weekday
+    {
+        kSunday = 0,
+        kMonday = 1,
+        kThursday = 4,
+        kFriday = 5,
+        kSaturday = 6,
+    };
+
+    int weekday(int64_t day)
+    {
+        return static_cast<int>(((day % 7) + 11) % 7); // 1970-01-01 was a Thursday
+    }
+
+    int yearOf(int64_t day)
+    {
+        int64_t y;
+        unsigned m, d;
+        Timestamp::civilFromDays(day, y, m, d);
+        return static_cast<int>(y);
+    }
+
+    int64_t nthWeekday(int year, unsigned month, int wd, int n)
+    {
+        const int64_t first = daysFromCivil(year, month, 1);
+        return first + (wd - weekday(first) + 7) % 7 + 7 * (n - 1);
+    }
+
+    int64_t lastWeekday(int year, unsigned month, int wd)
+    {
+        const int64_t last = month == 12 ? daysFromCivil(year + 1, 1, 1) - 1 : daysFromCivil(year, month + 1, 1) - 1;
+        return last - (weekday(last) - wd + 7) % 7;
+    }
+
+    // Saturday holidays move to Friday, Sunday holidays to Monday.
+    int64_t observed(int64_t day)
+    {
+        const int wd = weekday(day);
+        return wd == kSaturday ? day - 1 : wd == kSunday ? day + 1 : day;
+    }
+
+    // Gregorian Easter Sunday (anonymous algorithm).
+    int64_t easter(int year)
+    {
+        const int a = year % 19, b = year / 100, c = year % 100;
+        const int d = b / 4, e = b % 4, f = (b + 8) / 25, g = (b - f + 1) / 3;
+        const int h = (19 * a + b - d - g + 15) % 30;
+        const int i = c / 4, k = c % 4;
+        const int l = (32 + 2 * e + 2 * i - h - k) % 7;
+        const int m = (a + 11 * h + 22 * l) / 451;
+        const int month = (h + l - 7 * m + 114) / 31;
+        const int day = (h + l - 7 * m + 114) % 31 + 1;
+        return daysFromCivil(year, static_cast<unsigned>(month), static_cast<unsigned>(day));
+    }
+
+    // Unscheduled full-day closures since 1990.
+    constexpr int kSpecialClosures[][3] = {
+        {1994, 4, 27},                                             // Nixon funeral
+        {2001, 9, 11}, {2001, 9, 12}, {2001, 9, 13}, {2001, 9, 14}, // September 11
+        {2004, 6, 11},                                             // Reagan funeral
+        {2007, 1, 2},                                              // Ford funeral
+        {2012, 10, 29}, {2012, 10, 30},                            // Hurricane Sandy
+        {2018, 12, 5},                                             // G. H. W. Bush funeral
+        {2025, 1, 9},                                              // Carter funeral
+    };
+}
+
+TradingCalendar::TradingCalendar(int firstYear, int lastYear, const std::vector<int64_t> &holidays,
+                                 const std::vector<int64_t> &halfDays)
+    : firstYear_(firstYear), lastYear_(lastYear), firstDay_(daysFromCivil(firstYear, 1, 1))
+{
+    if (firstYear > lastYear)
+        throw std::invalid_argument("Trading calendar needs firstYear <= lastYear.");
+
+    const int64_t end = daysFromCivil(lastYear + 1, 1, 1);
+    kind_.resize(static_cast<size_t>(end - firstDay_));
+    for (size_t i = 0; i < kind_.size(); ++i)
+    {
+        const int wd = weekday(firstDay_ + static_cast<int64_t>(i));
+        kind_[i] = wd == kSaturday || wd == kSunday ? kClosed : kOpen;
+    }
+    for (int64_t day : holidays)
+        if (day >= firstDay_ && day < end)
+            kind_[static_cast<size_t>(day - firstDay_)] = kClosed;
+    for (int64_t day : halfDays)
+        if (day >= firstDay_ && day < end && kind_[static_cast<size_t>(day - firstDay_)] == kOpen)
+            kind_[static_cast<size_t>(day - firstDay_)] = kHalfDay;
+
+    rank_.resize(kind_.size() + 1);
+    uint32_t count = 0;
+    for (size_t i = 0; i < kind_.size(); ++i)
+    {
+        rank_[i] = count;
+        if (kind_[i] != kClosed)
+        {
+            sessions_.push_back(firstDay_ + static_cast<int64_t>(i));
+            ++count;
+        }
+    }
+    rank_[kind_.size()] = count;
+}
+
+TradingCalendar TradingCalendar::nyse(int firstYear, int lastYear)
+{
+    std::vector<int64_t> holidays, halfDays;
+    for (int y = firstYear; y <= lastYear; ++y)
+    {
+        const int64_t newYear = daysFromCivil(y, 1, 1);
+        if (weekday(newYear) != kSaturday)
+            holidays.push_back(observed(newYear));
+        if (y >= 1998)
+            holidays.push_back(nthWeekday(y, 1, kMonday, 3));
+        holidays.push_back(nthWeekday(y, 2, kMonday, 3));
+        holidays.push_back(easter(y) - 2);
+        holidays.push_back(lastWeekday(y, 5, kMonday));
+        if (y >= 2022)
+            holidays.push_back(observed(daysFromCivil(y, 6, 19)));
+        holidays.push_back(observed(daysFromCivil(y, 7, 4)));
+        holidays.push_back(nthWeekday(y, 9, kMonday, 1));
+        const int64_t thanksgiving = nthWeekday(y, 11, kThursday, 4);
+        holidays.push_back(thanksgiving);
+        holidays.push_back(observed(daysFromCivil(y, 12, 25)));
+
+        halfDays.push_back(daysFromCivil(y, 7, 3));
+        halfDays.push_back(thanksgiving + 1);
+        halfDays.push_back(daysFromCivil(y, 12, 24));
+    }
+    for (const auto &c : kSpecialClosures)
+        holidays.push_back(daysFromCivil(c[0], static_cast<unsigned>(c[1]), static_cast<unsigned>(c[2])));
+    return TradingCalendar(firstYear, lastYear, holidays, halfDays);
+}
+
+const TradingCalendar &TradingCalendar::nyse()
+{
+    static const TradingCalendar calendar = nyse(1990, 2070);
+    return calendar;
+}
+
+size_t TradingCalendar::offset(int64_t day) const
+{
+    if (day < firstDay_ || day > lastDay())
+        throw std::out_of_range("Day outside the trading calendar.");
+    return static_cast<size_t>(day - firstDay_);
+}
+
+int64_t TradingCalendar::rankAt(int64_t day) const
+{
+    if (day == lastDay() + 1)
+        return static_cast<int64_t>(sessions_.size());
+    return rank_[offset(day)];
+}
+
+bool TradingCalendar::isHoliday(int64_t day) const
+{
+    const int wd = weekday(day);
+    return kind_[offset(day)] == kClosed && wd != kSaturday && wd != kSunday;
+}
+
+int64_t TradingCalendar::sessionOnOrAfter(int64_t day) const
+{
+    const size_t rank = rank_[offset(day)];
+    if (rank == sessions_.size())
+        throw std::out_of_range("No session on or after this day in the trading calendar.");
+    return sessions_[rank];
+}
+
+int64_t TradingCalendar::sessionOnOrBefore(int64_t day) const
+{
+    const size_t i = offset(day);
+    if (kind_[i] != kClosed)
+        return day;
+    if (rank_[i] == 0)
+        throw std::out_of_range("No session on or before this day in the trading calendar.");
+    return sessions_[rank_[i] - 1];
+}
+
+int64_t TradingCalendar::sessionsBetween(int64_t from, int64_t to) const
+{
+    return rankAt(to) - rankAt(from);
+}
+
+int64_t TradingCalendar::addSessions(int64_t day, int64_t n) const
+{
+    const size_t i = offset(day);
+    int64_t target = static_cast<int64_t>(rank_[i]) + n;
+    if (n > 0 && kind_[i] == kClosed)
+        --target;
+    if (target < 0 || target >= static_cast<int64_t>(sessions_.size()))
+        throw std::out_of_range("Session offset leaves the trading calendar.");
+    return sessions_[static_cast<size_t>(target)];
+}
+
+int TradingCalendar::sessionsInYear(int year) const
+{
+    if (year < firstYear_ || year > lastYear_)
+        throw std::out_of_range("Year outside the trading calendar.");
+    return static_cast<int>(rankAt(daysFromCivil(year + 1, 1, 1)) - rankAt(daysFromCivil(year, 1, 1)));
+}
+
+double TradingCalendar::sessionsPerYear(int64_t from, int64_t to) const
+{
+    if (to < from)
+        throw std::invalid_argument("sessionsPerYear needs from <= to.");
+    offset(from); // range checks
+    offset(to);
+    const int y0 = yearOf(from), y1 = yearOf(to);
+    const int64_t sessions = rankAt(daysFromCivil(y1 + 1, 1, 1)) - rankAt(daysFromCivil(y0, 1, 1));
+    return static_cast<double>(sessions) / static_cast<double>(y1 - y0 + 1);
+}
+
+std::vector<TradingCalendar::Gap> TradingCalendar::findGaps(const std::vector<int64_t> &observedDays) const
+{
+    std::vector<Gap> gaps;
+    for (size_t i = 1; i < observedDays.size(); ++i)
+    {
+        if (observedDays[i] <= observedDays[i - 1])
+            throw std::invalid_argument("Observed days must be strictly increasing.");
+        const int64_t missing = rankAt(observedDays[i]) - rankAt(observedDays[i - 1] + 1);
+        if (missing > 0)
+            gaps.push_back({i, missing});
+    }
+    return gaps;
+}
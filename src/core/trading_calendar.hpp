@@ -0,0 +1,86 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Exchange sessions over a fixed span of years. Every day in the span stores
+// how many sessions precede it, so counting, stepping and rounding to
+// sessions are array lookups (O(1)) rather than day-by-day walks.
+//
+// Days are epoch days (Timestamp::daysFromCivil, Timestamp::parseEpochDays).
+// Queries outside the span throw std::out_of_range.
+class TradingCalendar
+{
+public:
+    struct Gap
+    {
+        size_t index;    // the gap lies between observations index - 1 and index
+        int64_t missing; // sessions in between with no observation
+    };
+
+    // Weekends are closed. `holidays` are weekdays the exchange is closed and
+    // `halfDays` early-close sessions, both in epoch days; entries outside
+    // the span are ignored.
+    TradingCalendar(int firstYear, int lastYear, const std::vector<int64_t> &holidays,
+                    const std::vector<int64_t> &halfDays = {});
+
+    // NYSE: New Year's Day (not observed on a Saturday), Martin Luther King
+    // Jr. Day (from 1998), Washington's Birthday, Good Friday, Memorial Day,
+    // Juneteenth (from 2022), Independence Day, Labor Day, Thanksgiving and
+    // Christmas, weekend dates observed on the nearest weekday, plus the
+    // unscheduled closures since 1990. Early closes on July 3, the day after
+    // Thanksgiving and Christmas Eve follow today's rule in every year.
+    static TradingCalendar nyse(int firstYear, int lastYear);
+
+    // NYSE for 1990-2070, built on first use.
+    static const TradingCalendar &nyse();
+
+    int64_t firstDay() const { return firstDay_; }
+    int64_t lastDay() const { return firstDay_ + static_cast<int64_t>(kind_.size()) - 1; }
+
+    bool isSession(int64_t day) const { return kind_[offset(day)] != kClosed; }
+    bool isHalfDay(int64_t day) const { return kind_[offset(day)] == kHalfDay; }
+    bool isHoliday(int64_t day) const; // a closed weekday
+
+    int64_t sessionOnOrAfter(int64_t day) const;
+    int64_t sessionOnOrBefore(int64_t day) const;
+
+    // Sessions in [from, to); negative when to < from. `to` may be one past
+    // lastDay().
+    int64_t sessionsBetween(int64_t from, int64_t to) const;
+
+    // The session n sessions after `day` (before, for negative n). A closed
+    // day counts as the instant before the next session, so adding 1 to a
+    // Saturday gives the following Monday when it is open, and adding 0
+    // rolls forward to it.
+    int64_t addSessions(int64_t day, int64_t n) const;
+
+    int sessionsInYear(int year) const;
+
+    // Mean sessions per calendar year over the years that [from, to] touches:
+    // the annualization factor for daily data in that span.
+    double sessionsPerYear(int64_t from, int64_t to) const;
+
+    // Sessions with no observation between consecutive observed days, which
+    // must be strictly increasing.
+    std::vector<Gap> findGaps(const std::vector<int64_t> &observedDays) const;
+
+private:
+    enum : uint8_t
+    {
+        kClosed = 0,
+        kOpen = 1,
+        kHalfDay = 2,
+    };
+
+    size_t offset(int64_t day) const;
+    int64_t rankAt(int64_t day) const; // sessions before `day`; day may be lastDay() + 1
+
+    int firstYear_ = 0;
+    int lastYear_ = 0;
+    int64_t firstDay_ = 0;
+    std::vector<uint8_t> kind_;     // per day
+    std::vector<uint32_t> rank_;    // per day plus one: sessions strictly before it
+    std::vector<int64_t> sessions_; // epoch day of each session
+};
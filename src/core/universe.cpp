@@ -0,0 +1,100 @@
+#include "core/universe.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <functional>
+#include <stdexcept>
+#include <string>
+
+namespace
+{
+    constexpr size_t kMinSlots = 16;
+
+    uint32_t hashTicker(std::string_view ticker)
+    {
+        const uint64_t h = std::hash<std::string_view>{}(ticker);
+        return static_cast<uint32_t>(h ^ (h >> 32));
+    }
+}
+
+void Universe::reserve(size_t tickers)
+{
+    series_.reserve(tickers);
+    const size_t wanted = std::bit_ceil(std::max(kMinSlots, 2 * tickers));
+    if (wanted > slots_.size())
+        rehash(wanted);
+}
+
+// Index of the slot holding `ticker`, or of the empty slot where it would go.
+size_t Universe::probe(std::string_view ticker, uint32_t hash) const
+{
+    const size_t mask = slots_.size() - 1;
+    for (size_t i = hash & mask;; i = (i + 1) & mask)
+    {
+        const Slot &slot = slots_[i];
+        if (slot.id == kEmpty || (slot.hash == hash && series_[slot.id].getTicker() == ticker))
+            return i;
+    }
+}
+
+void Universe::rehash(size_t capacity)
+{
+    std::vector<Slot> old = std::move(slots_);
+    slots_.assign(capacity, Slot{});
+    const size_t mask = capacity - 1;
+    for (const Slot &slot : old)
+    {
+        if (slot.id == kEmpty)
+            continue;
+        size_t i = slot.hash & mask;
+        while (slots_[i].id != kEmpty)
+            i = (i + 1) & mask;
+        slots_[i] = slot;
+    }
+}
+
+Universe::Id Universe::insert(PriceSeries series)
+{
+    if (2 * (series_.size() + 1) > slots_.size())
+        rehash(std::max(kMinSlots, 2 * slots_.size()));
+
+    const uint32_t hash = hashTicker(series.getTicker());
+    Slot &slot = slots_[probe(series.getTicker(), hash)];
+    if (slot.id != kEmpty)
+    {
+        series_[slot.id] = std::move(series);
+        return slot.id;
+    }
+
+    if (series_.size() >= kEmpty)
+        throw std::length_error("Universe holds at most 2^32 - 1 tickers");
+    slot = Slot{static_cast<Id>(series_.size()), hash};
+    series_.push_back(std::move(series));
+    return slot.id;
+}
+
+std::optional<Universe::Id> Universe::find(std::string_view ticker) const
+{
+    if (slots_.empty())
+        return std::nullopt;
+    const Slot &slot = slots_[probe(ticker, hashTicker(ticker))];
+    if (slot.id == kEmpty)
+        return std::nullopt;
+    return slot.id;
+}
+
+const PriceSeries &Universe::at(std::string_view ticker) const
+{
+    const auto id = find(ticker);
+    if (!id)
+        throw std::out_of_range("Ticker not in universe: " + std::string(ticker));
+    return series_[*id];
+}
+
+std::vector<PriceSeries> Universe::release()
+{
+    std::vector<PriceSeries> out = std::move(series_);
+    series_.clear();
+    slots_.clear();
+    return out;
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "core/price_series.hpp"
+
+// Price series for a set of tickers. Each ticker is interned once and given
+// a dense id in insertion order; the series themselves sit contiguously in a
+// vector indexed by id and are moved in, never copied. Ticker lookup goes
+// through an open-addressing table of ids (linear probing, at most half
+// full) that stores the hash next to the id, so a probe compares strings
+// only when the hashes match.
+//
+// Move-only: a universe owns every price and date of every ticker, and an
+// accidental copy of one is exactly what it exists to avoid.
+class Universe
+{
+public:
+    using Id = uint32_t;
+
+    Universe() = default;
+    Universe(Universe &&) noexcept = default;
+    Universe &operator=(Universe &&) noexcept = default;
+    Universe(const Universe &) = delete;
+    Universe &operator=(const Universe &) = delete;
+
+    void reserve(size_t tickers);
+
+    // Adds the series under its ticker, replacing any series already there
+    // (which keeps its id).
+    Id insert(PriceSeries series);
+
+    std::optional<Id> find(std::string_view ticker) const;
+    bool contains(std::string_view ticker) const { return find(ticker).has_value(); }
+
+    // Throws std::out_of_range for a ticker that is not present.
+    const PriceSeries &at(std::string_view ticker) const;
+
+    const PriceSeries &operator[](Id id) const { return series_[id]; }
+    const std::string &symbol(Id id) const { return series_[id].getTicker(); }
+
+    size_t size() const { return series_.size(); }
+    bool empty() const { return series_.empty(); }
+
+    // Every series in id order, e.g. for the Stats panel functions.
+    const std::vector<PriceSeries> &series() const { return series_; }
+    auto begin() const { return series_.begin(); }
+    auto end() const { return series_.end(); }
+
+    // Hands the series over in id order and leaves the universe empty.
+    std::vector<PriceSeries> release();
+
+private:
+    static constexpr Id kEmpty = UINT32_MAX;
+
+    struct Slot
+    {
+        Id id = kEmpty;
+        uint32_t hash = 0;
+    };
+
+    size_t probe(std::string_view ticker, uint32_t hash) const;
+    void rehash(size_t capacity);
+
+    std::vector<PriceSeries> series_;
+    std::vector<Slot> slots_; // size is zero or a power of two
+};
@@ -1,67 +1,164 @@
+#include <atomic>
+#include <csignal>
+#include <cstdio>
 #include <iostream>
-#include <vector>
-#include <algorithm>
+#include <memory>
 
 #include "./api/tiingo_client.hpp"
-#include "./core/price_series.hpp"
-#include "./cli/matrix_printer.hpp"
+#include "./api/price_cache.hpp"
+#include "./api/cache_store.hpp"
+#include "./cli/analytics_server.hpp"
+#include "./cli/batch_runner.hpp"
+#include "./utils/instrumentation.hpp"
+#include "./utils/task_scheduler.hpp"
 
-#include "./stats/returns.hpp"
-#include "./stats/ratios.hpp"
-#include "./stats/volatility.hpp"
-#include "./stats/drawdowns.hpp"
-#include "./stats/correlation.hpp"
-
-int main()
+namespace
 {
-    TiingoClient client;
+    // Read from the signal handler; a lock-free atomic is safe to load there.
+    std::atomic<AnalyticsServer *> activeServer{nullptr};
+    static_assert(std::atomic<AnalyticsServer *>::is_always_lock_free);
+
+    void stopServer(int)
+    {
+        if (AnalyticsServer *server = activeServer.load())
+            server->stop();
+    }
 
-    std::string ticker = "AAPL";
-    std::string startDate = "2023-01-01";
-    std::string endDate = "2023-12-31";
+    // SIGINT/SIGTERM stop `server` while this is alive; the default handlers
+    // are back before the server is destroyed, even if run() throws.
+    struct StopOnSignal
+    {
+        explicit StopOnSignal(AnalyticsServer &server)
+        {
+            activeServer.store(&server);
+            std::signal(SIGINT, stopServer);
+            std::signal(SIGTERM, stopServer);
+        }
+        ~StopOnSignal()
+        {
+            std::signal(SIGINT, SIG_DFL);
+            std::signal(SIGTERM, SIG_DFL);
+            activeServer.store(nullptr);
+        }
+        StopOnSignal(const StopOnSignal &) = delete;
+        StopOnSignal &operator=(const StopOnSignal &) = delete;
+    };
 
-    std::cout << "Fetching " << ticker << " data...\n";
-    PriceSeries series = client.fetchDailyPrices(ticker, startDate, endDate);
+    // Loads every ticker once, then answers queries until SIGINT or SIGTERM.
+    int serve(const BatchConfig &config, TiingoClient &client)
+    {
+        std::vector<std::shared_ptr<const PriceSeries>> loaded(config.tickers.size());
+        Tasks::TaskScheduler::global().parallelFor(loaded.size(), [&](size_t i)
+                                                   {
+            try
+            {
+                loaded[i] = client.fetchDailyPricesShared(config.tickers[i], config.startDate, config.endDate);
+            }
+            catch (const std::exception &e)
+            {
+                if (config.verbose)
+                    std::cerr << "[Error] " << config.tickers[i] << ": " << e.what() << "\n";
+            } });
 
-    std::vector<double> returns = Stats::Returns::computeDailyReturns(series);
-    double mean = Stats::Returns::meanReturns(returns);
+        // The server may run for days; persist what was just fetched now.
+        if (auto store = client.getCacheStore())
+            store->flush();
 
-    auto cov = Stats::Correlation::computeCorrelationMatrix({series});
-    std::vector<double> weights = {1.0};
-    double variance = Stats::Ratios::computePortfolioVariance(cov, weights);
+        QueryEngineOptions options;
+        options.riskFreeRate = config.riskFreeRate;
+        options.calendar = config.calendar.empty() ? nullptr : &TradingCalendar::nyse();
+        QueryEngine engine(loaded, options);
+        // The engine's columns are the only copy the server needs.
+        loaded.clear();
+        if (auto cache = client.getPriceCache())
+            cache->clear();
 
-    double sharpe = Stats::Ratios::computeSharpeRatio(mean, variance, 0.01);
-    double sortino = Stats::Ratios::computeSortinoRatio(mean, 0.01, returns);
+        AnalyticsServer server(engine, config.serveSocket);
+        std::fprintf(stderr, "Serving %zu tickers (%zu bars) on %s\n", engine.tickers(), engine.bars(),
+                     server.socketPath().c_str());
+        {
+            StopOnSignal stopOnSignal(server);
+            server.run();
+        }
 
-    std::vector<double> cumReturns;
-    double cum = 1.0;
-    for (double r : returns) {
-        cum *= (1.0 + r);
-        cumReturns.push_back(cum);
+        const auto stats = engine.cacheStats();
+        std::fprintf(stderr, "%llu requests, %llu cache hits, %llu misses\n",
+                     static_cast<unsigned long long>(server.requestsServed()),
+                     static_cast<unsigned long long>(stats.hits), static_cast<unsigned long long>(stats.misses));
+        return 0;
     }
+}
 
-    double mdd = Stats::Drawdowns::computeMaxDrawdown(cumReturns);
+// With no arguments this reproduces the old single-ticker run (AAPL, 2023).
+// See `main_exec --help` for the batch options; `--serve SOCKET` keeps the
+// loaded universe in memory and answers queries instead (cli/analytics_server.hpp).
+int main(int argc, char **argv)
+{
+    BatchConfig config;
+    try
+    {
+        config = BatchCli::parseArgs(argc, argv);
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "Error: " << e.what() << "\n\n" << BatchCli::usage();
+        return 1;
+    }
 
-    std::cout << "\n📈 Stats for " << ticker << " (" << startDate << " to " << endDate << ")\n";
-    std::cout << "----------------------------------------\n";
-    std::cout << "Mean Return      : " << mean << "\n";
-    std::cout << "Variance         : " << variance << "\n";
-    std::cout << "Sharpe Ratio     : " << sharpe << "\n";
-    std::cout << "Sortino Ratio    : " << sortino << "\n";
-    std::cout << "Max Drawdown     : " << mdd << "\n";
+    if (config.showHelp)
+    {
+        std::cout << BatchCli::usage();
+        return 0;
+    }
 
-    std::cout << "\n📊 Covariance Matrix:\n";
-    MatrixPrinter::print(cov);
+    Instrumentation::setEnabled(config.profile || !config.traceOutput.empty());
 
-    std::cout << "\n📉 Rolling Volatility (20d):\n";
-    auto rollVol = Stats::Volatility::computeRollingVolatility(returns, 20);
-    for (size_t i = 0; i < std::min(rollVol.size(), size_t(10)); ++i)
-        std::cout << "Day " << i + 20 << ": " << rollVol[i] << "\n";
+    try
+    {
+        TiingoClient client;
+        client.setOfflineMode(config.offline);
+        client.setVerbosity(config.verbose);
+        client.setPriceCache(std::make_shared<PriceCache>());
+        if (!config.cacheDir.empty())
+            client.setCacheStore(std::make_shared<ShardedCacheStore>(config.cacheDir));
 
-    std::cout << "\n📊 Rolling Sharpe (20d):\n";
-    auto rollSharpe = Stats::Volatility::computeRollingSharpe(returns, 20, 0.01);
-    for (size_t i = 0; i < std::min(rollSharpe.size(), size_t(10)); ++i)
-        std::cout << "Day " << i + 20 << ": " << rollSharpe[i] << "\n";
+        if (!config.serveSocket.empty())
+            return serve(config, client);
+
+        BatchRunner runner(config, [&](const std::string &ticker)
+                           { return client.fetchDailyPricesShared(ticker, config.startDate, config.endDate); });
+
+        BatchResult result = runner.run();
+        if (auto store = client.getCacheStore())
+            store->flush();
+        runner.write(result);
+
+        if (config.verbose)
+        {
+            for (const auto &f : result.failed)
+                std::cerr << "[Error] " << f << "\n";
+            for (const auto &g : result.gaps)
+                std::cerr << "[Gap] " << g << "\n";
+        }
+
+        std::fprintf(stderr, "\n%zu/%zu tickers, %u threads\n", result.metrics.rows(),
+                     config.tickers.size(), runner.config().threads);
+        for (const auto &t : result.timings)
+            std::fprintf(stderr, "  %-12s %10.2f ms\n", t.stage.c_str(), t.seconds * 1e3);
+
+        if (config.profile)
+        {
+            std::fprintf(stderr, "\n");
+            Instrumentation::writeSummary(stderr);
+        }
+        if (!config.traceOutput.empty())
+            Instrumentation::writeChromeTrace(config.traceOutput);
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
 
     return 0;
 }
@@ -0,0 +1,272 @@
+#include "stats/bootstrap.hpp"
+#include "stats/ratios.hpp"
+#include "stats/returns.hpp"
+#include "../utils/counter_rng.hpp"
+#include "../utils/instrumentation.hpp"
+#include "../utils/summation.hpp"
+#include "../utils/task_scheduler.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <optional>
+#include <span>
+#include <stdexcept>
+
+namespace Stats::Bootstrap
+{
+    namespace
+    {
+        constexpr size_t kTile = 16;       // strategies per fused pass
+        constexpr size_t kChunk = 128;     // resamples per work item
+        constexpr size_t kIndexBatch = 16; // resamples whose indices are held at once
+        constexpr size_t kMetrics = 5;     // sharpe, sortino, omega, max drawdown, calmar
+        constexpr size_t kSampleBudget = size_t{1} << 23; // resampled metrics held at once (64 MiB)
+
+        void validate(const Options &options)
+        {
+            if (options.resamples == 0)
+                throw std::invalid_argument("Bootstrap needs at least one resample.");
+            if (options.blockLength == 0)
+                throw std::invalid_argument("Block length must be positive.");
+            if (!(options.confidence > 0.0 && options.confidence < 1.0))
+                throw std::invalid_argument("Confidence must be in (0, 1).");
+            if (options.periodsPerYear <= 0)
+                throw std::invalid_argument("Periods per year must be positive.");
+        }
+
+        // Returns of one tile, time-major: panel[t * kTile + s]. Missing lanes
+        // repeat the tile's first strategy so every lane stays finite.
+        struct Tile
+        {
+            size_t first = 0;
+            size_t width = 0;
+            std::vector<double> panel;
+            double shift[kTile] = {};
+        };
+
+        Tile makeTile(const std::vector<std::vector<double>> &strategies, size_t first, size_t length)
+        {
+            Tile tile;
+            tile.first = first;
+            tile.width = std::min(kTile, strategies.size() - first);
+            tile.panel.resize(length * kTile);
+            for (size_t s = 0; s < kTile; ++s)
+            {
+                const std::vector<double> &r = strategies[first + (s < tile.width ? s : 0)];
+                for (size_t t = 0; t < length; ++t)
+                    tile.panel[t * kTile + s] = r[t];
+                tile.shift[s] = Summation::sum(std::span<const double>(r)) / static_cast<double>(length);
+            }
+            return tile;
+        }
+
+        // One pass over a resample for every lane of the tile. Sums are taken
+        // about each strategy's full-sample mean so the variance does not
+        // cancel. out[m * kTile + s].
+        void fusedMetrics(const Tile &tile, const uint32_t *idx, size_t n, const Options &options, double *out)
+        {
+            double sum[kTile] = {}, sumSq[kTile] = {}, downSq[kTile] = {}, downCount[kTile] = {};
+            double gain[kTile] = {}, loss[kTile] = {}, mdd[kTile] = {};
+            double wealth[kTile], peak[kTile];
+            std::fill_n(wealth, kTile, 1.0);
+            std::fill_n(peak, kTile, 1.0);
+
+            const double rf = options.riskFreeRate, tau = options.omegaThreshold;
+            const double *shift = tile.shift;
+            for (size_t t = 0; t < n; ++t)
+            {
+                const double *row = tile.panel.data() + static_cast<size_t>(idx[t]) * kTile;
+                for (size_t s = 0; s < kTile; ++s)
+                {
+                    const double r = row[s];
+                    const double d = r - shift[s];
+                    sum[s] += d;
+                    sumSq[s] += d * d;
+
+                    const bool below = r < rf;
+                    const double excess = r - rf;
+                    downSq[s] += below ? excess * excess : 0.0;
+                    downCount[s] += below ? 1.0 : 0.0;
+
+                    const double dev = r - tau;
+                    const bool above = r >= tau;
+                    gain[s] += above ? dev : 0.0;
+                    loss[s] += above ? 0.0 : -dev;
+
+                    wealth[s] *= 1.0 + r;
+                    peak[s] = std::max(peak[s], wealth[s]);
+                    mdd[s] = std::max(mdd[s], (peak[s] - wealth[s]) / peak[s]);
+                }
+            }
+
+            const double inf = std::numeric_limits<double>::infinity();
+            const double len = static_cast<double>(n);
+            for (size_t s = 0; s < kTile; ++s)
+            {
+                const double mean = shift[s] + sum[s] / len;
+                const double variance = std::max(sumSq[s] - sum[s] * sum[s] / len, 0.0) / (len - 1.0);
+                out[0 * kTile + s] = Ratios::computeSharpeRatio(mean, variance, rf);
+
+                const double downsideDev = downCount[s] > 0.0 ? std::sqrt(downSq[s] / downCount[s]) : 0.0;
+                out[1 * kTile + s] = downsideDev > 0.0 ? (mean - rf) / downsideDev : inf;
+
+                out[2 * kTile + s] = loss[s] > 0.0 ? gain[s] / loss[s] : inf;
+                out[3 * kTile + s] = mdd[s];
+
+                const double annual = Returns::computeAnnualizedReturn(wealth[s] - 1.0, static_cast<int>(n),
+                                                                       options.periodsPerYear);
+                out[4 * kTile + s] = Ratios::computeCalmarRatio(annual, mdd[s]);
+            }
+        }
+
+        // Same interpolation rule as MathUtils::percentile, on sorted data,
+        // without multiplying an infinite neighbour by a zero weight.
+        double sortedQuantile(const double *sorted, size_t n, double p)
+        {
+            const double rank = p * static_cast<double>(n - 1);
+            const size_t lower = static_cast<size_t>(rank);
+            const double weight = rank - static_cast<double>(lower);
+            if (weight == 0.0 || lower + 1 >= n)
+                return sorted[lower];
+            return sorted[lower] * (1.0 - weight) + sorted[lower + 1] * weight;
+        }
+    }
+
+    void resampleIndices(size_t length, size_t resample, const Options &options, std::vector<uint32_t> &indices)
+    {
+        indices.resize(length);
+        if (length == 0)
+            return;
+        const Random::CounterRng rng(options.seed, resample);
+        const size_t block = options.blockLength;
+
+        if (options.scheme == Scheme::Block)
+        {
+            for (size_t t = 0, b = 0; t < length; ++b)
+            {
+                size_t pos = rng.below(b, length);
+                for (size_t j = 0; j < block && t < length; ++j)
+                {
+                    indices[t++] = static_cast<uint32_t>(pos);
+                    pos = pos + 1 == length ? 0 : pos + 1;
+                }
+            }
+            return;
+        }
+
+        const double restart = 1.0 / static_cast<double>(block);
+        size_t pos = 0;
+        for (size_t t = 0; t < length; ++t)
+        {
+            if (t == 0 || rng.uniform(2 * t) < restart)
+                pos = rng.below(2 * t + 1, length);
+            else
+                pos = pos + 1 == length ? 0 : pos + 1;
+            indices[t] = static_cast<uint32_t>(pos);
+        }
+    }
+
+    RatioIntervals bootstrapRatios(const std::vector<double> &returns, const Options &options)
+    {
+        return bootstrapRatios(std::vector<std::vector<double>>{returns}, options).front();
+    }
+
+    std::vector<RatioIntervals> bootstrapRatios(const std::vector<std::vector<double>> &strategies,
+                                                const Options &options)
+    {
+        TRADEIQ_TIMED_SCOPE("stats.bootstrap");
+        validate(options);
+        if (strategies.empty())
+            return {};
+        const size_t n = strategies[0].size();
+        if (n < 2)
+            throw std::invalid_argument("Bootstrap needs at least 2 returns.");
+        if (n > std::numeric_limits<uint32_t>::max())
+            throw std::invalid_argument("Series too long for 32-bit resample indices.");
+        for (const auto &s : strategies)
+            if (s.size() != n)
+                throw std::invalid_argument("Strategies must have the same length.");
+
+        std::optional<Tasks::TaskScheduler> ownPool;
+        if (options.threads)
+            ownPool.emplace(Tasks::SchedulerOptions{options.threads});
+        Tasks::TaskScheduler &pool = ownPool ? *ownPool : Tasks::TaskScheduler::global();
+        const size_t resamples = options.resamples;
+        const size_t chunks = (resamples + kChunk - 1) / kChunk;
+        const double tail = 0.5 * (1.0 - options.confidence);
+
+        std::vector<uint32_t> identity(n);
+        std::iota(identity.begin(), identity.end(), 0u);
+
+        std::vector<RatioIntervals> out(strategies.size());
+        // As many tiles per pass as keep the samples within kSampleBudget; the
+        // indices of each resample are drawn once per pass and shared by all
+        // of its tiles.
+        const size_t tiles = (strategies.size() + kTile - 1) / kTile;
+        const size_t tileSamples = kMetrics * kTile * resamples;
+        const size_t perPass = std::clamp<size_t>(kSampleBudget / tileSamples, 1, tiles);
+
+        std::vector<Tile> pass;
+        // samples[p * tileSamples + (m * kTile + s) * resamples + b] for tile p of the pass.
+        std::vector<double> samples;
+        std::vector<double> estimates;
+
+        for (size_t firstTile = 0; firstTile < tiles; firstTile += perPass)
+        {
+            pass.clear();
+            for (size_t t = firstTile; t < std::min(tiles, firstTile + perPass); ++t)
+                pass.push_back(makeTile(strategies, t * kTile, n));
+            samples.resize(pass.size() * tileSamples);
+            estimates.resize(pass.size() * kMetrics * kTile);
+            for (size_t p = 0; p < pass.size(); ++p)
+                fusedMetrics(pass[p], identity.data(), n, options, estimates.data() + p * kMetrics * kTile);
+
+            pool.parallelFor(chunks, [&](size_t c)
+            {
+                // One set per worker thread, so chunks reuse the allocations.
+                thread_local std::vector<std::vector<uint32_t>> idx;
+                if (idx.size() < kIndexBatch)
+                    idx.resize(kIndexBatch);
+                double metrics[kMetrics * kTile];
+                const size_t chunkEnd = std::min(resamples, (c + 1) * kChunk);
+                for (size_t begin = c * kChunk; begin < chunkEnd; begin += kIndexBatch)
+                {
+                    const size_t end = std::min(chunkEnd, begin + kIndexBatch);
+                    for (size_t b = begin; b < end; ++b)
+                        resampleIndices(n, b, options, idx[b - begin]);
+
+                    for (size_t p = 0; p < pass.size(); ++p)
+                    {
+                        double *tileOut = samples.data() + p * tileSamples;
+                        for (size_t b = begin; b < end; ++b)
+                        {
+                            fusedMetrics(pass[p], idx[b - begin].data(), n, options, metrics);
+                            for (size_t k = 0; k < kMetrics * kTile; ++k)
+                                tileOut[k * resamples + b] = metrics[k];
+                        }
+                    }
+                }
+            });
+
+            pool.parallelFor(pass.size() * kMetrics * kTile, [&](size_t job)
+            {
+                const size_t p = job / (kMetrics * kTile), k = job % (kMetrics * kTile);
+                const size_t m = k / kTile, s = k % kTile;
+                if (s >= pass[p].width)
+                    return;
+                double *data = samples.data() + p * tileSamples + k * resamples;
+                std::sort(data, data + resamples);
+
+                RatioIntervals &r = out[pass[p].first + s];
+                Interval *intervals[kMetrics] = {&r.sharpe, &r.sortino, &r.omega, &r.maxDrawdown, &r.calmar};
+                intervals[m]->estimate = estimates[p * kMetrics * kTile + k];
+                intervals[m]->lower = sortedQuantile(data, resamples, tail);
+                intervals[m]->upper = sortedQuantile(data, resamples, 1.0 - tail);
+            });
+        }
+        return out;
+    }
+
+}
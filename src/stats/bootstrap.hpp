@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Bootstrap confidence intervals for return-based ratios.
+//
+// Resamples are drawn in blocks so serial dependence (volatility clustering,
+// drawdown runs) survives: the moving-block scheme copies fixed-length
+// circular blocks, the stationary scheme (Politis & Romano) uses geometric
+// block lengths with mean `blockLength`. blockLength = 1 is the i.i.d.
+// bootstrap.
+//
+// Resample b draws from a counter-based stream keyed by (seed, b), so results
+// do not depend on the thread count, and every strategy in a batch sees the
+// same index sequence for a given b (paired resampling keeps cross-strategy
+// dependence). Strategies are processed in tiles stored time-major, so one
+// index gathers a row of returns and a single fused pass updates every
+// metric for the whole tile.
+namespace Stats::Bootstrap
+{
+
+    enum class Scheme
+    {
+        Block,
+        Stationary
+    };
+
+    struct Options
+    {
+        Scheme scheme = Scheme::Stationary;
+        size_t resamples = 1000;
+        size_t blockLength = 20;
+        double confidence = 0.95;
+        double riskFreeRate = 0.0;   // per period, for Sharpe and Sortino
+        double omegaThreshold = 0.0; // per period
+        int periodsPerYear = 252;    // for Calmar's annualized return
+        uint64_t seed = 42;
+        unsigned threads = 0;        // 0 = shared task pool
+    };
+
+    // Point estimate on the original series plus the percentile interval.
+    struct Interval
+    {
+        double estimate = 0.0;
+        double lower = 0.0;
+        double upper = 0.0;
+    };
+
+    // Per-period Sharpe, Sortino and Omega as in Stats::Ratios; max drawdown of
+    // the wealth path starting at 1; Calmar = annualized return / max drawdown.
+    struct RatioIntervals
+    {
+        Interval sharpe;
+        Interval sortino;
+        Interval omega;
+        Interval maxDrawdown;
+        Interval calmar;
+    };
+
+    // Fills `indices` with resample `resample` of a series of `length` periods.
+    void resampleIndices(size_t length, size_t resample, const Options &options, std::vector<uint32_t> &indices);
+
+    // Throws std::invalid_argument for fewer than 2 returns or invalid options.
+    RatioIntervals bootstrapRatios(const std::vector<double> &returns, const Options &options = {});
+
+    // All strategies must have the same length.
+    std::vector<RatioIntervals> bootstrapRatios(const std::vector<std::vector<double>> &strategies,
+                                                const Options &options = {});
+
+}
@@ -1,49 +1,54 @@
 #include "stats/capture.hpp"
+#include "../utils/summation.hpp"
+#include <array>
 #include <stdexcept>
-#include <numeric>
 
 namespace Stats::Capture {
 
-double computeUpsideCaptureRatio(const std::vector<double>& portfolioReturns,
-                                 const std::vector<double>& benchmarkReturns) {
-    if (portfolioReturns.size() != benchmarkReturns.size())
-        throw std::invalid_argument("Return vectors must be the same length.");
+namespace {
+
+// Sums of portfolio and benchmark returns over the periods where `keep(benchmark)` holds.
+template <typename T, typename Pred>
+std::array<T, 2> conditionalSums(const std::vector<T>& portfolio, const std::vector<T>& benchmark, Pred keep) {
+    const T* p = portfolio.data();
+    const T* b = benchmark.data();
+    return Summation::reduce<2, T>(benchmark.size(), [p, b, keep](size_t i) {
+        bool k = keep(b[i]);
+        return std::array<T, 2>{k ? p[i] : T(0), k ? b[i] : T(0)};
+    });
+}
 
-    double portfolioSum = 0.0;
-    double benchmarkSum = 0.0;
+}
 
-    for (size_t i = 0; i < benchmarkReturns.size(); ++i) {
-        if (benchmarkReturns[i] > 0.0) {
-            portfolioSum += portfolioReturns[i];
-            benchmarkSum += benchmarkReturns[i];
-        }
-    }
+template <typename T>
+T computeUpsideCaptureRatio(const std::vector<T>& portfolioReturns,
+                            const std::vector<T>& benchmarkReturns) {
+    if (portfolioReturns.size() != benchmarkReturns.size())
+        throw std::invalid_argument("Return vectors must be the same length.");
 
-    if (benchmarkSum == 0.0)
-        return 0.0;
+    auto sums = conditionalSums(portfolioReturns, benchmarkReturns, [](T b) { return b > 0; });
+    if (sums[1] == 0)
+        return 0;
 
-    return portfolioSum / benchmarkSum;
+    return sums[0] / sums[1];
 }
 
-double computeDownsideCaptureRatio(const std::vector<double>& portfolioReturns,
-                                   const std::vector<double>& benchmarkReturns) {
+template <typename T>
+T computeDownsideCaptureRatio(const std::vector<T>& portfolioReturns,
+                              const std::vector<T>& benchmarkReturns) {
     if (portfolioReturns.size() != benchmarkReturns.size())
         throw std::invalid_argument("Return vectors must be the same length.");
 
-    double portfolioSum = 0.0;
-    double benchmarkSum = 0.0;
-
-    for (size_t i = 0; i < benchmarkReturns.size(); ++i) {
-        if (benchmarkReturns[i] < 0.0) {
-            portfolioSum += portfolioReturns[i];
-            benchmarkSum += benchmarkReturns[i];
-        }
-    }
+    auto sums = conditionalSums(portfolioReturns, benchmarkReturns, [](T b) { return b < 0; });
+    if (sums[1] == 0)
+        return 0;
 
-    if (benchmarkSum == 0.0)
-        return 0.0;
-
-    return portfolioSum / benchmarkSum;
+    return sums[0] / sums[1];
 }
 
+template float computeUpsideCaptureRatio<float>(const std::vector<float>&, const std::vector<float>&);
+template double computeUpsideCaptureRatio<double>(const std::vector<double>&, const std::vector<double>&);
+template float computeDownsideCaptureRatio<float>(const std::vector<float>&, const std::vector<float>&);
+template double computeDownsideCaptureRatio<double>(const std::vector<double>&, const std::vector<double>&);
+
 }
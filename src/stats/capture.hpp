@@ -4,9 +4,11 @@
 
 namespace Stats::Capture {
 
-    double computeUpsideCaptureRatio(const std::vector<double>& portfolioReturns,
-                                     const std::vector<double>& benchmarkReturns);
+    template <typename T = double>
+    T computeUpsideCaptureRatio(const std::vector<T>& portfolioReturns,
+                                const std::vector<T>& benchmarkReturns);
 
-    double computeDownsideCaptureRatio(const std::vector<double>& portfolioReturns,
-                                       const std::vector<double>& benchmarkReturns);
+    template <typename T = double>
+    T computeDownsideCaptureRatio(const std::vector<T>& portfolioReturns,
+                                  const std::vector<T>& benchmarkReturns);
 }
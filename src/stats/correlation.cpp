@@ -1,30 +1,36 @@
 #include "stats/correlation.hpp"
 #include "stats/returns.hpp"
-#include "../utils/math_utils.hpp"
+#include "../utils/instrumentation.hpp"
+#include "../utils/kernels.hpp"
+#include "../utils/summation.hpp"
 
-// delete for debugging
-#include <iostream>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <span>
+#include <stdexcept>
 
 namespace Stats::Correlation
 {
-
-    std::vector<std::vector<double>> computeCorrelationMatrix(const std::vector<PriceSeries> &assets)
+    namespace
     {
-        size_t n = assets.size();
-        std::vector<std::vector<double>> matrix(n, std::vector<double>(n, 1.0));
-
-        if (n == 0)
-            return matrix;
-
-        std::vector<std::vector<double>> returns(n);
-        for (size_t i = 0; i < n; ++i)
+        template <typename Vec>
+        void dailyReturnsInto(const PriceSeries &series, Vec &returns)
         {
-            returns[i] = assets[i].getDailyReturns();
+            const auto &prices = series.getPrices();
+            if (prices.size() < 2)
+                return;
+            returns.reserve(prices.size() - 1);
+            for (size_t i = 1; i < prices.size(); ++i)
+                returns.push_back((prices[i] - prices[i - 1]) / prices[i - 1]);
         }
 
-        for (size_t i = 0; i < n; ++i)
+        // Upper-triangle row i: pairs (i, j > i) over their common prefix; means
+        // are taken over that prefix in place rather than on copied sub-vectors.
+        template <typename Returns, typename Matrix>
+        void correlationRow(const Returns &returns, Matrix &matrix, size_t i)
         {
-            for (size_t j = i + 1; j < n; ++j)
+            for (size_t j = i + 1; j < returns.size(); ++j)
             {
                 const auto &r1 = returns[i];
                 const auto &r2 = returns[j];
@@ -36,21 +42,8 @@ namespace Stats::Correlation
                     continue;
                 }
 
-                std::vector<double>  sub_r1(r1.begin(), r1.begin() + len);
-                std::vector<double>  sub_r2(r2.begin(), r2.begin() + len);
-
-                double mean1 = MathUtils::mean(sub_r1);
-                double mean2 = MathUtils::mean(sub_r2);
-                
-                double numerator = 0.0, denom1 = 0.0, denom2 = 0.0;
-                for (size_t k = 0; k < len; ++k)
-                {
-                    double d1 = r1[k] - mean1;
-                    double d2 = r2[k] - mean2;
-                    numerator += d1 * d2;
-                    denom1 += d1 * d1;
-                    denom2 += d2 * d2;
-                }
+                const auto products = Kernels::centredCrossSums(r1.data(), r2.data(), len);
+                double numerator = products[0], denom1 = products[1], denom2 = products[2];
 
                 double corr = (denom1 > 0 && denom2 > 0)
                                   ? numerator / std::sqrt(denom1 * denom2)
@@ -60,6 +53,153 @@ namespace Stats::Correlation
             }
         }
 
+        // Task k owns rows k and n - 1 - k, so every task has about n pairs.
+        template <typename Policy, typename Returns, typename Matrix>
+        void correlationInto(Policy policy, const Returns &returns, Matrix &matrix)
+        {
+            const size_t n = returns.size();
+            Execution::forEach(policy, (n + 1) / 2, [&](size_t k) {
+                correlationRow(returns, matrix, k);
+                if (n - 1 - k != k)
+                    correlationRow(returns, matrix, n - 1 - k);
+            });
+        }
+
+        template <typename Policy>
+        std::vector<std::vector<double>> correlationMatrix(Policy policy, const std::vector<PriceSeries> &assets)
+        {
+            size_t n = assets.size();
+            std::vector<std::vector<double>> matrix(n, std::vector<double>(n, 1.0));
+
+            if (n == 0)
+                return matrix;
+
+            std::vector<std::vector<double>> returns(n);
+            Execution::forEach(policy, n, [&](size_t i) { returns[i] = assets[i].getDailyReturns(); });
+
+            correlationInto(policy, returns, matrix);
+            return matrix;
+        }
+
+        template <typename Policy>
+        std::vector<std::vector<double>> covarianceMatrix(Policy policy, const std::vector<std::vector<double>> &returns,
+                                                          bool sample)
+        {
+            const size_t n = returns.size();
+            if (n == 0)
+                return {};
+
+            size_t len = returns[0].size();
+            for (const auto &r : returns)
+                len = std::min(len, r.size());
+            if (len < 2)
+                throw std::invalid_argument("Covariance needs at least two common observations.");
+
+            std::vector<std::vector<double>> centered(n);
+            Execution::forEach(policy, n, [&](size_t i) {
+                std::span<const double> r(returns[i].data(), len);
+                const double mean = Summation::sum(r) / static_cast<double>(len);
+                centered[i].resize(len);
+                for (size_t t = 0; t < len; ++t)
+                    centered[i][t] = r[t] - mean;
+            });
+
+            // Rows are processed in blocks so each streamed column series is
+            // reused across the block while it is still in cache. Block b
+            // covers b + 1 column blocks, so the largest are handed out first.
+            constexpr size_t kBlock = 16;
+            const size_t blocks = (n + kBlock - 1) / kBlock;
+            const double denom = static_cast<double>(sample ? len - 1 : len);
+            std::vector<std::vector<double>> cov(n, std::vector<double>(n, 0.0));
+            Execution::forEach(policy, blocks, [&](size_t k) {
+                const size_t i0 = (blocks - 1 - k) * kBlock;
+                const size_t i1 = std::min(n, i0 + kBlock);
+                for (size_t j = 0; j < i1; ++j)
+                {
+                    const double *y = centered[j].data();
+                    for (size_t i = std::max(i0, j); i < i1; ++i)
+                    {
+                        const double *x = centered[i].data();
+                        double c = Kernels::dot(x, y, len) / denom;
+                        cov[i][j] = cov[j][i] = c;
+                    }
+                }
+            });
+            return cov;
+        }
+    }
+
+    std::vector<std::vector<double>> computeCorrelationMatrix(const std::vector<PriceSeries> &assets)
+    {
+        TRADEIQ_TIMED_SCOPE("stats.correlation_matrix");
+        return correlationMatrix(Execution::seq, assets);
+    }
+
+    template <Execution::Policy P>
+    std::vector<std::vector<double>> computeCorrelationMatrix(P policy, const std::vector<PriceSeries> &assets)
+    {
+        TRADEIQ_TIMED_SCOPE("stats.correlation_matrix");
+        return correlationMatrix(policy, assets);
+    }
+
+    std::pmr::vector<std::pmr::vector<double>> computeCorrelationMatrix(const std::vector<PriceSeries> &assets,
+                                                                         std::pmr::memory_resource *scratch)
+    {
+        TRADEIQ_TIMED_SCOPE("stats.correlation_matrix");
+        if (!scratch)
+            scratch = std::pmr::get_default_resource();
+
+        // Inner vectors pick up `scratch` through uses-allocator construction.
+        size_t n = assets.size();
+        std::pmr::vector<std::pmr::vector<double>> matrix(scratch);
+        matrix.reserve(n);
+        for (size_t i = 0; i < n; ++i)
+            matrix.emplace_back(n, 1.0);
+
+        if (n == 0)
+            return matrix;
+
+        std::pmr::vector<std::pmr::vector<double>> returns(scratch);
+        returns.resize(n);
+        for (size_t i = 0; i < n; ++i)
+            dailyReturnsInto(assets[i], returns[i]);
+
+        correlationInto(Execution::seq, returns, matrix);
         return matrix;
     }
-}
\ No newline at end of file
+
+    std::vector<std::vector<double>> computeCovarianceMatrix(const std::vector<std::vector<double>> &returns,
+                                                             bool sample)
+    {
+        TRADEIQ_TIMED_SCOPE("stats.covariance_matrix");
+        return covarianceMatrix(Execution::seq, returns, sample);
+    }
+
+    template <Execution::Policy P>
+    std::vector<std::vector<double>> computeCovarianceMatrix(P policy, const std::vector<std::vector<double>> &returns,
+                                                             bool sample)
+    {
+        TRADEIQ_TIMED_SCOPE("stats.covariance_matrix");
+        return covarianceMatrix(policy, returns, sample);
+    }
+
+    std::vector<std::vector<double>> computeCovarianceMatrix(const std::vector<PriceSeries> &assets, bool sample)
+    {
+        std::vector<std::vector<double>> returns;
+        returns.reserve(assets.size());
+        for (const auto &a : assets)
+            returns.push_back(a.getDailyReturns());
+        return computeCovarianceMatrix(returns, sample);
+    }
+
+#define TRADEIQ_CORRELATION_POLICY_INSTANTIATE(P)                                                                    \
+    template std::vector<std::vector<double>> computeCorrelationMatrix<P>(P, const std::vector<PriceSeries> &);       \
+    template std::vector<std::vector<double>> computeCovarianceMatrix<P>(P, const std::vector<std::vector<double>> &, \
+                                                                         bool);
+
+    TRADEIQ_CORRELATION_POLICY_INSTANTIATE(Execution::SequencedPolicy)
+    TRADEIQ_CORRELATION_POLICY_INSTANTIATE(Execution::ParallelPolicy)
+    TRADEIQ_CORRELATION_POLICY_INSTANTIATE(Execution::ParallelUnsequencedPolicy)
+
+#undef TRADEIQ_CORRELATION_POLICY_INSTANTIATE
+}
@@ -1,6 +1,8 @@
 #pragma once
 
 #include "core/price_series.hpp"
+#include "../utils/execution.hpp"
+#include <memory_resource>
 #include <vector>
 
 namespace Stats::Correlation
@@ -8,4 +10,27 @@ namespace Stats::Correlation
 
     std::vector<std::vector<double>> computeCorrelationMatrix(const std::vector<PriceSeries> &assets);
 
+    // Result and per-asset return buffers come from `scratch`; nullptr uses the default resource.
+    std::pmr::vector<std::pmr::vector<double>> computeCorrelationMatrix(const std::vector<PriceSeries> &assets,
+                                                                         std::pmr::memory_resource *scratch);
+
+    // Covariance over the prefix common to every series (not pairwise prefixes),
+    // so the matrix stays positive semi-definite for PCA and risk decomposition.
+    // Divides by L - 1 when `sample`. Throws if the common length is below 2.
+    std::vector<std::vector<double>> computeCovarianceMatrix(const std::vector<std::vector<double>> &returns,
+                                                             bool sample = true);
+
+    // Same, on daily returns of each price series.
+    std::vector<std::vector<double>> computeCovarianceMatrix(const std::vector<PriceSeries> &assets,
+                                                             bool sample = true);
+
+    // Policy forms: per-asset returns and blocks of pairs run as separate
+    // tasks. Every entry is computed exactly as in the sequential form.
+    template <Execution::Policy P>
+    std::vector<std::vector<double>> computeCorrelationMatrix(P policy, const std::vector<PriceSeries> &assets);
+
+    template <Execution::Policy P>
+    std::vector<std::vector<double>> computeCovarianceMatrix(P policy, const std::vector<std::vector<double>> &returns,
+                                                             bool sample = true);
+
 }
@@ -1,63 +1,60 @@
 #include "stats/distribution.hpp"
+#include "stats/moments.hpp"
+#include "../utils/summation.hpp"
+#include <array>
 #include <stdexcept>
 #include <cmath>
-#include <numeric>
-#include <unordered_set>
+#include <limits>
 
 namespace Stats::Distribution {
 
-double computeSkewness(const std::vector<double>& returns) {
+template <typename T>
+T computeSkewness(const std::vector<T>& returns) {
     if (returns.empty()) throw std::invalid_argument("Empty return series");
 
-    std::unordered_set<double> s(returns.begin(), returns.end());
-    if (s.size() == 1) throw std::invalid_argument("All Elements are identical"); 
-
-
-    double mean = std::accumulate(returns.begin(), returns.end(), 0.0) / returns.size();
-    double sum_sq = 0.0, sum_cube = 0.0;
-    for (double r : returns) {
-        double dev = r - mean;
-        sum_sq += dev * dev;
-        sum_cube += dev * dev * dev;
-    }
-    double n = static_cast<double>(returns.size());
-    if (sum_sq == 0.0) throw std::invalid_argument("Zero variance");
-    return (n / ((n - 1) * (n - 2))) * (sum_cube / std::pow(sum_sq / (n - 1), 1.5));
+    auto m = Moments::summarize<3>(returns);
+    if (m.constant) throw std::invalid_argument("All Elements are identical");
+    if (m.m2 == 0) throw std::invalid_argument("Zero variance");
+    return Moments::skewness(m, Moments::Estimator::Unbiased);
 }
 
-double computeKurtosis(const std::vector<double>& returns) {
+template <typename T>
+T computeKurtosis(const std::vector<T>& returns) {
     if (returns.empty()) throw std::invalid_argument("Empty return series");
-    double mean = std::accumulate(returns.begin(), returns.end(), 0.0) / returns.size();
-    double sum_sq = 0.0, sum_quad = 0.0;
-    for (double r : returns) {
-        double dev = r - mean;
-        sum_sq += dev * dev;
-        sum_quad += dev * dev * dev * dev;
-    }
-    double n = static_cast<double>(returns.size());
-    if (sum_sq == 0.0) return std::numeric_limits<double>::quiet_NaN();  // Undefined
-    double variance = sum_sq / n;
-    double kurtosis = (sum_quad / n) / (variance * variance);
-    return kurtosis - 3.0;  // Excess kurtosis
+    auto m = Moments::summarize<4>(returns);
+    if (m.m2 == 0) return std::numeric_limits<T>::quiet_NaN();  // Undefined
+    return Moments::excessKurtosis(m, Moments::Estimator::Population);
 }
 
-double computeGainLossRatio(const std::vector<double>& returns) {
+template <typename T>
+T computeGainLossRatio(const std::vector<T>& returns) {
     if (returns.empty()) throw std::invalid_argument("Empty return series");
-    double gains = 0.0, losses = 0.0;
-    for (double r : returns) {
-        if (r > 0) gains += r;
-        else if (r < 0) losses -= r;
-    }
-    if (losses == 0.0) return std::numeric_limits<double>::infinity();
-    return gains / losses;
+    const T *p = returns.data();
+    auto sums = Summation::reduce<2, T>(returns.size(), [p](size_t i) {
+        return std::array<T, 2>{p[i] > 0 ? p[i] : T(0), p[i] < 0 ? -p[i] : T(0)};
+    });
+    if (sums[1] == 0) return std::numeric_limits<T>::infinity();
+    return sums[0] / sums[1];
 }
 
-double computeHitRatio(const std::vector<double>& returns) {
+template <typename T>
+T computeHitRatio(const std::vector<T>& returns) {
     if (returns.empty()) throw std::invalid_argument("Empty return series");
-    int hits = 0;
-    for (double r : returns)
+    size_t hits = 0;
+    for (T r : returns)
         if (r > 0) ++hits;
-    return static_cast<double>(hits) / returns.size();
+    return static_cast<T>(static_cast<double>(hits) / returns.size());
 }
 
+#define TRADEIQ_DISTRIBUTION_INSTANTIATE(T)                   \
+    template T computeSkewness<T>(const std::vector<T>&);     \
+    template T computeKurtosis<T>(const std::vector<T>&);     \
+    template T computeGainLossRatio<T>(const std::vector<T>&); \
+    template T computeHitRatio<T>(const std::vector<T>&);
+
+TRADEIQ_DISTRIBUTION_INSTANTIATE(float)
+TRADEIQ_DISTRIBUTION_INSTANTIATE(double)
+
+#undef TRADEIQ_DISTRIBUTION_INSTANTIATE
+
 }
@@ -4,9 +4,9 @@
 
 namespace Stats::Distribution {
 
-    double computeSkewness(const std::vector<double>& returns);
-    double computeKurtosis(const std::vector<double>& returns);
-    double computeGainLossRatio(const std::vector<double>& returns);
-    double computeHitRatio(const std::vector<double>& returns);
+    template <typename T = double> T computeSkewness(const std::vector<T>& returns);
+    template <typename T = double> T computeKurtosis(const std::vector<T>& returns);
+    template <typename T = double> T computeGainLossRatio(const std::vector<T>& returns);
+    template <typename T = double> T computeHitRatio(const std::vector<T>& returns);
 
 }
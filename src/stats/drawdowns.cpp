@@ -1,4 +1,9 @@
 #include "stats/drawdowns.hpp"
+#include "stats/ratios.hpp"
+#include "stats/returns.hpp"
+#include "../utils/instrumentation.hpp"
+#include "../utils/summation.hpp"
+#include <algorithm>
 #include <limits>
 #include <stdexcept>
 #include <cmath>
@@ -6,19 +11,20 @@
 namespace Stats::Drawdowns
 {
 
-    double computeMaxDrawdown(const std::vector<double> &cumulativeReturns)
+    template <typename T>
+    T computeMaxDrawdown(const std::vector<T> &cumulativeReturns)
     {
         if (cumulativeReturns.empty())
-            return 0.0;
+            return 0;
 
-        double peak = cumulativeReturns[0];
-        double maxDrawdown = 0.0;
+        T peak = cumulativeReturns[0];
+        T maxDrawdown = 0;
 
         for (const auto &val : cumulativeReturns)
         {
             if (val > peak)
                 peak = val;
-            double drawdown = (peak - val) / peak;
+            T drawdown = (peak - val) / peak;
             if (drawdown > maxDrawdown)
                 maxDrawdown = drawdown;
         }
@@ -26,12 +32,13 @@ namespace Stats::Drawdowns
         return maxDrawdown;
     }
 
-    int computeMaxRecoveryTime(const std::vector<double> &cumulativeReturns)
+    template <typename T>
+    int computeMaxRecoveryTime(const std::vector<T> &cumulativeReturns)
     {
         if (cumulativeReturns.empty())
             return 0;
 
-        double peak = cumulativeReturns[0];
+        T peak = cumulativeReturns[0];
         size_t peakIndex = 0;
         int maxRecovery = 0;
 
@@ -69,28 +76,29 @@ namespace Stats::Drawdowns
         return maxRecovery;
     }
 
-    double computeAverageDrawdown(const std::vector<double> &cumulativeReturns)
+    template <typename T>
+    T computeAverageDrawdown(const std::vector<T> &cumulativeReturns)
     {
         if (cumulativeReturns.empty())
-            return 0.0;
+            return 0;
 
-        double peak = cumulativeReturns[0];
-        double trough = cumulativeReturns[0];
-        double drawdownSum = 0.0;
+        T peak = cumulativeReturns[0];
+        T trough = cumulativeReturns[0];
+        Summation::Accumulator<T> drawdownSum;
         int drawdownCount = 0;
         bool inDrawdown = false;
 
         for (size_t i = 1; i < cumulativeReturns.size(); ++i)
         {
-            double val = cumulativeReturns[i];
+            T val = cumulativeReturns[i];
 
             if (val > peak)
             {
                 // Closing any existing drawdown
                 if (inDrawdown)
                 {
-                    double dd = (peak - trough) / peak;
-                    drawdownSum += dd;
+                    T dd = (peak - trough) / peak;
+                    drawdownSum.add(dd);
                     drawdownCount++;
                     inDrawdown = false;
                 }
@@ -108,12 +116,241 @@ namespace Stats::Drawdowns
         // Handle drawdown at end of series
         if (inDrawdown)
         {
-            double dd = (peak - trough) / peak;
-            drawdownSum += dd;
+            T dd = (peak - trough) / peak;
+            drawdownSum.add(dd);
             drawdownCount++;
         }
 
-        return drawdownCount == 0 ? 0.0 : drawdownSum / drawdownCount;
+        return drawdownCount == 0 ? T(0) : drawdownSum.value() / static_cast<T>(drawdownCount);
+    }
+
+    namespace
+    {
+        size_t windowCount(size_t n, size_t w)
+        {
+            return w == 0 || n < w ? 0 : n - w + 1;
+        }
+
+        // Monotonic deque of indices whose values strictly improve on
+        // everything behind them under `better`; the front is the extreme.
+        template <typename T, typename Better>
+        std::vector<T> slidingExtreme(const std::vector<T> &values, size_t w, Better better)
+        {
+            std::vector<T> result;
+            const size_t n = values.size();
+            result.reserve(windowCount(n, w));
+            if (w == 0 || n < w)
+                return result;
+
+            std::vector<size_t> deque(n);
+            size_t head = 0, tail = 0;
+            for (size_t i = 0; i < n; ++i)
+            {
+                while (tail > head && !better(values[deque[tail - 1]], values[i]))
+                    --tail;
+                deque[tail++] = i;
+                if (deque[head] + w <= i)
+                    ++head;
+                if (i + 1 >= w)
+                    result.push_back(values[deque[head]]);
+            }
+            return result;
+        }
+
+        template <typename T>
+        struct DrawdownScratch
+        {
+            std::vector<T> sufHi, sufDd, preLo, preDd;
+        };
+
+        // Windows starting in block [bs, bs + w) are the block's suffix from i
+        // combined with the next block's prefix up to i + w - 1; the suffix
+        // keeps (max, drawdown) and the prefix (min, drawdown). Scratch holds
+        // one block per side, so it stays in cache and can be reused across
+        // columns.
+        template <typename T>
+        void slidingDrawdown(const T *x, size_t n, size_t w, DrawdownScratch<T> &scratch, T *out)
+        {
+            if (w == 0 || n < w)
+                return;
+
+            scratch.sufHi.resize(w);
+            scratch.sufDd.resize(w);
+            scratch.preLo.resize(w);
+            scratch.preDd.resize(w);
+            T *sh = scratch.sufHi.data(), *sd = scratch.sufDd.data();
+            T *pl = scratch.preLo.data(), *pd = scratch.preDd.data();
+
+            const size_t windows = n - w + 1;
+            for (size_t bs = 0; bs < windows; bs += w)
+            {
+                const T *block = x + bs;
+                T lo = sh[w - 1] = block[w - 1];
+                sd[w - 1] = 0;
+                for (size_t k = w - 1; k-- > 0;)
+                {
+                    const T v = block[k];
+                    sd[k] = std::max(sd[k + 1], (v - lo) / v);
+                    lo = std::min(lo, v);
+                    sh[k] = std::max(sh[k + 1], v);
+                }
+                out[bs] = sd[0];
+
+                const T *next = block + w;
+                const size_t count = std::min(bs + w, windows) - bs - 1;
+                T hi = 0;
+                for (size_t k = 0; k < count; ++k)
+                {
+                    const T v = next[k];
+                    if (k == 0)
+                    {
+                        hi = pl[0] = v;
+                        pd[0] = 0;
+                    }
+                    else
+                    {
+                        pd[k] = std::max(pd[k - 1], (hi - v) / hi);
+                        hi = std::max(hi, v);
+                        pl[k] = std::min(pl[k - 1], v);
+                    }
+                    out[bs + k + 1] = std::max(std::max(sd[k + 1], pd[k]), (sh[k + 1] - pl[k]) / sh[k + 1]);
+                }
+            }
+        }
+
+        template <typename T>
+        T windowCalmar(T start, T end, size_t w, int periodsPerYear, T mdd)
+        {
+            const double annual = Stats::Returns::computeAnnualizedReturn(static_cast<double>(end / start - 1),
+                                                                          static_cast<int>(w - 1), periodsPerYear);
+            return static_cast<T>(Stats::Ratios::computeCalmarRatio(annual, static_cast<double>(mdd)));
+        }
+
+        template <typename T>
+        void checkPanel(const std::vector<std::vector<T>> &columns)
+        {
+            for (const auto &c : columns)
+                if (c.size() != columns[0].size())
+                    throw std::invalid_argument("Panel columns must have the same length.");
+        }
+    }
+
+    template <typename T>
+    std::vector<T> computeRollingMin(const std::vector<T> &values, size_t window)
+    {
+        return slidingExtreme(values, window, [](T a, T b) { return a < b; });
+    }
+
+    template <typename T>
+    std::vector<T> computeRollingMax(const std::vector<T> &values, size_t window)
+    {
+        return slidingExtreme(values, window, [](T a, T b) { return a > b; });
+    }
+
+    template <typename T>
+    std::vector<T> computeRollingMaxDrawdown(const std::vector<T> &cumulativeReturns, size_t window)
+    {
+        TRADEIQ_TIMED_SCOPE("stats.rolling_max_drawdown");
+        std::vector<T> result(windowCount(cumulativeReturns.size(), window));
+        DrawdownScratch<T> scratch;
+        slidingDrawdown(cumulativeReturns.data(), cumulativeReturns.size(), window, scratch, result.data());
+        return result;
     }
 
+    template <typename T>
+    std::vector<T> computeRollingCalmar(const std::vector<T> &cumulativeReturns, size_t window, int periodsPerYear)
+    {
+        if (window < 2)
+            return {};
+        std::vector<T> result = computeRollingMaxDrawdown(cumulativeReturns, window);
+        for (size_t i = 0; i < result.size(); ++i)
+            result[i] = windowCalmar(cumulativeReturns[i], cumulativeReturns[i + window - 1], window, periodsPerYear,
+                                     result[i]);
+        return result;
+    }
+
+    template <typename T>
+    std::vector<std::vector<T>> computeRollingMaxDrawdown(const std::vector<std::vector<T>> &cumulativeReturns,
+                                                          size_t window)
+    {
+        TRADEIQ_TIMED_SCOPE("stats.rolling_max_drawdown_panel");
+        checkPanel(cumulativeReturns);
+        const size_t cols = cumulativeReturns.size();
+        const size_t n = cols == 0 ? 0 : cumulativeReturns[0].size();
+        std::vector<std::vector<T>> result(cols, std::vector<T>(windowCount(n, window)));
+
+        DrawdownScratch<T> scratch;
+        for (size_t c = 0; c < cols; ++c)
+            slidingDrawdown(cumulativeReturns[c].data(), n, window, scratch, result[c].data());
+        return result;
+    }
+
+    template <typename T>
+    std::vector<std::vector<T>> computeRollingCalmar(const std::vector<std::vector<T>> &cumulativeReturns,
+                                                     size_t window, int periodsPerYear)
+    {
+        if (window < 2)
+        {
+            checkPanel(cumulativeReturns);
+            return std::vector<std::vector<T>>(cumulativeReturns.size());
+        }
+        std::vector<std::vector<T>> result = computeRollingMaxDrawdown(cumulativeReturns, window);
+        for (size_t c = 0; c < result.size(); ++c)
+        {
+            const std::vector<T> &w = cumulativeReturns[c];
+            for (size_t i = 0; i < result[c].size(); ++i)
+                result[c][i] = windowCalmar(w[i], w[i + window - 1], window, periodsPerYear, result[c][i]);
+        }
+        return result;
+    }
+
+    template <Execution::Policy P, typename T>
+    std::vector<T> computeMaxDrawdown(P policy, const std::vector<std::vector<T>> &cumulativeReturns)
+    {
+        TRADEIQ_TIMED_SCOPE("stats.max_drawdown_panel");
+        return Execution::map(policy, cumulativeReturns.size(),
+                              [&](size_t c) { return computeMaxDrawdown(cumulativeReturns[c]); });
+    }
+
+    template <Execution::Policy P, typename T>
+    std::vector<std::vector<T>> computeRollingMaxDrawdown(P policy, const std::vector<std::vector<T>> &cumulativeReturns,
+                                                          size_t window)
+    {
+        TRADEIQ_TIMED_SCOPE("stats.rolling_max_drawdown_panel");
+        return Execution::map(policy, cumulativeReturns.size(),
+                              [&](size_t c) { return computeRollingMaxDrawdown(cumulativeReturns[c], window); });
+    }
+
+    template float computeMaxDrawdown<float>(const std::vector<float> &);
+    template double computeMaxDrawdown<double>(const std::vector<double> &);
+    template int computeMaxRecoveryTime<float>(const std::vector<float> &);
+    template int computeMaxRecoveryTime<double>(const std::vector<double> &);
+    template float computeAverageDrawdown<float>(const std::vector<float> &);
+    template double computeAverageDrawdown<double>(const std::vector<double> &);
+    template std::vector<float> computeRollingMin<float>(const std::vector<float> &, size_t);
+    template std::vector<double> computeRollingMin<double>(const std::vector<double> &, size_t);
+    template std::vector<float> computeRollingMax<float>(const std::vector<float> &, size_t);
+    template std::vector<double> computeRollingMax<double>(const std::vector<double> &, size_t);
+    template std::vector<float> computeRollingMaxDrawdown<float>(const std::vector<float> &, size_t);
+    template std::vector<double> computeRollingMaxDrawdown<double>(const std::vector<double> &, size_t);
+    template std::vector<float> computeRollingCalmar<float>(const std::vector<float> &, size_t, int);
+    template std::vector<double> computeRollingCalmar<double>(const std::vector<double> &, size_t, int);
+    template std::vector<std::vector<float>> computeRollingMaxDrawdown<float>(const std::vector<std::vector<float>> &, size_t);
+    template std::vector<std::vector<double>> computeRollingMaxDrawdown<double>(const std::vector<std::vector<double>> &, size_t);
+    template std::vector<std::vector<float>> computeRollingCalmar<float>(const std::vector<std::vector<float>> &, size_t, int);
+    template std::vector<std::vector<double>> computeRollingCalmar<double>(const std::vector<std::vector<double>> &, size_t, int);
+
+#define TRADEIQ_DRAWDOWNS_POLICY_INSTANTIATE(P, T)                                                                   \
+    template std::vector<T> computeMaxDrawdown<P, T>(P, const std::vector<std::vector<T>> &);                        \
+    template std::vector<std::vector<T>> computeRollingMaxDrawdown<P, T>(P, const std::vector<std::vector<T>> &, size_t);
+
+    TRADEIQ_DRAWDOWNS_POLICY_INSTANTIATE(Execution::SequencedPolicy, float)
+    TRADEIQ_DRAWDOWNS_POLICY_INSTANTIATE(Execution::SequencedPolicy, double)
+    TRADEIQ_DRAWDOWNS_POLICY_INSTANTIATE(Execution::ParallelPolicy, float)
+    TRADEIQ_DRAWDOWNS_POLICY_INSTANTIATE(Execution::ParallelPolicy, double)
+    TRADEIQ_DRAWDOWNS_POLICY_INSTANTIATE(Execution::ParallelUnsequencedPolicy, float)
+    TRADEIQ_DRAWDOWNS_POLICY_INSTANTIATE(Execution::ParallelUnsequencedPolicy, double)
+
+#undef TRADEIQ_DRAWDOWNS_POLICY_INSTANTIATE
+
 } // namespace Stats::Drawdowns
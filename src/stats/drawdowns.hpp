@@ -1,13 +1,58 @@
 #pragma once
 
+#include "../utils/execution.hpp"
+#include <cstddef>
 #include <vector>
 
 namespace Stats::Drawdowns {
 
-    double computeMaxDrawdown(const std::vector<double>& cumulativeReturns);
+    template <typename T = double>
+    T computeMaxDrawdown(const std::vector<T>& cumulativeReturns);
 
-    int computeMaxRecoveryTime(const std::vector<double>& cumulativeReturns);
+    template <typename T = double>
+    int computeMaxRecoveryTime(const std::vector<T>& cumulativeReturns);
 
-    double computeAverageDrawdown(const std::vector<double>& cumulativeReturns);
+    template <typename T = double>
+    T computeAverageDrawdown(const std::vector<T>& cumulativeReturns);
+
+    // Sliding-window kernels. Each returns one value per full window
+    // (n - window + 1) and is empty when the window is 0 or longer than the
+    // series. Min/max use a monotonic deque (amortized O(1) per step).
+    template <typename T = double>
+    std::vector<T> computeRollingMin(const std::vector<T>& values, size_t window);
+
+    template <typename T = double>
+    std::vector<T> computeRollingMax(const std::vector<T>& values, size_t window);
+
+    // computeMaxDrawdown of every `window`-point slice of the wealth index, in
+    // O(1) per step. Drawdown is a monoid over (min, max, max drawdown), so
+    // each window is one block suffix combined with the next block's prefix
+    // (van Herk / Gil-Werman). Matches computeMaxDrawdown on each slice.
+    template <typename T = double>
+    std::vector<T> computeRollingMaxDrawdown(const std::vector<T>& cumulativeReturns, size_t window);
+
+    // Annualized return over each window (window - 1 periods) divided by its
+    // max drawdown, as Stats::Ratios::computeCalmarRatio. Needs window >= 2.
+    template <typename T = double>
+    std::vector<T> computeRollingCalmar(const std::vector<T>& cumulativeReturns, size_t window, int periodsPerYear);
+
+    // Panel forms: one wealth series per column, all the same length; result[c][i].
+    // Columns share one set of block buffers.
+    template <typename T = double>
+    std::vector<std::vector<T>> computeRollingMaxDrawdown(const std::vector<std::vector<T>>& cumulativeReturns,
+                                                          size_t window);
+
+    template <typename T = double>
+    std::vector<std::vector<T>> computeRollingCalmar(const std::vector<std::vector<T>>& cumulativeReturns,
+                                                     size_t window, int periodsPerYear);
+
+    // Policy forms over many wealth series (lengths may differ), one task per
+    // series (see Execution); result[c] is the single-series result.
+    template <Execution::Policy P, typename T = double>
+    std::vector<T> computeMaxDrawdown(P policy, const std::vector<std::vector<T>>& cumulativeReturns);
+
+    template <Execution::Policy P, typename T = double>
+    std::vector<std::vector<T>> computeRollingMaxDrawdown(P policy, const std::vector<std::vector<T>>& cumulativeReturns,
+                                                          size_t window);
 
 }
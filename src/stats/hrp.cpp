@@ -0,0 +1,282 @@
+#include "stats/hrp.hpp"
+#include "stats/correlation.hpp"
+#include "../utils/instrumentation.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+namespace Stats::HRP
+{
+    namespace
+    {
+        // Strict upper triangle of a symmetric N x N matrix, row by row.
+        class CondensedMatrix
+        {
+        public:
+            explicit CondensedMatrix(size_t n) : n_(n), data_(n * (n - 1) / 2) {}
+
+            double &at(size_t i, size_t j)
+            {
+                if (i > j)
+                    std::swap(i, j);
+                return data_[i * n_ - i * (i + 1) / 2 + (j - i - 1)];
+            }
+
+        private:
+            size_t n_;
+            std::vector<double> data_;
+        };
+
+        template <typename Transform>
+        CondensedMatrix condense(const std::vector<std::vector<double>> &m, Transform transform)
+        {
+            const size_t n = m.size();
+            if (n == 0)
+                throw std::invalid_argument("Clustering needs at least one asset.");
+            for (const auto &row : m)
+                if (row.size() != n)
+                    throw std::invalid_argument("Matrix must be square.");
+
+            CondensedMatrix d(n);
+            for (size_t i = 0; i < n; ++i)
+                for (size_t j = i + 1; j < n; ++j)
+                    d.at(i, j) = transform(m[i][j]);
+            return d;
+        }
+
+        double toDistance(double rho)
+        {
+            return std::sqrt(std::max(0.0, 0.5 * (1.0 - rho)));
+        }
+
+        // Nearest-neighbour chain: follow nearest neighbours until two clusters
+        // are each other's nearest, merge them, and resume from the remaining
+        // chain. Ties prefer the previous chain element so the chain always
+        // terminates. Merged clusters live in the lower of their two slots.
+        Dendrogram nnChain(CondensedMatrix &d, size_t n, Linkage linkage)
+        {
+            struct RawMerge
+            {
+                size_t a, b;
+                double distance;
+            };
+
+            std::vector<size_t> size(n, 1);
+            std::vector<char> active(n, 1);
+            std::vector<RawMerge> raw;
+            raw.reserve(n - 1);
+            std::vector<size_t> chain;
+            chain.reserve(n);
+
+            size_t first = 0;
+            for (size_t step = 0; step + 1 < n; ++step)
+            {
+                if (chain.empty())
+                {
+                    while (!active[first])
+                        ++first;
+                    chain.push_back(first);
+                }
+
+                size_t a, b;
+                double best;
+                for (;;)
+                {
+                    a = chain.back();
+                    const size_t prev = chain.size() >= 2 ? chain[chain.size() - 2] : n;
+                    b = prev;
+                    best = prev < n ? d.at(a, prev) : std::numeric_limits<double>::infinity();
+                    for (size_t c = 0; c < n; ++c)
+                    {
+                        if (!active[c] || c == a)
+                            continue;
+                        const double x = d.at(a, c);
+                        if (x < best)
+                        {
+                            best = x;
+                            b = c;
+                        }
+                    }
+                    if (b == prev)
+                        break;
+                    chain.push_back(b);
+                }
+                chain.pop_back();
+                chain.pop_back();
+                if (a > b)
+                    std::swap(a, b);
+                raw.push_back({a, b, best});
+
+                // Lance-Williams update into slot a.
+                const double sa = static_cast<double>(size[a]), sb = static_cast<double>(size[b]);
+                for (size_t c = 0; c < n; ++c)
+                {
+                    if (!active[c] || c == a || c == b)
+                        continue;
+                    double &dac = d.at(a, c);
+                    const double dbc = d.at(b, c);
+                    dac = linkage == Linkage::Single ? std::min(dac, dbc) : (sa * dac + sb * dbc) / (sa + sb);
+                }
+                active[b] = 0;
+                size[a] += size[b];
+            }
+
+            // The chain finds merges out of distance order; sort them and
+            // relabel with a union-find so ids follow the SciPy convention.
+            std::stable_sort(raw.begin(), raw.end(),
+                             [](const RawMerge &x, const RawMerge &y) { return x.distance < y.distance; });
+
+            std::vector<size_t> parent(2 * n - 1), count(2 * n - 1, 1);
+            for (size_t i = 0; i < parent.size(); ++i)
+                parent[i] = i;
+            auto find = [&parent](size_t x) {
+                size_t root = x;
+                while (parent[root] != root)
+                    root = parent[root];
+                while (parent[x] != root)
+                    x = std::exchange(parent[x], root);
+                return root;
+            };
+
+            Dendrogram tree;
+            tree.leaves = n;
+            tree.merges.reserve(n - 1);
+            for (const RawMerge &m : raw)
+            {
+                const size_t x = find(m.a), y = find(m.b);
+                const size_t id = n + tree.merges.size();
+                count[id] = count[x] + count[y];
+                parent[x] = parent[y] = id;
+                tree.merges.push_back({std::min(x, y), std::max(x, y), m.distance, count[id]});
+            }
+            return tree;
+        }
+
+        // Variance of the inverse-variance portfolio over order[lo, hi).
+        double clusterVariance(const std::vector<std::vector<double>> &cov, const std::vector<size_t> &order,
+                               size_t lo, size_t hi, std::vector<double> &w)
+        {
+            w.resize(hi - lo);
+            double total = 0.0;
+            for (size_t i = lo; i < hi; ++i)
+                total += w[i - lo] = 1.0 / cov[order[i]][order[i]];
+
+            double variance = 0.0;
+            for (size_t i = lo; i < hi; ++i)
+            {
+                const auto &row = cov[order[i]];
+                double s = 0.0;
+                for (size_t j = lo; j < hi; ++j)
+                    s += row[order[j]] * w[j - lo];
+                variance += w[i - lo] * s;
+            }
+            return variance / (total * total);
+        }
+    }
+
+    std::vector<std::vector<double>> correlationDistance(const std::vector<std::vector<double>> &correlation)
+    {
+        std::vector<std::vector<double>> distance(correlation.size());
+        for (size_t i = 0; i < correlation.size(); ++i)
+        {
+            distance[i].resize(correlation[i].size());
+            for (size_t j = 0; j < correlation[i].size(); ++j)
+                distance[i][j] = i == j ? 0.0 : toDistance(correlation[i][j]);
+        }
+        return distance;
+    }
+
+    Dendrogram cluster(const std::vector<std::vector<double>> &distance, Linkage linkage)
+    {
+        TRADEIQ_TIMED_SCOPE("stats.hrp_cluster");
+        CondensedMatrix d = condense(distance, [](double x) { return x; });
+        return nnChain(d, distance.size(), linkage);
+    }
+
+    std::vector<size_t> quasiDiagonalOrder(const Dendrogram &tree)
+    {
+        const size_t n = tree.leaves;
+        std::vector<size_t> order;
+        if (n == 0)
+            return order;
+        order.reserve(n);
+
+        std::vector<size_t> stack{2 * n - 2};
+        while (!stack.empty())
+        {
+            const size_t id = stack.back();
+            stack.pop_back();
+            if (id < n)
+            {
+                order.push_back(id);
+                continue;
+            }
+            const Merge &m = tree.merges[id - n];
+            stack.push_back(m.right);
+            stack.push_back(m.left);
+        }
+        return order;
+    }
+
+    std::vector<double> recursiveBisectionWeights(const std::vector<std::vector<double>> &covariance,
+                                                  const std::vector<size_t> &order)
+    {
+        const size_t n = covariance.size();
+        if (order.size() != n)
+            throw std::invalid_argument("Order must list every asset once.");
+        for (size_t i = 0; i < n; ++i)
+        {
+            if (covariance[i].size() != n)
+                throw std::invalid_argument("Covariance matrix must be square.");
+            if (!(covariance[i][i] > 0.0))
+                throw std::invalid_argument("Covariance diagonal must be positive.");
+        }
+
+        std::vector<double> weights(n, 1.0), scratch;
+        std::vector<std::pair<size_t, size_t>> ranges;
+        if (n > 1)
+            ranges.emplace_back(0, n);
+        while (!ranges.empty())
+        {
+            const auto [lo, hi] = ranges.back();
+            ranges.pop_back();
+            const size_t mid = lo + (hi - lo) / 2;
+
+            const double left = clusterVariance(covariance, order, lo, mid, scratch);
+            const double right = clusterVariance(covariance, order, mid, hi, scratch);
+            const double alpha = left + right > 0.0 ? 1.0 - left / (left + right) : 0.5;
+            for (size_t i = lo; i < mid; ++i)
+                weights[order[i]] *= alpha;
+            for (size_t i = mid; i < hi; ++i)
+                weights[order[i]] *= 1.0 - alpha;
+
+            if (mid - lo > 1)
+                ranges.emplace_back(lo, mid);
+            if (hi - mid > 1)
+                ranges.emplace_back(mid, hi);
+        }
+        return weights;
+    }
+
+    std::vector<double> computeHRPWeights(const std::vector<std::vector<double>> &covariance,
+                                          const std::vector<std::vector<double>> &correlation, Linkage linkage)
+    {
+        TRADEIQ_TIMED_SCOPE("stats.hrp");
+        if (covariance.size() != correlation.size())
+            throw std::invalid_argument("Covariance and correlation sizes differ.");
+
+        CondensedMatrix d = condense(correlation, toDistance);
+        const Dendrogram tree = nnChain(d, correlation.size(), linkage);
+        return recursiveBisectionWeights(covariance, quasiDiagonalOrder(tree));
+    }
+
+    std::vector<double> computeHRPWeights(const std::vector<PriceSeries> &assets, Linkage linkage)
+    {
+        return computeHRPWeights(Correlation::computeCovarianceMatrix(assets), Correlation::computeCorrelationMatrix(assets),
+                                 linkage);
+    }
+
+}
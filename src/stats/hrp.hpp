@@ -0,0 +1,62 @@
+#pragma once
+
+#include "core/price_series.hpp"
+
+#include <cstddef>
+#include <vector>
+
+// Hierarchical risk parity (Lopez de Prado, 2016).
+//
+// Correlations become distances d = sqrt((1 - rho) / 2). Clustering uses the
+// nearest-neighbour chain algorithm, which is O(N^2) time for reducible
+// linkages (single, average) against O(N^3) for the naive closest-pair scan,
+// and works on a condensed upper triangle of N(N-1)/2 distances. The leaves
+// of the tree are then ordered so similar assets sit next to each other
+// (quasi-diagonalization), and weights are split top-down between the two
+// halves of each cluster in inverse proportion to their variance.
+namespace Stats::HRP
+{
+
+    enum class Linkage
+    {
+        Single,
+        Average
+    };
+
+    // One merge, in SciPy's linkage layout: ids below N are assets, id N + i
+    // is the cluster formed by merges[i]. Merges are sorted by distance.
+    struct Merge
+    {
+        size_t left = 0;
+        size_t right = 0;
+        double distance = 0.0;
+        size_t size = 0;
+    };
+
+    struct Dendrogram
+    {
+        size_t leaves = 0;
+        std::vector<Merge> merges; // leaves - 1 entries
+    };
+
+    std::vector<std::vector<double>> correlationDistance(const std::vector<std::vector<double>> &correlation);
+
+    // `distance` must be square and symmetric. Throws std::invalid_argument if empty or not square.
+    Dendrogram cluster(const std::vector<std::vector<double>> &distance, Linkage linkage = Linkage::Single);
+
+    // Leaf order from a left-to-right walk of the tree.
+    std::vector<size_t> quasiDiagonalOrder(const Dendrogram &tree);
+
+    // Weights indexed by asset (not by position in `order`); they sum to 1.
+    std::vector<double> recursiveBisectionWeights(const std::vector<std::vector<double>> &covariance,
+                                                  const std::vector<size_t> &order);
+
+    // Full pipeline. Clusters straight from the correlation matrix without
+    // materializing the N x N distance matrix.
+    std::vector<double> computeHRPWeights(const std::vector<std::vector<double>> &covariance,
+                                          const std::vector<std::vector<double>> &correlation,
+                                          Linkage linkage = Linkage::Single);
+
+    std::vector<double> computeHRPWeights(const std::vector<PriceSeries> &assets, Linkage linkage = Linkage::Single);
+
+}
@@ -0,0 +1,124 @@
+#pragma once
+
+#include "../utils/kernels.hpp"
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <span>
+#include <vector>
+
+// Central-moment engine shared by Stats::Utils, Stats::Distribution and MathUtils.
+//
+// summarize() makes one pass for the sum, noting whether every element equals
+// the first (so constant input needs no extra scan or hash set), and one
+// pass for the central sums up to `Order`; both are vectorized pairwise
+// reductions, run through Kernels at the CPU's best instruction set. The
+// estimator functions then apply the requested normalization:
+//   Population  divide by n                       (g1, g2)
+//   Sample      central moments over the n-1 variance
+//   Unbiased    adjusted Fisher-Pearson G1 / bias-corrected G2 (Excel SKEW/KURT)
+namespace Stats::Moments
+{
+    enum class Estimator
+    {
+        Population,
+        Sample,
+        Unbiased
+    };
+
+    template <typename T>
+    struct Summary
+    {
+        size_t count = 0;
+        T mean = 0;
+        T m2 = 0; // sum of (x - mean)^2
+        T m3 = 0; // sum of (x - mean)^3, if Order >= 3
+        T m4 = 0; // sum of (x - mean)^4, if Order >= 4
+        bool constant = true; // all elements compare equal (true for n <= 1)
+    };
+
+    template <int Order = 4, typename T>
+    Summary<T> summarize(std::span<const T> data)
+    {
+        static_assert(Order >= 2 && Order <= 4, "Order must be 2, 3 or 4");
+
+        Summary<T> s;
+        s.count = data.size();
+        if (data.empty())
+            return s;
+
+        const T *p = data.data();
+        auto pass1 = Kernels::sumAndMismatches(p, data.size());
+        s.constant = pass1[1] == 0;
+        if (s.constant)
+        {
+            s.mean = p[0]; // exact, and every deviation is zero
+            return s;
+        }
+        const T n = static_cast<T>(data.size());
+        s.mean = pass1[0] / n;
+
+        auto central = Kernels::centralSums(p, data.size(), s.mean, Order);
+        // Corrected two-pass: remove the residual of the rounded mean from m2.
+        T m2 = central[1] - central[0] * central[0] / n;
+        s.m2 = m2 > 0 ? m2 : T(0);
+        if constexpr (Order >= 3)
+            s.m3 = central[2];
+        if constexpr (Order >= 4)
+            s.m4 = central[3];
+        return s;
+    }
+
+    template <int Order = 4, typename T>
+    Summary<T> summarize(const std::vector<T> &data)
+    {
+        return summarize<Order>(std::span<const T>(data));
+    }
+
+    template <typename T>
+    T variance(const Summary<T> &s, Estimator e)
+    {
+        const T n = static_cast<T>(s.count);
+        return e == Estimator::Population ? s.m2 / n : s.m2 / (n - 1);
+    }
+
+    template <typename T>
+    T skewness(const Summary<T> &s, Estimator e)
+    {
+        const T n = static_cast<T>(s.count);
+        switch (e)
+        {
+        case Estimator::Population:
+            return (s.m3 / n) / std::pow(s.m2 / n, T(1.5));
+        case Estimator::Sample:
+            return (s.m3 / n) / std::pow(s.m2 / (n - 1), T(1.5));
+        default:
+            return (n / ((n - 1) * (n - 2))) * (s.m3 / std::pow(s.m2 / (n - 1), T(1.5)));
+        }
+    }
+
+    template <typename T>
+    T excessKurtosis(const Summary<T> &s, Estimator e)
+    {
+        const T n = static_cast<T>(s.count);
+        switch (e)
+        {
+        case Estimator::Population:
+        {
+            T v = s.m2 / n;
+            return (s.m4 / n) / (v * v) - T(3);
+        }
+        case Estimator::Sample:
+        {
+            T v = s.m2 / (n - 1);
+            return (s.m4 / n) / (v * v) - T(3);
+        }
+        default:
+        {
+            T v = s.m2 / (n - 1);
+            T k = s.m4 / (v * v); // sum of z^4
+            return n * (n + 1) / ((n - 1) * (n - 2) * (n - 3)) * k - T(3) * (n - 1) * (n - 1) / ((n - 2) * (n - 3));
+        }
+        }
+    }
+}
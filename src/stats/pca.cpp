@@ -0,0 +1,320 @@
+#include "stats/pca.hpp"
+#include "../utils/instrumentation.hpp"
+#include "../utils/summation.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+
+namespace Stats::PCA
+{
+    namespace
+    {
+        // Row-major n x n copy of a square matrix.
+        std::vector<double> toDense(const std::vector<std::vector<double>> &m)
+        {
+            const size_t n = m.size();
+            std::vector<double> a(n * n);
+            for (size_t i = 0; i < n; ++i)
+            {
+                if (m[i].size() != n)
+                    throw std::invalid_argument("Covariance matrix must be square.");
+                std::copy(m[i].begin(), m[i].end(), a.begin() + i * n);
+            }
+            return a;
+        }
+
+        double dot(const double *x, const double *y, size_t n)
+        {
+            return Summation::reduce<1, double>(n, [x, y](size_t i) { return std::array<double, 1>{x[i] * y[i]}; })[0];
+        }
+
+        // Cyclic Jacobi on a symmetric row-major matrix. On return the diagonal
+        // of `a` holds the eigenvalues and the rows of `vt` the eigenvectors.
+        // Each rotation updates rows p and q contiguously and mirrors them into
+        // the columns, using the closed-form diagonal update.
+        void jacobi(std::vector<double> &a, size_t n, std::vector<double> &vt)
+        {
+            vt.assign(n * n, 0.0);
+            for (size_t i = 0; i < n; ++i)
+                vt[i * n + i] = 1.0;
+
+            for (int sweep = 0; sweep < 100; ++sweep)
+            {
+                double off = 0.0, diag = 0.0;
+                for (size_t p = 0; p < n; ++p)
+                {
+                    diag += a[p * n + p] * a[p * n + p];
+                    for (size_t q = p + 1; q < n; ++q)
+                        off += a[p * n + q] * a[p * n + q];
+                }
+                if (off <= 1e-30 * diag || off == 0.0)
+                    return;
+
+                for (size_t p = 0; p < n; ++p)
+                {
+                    for (size_t q = p + 1; q < n; ++q)
+                    {
+                        const double apq = a[p * n + q];
+                        if (apq == 0.0)
+                            continue;
+                        const double theta = (a[q * n + q] - a[p * n + p]) / (2.0 * apq);
+                        const double t = (theta >= 0.0 ? 1.0 : -1.0) / (std::abs(theta) + std::sqrt(theta * theta + 1.0));
+                        const double c = 1.0 / std::sqrt(t * t + 1.0);
+                        const double s = t * c;
+
+                        double *rp = a.data() + p * n;
+                        double *rq = a.data() + q * n;
+                        const double app = rp[p], aqq = rq[q];
+                        for (size_t k = 0; k < n; ++k)
+                        {
+                            const double apk = rp[k], aqk = rq[k];
+                            rp[k] = c * apk - s * aqk;
+                            rq[k] = s * apk + c * aqk;
+                        }
+                        rp[p] = app - t * apq;
+                        rq[q] = aqq + t * apq;
+                        rp[q] = rq[p] = 0.0;
+                        for (size_t k = 0; k < n; ++k)
+                        {
+                            a[k * n + p] = rp[k];
+                            a[k * n + q] = rq[k];
+                        }
+
+                        double *vp = vt.data() + p * n;
+                        double *vq = vt.data() + q * n;
+                        for (size_t k = 0; k < n; ++k)
+                        {
+                            const double x = vp[k], y = vq[k];
+                            vp[k] = c * x - s * y;
+                            vq[k] = s * x + c * y;
+                        }
+                    }
+                }
+            }
+        }
+
+        // Eigenvalue indices of a Jacobi result, largest first.
+        std::vector<size_t> descendingOrder(const std::vector<double> &a, size_t n)
+        {
+            std::vector<size_t> order(n);
+            std::iota(order.begin(), order.end(), 0);
+            std::stable_sort(order.begin(), order.end(),
+                             [&](size_t x, size_t y) { return a[x * n + x] > a[y * n + y]; });
+            return order;
+        }
+
+        void normalizeSigns(Decomposition &d)
+        {
+            const size_t n = d.loadings.size();
+            for (size_t c = 0; c < d.components(); ++c)
+            {
+                size_t arg = 0;
+                for (size_t i = 1; i < n; ++i)
+                    if (std::abs(d.loadings[i][c]) > std::abs(d.loadings[arg][c]))
+                        arg = i;
+                if (n > 0 && d.loadings[arg][c] < 0.0)
+                    for (size_t i = 0; i < n; ++i)
+                        d.loadings[i][c] = -d.loadings[i][c];
+            }
+        }
+
+        void finish(Decomposition &d)
+        {
+            d.explainedVarianceRatio.resize(d.eigenvalues.size());
+            for (size_t c = 0; c < d.eigenvalues.size(); ++c)
+                d.explainedVarianceRatio[c] = d.totalVariance > 0.0 ? d.eigenvalues[c] / d.totalVariance : 0.0;
+            normalizeSigns(d);
+        }
+
+        // Orthonormalizes the m columns (each n long, stored contiguously) with
+        // two passes of modified Gram-Schmidt. Columns that vanish are zeroed.
+        void orthonormalize(std::vector<double> &q, size_t n, size_t m)
+        {
+            for (size_t j = 0; j < m; ++j)
+            {
+                double *qj = q.data() + j * n;
+                const double before = std::sqrt(dot(qj, qj, n));
+                for (int pass = 0; pass < 2; ++pass)
+                {
+                    for (size_t l = 0; l < j; ++l)
+                    {
+                        const double *ql = q.data() + l * n;
+                        const double r = dot(ql, qj, n);
+                        for (size_t i = 0; i < n; ++i)
+                            qj[i] -= r * ql[i];
+                    }
+                }
+                const double norm = std::sqrt(dot(qj, qj, n));
+                const double scale = norm > 1e-12 * before ? 1.0 / norm : 0.0;
+                for (size_t i = 0; i < n; ++i)
+                    qj[i] *= scale;
+            }
+        }
+
+        // out column j = A * column j of `cols`. The block is transposed to
+        // n x m so each row of A streams once against contiguous m-wide rows.
+        void multiply(const std::vector<double> &a, size_t n, const std::vector<double> &cols, size_t m,
+                      std::vector<double> &out)
+        {
+            std::vector<double> rows(n * m), acc(m);
+            for (size_t j = 0; j < m; ++j)
+                for (size_t k = 0; k < n; ++k)
+                    rows[k * m + j] = cols[j * n + k];
+
+            out.resize(n * m);
+            for (size_t i = 0; i < n; ++i)
+            {
+                const double *row = a.data() + i * n;
+                std::fill(acc.begin(), acc.end(), 0.0);
+                for (size_t k = 0; k < n; ++k)
+                {
+                    const double aik = row[k];
+                    const double *r = rows.data() + k * m;
+                    for (size_t j = 0; j < m; ++j)
+                        acc[j] += aik * r[j];
+                }
+                for (size_t j = 0; j < m; ++j)
+                    out[j * n + i] = acc[j];
+            }
+        }
+    }
+
+    Decomposition decompose(const std::vector<std::vector<double>> &cov)
+    {
+        TRADEIQ_TIMED_SCOPE("stats.pca_full");
+        const size_t n = cov.size();
+        std::vector<double> a = toDense(cov);
+
+        Decomposition d;
+        for (size_t i = 0; i < n; ++i)
+            d.totalVariance += a[i * n + i];
+
+        std::vector<double> v;
+        jacobi(a, n, v);
+        const std::vector<size_t> order = descendingOrder(a, n);
+
+        d.eigenvalues.resize(n);
+        d.loadings.assign(n, std::vector<double>(n));
+        for (size_t c = 0; c < n; ++c)
+        {
+            d.eigenvalues[c] = a[order[c] * n + order[c]];
+            for (size_t i = 0; i < n; ++i)
+                d.loadings[i][c] = v[order[c] * n + i];
+        }
+        finish(d);
+        return d;
+    }
+
+    Decomposition decomposeTopK(const std::vector<std::vector<double>> &cov, size_t k, TopKOptions options)
+    {
+        const size_t n = cov.size();
+        if (k == 0 || k > n)
+            throw std::invalid_argument("Component count must be between 1 and the matrix size.");
+
+        const size_t m = k + options.oversample;
+        if (m >= n)
+        {
+            Decomposition full = decompose(cov);
+            full.eigenvalues.resize(k);
+            full.explainedVarianceRatio.resize(k);
+            for (auto &row : full.loadings)
+                row.resize(k);
+            return full;
+        }
+
+        TRADEIQ_TIMED_SCOPE("stats.pca_topk");
+        const std::vector<double> a = toDense(cov);
+
+        std::mt19937_64 rng(options.seed);
+        std::normal_distribution<double> gauss(0.0, 1.0);
+        std::vector<double> q(n * m), z;
+        for (double &x : q)
+            x = gauss(rng);
+
+        multiply(a, n, q, m, z);
+        q.swap(z);
+        orthonormalize(q, n, m);
+        for (size_t it = 0; it < options.powerIterations; ++it)
+        {
+            multiply(a, n, q, m, z);
+            q.swap(z);
+            orthonormalize(q, n, m);
+        }
+
+        // Projected problem B = Q' A Q, symmetrized against rounding.
+        multiply(a, n, q, m, z);
+        std::vector<double> b(m * m);
+        for (size_t j = 0; j < m; ++j)
+            for (size_t l = 0; l <= j; ++l)
+                b[j * m + l] = b[l * m + j] =
+                    0.5 * (dot(q.data() + j * n, z.data() + l * n, n) + dot(q.data() + l * n, z.data() + j * n, n));
+
+        std::vector<double> vb;
+        jacobi(b, m, vb);
+        const std::vector<size_t> order = descendingOrder(b, m);
+
+        Decomposition d;
+        for (size_t i = 0; i < n; ++i)
+            d.totalVariance += a[i * n + i];
+        d.eigenvalues.resize(k);
+        d.loadings.assign(n, std::vector<double>(k, 0.0));
+        for (size_t c = 0; c < k; ++c)
+        {
+            d.eigenvalues[c] = b[order[c] * m + order[c]];
+            for (size_t l = 0; l < m; ++l)
+            {
+                const double coef = vb[order[c] * m + l];
+                const double *ql = q.data() + l * n;
+                for (size_t i = 0; i < n; ++i)
+                    d.loadings[i][c] += coef * ql[i];
+            }
+        }
+        finish(d);
+        return d;
+    }
+
+    std::vector<double> riskContributions(const std::vector<std::vector<double>> &cov, const std::vector<double> &weights)
+    {
+        const size_t n = weights.size();
+        if (cov.size() != n)
+            throw std::invalid_argument("Weights and covariance matrix sizes differ.");
+
+        std::vector<double> marginal(n);
+        for (size_t i = 0; i < n; ++i)
+        {
+            if (cov[i].size() != n)
+                throw std::invalid_argument("Covariance matrix must be square.");
+            marginal[i] = dot(cov[i].data(), weights.data(), n);
+        }
+        const double variance = dot(weights.data(), marginal.data(), n);
+
+        std::vector<double> contributions(n, 0.0);
+        if (variance <= 0.0)
+            return contributions;
+        const double vol = std::sqrt(variance);
+        for (size_t i = 0; i < n; ++i)
+            contributions[i] = weights[i] * marginal[i] / vol;
+        return contributions;
+    }
+
+    std::vector<double> componentRiskContributions(const Decomposition &pca, const std::vector<double> &weights)
+    {
+        if (pca.loadings.size() != weights.size())
+            throw std::invalid_argument("Weights and loadings sizes differ.");
+
+        std::vector<double> out(pca.components(), 0.0);
+        for (size_t c = 0; c < pca.components(); ++c)
+        {
+            double exposure = 0.0;
+            for (size_t i = 0; i < weights.size(); ++i)
+                exposure += weights[i] * pca.loadings[i][c];
+            out[c] = pca.eigenvalues[c] * exposure * exposure;
+        }
+        return out;
+    }
+
+}
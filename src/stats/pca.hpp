@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Eigen-decomposition of a covariance matrix for risk decomposition.
+//
+// decompose() is a cyclic Jacobi eigensolver: exact to rounding, O(N^3) per
+// sweep, fine up to a few hundred assets. decomposeTopK() is randomized
+// subspace iteration (Halko, Martinsson & Tropp): it multiplies the matrix by
+// k + oversample random vectors, sharpens the subspace with a few power
+// iterations and solves only the small projected problem, so the cost is
+// O(N^2 (k + oversample)) per iteration rather than O(N^3).
+namespace Stats::PCA
+{
+
+    struct Decomposition
+    {
+        std::vector<double> eigenvalues;             // descending
+        std::vector<std::vector<double>> loadings;   // [asset][component], unit-norm eigenvectors
+        std::vector<double> explainedVarianceRatio;  // eigenvalue / totalVariance
+        double totalVariance = 0.0;                  // trace of the input matrix
+
+        size_t components() const { return eigenvalues.size(); }
+    };
+
+    struct TopKOptions
+    {
+        size_t oversample = 10;
+        size_t powerIterations = 4;
+        uint64_t seed = 42;
+    };
+
+    // Eigenvectors are sign-normalized so their largest-magnitude entry is positive.
+    // Both throw std::invalid_argument for a non-square input.
+    Decomposition decompose(const std::vector<std::vector<double>> &cov);
+
+    // Falls back to decompose() when k + oversample covers the whole matrix.
+    Decomposition decomposeTopK(const std::vector<std::vector<double>> &cov, size_t k, TopKOptions options = {});
+
+    // Euler risk contributions w_i (Cov w)_i / sigma_p; they sum to the portfolio volatility.
+    std::vector<double> riskContributions(const std::vector<std::vector<double>> &cov, const std::vector<double> &weights);
+
+    // Portfolio variance carried by each component: lambda_j * (w . v_j)^2.
+    std::vector<double> componentRiskContributions(const Decomposition &pca, const std::vector<double> &weights);
+
+}
@@ -0,0 +1,220 @@
+#include "stats/quantiles.hpp"
+#include "../utils/instrumentation.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <stdexcept>
+
+namespace Stats::Quantiles
+{
+
+    template <typename T>
+    RollingOrderStatistics<T>::RollingOrderStatistics(std::span<const T> series)
+        : series_(series), sorted_(series.size()), rankOf_(series.size()), tree_(series.size() + 1, 0)
+    {
+        std::vector<uint32_t> order(series.size());
+        std::iota(order.begin(), order.end(), 0u);
+        std::stable_sort(order.begin(), order.end(), [&series](uint32_t a, uint32_t b) { return series[a] < series[b]; });
+        for (size_t r = 0; r < order.size(); ++r)
+        {
+            rankOf_[order[r]] = static_cast<uint32_t>(r);
+            sorted_[r] = series[order[r]];
+        }
+        top_ = 1;
+        while (top_ * 2 <= series.size())
+            top_ *= 2;
+    }
+
+    template <typename T>
+    void RollingOrderStatistics<T>::insert(size_t index)
+    {
+        for (size_t i = rankOf_[index] + 1; i < tree_.size(); i += i & (~i + 1))
+            ++tree_[i];
+        ++count_;
+    }
+
+    template <typename T>
+    void RollingOrderStatistics<T>::evict(size_t index)
+    {
+        for (size_t i = rankOf_[index] + 1; i < tree_.size(); i += i & (~i + 1))
+            --tree_[i];
+        --count_;
+    }
+
+    template <typename T>
+    size_t RollingOrderStatistics<T>::prefixCount(size_t ranks) const
+    {
+        int64_t total = 0;
+        for (size_t i = ranks; i > 0; i -= i & (~i + 1))
+            total += tree_[i];
+        return static_cast<size_t>(total);
+    }
+
+    template <typename T>
+    T RollingOrderStatistics<T>::kth(size_t k) const
+    {
+        if (k >= count_)
+            throw std::out_of_range("Order statistic index outside the window.");
+        size_t pos = 0;
+        int64_t remaining = static_cast<int64_t>(k) + 1;
+        for (size_t step = top_; step > 0; step >>= 1)
+        {
+            if (pos + step < tree_.size() && tree_[pos + step] < remaining)
+            {
+                pos += step;
+                remaining -= tree_[pos];
+            }
+        }
+        return sorted_[pos];
+    }
+
+    template <typename T>
+    T RollingOrderStatistics<T>::percentile(T p) const
+    {
+        if (count_ == 0)
+            throw std::invalid_argument("Data is empty.");
+        if (p < 0.0 || p > 100.0)
+            throw std::invalid_argument("Percentile must be between 0 and 100.");
+        T rank = (p / T(100)) * static_cast<T>(count_ - 1);
+        size_t lower = static_cast<size_t>(rank);
+        size_t upper = lower + 1;
+        T weight = rank - static_cast<T>(lower);
+        return upper < count_
+                   ? kth(lower) * (T(1) - weight) + kth(upper) * weight
+                   : kth(lower);
+    }
+
+    template <typename T>
+    size_t RollingOrderStatistics<T>::countAtOrBelow(T value) const
+    {
+        const size_t ranks = static_cast<size_t>(std::upper_bound(sorted_.begin(), sorted_.end(), value) - sorted_.begin());
+        return prefixCount(ranks);
+    }
+
+    namespace
+    {
+        // Slides a window of `w` over `values` and calls visit(stats, i) for
+        // every full window i.
+        template <typename T, typename Visit>
+        void slide(const std::vector<T> &values, size_t w, Visit visit)
+        {
+            if (w == 0 || values.size() < w)
+                return;
+            RollingOrderStatistics<T> stats{std::span<const T>(values)};
+            for (size_t j = 0; j + 1 < w; ++j)
+                stats.insert(j);
+            for (size_t i = 0; i + w <= values.size(); ++i)
+            {
+                stats.insert(i + w - 1);
+                visit(stats, i);
+                stats.evict(i);
+            }
+        }
+
+        void checkPercentile(double p)
+        {
+            if (p < 0.0 || p > 100.0)
+                throw std::invalid_argument("Percentile must be between 0 and 100.");
+        }
+
+        void checkConfidence(double confidence)
+        {
+            if (!(confidence > 0.0 && confidence < 1.0))
+                throw std::invalid_argument("Confidence must be in (0, 1).");
+        }
+
+        size_t windows(size_t n, size_t w)
+        {
+            return w == 0 || n < w ? 0 : n - w + 1;
+        }
+    }
+
+    template <typename T>
+    std::vector<T> computeRollingQuantile(const std::vector<T> &values, size_t window, std::type_identity_t<T> percentile)
+    {
+        TRADEIQ_TIMED_SCOPE("stats.rolling_quantile");
+        checkPercentile(percentile);
+        std::vector<T> result(windows(values.size(), window));
+        slide(values, window, [&](const RollingOrderStatistics<T> &s, size_t i) { result[i] = s.percentile(percentile); });
+        return result;
+    }
+
+    template <typename T>
+    std::vector<std::vector<T>> computeRollingQuantiles(const std::vector<T> &values, size_t window,
+                                                        const std::vector<T> &percentiles)
+    {
+        TRADEIQ_TIMED_SCOPE("stats.rolling_quantile");
+        for (T p : percentiles)
+            checkPercentile(p);
+        std::vector<std::vector<T>> result(percentiles.size(), std::vector<T>(windows(values.size(), window)));
+        slide(values, window, [&](const RollingOrderStatistics<T> &s, size_t i) {
+            for (size_t q = 0; q < percentiles.size(); ++q)
+                result[q][i] = s.percentile(percentiles[q]);
+        });
+        return result;
+    }
+
+    template <typename T>
+    std::vector<T> computeRollingMedian(const std::vector<T> &values, size_t window)
+    {
+        return computeRollingQuantile(values, window, T(50));
+    }
+
+    template <typename T>
+    std::vector<T> computeRollingVaR(const std::vector<T> &returns, size_t window, std::type_identity_t<T> confidence)
+    {
+        checkConfidence(confidence);
+        std::vector<T> result = computeRollingQuantile(returns, window, T(100) * (T(1) - confidence));
+        for (T &x : result)
+            x = -x;
+        return result;
+    }
+
+    template <typename T>
+    std::vector<T> computeRollingCVaR(const std::vector<T> &returns, size_t window, std::type_identity_t<T> confidence)
+    {
+        TRADEIQ_TIMED_SCOPE("stats.rolling_cvar");
+        checkConfidence(confidence);
+        // The epsilon keeps e.g. 100 * (1 - 0.95) = 5.0000000000000044 at 5.
+        const double tail = std::ceil(static_cast<double>(window) * (1.0 - static_cast<double>(confidence)) - 1e-9);
+        const size_t k = std::clamp<size_t>(static_cast<size_t>(tail), 1, std::max<size_t>(window, 1));
+
+        std::vector<T> result(windows(returns.size(), window));
+        slide(returns, window, [&](const RollingOrderStatistics<T> &s, size_t i) {
+            T sum = 0;
+            for (size_t j = 0; j < k; ++j)
+                sum += s.kth(j);
+            result[i] = -sum / static_cast<T>(k);
+        });
+        return result;
+    }
+
+    template <typename T>
+    std::vector<T> computeRollingPercentileRank(const std::vector<T> &values, size_t window)
+    {
+        TRADEIQ_TIMED_SCOPE("stats.rolling_percentile_rank");
+        std::vector<T> result(windows(values.size(), window));
+        slide(values, window, [&](const RollingOrderStatistics<T> &s, size_t i) {
+            const size_t atOrBelow = s.countAtOrBelow(values[i + window - 1]);
+            result[i] = T(100) * static_cast<T>(atOrBelow) / static_cast<T>(window);
+        });
+        return result;
+    }
+
+#define TRADEIQ_QUANTILES_INSTANTIATE(T)                                                                           \
+    template class RollingOrderStatistics<T>;                                                                      \
+    template std::vector<T> computeRollingQuantile<T>(const std::vector<T> &, size_t, std::type_identity_t<T>);    \
+    template std::vector<std::vector<T>> computeRollingQuantiles<T>(const std::vector<T> &, size_t,                \
+                                                                    const std::vector<T> &);                       \
+    template std::vector<T> computeRollingMedian<T>(const std::vector<T> &, size_t);                               \
+    template std::vector<T> computeRollingVaR<T>(const std::vector<T> &, size_t, std::type_identity_t<T>);         \
+    template std::vector<T> computeRollingCVaR<T>(const std::vector<T> &, size_t, std::type_identity_t<T>);        \
+    template std::vector<T> computeRollingPercentileRank<T>(const std::vector<T> &, size_t);
+
+    TRADEIQ_QUANTILES_INSTANTIATE(float)
+    TRADEIQ_QUANTILES_INSTANTIATE(double)
+
+#undef TRADEIQ_QUANTILES_INSTANTIATE
+
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+// Rolling order statistics.
+//
+// Every value of the series is ranked once up front (a stable sort, so ties
+// get distinct ranks). The window is then a Fenwick tree of 0/1 counts over
+// those ranks: insert and evict are O(log n), and the k-th smallest value in
+// the window is a single O(log n) descent, so several quantiles per step cost
+// no more than one. Quantiles use the same interpolation as
+// MathUtils::percentile and are bit-identical to it.
+//
+// Rolling outputs have one entry per full window (n - window + 1), like the
+// Stats::Volatility kernels, and are empty when the window is 0 or longer
+// than the series. Percentiles are in [0, 100]; anything else throws
+// std::invalid_argument.
+namespace Stats::Quantiles
+{
+
+    template <typename T = double>
+    class RollingOrderStatistics
+    {
+    public:
+        // `series` must outlive this object.
+        explicit RollingOrderStatistics(std::span<const T> series);
+
+        void insert(size_t index);
+        void evict(size_t index);
+        size_t size() const { return count_; }
+
+        // k-th smallest value in the window, 0-based.
+        T kth(size_t k) const;
+        // MathUtils::percentile of the window contents.
+        T percentile(T p) const;
+        // Window values <= value.
+        size_t countAtOrBelow(T value) const;
+
+    private:
+        size_t prefixCount(size_t ranks) const;
+
+        std::span<const T> series_;
+        std::vector<T> sorted_;         // series values in rank order
+        std::vector<uint32_t> rankOf_;  // series index -> rank
+        std::vector<int32_t> tree_;     // Fenwick tree, 1-based
+        size_t top_ = 0;                // highest power of two <= n
+        size_t count_ = 0;
+    };
+
+    template <typename T = double>
+    std::vector<T> computeRollingQuantile(const std::vector<T> &values, size_t window, std::type_identity_t<T> percentile);
+
+    // result[q][i] is percentiles[q] of window i.
+    template <typename T = double>
+    std::vector<std::vector<T>> computeRollingQuantiles(const std::vector<T> &values, size_t window,
+                                                        const std::vector<T> &percentiles);
+
+    template <typename T = double>
+    std::vector<T> computeRollingMedian(const std::vector<T> &values, size_t window);
+
+    // Historical VaR as a positive loss: -percentile(returns, 100 * (1 - confidence)).
+    template <typename T = double>
+    std::vector<T> computeRollingVaR(const std::vector<T> &returns, size_t window, std::type_identity_t<T> confidence);
+
+    // Expected shortfall as a positive loss: minus the mean of the
+    // ceil(window * (1 - confidence)) worst returns (at least one).
+    template <typename T = double>
+    std::vector<T> computeRollingCVaR(const std::vector<T> &returns, size_t window, std::type_identity_t<T> confidence);
+
+    // Share of each window, in percent, at or below its newest value.
+    template <typename T = double>
+    std::vector<T> computeRollingPercentileRank(const std::vector<T> &values, size_t window);
+
+}
@@ -1,5 +1,9 @@
 #include "stats/ratios.hpp"
-#include <numeric>
+#include "../utils/kernels.hpp"
+#include "../utils/summation.hpp"
+#include <array>
+#include <limits>
+#include <span>
 #include <cmath>
 #include <stdexcept>
 
@@ -11,21 +15,21 @@ double computeSharpeRatio(double expectedReturn, double variance, double riskFre
     return excessReturn / std::sqrt(variance);
 }
 
-double computeSortinoRatio(double expectedReturn, double riskFreeRate, const std::vector<double> &returns) {
-    double downsideSum = 0.0;
-    int count = 0;
-
-    for (double r : returns) {
-        if (r < riskFreeRate) {
-            double diff = r - riskFreeRate;
-            downsideSum += diff * diff;
-            ++count;
-        }
-    }
-
-    if (count == 0) return std::numeric_limits<double>::infinity();
-    double downsideDev = std::sqrt(downsideSum / count);
-    if (downsideDev == 0.0) return std::numeric_limits<double>::infinity();
+template <typename T>
+T computeSortinoRatio(std::type_identity_t<T> expectedReturn, std::type_identity_t<T> riskFreeRate,
+                      const std::vector<T> &returns) {
+    const T *p = returns.data();
+    const T rf = riskFreeRate;
+    auto downside = Summation::reduce<2, T>(returns.size(), [p, rf](size_t i) {
+        T diff = p[i] - rf;
+        bool below = p[i] < rf;
+        return std::array<T, 2>{below ? diff * diff : T(0), below ? T(1) : T(0)};
+    });
+    T count = downside[1];
+
+    if (count == 0) return std::numeric_limits<T>::infinity();
+    T downsideDev = std::sqrt(downside[0] / count);
+    if (downsideDev == 0) return std::numeric_limits<T>::infinity();
 
     return (expectedReturn - riskFreeRate) / downsideDev;
 }
@@ -45,55 +49,55 @@ double computeSterlingRatio(double averageReturn, double riskFreeRate, double av
     return (averageReturn - riskFreeRate) / averageDrawdown;
 }
 
-double computeInformationRatio(std::vector<double> &portfolioReturns, const std::vector<double> benchmarkReturns) {
+template <typename T>
+T computeInformationRatio(const std::vector<T> &portfolioReturns, const std::vector<T> &benchmarkReturns) {
     size_t n = portfolioReturns.size();
     if (n == 0 || benchmarkReturns.size() != n)
         throw std::invalid_argument("Returns must be non-empty and of equal length.");
 
-    std::vector<double> activeReturns;
+    std::vector<T> activeReturns;
     activeReturns.reserve(n);
 
     for (size_t i = 0; i < n; ++i)
         activeReturns.push_back(portfolioReturns[i] - benchmarkReturns[i]);
 
-    double meanActive = std::accumulate(activeReturns.begin(), activeReturns.end(), 0.0) / n;
-
-    double sqSum = 0.0;
-    for (double r : activeReturns)
-        sqSum += (r - meanActive) * (r - meanActive);
-
-    double stddev = std::sqrt(sqSum / n);
-    if (stddev == 0.0) return 0.0;
+    std::span<const T> active(activeReturns);
+    T meanActive = Summation::sum(active) / static_cast<T>(n);
+    T stddev = std::sqrt(Summation::sumSquaredDeviations(active, meanActive) / static_cast<T>(n));
+    if (stddev == 0) return 0;
 
     return meanActive / stddev;
 }
 
-double computeOmegaRatio(const std::vector<double> &returns, double threshold) {
-    double num = 0.0, denom = 0.0;
-
-    for (double r : returns) {
-        if (r >= threshold)
-            num += (r - threshold);
-        else
-            denom += (threshold - r);
-    }
+template <typename T>
+T computeOmegaRatio(const std::vector<T> &returns, std::type_identity_t<T> threshold) {
+    const T *p = returns.data();
+    const T tau = threshold;
+    auto parts = Summation::reduce<2, T>(returns.size(), [p, tau](size_t i) {
+        T d = p[i] - tau;
+        bool above = p[i] >= tau;
+        return std::array<T, 2>{above ? d : T(0), above ? T(0) : -d};
+    });
+
+    if (parts[1] == 0) return std::numeric_limits<T>::infinity();
+    return parts[0] / parts[1];
+}
 
-    if (denom == 0.0) return std::numeric_limits<double>::infinity();
-    return num / denom;
+template <typename T>
+T computePortfolioVariance(const std::vector<std::vector<T>>& covMatrix,
+                           const std::vector<T>& weights) {
+    return Kernels::quadraticForm(covMatrix.data(), weights.data(), weights.size());
 }
 
-double computePortfolioVariance(const std::vector<std::vector<double>>& covMatrix,
-                                const std::vector<double>& weights) {
-    double variance = 0.0;
-    size_t n = weights.size();
+#define TRADEIQ_RATIOS_INSTANTIATE(T)                                                                       \
+    template T computeSortinoRatio<T>(std::type_identity_t<T>, std::type_identity_t<T>, const std::vector<T> &); \
+    template T computeInformationRatio<T>(const std::vector<T> &, const std::vector<T> &);                  \
+    template T computeOmegaRatio<T>(const std::vector<T> &, std::type_identity_t<T>);                       \
+    template T computePortfolioVariance<T>(const std::vector<std::vector<T>> &, const std::vector<T> &);
 
-    for (size_t i = 0; i < n; ++i) {
-        for (size_t j = 0; j < n; ++j) {
-            variance += weights[i] * covMatrix[i][j] * weights[j];
-        }
-    }
+TRADEIQ_RATIOS_INSTANTIATE(float)
+TRADEIQ_RATIOS_INSTANTIATE(double)
 
-    return variance;
-}
+#undef TRADEIQ_RATIOS_INSTANTIATE
 
 }
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <type_traits>
 #include <vector>
 
 namespace Stats::Ratios
@@ -7,7 +8,9 @@ namespace Stats::Ratios
 
     double computeSharpeRatio(double expectedReturn, double variance, double riskFreeRate);
 
-    double computeSortinoRatio(double expectedReturn, double riskFreeRate, const std::vector<double> &returns);
+    template <typename T = double>
+    T computeSortinoRatio(std::type_identity_t<T> expectedReturn, std::type_identity_t<T> riskFreeRate,
+                          const std::vector<T> &returns);
 
     double computeTreynorRatio(double expectedReturns, double riskFreeRate, double portfolioBeta);
 
@@ -15,10 +18,13 @@ namespace Stats::Ratios
 
     double computeSterlingRatio(double averageReturn, double riskFreeRate, double averageDrawdown);
 
-    double computeInformationRatio(std::vector<double> &portfolioReturns, const std::vector<double> benchmarkReturns);
+    template <typename T = double>
+    T computeInformationRatio(const std::vector<T> &portfolioReturns, const std::vector<T> &benchmarkReturns);
 
-    double computeOmegaRatio(const std::vector<double> &returns, double threshold);
+    template <typename T = double>
+    T computeOmegaRatio(const std::vector<T> &returns, std::type_identity_t<T> threshold);
 
-    double computePortfolioVariance(const std::vector<std::vector<double>> &cov, const std::vector<double> &weights);
+    template <typename T = double>
+    T computePortfolioVariance(const std::vector<std::vector<T>> &cov, const std::vector<T> &weights);
 
 }
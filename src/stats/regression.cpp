@@ -0,0 +1,323 @@
+#include "stats/regression.hpp"
+#include "../utils/instrumentation.hpp"
+#include "../utils/summation.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <span>
+#include <stdexcept>
+
+namespace Stats::Regression
+{
+    namespace
+    {
+        constexpr double kNaN = std::numeric_limits<double>::quiet_NaN();
+        // Below this fraction of z'z, SSR from the sliding sums is recomputed
+        // from residuals (the subtraction would keep fewer than ~6 digits).
+        constexpr double kResidualFloor = 1e-10;
+
+        // Validates the panel and returns its length T.
+        size_t checkShapes(const std::vector<std::vector<double>> &assets,
+                           const std::vector<std::vector<double>> &factors)
+        {
+            if (assets.empty())
+                throw std::invalid_argument("Regression needs at least one asset.");
+            if (factors.empty())
+                throw std::invalid_argument("Regression needs at least one factor.");
+            const size_t t = factors[0].size();
+            for (const auto &f : factors)
+                if (f.size() != t)
+                    throw std::invalid_argument("Factor series must have the same length.");
+            for (const auto &a : assets)
+                if (a.size() != t)
+                    throw std::invalid_argument("Asset and factor series must have the same length.");
+            return t;
+        }
+
+        // Row-major T x P design matrix [1, f_1 .. f_K].
+        std::vector<double> designMatrix(const std::vector<std::vector<double>> &factors, size_t t)
+        {
+            const size_t p = factors.size() + 1;
+            std::vector<double> x(t * p);
+            for (size_t i = 0; i < t; ++i)
+            {
+                x[i * p] = 1.0;
+                for (size_t k = 0; k < factors.size(); ++k)
+                    x[i * p + k + 1] = factors[k][i];
+            }
+            return x;
+        }
+
+        // In-place lower Cholesky of a symmetric P x P matrix (row-major, lower
+        // triangle used). Returns false if it is not numerically positive definite.
+        bool cholesky(std::vector<double> &a, size_t p)
+        {
+            double scale = 0.0;
+            for (size_t i = 0; i < p; ++i)
+                scale = std::max(scale, a[i * p + i]);
+            const double tolerance = scale * 1e-12;
+
+            for (size_t j = 0; j < p; ++j)
+            {
+                double d = a[j * p + j];
+                for (size_t k = 0; k < j; ++k)
+                    d -= a[j * p + k] * a[j * p + k];
+                if (!(d > tolerance))
+                    return false;
+                const double l = std::sqrt(d);
+                a[j * p + j] = l;
+                for (size_t i = j + 1; i < p; ++i)
+                {
+                    double s = a[i * p + j];
+                    for (size_t k = 0; k < j; ++k)
+                        s -= a[i * p + k] * a[j * p + k];
+                    a[i * p + j] = s / l;
+                }
+            }
+            return true;
+        }
+
+        // Solves L L' x = b.
+        void choleskySolve(const std::vector<double> &l, size_t p, const double *b, double *x)
+        {
+            for (size_t i = 0; i < p; ++i)
+            {
+                double s = b[i];
+                for (size_t k = 0; k < i; ++k)
+                    s -= l[i * p + k] * x[k];
+                x[i] = s / l[i * p + i];
+            }
+            for (size_t i = p; i-- > 0;)
+            {
+                double s = x[i];
+                for (size_t k = i + 1; k < p; ++k)
+                    s -= l[k * p + i] * x[k];
+                x[i] = s / l[i * p + i];
+            }
+        }
+
+        // diag((L L')^-1) = column sums of squares of L^-1.
+        void inverseDiagonal(const std::vector<double> &l, size_t p, std::vector<double> &diag)
+        {
+            diag.assign(p, 0.0);
+            std::vector<double> col(p);
+            for (size_t j = 0; j < p; ++j)
+            {
+                for (size_t i = 0; i < p; ++i)
+                {
+                    double s = (i == j) ? 1.0 : 0.0;
+                    for (size_t k = j; k < i; ++k)
+                        s -= l[i * p + k] * col[k];
+                    col[i] = i < j ? 0.0 : s / l[i * p + i];
+                    if (i >= j)
+                        diag[j] += col[i] * col[i];
+                }
+            }
+        }
+
+        // Writes alpha, betas and their t-stats for one fit. `coef` has P entries.
+        void storeFit(const double *coef, const std::vector<double> &invDiag, size_t p, double ssr, double dof,
+                      double *alpha, double *betas, double *alphaT, double *betaT)
+        {
+            const double sigma2 = ssr / dof;
+            *alpha = coef[0];
+            *alphaT = coef[0] / std::sqrt(sigma2 * invDiag[0]);
+            for (size_t k = 1; k < p; ++k)
+            {
+                betas[k - 1] = coef[k];
+                betaT[k - 1] = coef[k] / std::sqrt(sigma2 * invDiag[k]);
+            }
+        }
+    }
+
+    FactorRegression regressOnFactors(const std::vector<std::vector<double>> &assetReturns,
+                                      const std::vector<std::vector<double>> &factorReturns)
+    {
+        TRADEIQ_TIMED_SCOPE("stats.factor_regression");
+        const size_t t = checkShapes(assetReturns, factorReturns);
+        const size_t k = factorReturns.size();
+        const size_t p = k + 1;
+        if (t <= p)
+            throw std::invalid_argument("Need more observations than factors + 1.");
+
+        const std::vector<double> x = designMatrix(factorReturns, t);
+
+        std::vector<double> xtx(p * p, 0.0);
+        for (size_t i = 0; i < t; ++i)
+        {
+            const double *row = x.data() + i * p;
+            for (size_t r = 0; r < p; ++r)
+                for (size_t c = 0; c <= r; ++c)
+                    xtx[r * p + c] += row[r] * row[c];
+        }
+        if (!cholesky(xtx, p))
+            throw std::runtime_error("Factor matrix is singular (collinear or constant factors).");
+        std::vector<double> invDiag;
+        inverseDiagonal(xtx, p, invDiag);
+
+        FactorRegression out;
+        out.assets = assetReturns.size();
+        out.factors = k;
+        out.alphas.resize(out.assets);
+        out.betas.resize(out.assets * k);
+        out.alphaTStats.resize(out.assets);
+        out.betaTStats.resize(out.assets * k);
+        out.rSquared.resize(out.assets);
+
+        const double dof = static_cast<double>(t - p);
+        std::vector<double> xty(p), coef(p);
+        for (size_t a = 0; a < out.assets; ++a)
+        {
+            const double *y = assetReturns[a].data();
+            std::fill(xty.begin(), xty.end(), 0.0);
+            for (size_t i = 0; i < t; ++i)
+            {
+                const double *row = x.data() + i * p;
+                for (size_t r = 0; r < p; ++r)
+                    xty[r] += row[r] * y[i];
+            }
+            choleskySolve(xtx, p, xty.data(), coef.data());
+
+            const double *b = coef.data();
+            const double *xs = x.data();
+            const double ssr = Summation::reduce<1, double>(t, [y, b, xs, p](size_t i) {
+                double fit = 0.0;
+                for (size_t r = 0; r < p; ++r)
+                    fit += xs[i * p + r] * b[r];
+                double e = y[i] - fit;
+                return std::array<double, 1>{e * e};
+            })[0];
+
+            std::span<const double> ys(y, t);
+            const double sst = Summation::sumSquaredDeviations(ys, Summation::sum(ys) / static_cast<double>(t));
+
+            storeFit(coef.data(), invDiag, p, ssr, dof, &out.alphas[a], &out.betas[a * k], &out.alphaTStats[a],
+                     &out.betaTStats[a * k]);
+            out.rSquared[a] = sst > 0.0 ? 1.0 - ssr / sst : kNaN;
+        }
+        return out;
+    }
+
+    RollingFactorRegression rollingRegressOnFactors(const std::vector<std::vector<double>> &assetReturns,
+                                                    const std::vector<std::vector<double>> &factorReturns,
+                                                    size_t window)
+    {
+        TRADEIQ_TIMED_SCOPE("stats.rolling_factor_regression");
+        const size_t t = checkShapes(assetReturns, factorReturns);
+        const size_t k = factorReturns.size();
+        const size_t p = k + 1;
+        if (window <= p || window > t)
+            throw std::invalid_argument("Window must exceed factors + 1 and fit in the series.");
+
+        const std::vector<double> x = designMatrix(factorReturns, t);
+        const size_t n = assetReturns.size();
+
+        RollingFactorRegression out;
+        out.windows = t - window + 1;
+        out.assets = n;
+        out.factors = k;
+        out.window = window;
+        out.alphas.resize(out.windows * n);
+        out.betas.resize(out.windows * n * k);
+        out.alphaTStats.resize(out.windows * n);
+        out.betaTStats.resize(out.windows * n * k);
+        out.rSquared.resize(out.windows * n);
+
+        // Sliding sums: G = X'X (lower triangle), and per asset X'z, sum z and
+        // sum z^2 for z = y - shift. The shift is the asset's mean over the
+        // window at the last rebuild, so SSR and SST below come from sums of
+        // deviations rather than raw squares.
+        std::vector<double> g(p * p), xtz(n * p), sz(n), szz(n), shift(n);
+        auto accumulateRow = [&](size_t i, double sign) {
+            const double *row = x.data() + i * p;
+            for (size_t r = 0; r < p; ++r)
+                for (size_t c = 0; c <= r; ++c)
+                    g[r * p + c] += sign * row[r] * row[c];
+            for (size_t a = 0; a < n; ++a)
+            {
+                const double z = assetReturns[a][i] - shift[a];
+                const double signedZ = sign * z;
+                double *c = xtz.data() + a * p;
+                for (size_t r = 0; r < p; ++r)
+                    c[r] += row[r] * signedZ;
+                sz[a] += signedZ;
+                szz[a] += signedZ * z;
+            }
+        };
+
+        const double w = static_cast<double>(window);
+        const double dof = static_cast<double>(window - p);
+        std::vector<double> l(p * p), invDiag, coef(p);
+        for (size_t s = 0; s < out.windows; ++s)
+        {
+            if (s % window == 0)
+            {
+                for (size_t a = 0; a < n; ++a)
+                    shift[a] = Summation::sum(std::span<const double>(assetReturns[a].data() + s, window)) / w;
+                std::fill(g.begin(), g.end(), 0.0);
+                std::fill(xtz.begin(), xtz.end(), 0.0);
+                std::fill(sz.begin(), sz.end(), 0.0);
+                std::fill(szz.begin(), szz.end(), 0.0);
+                for (size_t i = s; i < s + window; ++i)
+                    accumulateRow(i, 1.0);
+            }
+            else
+            {
+                accumulateRow(s + window - 1, 1.0);
+                accumulateRow(s - 1, -1.0);
+            }
+
+            l = g;
+            const bool ok = cholesky(l, p);
+            if (ok)
+                inverseDiagonal(l, p, invDiag);
+
+            for (size_t a = 0; a < n; ++a)
+            {
+                const size_t idx = s * n + a;
+                if (!ok)
+                {
+                    out.alphas[idx] = out.alphaTStats[idx] = out.rSquared[idx] = kNaN;
+                    std::fill_n(out.betas.begin() + idx * k, k, kNaN);
+                    std::fill_n(out.betaTStats.begin() + idx * k, k, kNaN);
+                    continue;
+                }
+                const double *c = xtz.data() + a * p;
+                choleskySolve(l, p, c, coef.data());
+
+                // At the optimum, SSR = z'z - b'X'z. When the fit leaves little
+                // of z'z that difference is mostly rounding, so sum the
+                // residuals of this window instead.
+                double explained = 0.0;
+                for (size_t r = 0; r < p; ++r)
+                    explained += coef[r] * c[r];
+                double ssr = szz[a] - explained;
+                if (!(ssr > kResidualFloor * szz[a]))
+                {
+                    const double *y = assetReturns[a].data() + s;
+                    const double *xs = x.data() + s * p;
+                    const double *b = coef.data();
+                    const double m = shift[a];
+                    ssr = Summation::reduce<1, double>(window, [y, xs, b, p, m](size_t i) {
+                        double fit = m;
+                        for (size_t r = 0; r < p; ++r)
+                            fit += xs[i * p + r] * b[r];
+                        const double e = y[i] - fit;
+                        return std::array<double, 1>{e * e};
+                    })[0];
+                }
+                const double sst = std::max(szz[a] - sz[a] * sz[a] / w, 0.0);
+
+                // y = z + shift, and X has an intercept column.
+                coef[0] += shift[a];
+                storeFit(coef.data(), invDiag, p, ssr, dof, &out.alphas[idx], &out.betas[idx * k],
+                         &out.alphaTStats[idx], &out.betaTStats[idx * k]);
+                out.rSquared[idx] = sst > 0.0 ? 1.0 - ssr / sst : kNaN;
+            }
+        }
+        return out;
+    }
+
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+// Multi-factor OLS over a returns panel:
+//   r_a(t) = alpha_a + sum_k beta_ak * f_k(t) + e_a(t)
+//
+// Every asset shares the same design matrix X = [1, f_1 .. f_K], so X'X is
+// Cholesky-factored once and each asset costs one pass for X'y, a P x P
+// triangular solve (P = K + 1) and one pass for its residuals. The rolling
+// variant slides X'X and X'y by adding the newest row and removing the oldest
+// (O(K^2) per step) and rebuilds them every `window` steps so rounding cannot
+// accumulate; y is taken about its window mean at each rebuild, and windows
+// fitted almost exactly get their SSR from a residual pass.
+namespace Stats::Regression
+{
+
+    struct FactorRegression
+    {
+        size_t assets = 0;
+        size_t factors = 0;
+        std::vector<double> alphas;      // [asset]
+        std::vector<double> betas;       // [asset * factors + factor]
+        std::vector<double> alphaTStats; // [asset]
+        std::vector<double> betaTStats;  // [asset * factors + factor]
+        std::vector<double> rSquared;    // [asset]
+
+        double beta(size_t asset, size_t factor) const { return betas[asset * factors + factor]; }
+        double betaTStat(size_t asset, size_t factor) const { return betaTStats[asset * factors + factor]; }
+    };
+
+    // Window i covers observations [i, i + window); results are indexed by
+    // window first, then asset. Windows whose factors are collinear are NaN.
+    struct RollingFactorRegression
+    {
+        size_t windows = 0;
+        size_t assets = 0;
+        size_t factors = 0;
+        size_t window = 0;
+        std::vector<double> alphas;      // [w * assets + asset]
+        std::vector<double> betas;       // [(w * assets + asset) * factors + factor]
+        std::vector<double> alphaTStats; // [w * assets + asset]
+        std::vector<double> betaTStats;  // [(w * assets + asset) * factors + factor]
+        std::vector<double> rSquared;    // [w * assets + asset]
+
+        double alpha(size_t w, size_t asset) const { return alphas[w * assets + asset]; }
+        double beta(size_t w, size_t asset, size_t factor) const { return betas[(w * assets + asset) * factors + factor]; }
+    };
+
+    // assetReturns[a] and factorReturns[k] must share one length T > factors + 1.
+    // Throws std::invalid_argument on shape errors and std::runtime_error when
+    // the factors are collinear (including a constant factor).
+    FactorRegression regressOnFactors(const std::vector<std::vector<double>> &assetReturns,
+                                      const std::vector<std::vector<double>> &factorReturns);
+
+    // Requires factors + 1 < window <= T.
+    RollingFactorRegression rollingRegressOnFactors(const std::vector<std::vector<double>> &assetReturns,
+                                                    const std::vector<std::vector<double>> &factorReturns,
+                                                    size_t window);
+
+}
@@ -1,5 +1,7 @@
 #include "stats/returns.hpp"
-#include <numeric>
+#include "../utils/instrumentation.hpp"
+#include "../utils/summation.hpp"
+#include <array>
 #include <stdexcept>
 #include <cmath>
 
@@ -30,10 +32,11 @@ std::vector<double> computeDailyReturns(const PriceSeries &series) {
 }
 
 
-double meanReturns(const std::vector<double> &returns) {
+template <typename T>
+T meanReturns(const std::vector<T> &returns) {
     if (returns.empty()) throw std::invalid_argument("Returns vector is empty");
-    double sum = std::accumulate(returns.begin(), returns.end(), 0.0);
-    return sum / static_cast<double>(returns.size());
+    T sum = Summation::sum<T>(returns.begin(), returns.end());
+    return sum / static_cast<T>(returns.size());
 }
 
 double computeTotalReturn(const PriceSeries& series) {
@@ -58,16 +61,33 @@ double computeAnnualizedReturn(double totalReturn, int numPeriods, int periodsPe
     return std::pow(1.0 + totalReturn, static_cast<double>(periodsPerYear) / numPeriods) - 1.0;
 }
 
-double expectedPortfolioReturn(const std::vector<double> &meanReturns,
-                               const std::vector<double> &weights) {
+template <typename T>
+T expectedPortfolioReturn(const std::vector<T> &meanReturns,
+                          const std::vector<T> &weights) {
     if (meanReturns.size() != weights.size())
         throw std::invalid_argument("Mismatched lengths in expectedPortfolioReturn");
 
-    double result = 0.0;
-    for (size_t i = 0; i < meanReturns.size(); ++i) {
-        result += meanReturns[i] * weights[i];
-    }
-    return result;
+    const T *m = meanReturns.data();
+    const T *w = weights.data();
+    return Summation::reduce<1, T>(meanReturns.size(), [m, w](size_t i) {
+        return std::array<T, 1>{m[i] * w[i]};
+    })[0];
+}
+
+template <Execution::Policy P>
+std::vector<std::vector<double>> computeDailyReturns(P policy, const std::vector<PriceSeries> &series) {
+    TRADEIQ_TIMED_SCOPE("stats.daily_returns_panel");
+    return Execution::map(policy, series.size(), [&](size_t i) { return computeDailyReturns(series[i]); });
 }
 
+template std::vector<std::vector<double>> computeDailyReturns(Execution::SequencedPolicy, const std::vector<PriceSeries> &);
+template std::vector<std::vector<double>> computeDailyReturns(Execution::ParallelPolicy, const std::vector<PriceSeries> &);
+template std::vector<std::vector<double>> computeDailyReturns(Execution::ParallelUnsequencedPolicy,
+                                                              const std::vector<PriceSeries> &);
+
+template float meanReturns<float>(const std::vector<float> &);
+template double meanReturns<double>(const std::vector<double> &);
+template float expectedPortfolioReturn<float>(const std::vector<float> &, const std::vector<float> &);
+template double expectedPortfolioReturn<double>(const std::vector<double> &, const std::vector<double> &);
+
 }
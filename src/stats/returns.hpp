@@ -1,5 +1,5 @@
 /*
-computeDailyReturns
+computeDailyReturns (single series, or many under an execution policy)
 meanReturns
 computeTotalReturn
 computeAnnualizedReturn
@@ -9,6 +9,8 @@ expectedPortfolioReturn
 #pragma once
 
 #include "core/price_series.hpp"
+#include "../utils/execution.hpp"
+#include <type_traits>
 #include <vector>
 #include <string>
 
@@ -17,8 +19,13 @@ namespace Stats::Returns {
     // Compute simple daily percentage returns from price series
     std::vector<double> computeDailyReturns(const PriceSeries &series);
 
+    // Daily returns of every series, one task per series (see Execution).
+    template <Execution::Policy P>
+    std::vector<std::vector<double>> computeDailyReturns(P policy, const std::vector<PriceSeries> &series);
+
     // Mean of any return vector
-    double meanReturns(const std::vector<double> &returns);
+    template <typename T = double>
+    T meanReturns(const std::vector<T> &returns);
 
     // Cumulative total return from price series
     double computeTotalReturn(const PriceSeries &series);
@@ -27,7 +34,8 @@ namespace Stats::Returns {
     double computeAnnualizedReturn(double totalReturn, int numPeriods, int periodsPerYear);
 
     // Weighted expected return from mean return vector and weights
-    double expectedPortfolioReturn(const std::vector<double> &meanReturns,
-                                   const std::vector<double> &weights);
+    template <typename T = double>
+    T expectedPortfolioReturn(const std::vector<T> &meanReturns,
+                              const std::vector<T> &weights);
 
 }
@@ -0,0 +1,183 @@
+#include "stats/thresholds.hpp"
+#include "../utils/instrumentation.hpp"
+#include "../utils/summation.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <span>
+#include <stdexcept>
+
+namespace Stats::Thresholds
+{
+    namespace
+    {
+        // out[k] = compensated sum of the first k values of `values`.
+        template <typename T, typename Value>
+        std::vector<T> prefixSums(size_t n, Value value)
+        {
+            std::vector<T> out(n + 1);
+            Summation::Accumulator<T> acc;
+            out[0] = 0;
+            for (size_t i = 0; i < n; ++i)
+            {
+                acc.add(value(i));
+                out[i + 1] = acc.value();
+            }
+            return out;
+        }
+    }
+
+    template <typename T>
+    ReturnThresholds<T>::ReturnThresholds(const std::vector<T> &returns) : sorted_(returns)
+    {
+        std::sort(sorted_.begin(), sorted_.end());
+        if (!sorted_.empty())
+            mean_ = Summation::sum(std::span<const T>(sorted_)) / static_cast<T>(sorted_.size());
+        prefix_ = prefixSums<T>(sorted_.size(), [this](size_t i) { return sorted_[i] - mean_; });
+        prefixSq_ = prefixSums<T>(sorted_.size(), [this](size_t i) {
+            T d = sorted_[i] - mean_;
+            return d * d;
+        });
+    }
+
+    template <typename T>
+    T ReturnThresholds<T>::omega(std::type_identity_t<T> threshold) const
+    {
+        const size_t n = sorted_.size();
+        const size_t k = static_cast<size_t>(std::lower_bound(sorted_.begin(), sorted_.end(), threshold) - sorted_.begin());
+        const T shift = threshold - mean_;
+        const T below = static_cast<T>(k), above = static_cast<T>(n - k);
+
+        // Gains over r >= tau and losses over r < tau, clamped against rounding.
+        const T gain = std::max((prefix_[n] - prefix_[k]) - above * shift, T(0));
+        const T loss = std::max(below * shift - prefix_[k], T(0));
+        if (loss == 0)
+            return std::numeric_limits<T>::infinity();
+        return gain / loss;
+    }
+
+    template <typename T>
+    T ReturnThresholds<T>::downsideDeviation(std::type_identity_t<T> threshold) const
+    {
+        const size_t k = static_cast<size_t>(std::lower_bound(sorted_.begin(), sorted_.end(), threshold) - sorted_.begin());
+        if (k == 0)
+            return 0;
+        const T shift = threshold - mean_;
+        const T count = static_cast<T>(k);
+        const T squares = prefixSq_[k] - T(2) * shift * prefix_[k] + count * shift * shift;
+        return std::sqrt(std::max(squares, T(0)) / count);
+    }
+
+    template <typename T>
+    T ReturnThresholds<T>::sortino(std::type_identity_t<T> expectedReturn, std::type_identity_t<T> threshold) const
+    {
+        const T dd = downsideDeviation(threshold);
+        if (dd == 0)
+            return std::numeric_limits<T>::infinity();
+        return (expectedReturn - threshold) / dd;
+    }
+
+    template <typename T>
+    CaptureThresholds<T>::CaptureThresholds(const std::vector<T> &portfolioReturns, const std::vector<T> &benchmarkReturns)
+    {
+        if (portfolioReturns.size() != benchmarkReturns.size())
+            throw std::invalid_argument("Return vectors must be the same length.");
+
+        const size_t n = benchmarkReturns.size();
+        std::vector<size_t> order(n);
+        std::iota(order.begin(), order.end(), 0);
+        std::sort(order.begin(), order.end(),
+                  [&benchmarkReturns](size_t a, size_t b) { return benchmarkReturns[a] < benchmarkReturns[b]; });
+
+        benchmark_.resize(n);
+        for (size_t i = 0; i < n; ++i)
+            benchmark_[i] = benchmarkReturns[order[i]];
+        portfolioPrefix_ = prefixSums<T>(n, [&](size_t i) { return portfolioReturns[order[i]]; });
+        benchmarkPrefix_ = prefixSums<T>(n, [this](size_t i) { return benchmark_[i]; });
+    }
+
+    template <typename T>
+    T CaptureThresholds<T>::upside(std::type_identity_t<T> threshold) const
+    {
+        const size_t n = benchmark_.size();
+        const size_t k = static_cast<size_t>(std::upper_bound(benchmark_.begin(), benchmark_.end(), threshold) - benchmark_.begin());
+        const T bench = benchmarkPrefix_[n] - benchmarkPrefix_[k];
+        if (bench == 0)
+            return 0;
+        return (portfolioPrefix_[n] - portfolioPrefix_[k]) / bench;
+    }
+
+    template <typename T>
+    T CaptureThresholds<T>::downside(std::type_identity_t<T> threshold) const
+    {
+        const size_t k = static_cast<size_t>(std::lower_bound(benchmark_.begin(), benchmark_.end(), threshold) - benchmark_.begin());
+        const T bench = benchmarkPrefix_[k];
+        if (bench == 0)
+            return 0;
+        return portfolioPrefix_[k] / bench;
+    }
+
+    template <typename T>
+    std::vector<T> computeOmegaCurve(const std::vector<T> &returns, const std::vector<T> &thresholds)
+    {
+        TRADEIQ_TIMED_SCOPE("stats.omega_curve");
+        const ReturnThresholds<T> curve(returns);
+        std::vector<T> out(thresholds.size());
+        for (size_t i = 0; i < thresholds.size(); ++i)
+            out[i] = curve.omega(thresholds[i]);
+        return out;
+    }
+
+    template <typename T>
+    std::vector<T> computeSortinoCurve(std::type_identity_t<T> expectedReturn, const std::vector<T> &returns,
+                                       const std::vector<T> &thresholds)
+    {
+        TRADEIQ_TIMED_SCOPE("stats.sortino_curve");
+        const ReturnThresholds<T> curve(returns);
+        std::vector<T> out(thresholds.size());
+        for (size_t i = 0; i < thresholds.size(); ++i)
+            out[i] = curve.sortino(expectedReturn, thresholds[i]);
+        return out;
+    }
+
+    template <typename T>
+    std::vector<T> computeUpsideCaptureCurve(const std::vector<T> &portfolioReturns, const std::vector<T> &benchmarkReturns,
+                                             const std::vector<T> &thresholds)
+    {
+        const CaptureThresholds<T> curve(portfolioReturns, benchmarkReturns);
+        std::vector<T> out(thresholds.size());
+        for (size_t i = 0; i < thresholds.size(); ++i)
+            out[i] = curve.upside(thresholds[i]);
+        return out;
+    }
+
+    template <typename T>
+    std::vector<T> computeDownsideCaptureCurve(const std::vector<T> &portfolioReturns,
+                                               const std::vector<T> &benchmarkReturns, const std::vector<T> &thresholds)
+    {
+        const CaptureThresholds<T> curve(portfolioReturns, benchmarkReturns);
+        std::vector<T> out(thresholds.size());
+        for (size_t i = 0; i < thresholds.size(); ++i)
+            out[i] = curve.downside(thresholds[i]);
+        return out;
+    }
+
+#define TRADEIQ_THRESHOLDS_INSTANTIATE(T)                                                                              \
+    template class ReturnThresholds<T>;                                                                                \
+    template class CaptureThresholds<T>;                                                                               \
+    template std::vector<T> computeOmegaCurve<T>(const std::vector<T> &, const std::vector<T> &);                      \
+    template std::vector<T> computeSortinoCurve<T>(std::type_identity_t<T>, const std::vector<T> &,                    \
+                                                   const std::vector<T> &);                                            \
+    template std::vector<T> computeUpsideCaptureCurve<T>(const std::vector<T> &, const std::vector<T> &,               \
+                                                         const std::vector<T> &);                                      \
+    template std::vector<T> computeDownsideCaptureCurve<T>(const std::vector<T> &, const std::vector<T> &,             \
+                                                           const std::vector<T> &);
+
+    TRADEIQ_THRESHOLDS_INSTANTIATE(float)
+    TRADEIQ_THRESHOLDS_INSTANTIATE(double)
+
+#undef TRADEIQ_THRESHOLDS_INSTANTIATE
+
+}
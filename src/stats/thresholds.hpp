@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+// Threshold curves: Omega, Sortino and capture ratios at many minimum
+// acceptable returns (MAR) for the cost of one sort.
+//
+// The returns are sorted once, centred on their mean, and stored with
+// compensated prefix sums of the values and their squares. For a threshold
+// tau, one binary search gives the count k below tau and
+//   sum_{r < tau} (tau - r)   = k (tau - mu) - P1[k]
+//   sum_{r < tau} (r - tau)^2 = P2[k] - 2 (tau - mu) P1[k] + k (tau - mu)^2
+// so each query is O(log n) and agrees with the full scans in Stats::Ratios
+// and Stats::Capture to rounding.
+namespace Stats::Thresholds
+{
+
+    template <typename T = double>
+    class ReturnThresholds
+    {
+    public:
+        explicit ReturnThresholds(const std::vector<T> &returns);
+
+        // Stats::Ratios::computeOmegaRatio(returns, threshold).
+        T omega(std::type_identity_t<T> threshold) const;
+        // sqrt of the mean squared shortfall over returns below the threshold;
+        // 0 when none are below.
+        T downsideDeviation(std::type_identity_t<T> threshold) const;
+        // Stats::Ratios::computeSortinoRatio(expectedReturn, threshold, returns).
+        T sortino(std::type_identity_t<T> expectedReturn, std::type_identity_t<T> threshold) const;
+
+        size_t size() const { return sorted_.size(); }
+
+    private:
+        std::vector<T> sorted_;
+        std::vector<T> prefix_;   // prefix_[k] = sum of (sorted_[i] - mean_) for i < k
+        std::vector<T> prefixSq_; // same for squares
+        T mean_ = 0;
+    };
+
+    // Capture ratios with the benchmark split at `threshold` instead of 0:
+    // upside over periods with benchmark > threshold, downside below it.
+    // threshold = 0 matches Stats::Capture.
+    template <typename T = double>
+    class CaptureThresholds
+    {
+    public:
+        // Throws std::invalid_argument if the lengths differ.
+        CaptureThresholds(const std::vector<T> &portfolioReturns, const std::vector<T> &benchmarkReturns);
+
+        T upside(std::type_identity_t<T> threshold) const;
+        T downside(std::type_identity_t<T> threshold) const;
+
+    private:
+        std::vector<T> benchmark_;          // sorted
+        std::vector<T> portfolioPrefix_;    // in benchmark order
+        std::vector<T> benchmarkPrefix_;
+    };
+
+    template <typename T = double>
+    std::vector<T> computeOmegaCurve(const std::vector<T> &returns, const std::vector<T> &thresholds);
+
+    template <typename T = double>
+    std::vector<T> computeSortinoCurve(std::type_identity_t<T> expectedReturn, const std::vector<T> &returns,
+                                       const std::vector<T> &thresholds);
+
+    template <typename T = double>
+    std::vector<T> computeUpsideCaptureCurve(const std::vector<T> &portfolioReturns, const std::vector<T> &benchmarkReturns,
+                                             const std::vector<T> &thresholds);
+
+    template <typename T = double>
+    std::vector<T> computeDownsideCaptureCurve(const std::vector<T> &portfolioReturns,
+                                               const std::vector<T> &benchmarkReturns, const std::vector<T> &thresholds);
+
+}
@@ -1,89 +1,80 @@
 #include "stats/utils.hpp"
+#include "stats/moments.hpp"
+#include "../utils/summation.hpp"
+#include <array>
 #include <cmath>
 #include <stdexcept>
-#include <numeric>
-#include <unordered_set>
+#include <limits>
 
 namespace Stats::Utils {
 
-double computeSkewness(const std::vector<double> &returns) {
+template <typename T>
+T computeSkewness(const std::vector<T> &returns) {
     const size_t n = returns.size();
     if (n < 3)
         throw std::invalid_argument("Skewness requires at least 3 data points.");
 
-    std::unordered_set<double> s(returns.begin(), returns.end());
-    if(s.size() == 1 ) throw std::invalid_argument("All elements in this vector are identical");
-    double mean = std::accumulate(returns.begin(), returns.end(), 0.0) / n;
-
-    double m2 = 0.0, m3 = 0.0;
-    for (double x : returns) {
-        double diff = x - mean;
-        m2 += diff * diff;
-        m3 += diff * diff * diff;
-    }
-
-    m2 /= n;
-    m3 /= n;
-
-    if (m2 == 0.0)
+    auto m = Moments::summarize<3>(returns);
+    if (m.constant)
+        throw std::invalid_argument("All elements in this vector are identical");
+    if (m.m2 == 0)
         throw std::invalid_argument("Skewness undefined for zero variance.");
 
-    return m3 / std::pow(m2, 1.5);
+    return Moments::skewness(m, Moments::Estimator::Population);
 }
 
-double computeKurtosis(const std::vector<double> &returns) {
+template <typename T>
+T computeKurtosis(const std::vector<T> &returns) {
     const size_t n = returns.size();
     if (n < 4)
         throw std::invalid_argument("Kurtosis requires at least 4 data points.");
 
-    double mean = std::accumulate(returns.begin(), returns.end(), 0.0) / n;
-
-    double m2 = 0.0, m4 = 0.0;
-    for (double x : returns) {
-        double diff = x - mean;
-        m2 += diff * diff;
-        m4 += diff * diff * diff * diff;
-    }
-
-    m2 /= n;
-    m4 /= n;
+    auto m = Moments::summarize<4>(returns);
+    if (m.m2 == 0)
+        return std::numeric_limits<T>::quiet_NaN();  // undefined
 
-    if (m2 == 0.0)
-        return std::numeric_limits<double>::quiet_NaN();  // undefined
-
-    return m4 / (m2 * m2) - 3.0; // excess kurtosis
+    return Moments::excessKurtosis(m, Moments::Estimator::Population);
 }
 
-double computeGainLossRatio(const std::vector<double> &returns) {
+template <typename T>
+T computeGainLossRatio(const std::vector<T> &returns) {
     if (returns.empty())
         throw std::invalid_argument("Returns cannot be empty.");
 
-    double gains = 0.0, losses = 0.0;
-
-    for (double r : returns) {
-        if (r > 0.0)
-            gains += r;
-        else if (r < 0.0)
-            losses += std::abs(r);
-    }
+    const T *p = returns.data();
+    auto sums = Summation::reduce<2, T>(returns.size(), [p](size_t i) {
+        return std::array<T, 2>{p[i] > 0 ? p[i] : T(0), p[i] < 0 ? -p[i] : T(0)};
+    });
 
-    if (losses == 0.0)
-        return std::numeric_limits<double>::infinity();
-    return gains / losses;
+    if (sums[1] == 0)
+        return std::numeric_limits<T>::infinity();
+    return sums[0] / sums[1];
 }
 
-double computeHitRatio(const std::vector<double> &returns) {
+template <typename T>
+T computeHitRatio(const std::vector<T> &returns) {
     const size_t n = returns.size();
     if (n == 0)
         throw std::invalid_argument("Returns cannot be empty.");
 
     size_t hits = 0;
-    for (double r : returns) {
-        if (r > 0.0)
+    for (T r : returns) {
+        if (r > 0)
             ++hits;
     }
 
-    return static_cast<double>(hits) / n;
+    return static_cast<T>(static_cast<double>(hits) / n);
 }
 
+#define TRADEIQ_STATS_UTILS_INSTANTIATE(T)                       \
+    template T computeSkewness<T>(const std::vector<T> &);       \
+    template T computeKurtosis<T>(const std::vector<T> &);       \
+    template T computeGainLossRatio<T>(const std::vector<T> &);  \
+    template T computeHitRatio<T>(const std::vector<T> &);
+
+TRADEIQ_STATS_UTILS_INSTANTIATE(float)
+TRADEIQ_STATS_UTILS_INSTANTIATE(double)
+
+#undef TRADEIQ_STATS_UTILS_INSTANTIATE
+
 } 
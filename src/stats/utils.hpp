@@ -4,11 +4,15 @@
 
 namespace Stats::Utils {
 
-    double computeSkewness(const std::vector<double> &returns);
+    template <typename T = double>
+    T computeSkewness(const std::vector<T> &returns);
 
-    double computeKurtosis(const std::vector<double> &returns);
+    template <typename T = double>
+    T computeKurtosis(const std::vector<T> &returns);
 
-    double computeGainLossRatio(const std::vector<double> &returns);
+    template <typename T = double>
+    T computeGainLossRatio(const std::vector<T> &returns);
 
-    double computeHitRatio(const std::vector<double> &returns);
-}
\ No newline at end of file
+    template <typename T = double>
+    T computeHitRatio(const std::vector<T> &returns);
+}
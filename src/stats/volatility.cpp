@@ -1,108 +1,175 @@
 #include "stats/volatility.hpp"
 #include "ratios.hpp"
+#include "../utils/instrumentation.hpp"
+#include "../utils/kernels.hpp"
+#include "../utils/summation.hpp"
+#include <algorithm>
 #include <cmath>
-#include <numeric>
+#include <span>
 #include <stdexcept>
 
 namespace Stats::Volatility
 {
 
-    double computeAnnualizedVolatility(const std::vector<double> &returns, int periodsPerYear)
+    template <typename T>
+    T computeAnnualizedVolatility(const std::vector<T> &returns, int periodsPerYear)
     {
         if (returns.empty())
             throw std::invalid_argument("Returns vector cannot be empty.");
         if (periodsPerYear <= 0)
             throw std::invalid_argument("Periods per year must be positive.");
 
-        double mean = std::accumulate(returns.begin(), returns.end(), 0.0) / returns.size();
-        double sumSquares = 0.0;
+        T variance = Summation::variance(std::span<const T>(returns), true);
+        return std::sqrt(variance) * std::sqrt(static_cast<T>(periodsPerYear));
+    }
 
-        for (double r : returns)
+    namespace
+    {
+        template <typename T, typename Out>
+        void rollingVolatilityInto(const std::vector<T> &returns, size_t window, Out &result)
         {
-            double diff = r - mean;
-            sumSquares += diff * diff;
+            if (returns.size() < window || window == 0)
+                return;
+
+            result.resize(returns.size() - window + 1);
+            Kernels::rollingMoments(returns.data(), returns.size(), window, static_cast<T *>(nullptr), result.data());
+            const T dof = static_cast<T>(window - 1);
+            for (T &v : result)
+                v = std::sqrt(v / dof);
         }
 
-        double variance = sumSquares / (returns.size() - 1);
-        return std::sqrt(variance) * std::sqrt(periodsPerYear);
+        template <typename T, typename Out>
+        void rollingSharpeInto(const std::vector<T> &returns, int windowSize, T riskFreeRate, Out &rollingSharpe)
+        {
+            if (windowSize <= 0 || returns.size() < static_cast<size_t>(windowSize))
+                return;
+
+            const size_t w = static_cast<size_t>(windowSize);
+            Out means(returns.size() - w + 1, rollingSharpe.get_allocator());
+            rollingSharpe.resize(means.size());
+            Kernels::rollingMoments(returns.data(), returns.size(), w, means.data(), rollingSharpe.data());
+            for (size_t i = 0; i < means.size(); ++i)
+            {
+                T variance = rollingSharpe[i] / static_cast<T>(windowSize);
+                rollingSharpe[i] = static_cast<T>(Stats::Ratios::computeSharpeRatio(means[i], variance, riskFreeRate));
+            }
+        }
     }
 
-    std::vector<double> computeRollingStandardDeviation(const std::vector<double> &returns, bool sample)
+    template <typename T>
+    std::vector<T> computeRollingStandardDeviation(const std::vector<T> &returns, bool sample)
     {
+        TRADEIQ_TIMED_SCOPE("stats.rolling_std");
         size_t window = 3;
         if (returns.size() < window)
             return {};
 
-        std::vector<double> result;
-        result.reserve(returns.size() - window + 1);
-
-        for (size_t i = 0; i <= returns.size() - window; ++i)
-        {
-            double sum = 0.0, sumSq = 0.0;
-
-            for (size_t j = 0; j < window; ++j)
-            {
-                double val = returns[i + j];
-                sum += val;
-                sumSq += val * val;
-            }
+        std::vector<T> result(returns.size() - window + 1);
+        Kernels::rollingMoments(returns.data(), returns.size(), window, static_cast<T *>(nullptr), result.data());
 
-            double mean = sum / window;
-            double variance = (sumSq - window * mean * mean) / (sample ? (window - 1) : window);
-            result.push_back(std::sqrt(variance));
-        }
+        const T dof = static_cast<T>(sample ? window - 1 : window);
+        for (T &v : result)
+            v = std::sqrt(v / dof);
 
         return result;
     }
 
-    std::vector<double> computeRollingVolatility(const std::vector<double> &returns, size_t window)
+    template <typename T>
+    std::vector<T> computeRollingVolatility(const std::vector<T> &returns, size_t window)
     {
-        if (returns.size() < window || window == 0)
-            return {};
-
-        std::vector<double> result;
-        result.reserve(returns.size() - window + 1);
-
-        for (size_t i = 0; i <= returns.size() - window; ++i)
-        {
-            double sum = 0.0, sumSq = 0.0;
-
-            for (size_t j = 0; j < window; ++j)
-            {
-                double val = returns[i + j];
-                sum += val;
-                sumSq += val * val;
-            }
-
-            double mean = sum / window;
-            double variance = (sumSq - window * mean * mean) / (window - 1);
-            result.push_back(std::sqrt(variance));
-        }
-
+        TRADEIQ_TIMED_SCOPE("stats.rolling_volatility");
+        std::vector<T> result;
+        rollingVolatilityInto(returns, window, result);
         return result;
     }
 
-    std::vector<double> computeRollingSharpe(const std::vector<double> &returns, int windowSize, double riskFreeRate)
+    template <typename T>
+    std::pmr::vector<T> computeRollingVolatility(const std::vector<T> &returns, size_t window,
+                                                 std::pmr::memory_resource *scratch)
     {
-        std::vector<double> rollingSharpe;
+        TRADEIQ_TIMED_SCOPE("stats.rolling_volatility");
+        std::pmr::vector<T> result(scratch ? scratch : std::pmr::get_default_resource());
+        rollingVolatilityInto(returns, window, result);
+        return result;
+    }
 
-        for (size_t i = 0; i + windowSize <= returns.size(); ++i)
-        {
-            std::vector<double> window(returns.begin() + i, returns.begin() + i + windowSize);
+    template <typename T>
+    std::vector<T> computeRollingSharpe(const std::vector<T> &returns, int windowSize, std::type_identity_t<T> riskFreeRate)
+    {
+        TRADEIQ_TIMED_SCOPE("stats.rolling_sharpe");
+        std::vector<T> rollingSharpe;
+        rollingSharpeInto<T>(returns, windowSize, riskFreeRate, rollingSharpe);
+        return rollingSharpe;
+    }
 
-            double sum = std::accumulate(window.begin(), window.end(), 0.0);
-            double mean = sum / windowSize;
+    template <typename T>
+    std::pmr::vector<T> computeRollingSharpe(const std::vector<T> &returns, int windowSize, std::type_identity_t<T> riskFreeRate,
+                                             std::pmr::memory_resource *scratch)
+    {
+        TRADEIQ_TIMED_SCOPE("stats.rolling_sharpe");
+        std::pmr::vector<T> rollingSharpe(scratch ? scratch : std::pmr::get_default_resource());
+        rollingSharpeInto<T>(returns, windowSize, riskFreeRate, rollingSharpe);
+        return rollingSharpe;
+    }
 
-            double variance = 0.0;
-            for (const auto &val : window)
-                variance += (val - mean) * (val - mean);
-            variance /= windowSize;
+    template <Execution::Policy P, typename T>
+    std::vector<T> computeAnnualizedVolatility(P policy, const std::vector<std::vector<T>> &returns, int periodsPerYear)
+    {
+        TRADEIQ_TIMED_SCOPE("stats.annualized_volatility_panel");
+        return Execution::map(policy, returns.size(),
+                              [&](size_t c) { return computeAnnualizedVolatility(returns[c], periodsPerYear); });
+    }
 
-            double sharpe = Stats::Ratios::computeSharpeRatio(mean, variance, riskFreeRate);
-            rollingSharpe.push_back(sharpe);
-        }
+    template <Execution::Policy P, typename T>
+    std::vector<std::vector<T>> computeRollingVolatility(P policy, const std::vector<std::vector<T>> &returns, size_t window)
+    {
+        TRADEIQ_TIMED_SCOPE("stats.rolling_volatility_panel");
+        return Execution::map(policy, returns.size(), [&](size_t c) {
+            std::vector<T> column;
+            rollingVolatilityInto(returns[c], window, column);
+            return column;
+        });
+    }
 
-        return rollingSharpe;
+    template <Execution::Policy P, typename T>
+    std::vector<std::vector<T>> computeRollingSharpe(P policy, const std::vector<std::vector<T>> &returns, int windowSize,
+                                                     std::type_identity_t<T> riskFreeRate)
+    {
+        TRADEIQ_TIMED_SCOPE("stats.rolling_sharpe_panel");
+        return Execution::map(policy, returns.size(), [&](size_t c) {
+            std::vector<T> column;
+            rollingSharpeInto<T>(returns[c], windowSize, riskFreeRate, column);
+            return column;
+        });
     }
 
+#define TRADEIQ_VOLATILITY_POLICY_INSTANTIATE(P, T)                                                                    \
+    template std::vector<T> computeAnnualizedVolatility<P, T>(P, const std::vector<std::vector<T>> &, int);            \
+    template std::vector<std::vector<T>> computeRollingVolatility<P, T>(P, const std::vector<std::vector<T>> &, size_t); \
+    template std::vector<std::vector<T>> computeRollingSharpe<P, T>(P, const std::vector<std::vector<T>> &, int,       \
+                                                                    std::type_identity_t<T>);
+
+    TRADEIQ_VOLATILITY_POLICY_INSTANTIATE(Execution::SequencedPolicy, float)
+    TRADEIQ_VOLATILITY_POLICY_INSTANTIATE(Execution::SequencedPolicy, double)
+    TRADEIQ_VOLATILITY_POLICY_INSTANTIATE(Execution::ParallelPolicy, float)
+    TRADEIQ_VOLATILITY_POLICY_INSTANTIATE(Execution::ParallelPolicy, double)
+    TRADEIQ_VOLATILITY_POLICY_INSTANTIATE(Execution::ParallelUnsequencedPolicy, float)
+    TRADEIQ_VOLATILITY_POLICY_INSTANTIATE(Execution::ParallelUnsequencedPolicy, double)
+
+#undef TRADEIQ_VOLATILITY_POLICY_INSTANTIATE
+
+#define TRADEIQ_VOLATILITY_INSTANTIATE(T)                                                                               \
+    template T computeAnnualizedVolatility<T>(const std::vector<T> &, int);                                             \
+    template std::vector<T> computeRollingVolatility<T>(const std::vector<T> &, size_t);                                \
+    template std::vector<T> computeRollingStandardDeviation<T>(const std::vector<T> &, bool);                           \
+    template std::vector<T> computeRollingSharpe<T>(const std::vector<T> &, int, std::type_identity_t<T>);              \
+    template std::pmr::vector<T> computeRollingVolatility<T>(const std::vector<T> &, size_t, std::pmr::memory_resource *); \
+    template std::pmr::vector<T> computeRollingSharpe<T>(const std::vector<T> &, int, std::type_identity_t<T>,          \
+                                                         std::pmr::memory_resource *);
+
+    TRADEIQ_VOLATILITY_INSTANTIATE(float)
+    TRADEIQ_VOLATILITY_INSTANTIATE(double)
+
+#undef TRADEIQ_VOLATILITY_INSTANTIATE
+
 } // namespace Stats::Volatility
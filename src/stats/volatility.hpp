@@ -1,15 +1,42 @@
 #pragma once
 
+#include "../utils/execution.hpp"
+#include <memory_resource>
+#include <type_traits>
 #include <vector>
 
 namespace Stats::Volatility {
 
-    double computeAnnualizedVolatility(const std::vector<double>& returns, int periodsPerYear);
+    template <typename T = double>
+    T computeAnnualizedVolatility(const std::vector<T>& returns, int periodsPerYear);
 
-    std::vector<double> computeRollingVolatility(const std::vector<double>& returns, size_t window);
+    template <typename T = double>
+    std::vector<T> computeRollingVolatility(const std::vector<T>& returns, size_t window);
 
-    std::vector<double> computeRollingStandardDeviation(const std::vector<double>& returns, bool sample = false);
+    template <typename T = double>
+    std::vector<T> computeRollingStandardDeviation(const std::vector<T>& returns, bool sample = false);
 
-    std::vector<double> computeRollingSharpe(const std::vector<double>& returns, int windowSize, double riskFreeRate);
+    template <typename T = double>
+    std::vector<T> computeRollingSharpe(const std::vector<T>& returns, int windowSize, std::type_identity_t<T> riskFreeRate);
 
-}
\ No newline at end of file
+    // Same results, allocated from `scratch` (e.g. a ScratchArena); nullptr uses the default resource.
+    template <typename T = double>
+    std::pmr::vector<T> computeRollingVolatility(const std::vector<T>& returns, size_t window,
+                                                 std::pmr::memory_resource* scratch);
+    template <typename T = double>
+    std::pmr::vector<T> computeRollingSharpe(const std::vector<T>& returns, int windowSize, std::type_identity_t<T> riskFreeRate,
+                                             std::pmr::memory_resource* scratch);
+
+    // Panel forms: one returns series per column, each column its own task
+    // (see Execution); result[c] is the single-series result for column c.
+    template <Execution::Policy P, typename T = double>
+    std::vector<T> computeAnnualizedVolatility(P policy, const std::vector<std::vector<T>>& returns, int periodsPerYear);
+
+    template <Execution::Policy P, typename T = double>
+    std::vector<std::vector<T>> computeRollingVolatility(P policy, const std::vector<std::vector<T>>& returns, size_t window);
+
+    template <Execution::Policy P, typename T = double>
+    std::vector<std::vector<T>> computeRollingSharpe(P policy, const std::vector<std::vector<T>>& returns, int windowSize,
+                                                     std::type_identity_t<T> riskFreeRate);
+
+}
@@ -0,0 +1,82 @@
+#include "arena.hpp"
+
+#include <algorithm>
+#include <cstdint>
+
+namespace
+{
+    constexpr size_t kChunkAlignment = alignof(std::max_align_t);
+
+    size_t alignUp(size_t value, size_t alignment) { return (value + alignment - 1) & ~(alignment - 1); }
+}
+
+ScratchArena::ScratchArena(size_t initialBytes, std::pmr::memory_resource *upstream)
+    : upstream_(upstream ? upstream : std::pmr::get_default_resource()),
+      nextSize_(std::max<size_t>(initialBytes, 1024)) {}
+
+ScratchArena::~ScratchArena()
+{
+    release();
+}
+
+void ScratchArena::reset()
+{
+    current_ = 0;
+    offset_ = 0;
+}
+
+void ScratchArena::release()
+{
+    for (const auto &c : chunks_)
+        upstream_->deallocate(c.data, c.size, kChunkAlignment);
+    chunks_.clear();
+    reset();
+}
+
+size_t ScratchArena::bytesUsed() const
+{
+    size_t used = offset_;
+    for (size_t i = 0; i < current_ && i < chunks_.size(); ++i)
+        used += chunks_[i].size;
+    return used;
+}
+
+size_t ScratchArena::capacity() const
+{
+    size_t total = 0;
+    for (const auto &c : chunks_)
+        total += c.size;
+    return total;
+}
+
+void *ScratchArena::do_allocate(size_t bytes, size_t alignment)
+{
+    bytes = std::max<size_t>(bytes, 1);
+
+    // Bump within the current chunk, else move on to the next retained chunk
+    // that fits, else grow. Skipped tails are reclaimed on reset().
+    while (current_ < chunks_.size())
+    {
+        Chunk &c = chunks_[current_];
+        uintptr_t base = reinterpret_cast<uintptr_t>(c.data);
+        size_t start = alignUp(base + offset_, alignment) - base;
+        if (start + bytes <= c.size)
+        {
+            offset_ = start + bytes;
+            return c.data + start;
+        }
+        ++current_;
+        offset_ = 0;
+    }
+
+    size_t size = std::max(nextSize_, alignUp(bytes + alignment, kChunkAlignment));
+    auto *data = static_cast<std::byte *>(upstream_->allocate(size, kChunkAlignment));
+    chunks_.push_back({data, size});
+    nextSize_ = size * 2;
+
+    current_ = chunks_.size() - 1;
+    uintptr_t base = reinterpret_cast<uintptr_t>(data);
+    size_t start = alignUp(base, alignment) - base;
+    offset_ = start + bytes;
+    return data + start;
+}
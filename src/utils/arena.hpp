@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstddef>
+#include <memory_resource>
+#include <vector>
+
+// Monotonic bump allocator for per-run scratch buffers.
+//
+// Unlike std::pmr::monotonic_buffer_resource, reset() rewinds to the first
+// chunk but keeps every chunk it has obtained from upstream. A loop that calls
+// reset() between iterations stops touching the heap once the arena has grown
+// to the peak working set. deallocate() is a no-op. Not thread-safe; use one
+// arena per worker.
+class ScratchArena : public std::pmr::memory_resource
+{
+public:
+    explicit ScratchArena(size_t initialBytes = 64 * 1024,
+                          std::pmr::memory_resource *upstream = std::pmr::get_default_resource());
+    ~ScratchArena() override;
+
+    ScratchArena(const ScratchArena &) = delete;
+    ScratchArena &operator=(const ScratchArena &) = delete;
+
+    // Invalidates everything allocated so far; keeps the memory.
+    void reset();
+    // Returns all chunks to upstream.
+    void release();
+
+    size_t bytesUsed() const;
+    size_t capacity() const;
+    size_t chunkCount() const { return chunks_.size(); }
+
+private:
+    struct Chunk
+    {
+        std::byte *data;
+        size_t size;
+    };
+
+    void *do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void *, size_t, size_t) override {}
+    bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override { return this == &other; }
+
+    std::pmr::memory_resource *upstream_;
+    std::vector<Chunk> chunks_;
+    size_t current_ = 0; // chunk being bumped
+    size_t offset_ = 0;  // bytes used in chunks_[current_]
+    size_t nextSize_;
+};
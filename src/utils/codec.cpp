@@ -0,0 +1,255 @@
+#include "codec.hpp"
+#include <bit>
+#include <cstring>
+#include <stdexcept>
+
+namespace Codec
+{
+    namespace
+    {
+        class BitWriter
+        {
+        public:
+            explicit BitWriter(std::string &out) : out_(out) {}
+
+            void write(uint64_t value, unsigned bits)
+            {
+                while (bits > 0)
+                {
+                    unsigned space = 8 - used_;
+                    unsigned take = bits < space ? bits : space;
+                    uint8_t chunk = static_cast<uint8_t>((value >> (bits - take)) & ((1u << take) - 1));
+                    current_ = static_cast<uint8_t>(current_ | (chunk << (space - take)));
+                    used_ += take;
+                    bits -= take;
+                    if (used_ == 8)
+                    {
+                        out_.push_back(static_cast<char>(current_));
+                        current_ = 0;
+                        used_ = 0;
+                    }
+                }
+            }
+
+            void flush()
+            {
+                if (used_ > 0)
+                    out_.push_back(static_cast<char>(current_));
+                current_ = 0;
+                used_ = 0;
+            }
+
+        private:
+            std::string &out_;
+            uint8_t current_ = 0;
+            unsigned used_ = 0;
+        };
+
+        class BitReader
+        {
+        public:
+            BitReader(const uint8_t *data, size_t size) : data_(data), size_(size) {}
+
+            uint64_t read(unsigned bits)
+            {
+                uint64_t value = 0;
+                while (bits > 0)
+                {
+                    if (pos_ >= size_)
+                        throw std::runtime_error("Codec: truncated bit stream");
+                    unsigned avail = 8 - bit_;
+                    unsigned take = bits < avail ? bits : avail;
+                    uint8_t chunk = static_cast<uint8_t>((data_[pos_] >> (avail - take)) & ((1u << take) - 1));
+                    value = (value << take) | chunk;
+                    bit_ += take;
+                    bits -= take;
+                    if (bit_ == 8)
+                    {
+                        bit_ = 0;
+                        ++pos_;
+                    }
+                }
+                return value;
+            }
+
+        private:
+            const uint8_t *data_;
+            size_t size_;
+            size_t pos_ = 0;
+            unsigned bit_ = 0;
+        };
+    }
+
+    void appendVarint(std::string &out, uint64_t value)
+    {
+        while (value >= 0x80)
+        {
+            out.push_back(static_cast<char>((value & 0x7F) | 0x80));
+            value >>= 7;
+        }
+        out.push_back(static_cast<char>(value));
+    }
+
+    uint64_t readVarint(const uint8_t *&cursor, const uint8_t *end)
+    {
+        uint64_t value = 0;
+        unsigned shift = 0;
+        while (cursor < end && shift < 64)
+        {
+            uint8_t byte = *cursor++;
+            value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+            if ((byte & 0x80) == 0)
+                return value;
+            shift += 7;
+        }
+        throw std::runtime_error("Codec: truncated varint");
+    }
+
+    std::string encodeTimestamps(const std::vector<int64_t> &values)
+    {
+        std::string out;
+        out.reserve(values.size() + 16);
+
+        int64_t prev = 0;
+        int64_t prevDelta = 0;
+        for (size_t i = 0; i < values.size(); ++i)
+        {
+            if (i == 0)
+            {
+                appendVarint(out, zigzagEncode(values[0]));
+            }
+            else
+            {
+                int64_t delta = values[i] - prev;
+                appendVarint(out, zigzagEncode(delta - prevDelta));
+                prevDelta = delta;
+            }
+            prev = values[i];
+        }
+        return out;
+    }
+
+    std::vector<int64_t> decodeTimestamps(const uint8_t *data, size_t size, size_t count)
+    {
+        std::vector<int64_t> values;
+        values.reserve(count);
+
+        const uint8_t *cursor = data;
+        const uint8_t *end = data + size;
+        int64_t prev = 0;
+        int64_t delta = 0;
+        for (size_t i = 0; i < count; ++i)
+        {
+            int64_t v = zigzagDecode(readVarint(cursor, end));
+            if (i == 0)
+            {
+                prev = v;
+            }
+            else
+            {
+                delta += v;
+                prev += delta;
+            }
+            values.push_back(prev);
+        }
+        return values;
+    }
+
+    std::string encodeDoubles(const std::vector<double> &values)
+    {
+        std::string out;
+        out.reserve(values.size() * 4 + 8);
+        BitWriter writer(out);
+
+        uint64_t prev = 0;
+        unsigned prevLeading = 65; // 65 = no window established yet
+        unsigned prevTrailing = 0;
+
+        for (size_t i = 0; i < values.size(); ++i)
+        {
+            uint64_t bits = std::bit_cast<uint64_t>(values[i]);
+            if (i == 0)
+            {
+                writer.write(bits, 64);
+                prev = bits;
+                continue;
+            }
+
+            uint64_t x = bits ^ prev;
+            prev = bits;
+            if (x == 0)
+            {
+                writer.write(0, 1);
+                continue;
+            }
+            writer.write(1, 1);
+
+            unsigned leading = static_cast<unsigned>(std::countl_zero(x));
+            unsigned trailing = static_cast<unsigned>(std::countr_zero(x));
+            if (leading > 31)
+                leading = 31;
+
+            if (prevLeading != 65 && leading >= prevLeading && trailing >= prevTrailing)
+            {
+                // Meaningful bits fit inside the previous window.
+                writer.write(0, 1);
+                writer.write(x >> prevTrailing, 64 - prevLeading - prevTrailing);
+            }
+            else
+            {
+                unsigned significant = 64 - leading - trailing;
+                writer.write(1, 1);
+                writer.write(leading, 5);
+                writer.write(significant - 1, 6);
+                writer.write(x >> trailing, significant);
+                prevLeading = leading;
+                prevTrailing = trailing;
+            }
+        }
+        writer.flush();
+        return out;
+    }
+
+    std::vector<double> decodeDoubles(const uint8_t *data, size_t size, size_t count)
+    {
+        std::vector<double> values;
+        values.reserve(count);
+        if (count == 0)
+            return values;
+
+        BitReader reader(data, size);
+        uint64_t prev = reader.read(64);
+        values.push_back(std::bit_cast<double>(prev));
+
+        unsigned leading = 0;
+        unsigned trailing = 0;
+        for (size_t i = 1; i < count; ++i)
+        {
+            if (reader.read(1) == 1)
+            {
+                if (reader.read(1) == 1)
+                {
+                    leading = static_cast<unsigned>(reader.read(5));
+                    unsigned significant = static_cast<unsigned>(reader.read(6)) + 1;
+                    trailing = 64 - leading - significant;
+                }
+                uint64_t x = reader.read(64 - leading - trailing) << trailing;
+                prev ^= x;
+            }
+            values.push_back(std::bit_cast<double>(prev));
+        }
+        return values;
+    }
+
+    uint64_t checksum(const void *data, size_t size)
+    {
+        const auto *bytes = static_cast<const uint8_t *>(data);
+        uint64_t hash = 1469598103934665603ULL;
+        for (size_t i = 0; i < size; ++i)
+        {
+            hash ^= bytes[i];
+            hash *= 1099511628211ULL;
+        }
+        return hash;
+    }
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Lightweight column codecs used by the on-disk cache store.
+//  - timestamps: delta-of-delta, zigzag LEB128 varints (regular daily/5-min bars
+//    collapse to ~1 byte per row)
+//  - doubles: Gorilla-style XOR against the previous value, bit packed
+namespace Codec
+{
+    void appendVarint(std::string &out, uint64_t value);
+    uint64_t readVarint(const uint8_t *&cursor, const uint8_t *end);
+
+    inline uint64_t zigzagEncode(int64_t v) { return (static_cast<uint64_t>(v) << 1) ^ static_cast<uint64_t>(v >> 63); }
+    inline int64_t zigzagDecode(uint64_t v) { return static_cast<int64_t>(v >> 1) ^ -static_cast<int64_t>(v & 1); }
+
+    std::string encodeTimestamps(const std::vector<int64_t> &values);
+    std::vector<int64_t> decodeTimestamps(const uint8_t *data, size_t size, size_t count);
+
+    std::string encodeDoubles(const std::vector<double> &values);
+    std::vector<double> decodeDoubles(const uint8_t *data, size_t size, size_t count);
+
+    // FNV-1a 64-bit; used as a cheap integrity check, not a cryptographic hash.
+    uint64_t checksum(const void *data, size_t size);
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstdint>
+
+// Counter-based random numbers: the value for (seed, stream, counter) is a pure
+// function of its inputs, so parallel workers produce the same draws however
+// the work is split. Each stream is a SplitMix64 Weyl sequence under its own
+// key.
+namespace Random
+{
+    inline constexpr uint64_t kGolden = 0x9E3779B97F4A7C15ULL;
+
+    inline uint64_t mix64(uint64_t z)
+    {
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+    class CounterRng
+    {
+    public:
+        CounterRng(uint64_t seed, uint64_t stream) : key_(mix64(seed ^ mix64((stream + 1) * kGolden))) {}
+
+        uint64_t operator()(uint64_t counter) const { return mix64(key_ + (counter + 1) * kGolden); }
+
+        // Uniform in [0, 1) from the top 53 bits.
+        double uniform(uint64_t counter) const { return static_cast<double>((*this)(counter) >> 11) * 0x1.0p-53; }
+
+        // Uniform in [0, bound); bound must be below 2^53.
+        uint64_t below(uint64_t counter, uint64_t bound) const
+        {
+            return static_cast<uint64_t>(uniform(counter) * static_cast<double>(bound));
+        }
+
+    private:
+        uint64_t key_;
+    };
+}
@@ -0,0 +1,95 @@
+#include "utils/cpu_dispatch.hpp"
+
+#include <atomic>
+#include <cctype>
+#include <cstdlib>
+#include <stdexcept>
+#include <string>
+
+namespace CpuDispatch
+{
+    namespace
+    {
+        Isa probe()
+        {
+#if TRADEIQ_CPU_DISPATCH
+            // libgcc also checks XCR0, so these are false when the OS does
+            // not save the wider registers.
+            __builtin_cpu_init();
+            if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512dq") &&
+                __builtin_cpu_supports("avx512vl") && __builtin_cpu_supports("avx512bw"))
+                return Isa::AVX512;
+            if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+                return Isa::AVX2;
+#endif
+            return Isa::Baseline;
+        }
+
+        // An unknown or unsupported TRADEIQ_ISA falls back to the detected level.
+        Isa startup()
+        {
+            const Isa best = detected();
+            if (const char *env = std::getenv("TRADEIQ_ISA"))
+            {
+                try
+                {
+                    const Isa wanted = parse(env);
+                    return wanted < best ? wanted : best;
+                }
+                catch (const std::invalid_argument &)
+                {
+                }
+            }
+            return best;
+        }
+
+        std::atomic<Isa> &selected()
+        {
+            static std::atomic<Isa> isa{startup()};
+            return isa;
+        }
+    }
+
+    const char *name(Isa isa)
+    {
+        switch (isa)
+        {
+        case Isa::AVX2:
+            return "avx2";
+        case Isa::AVX512:
+            return "avx512";
+        default:
+            return "baseline";
+        }
+    }
+
+    Isa parse(std::string_view text)
+    {
+        std::string lower(text);
+        for (char &c : lower)
+            c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+        for (Isa isa : {Isa::Baseline, Isa::AVX2, Isa::AVX512})
+            if (lower == name(isa))
+                return isa;
+        throw std::invalid_argument("Unknown instruction set level: " + std::string(text));
+    }
+
+    Isa detected()
+    {
+        static const Isa isa = probe();
+        return isa;
+    }
+
+    bool supported(Isa isa) { return isa <= detected(); }
+
+    Isa active() { return selected().load(std::memory_order_relaxed); }
+
+    void force(Isa isa)
+    {
+        if (!supported(isa))
+            throw std::invalid_argument(std::string("Instruction set level not supported here: ") + name(isa));
+        selected().store(isa, std::memory_order_relaxed);
+    }
+
+    void reset() { selected().store(startup(), std::memory_order_relaxed); }
+}
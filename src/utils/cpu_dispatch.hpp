@@ -0,0 +1,53 @@
+#pragma once
+
+#include <string_view>
+
+// Instruction-set level used by the vectorized kernels in Kernels.
+//
+// The library itself is built for baseline x86-64 (SSE2). With the
+// TRADEIQ_CPU_DISPATCH CMake option the hot kernels are also compiled for
+// AVX2 and AVX-512, and the best level the CPU and OS support is chosen on
+// first use. TRADEIQ_ISA=baseline|avx2|avx512 in the environment caps the
+// startup choice; force() pins a level for benchmarks and equivalence tests.
+// Every level evaluates the same operations in the same order (floating-point
+// contraction is off), so results are bit-identical whichever one runs.
+namespace CpuDispatch
+{
+    enum class Isa
+    {
+        Baseline,
+        AVX2,
+        AVX512
+    };
+
+    const char *name(Isa isa);
+
+    // Accepts the names returned by name(), case-insensitively. Throws
+    // std::invalid_argument for anything else.
+    Isa parse(std::string_view name);
+
+    // Best level both this CPU and this build support.
+    Isa detected();
+    bool supported(Isa isa);
+
+    Isa active();
+
+    // Throws std::invalid_argument if the level is not supported.
+    void force(Isa isa);
+
+    // Restores the startup choice.
+    void reset();
+
+    class ScopedIsa
+    {
+    public:
+        explicit ScopedIsa(Isa isa) : previous_(active()) { force(isa); }
+        ~ScopedIsa() { force(previous_); }
+
+        ScopedIsa(const ScopedIsa &) = delete;
+        ScopedIsa &operator=(const ScopedIsa &) = delete;
+
+    private:
+        Isa previous_;
+    };
+}
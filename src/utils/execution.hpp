@@ -0,0 +1,132 @@
+#pragma once
+
+#include "summation.hpp"
+#include "task_scheduler.hpp"
+
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Execution policies for the Stats overloads that work on many series, in
+// the spirit of std::execution:
+//   seq        one thread, in index order
+//   par        per-item work spread over Tasks::TaskScheduler::global()
+//   par_unseq  as par, and the body promises no ordering between items, so
+//              the loop over each chunk is marked safe to vectorize
+//
+// Results never depend on the policy or the thread count: per-item outputs
+// go to their own slot, and reduce() combines partial sums along the same
+// pairwise tree Summation::reduce uses, so it returns the same bits.
+namespace Execution
+{
+    struct SequencedPolicy
+    {
+    };
+    struct ParallelPolicy
+    {
+    };
+    struct ParallelUnsequencedPolicy
+    {
+    };
+
+    inline constexpr SequencedPolicy seq{};
+    inline constexpr ParallelPolicy par{};
+    inline constexpr ParallelUnsequencedPolicy par_unseq{};
+
+    template <typename P>
+    concept Policy = std::same_as<std::remove_cvref_t<P>, SequencedPolicy> ||
+                     std::same_as<std::remove_cvref_t<P>, ParallelPolicy> ||
+                     std::same_as<std::remove_cvref_t<P>, ParallelUnsequencedPolicy>;
+
+    // Calls fn(i) for every i in [0, count), `grain` consecutive indices per task.
+    template <Policy P, typename Fn>
+    void forEach(P, size_t count, Fn &&fn, size_t grain = 1)
+    {
+        if constexpr (std::same_as<P, SequencedPolicy>)
+        {
+            for (size_t i = 0; i < count; ++i)
+                fn(i);
+        }
+        else if constexpr (std::same_as<P, ParallelUnsequencedPolicy>)
+        {
+            Tasks::TaskScheduler::global().parallelForChunks(count, grain, [&fn](size_t begin, size_t end) {
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC ivdep
+#endif
+                for (size_t i = begin; i < end; ++i)
+                    fn(i);
+            });
+        }
+        else
+        {
+            Tasks::TaskScheduler::global().parallelFor(count, fn, grain);
+        }
+    }
+
+    // out[i] = fn(i); the result type must be default-constructible.
+    template <Policy P, typename Fn>
+    auto map(P policy, size_t count, Fn &&fn)
+    {
+        std::vector<std::invoke_result_t<Fn &, size_t>> out(count);
+        forEach(policy, count, [&](size_t i) { out[i] = fn(i); });
+        return out;
+    }
+
+    namespace detail
+    {
+        // Subtrees of at most this many elements are not split further; each
+        // is summed by one task.
+        inline constexpr size_t kReduceLeaf = 1 << 15;
+
+        inline void collectLeaves(size_t begin, size_t end, std::vector<std::pair<size_t, size_t>> &leaves)
+        {
+            if (end - begin <= kReduceLeaf)
+            {
+                leaves.emplace_back(begin, end);
+                return;
+            }
+            const size_t mid = Summation::detail::splitPoint(begin, end);
+            collectLeaves(begin, mid, leaves);
+            collectLeaves(mid, end, leaves);
+        }
+
+        template <size_t K, typename T>
+        std::array<T, K> combineLeaves(size_t begin, size_t end, const std::vector<std::array<T, K>> &partial,
+                                       size_t &next)
+        {
+            if (end - begin <= kReduceLeaf)
+                return partial[next++];
+            const size_t mid = Summation::detail::splitPoint(begin, end);
+            std::array<T, K> lo = combineLeaves<K, T>(begin, mid, partial, next);
+            const std::array<T, K> hi = combineLeaves<K, T>(mid, end, partial, next);
+            for (size_t k = 0; k < K; ++k)
+                lo[k] += hi[k];
+            return lo;
+        }
+    }
+
+    // Summation::reduce with the top of its pairwise tree spread over the
+    // pool; bit-identical to it for every policy and thread count.
+    template <size_t K, typename T, Policy P, typename F>
+    std::array<T, K> reduce(P policy, size_t n, const F &f)
+    {
+        if constexpr (std::same_as<P, SequencedPolicy>)
+            return Summation::reduce<K, T>(n, f);
+        else
+        {
+            if (n <= detail::kReduceLeaf)
+                return Summation::reduce<K, T>(n, f);
+            std::vector<std::pair<size_t, size_t>> leaves;
+            detail::collectLeaves(0, n, leaves);
+            std::vector<std::array<T, K>> partial(leaves.size());
+            forEach(policy, leaves.size(), [&](size_t i) {
+                partial[i] = Summation::detail::reduceRange<K, T>(leaves[i].first, leaves[i].second, f);
+            });
+            size_t next = 0;
+            return detail::combineLeaves<K, T>(0, n, partial, next);
+        }
+    }
+}
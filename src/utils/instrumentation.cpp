@@ -0,0 +1,386 @@
+#include "instrumentation.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace Instrumentation
+{
+    namespace
+    {
+        constexpr size_t kMaxSpansPerThread = 1 << 20;
+        constexpr int kSubBuckets = 8; // per power of two
+        constexpr int kMinExponent = -64;
+        constexpr int kMaxExponent = 64;
+        constexpr size_t kBuckets = static_cast<size_t>(kMaxExponent - kMinExponent) * kSubBuckets + 1;
+
+        std::atomic<bool> gEnabled{false};
+
+        // Log-linear buckets; bucket 0 holds values <= 0.
+        struct Histogram
+        {
+            uint64_t count = 0;
+            double total = 0.0;
+            double min = std::numeric_limits<double>::infinity();
+            double max = -std::numeric_limits<double>::infinity();
+            std::vector<uint64_t> buckets;
+
+            static size_t bucketOf(double v)
+            {
+                if (!(v > 0.0))
+                    return 0;
+                int e;
+                double m = std::frexp(v, &e); // v = m * 2^e, m in [0.5, 1)
+                e = std::clamp(e, kMinExponent + 1, kMaxExponent);
+                int sub = std::min(kSubBuckets - 1, static_cast<int>((m - 0.5) * 2 * kSubBuckets));
+                return 1 + static_cast<size_t>(e - kMinExponent - 1) * kSubBuckets + static_cast<size_t>(sub);
+            }
+
+            static double valueOf(size_t bucket)
+            {
+                if (bucket == 0)
+                    return 0.0;
+                size_t i = bucket - 1;
+                int e = static_cast<int>(i / kSubBuckets) + kMinExponent + 1;
+                double sub = static_cast<double>(i % kSubBuckets);
+                return std::ldexp(0.5 + (sub + 0.5) / (2 * kSubBuckets), e);
+            }
+
+            void add(double v)
+            {
+                if (buckets.empty())
+                    buckets.resize(kBuckets, 0);
+                ++buckets[bucketOf(v)];
+                ++count;
+                total += v;
+                min = std::min(min, v);
+                max = std::max(max, v);
+            }
+
+            void merge(const Histogram &other)
+            {
+                if (other.count == 0)
+                    return;
+                if (buckets.empty())
+                    buckets.resize(kBuckets, 0);
+                for (size_t b = 0; b < kBuckets; ++b)
+                    buckets[b] += other.buckets[b];
+                count += other.count;
+                total += other.total;
+                min = std::min(min, other.min);
+                max = std::max(max, other.max);
+            }
+
+            double quantile(double q) const
+            {
+                if (count == 0)
+                    return 0.0;
+                uint64_t rank = static_cast<uint64_t>(std::ceil(q * static_cast<double>(count)));
+                rank = std::max<uint64_t>(rank, 1);
+                uint64_t seen = 0;
+                for (size_t b = 0; b < buckets.size(); ++b)
+                {
+                    seen += buckets[b];
+                    if (seen >= rank)
+                        return std::clamp(valueOf(b), min, max);
+                }
+                return max;
+            }
+        };
+
+        struct ThreadBuffer
+        {
+            std::mutex mutex; // uncontended except while exporting
+            uint32_t thread = 0;
+            std::vector<Span> spans;
+            uint64_t dropped = 0;
+            std::unordered_map<const char *, Histogram> timers;
+            std::unordered_map<const char *, Histogram> values;
+            std::unordered_map<const char *, int64_t> counters;
+        };
+
+        struct Registry
+        {
+            std::mutex mutex;
+            std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+        };
+
+        // Leaked on purpose: thread_local buffers may be torn down after statics.
+        Registry &registry()
+        {
+            static Registry *r = new Registry();
+            return *r;
+        }
+
+        ThreadBuffer &local()
+        {
+            thread_local std::shared_ptr<ThreadBuffer> buffer = []
+            {
+                auto b = std::make_shared<ThreadBuffer>();
+                Registry &r = registry();
+                std::lock_guard<std::mutex> lock(r.mutex);
+                b->thread = static_cast<uint32_t>(r.buffers.size());
+                r.buffers.push_back(b);
+                return b;
+            }();
+            return *buffer;
+        }
+
+        std::vector<std::shared_ptr<ThreadBuffer>> allBuffers()
+        {
+            Registry &r = registry();
+            std::lock_guard<std::mutex> lock(r.mutex);
+            return r.buffers;
+        }
+
+        void appendJsonString(std::string &out, const char *text)
+        {
+            out += '"';
+            for (const char *p = text; *p; ++p)
+            {
+                if (*p == '"' || *p == '\\')
+                    out += '\\';
+                if (static_cast<unsigned char>(*p) < 0x20)
+                    continue;
+                out += *p;
+            }
+            out += '"';
+        }
+
+        // Trace-event timestamps are microseconds.
+        void appendMicros(std::string &out, uint64_t nanos)
+        {
+            char buf[32];
+            auto res = std::to_chars(buf, buf + sizeof(buf), static_cast<double>(nanos) / 1e3,
+                                     std::chars_format::fixed, 3);
+            out.append(buf, res.ptr);
+        }
+
+        void appendInt(std::string &out, int64_t value)
+        {
+            char buf[24];
+            auto res = std::to_chars(buf, buf + sizeof(buf), value);
+            out.append(buf, res.ptr);
+        }
+    }
+
+    void setEnabled(bool on)
+    {
+        nowNanos(); // pin the epoch before the first span
+        gEnabled.store(on, std::memory_order_relaxed);
+    }
+
+    bool enabled()
+    {
+        return gEnabled.load(std::memory_order_relaxed);
+    }
+
+    uint64_t nowNanos()
+    {
+        static const auto epoch = std::chrono::steady_clock::now();
+        return static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - epoch).count());
+    }
+
+    void recordSpan(const char *name, uint64_t startNanos, uint64_t durationNanos)
+    {
+        ThreadBuffer &b = local();
+        std::lock_guard<std::mutex> lock(b.mutex);
+        if (b.spans.size() < kMaxSpansPerThread)
+            b.spans.push_back({name, startNanos, durationNanos, b.thread});
+        else
+            ++b.dropped;
+        b.timers[name].add(static_cast<double>(durationNanos));
+    }
+
+    void addCounter(const char *name, int64_t delta)
+    {
+        ThreadBuffer &b = local();
+        std::lock_guard<std::mutex> lock(b.mutex);
+        b.counters[name] += delta;
+    }
+
+    void recordValue(const char *name, double value)
+    {
+        ThreadBuffer &b = local();
+        std::lock_guard<std::mutex> lock(b.mutex);
+        b.values[name].add(value);
+    }
+
+    std::vector<MetricSummary> summarize()
+    {
+        std::map<std::string, Histogram> timers, values;
+        std::map<std::string, int64_t> counters;
+        for (const auto &b : allBuffers())
+        {
+            std::lock_guard<std::mutex> lock(b->mutex);
+            for (const auto &[name, h] : b->timers)
+                timers[name].merge(h);
+            for (const auto &[name, h] : b->values)
+                values[name].merge(h);
+            for (const auto &[name, v] : b->counters)
+                counters[name] += v;
+        }
+
+        std::vector<MetricSummary> out;
+        auto emit = [&](const std::string &name, Kind kind, const Histogram &h, double scale)
+        {
+            MetricSummary s;
+            s.name = name;
+            s.kind = kind;
+            s.count = h.count;
+            s.total = h.total * scale;
+            s.min = h.min * scale;
+            s.max = h.max * scale;
+            s.p50 = h.quantile(0.50) * scale;
+            s.p99 = h.quantile(0.99) * scale;
+            out.push_back(s);
+        };
+
+        for (const auto &[name, h] : timers)
+            emit(name, Kind::Timer, h, 1e-6);
+        for (const auto &[name, h] : values)
+            emit(name, Kind::Histogram, h, 1.0);
+        for (const auto &[name, v] : counters)
+        {
+            MetricSummary s;
+            s.name = name;
+            s.kind = Kind::Counter;
+            s.count = 1;
+            s.total = s.min = s.max = s.p50 = s.p99 = static_cast<double>(v);
+            out.push_back(s);
+        }
+        return out;
+    }
+
+    std::vector<Span> spans()
+    {
+        std::vector<Span> out;
+        for (const auto &b : allBuffers())
+        {
+            std::lock_guard<std::mutex> lock(b->mutex);
+            out.insert(out.end(), b->spans.begin(), b->spans.end());
+        }
+        std::sort(out.begin(), out.end(), [](const Span &a, const Span &b)
+                  { return a.start < b.start; });
+        return out;
+    }
+
+    uint64_t droppedSpans()
+    {
+        uint64_t dropped = 0;
+        for (const auto &b : allBuffers())
+        {
+            std::lock_guard<std::mutex> lock(b->mutex);
+            dropped += b->dropped;
+        }
+        return dropped;
+    }
+
+    void writeChromeTrace(const std::string &path)
+    {
+        std::FILE *file = std::fopen(path.c_str(), "wb");
+        if (!file)
+            throw std::runtime_error("Cannot open trace file: " + path);
+
+        std::string out;
+        out.reserve(1 << 20);
+        out += "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+        bool first = true;
+        auto separator = [&]
+        {
+            if (!first)
+                out += ",\n";
+            first = false;
+        };
+
+        auto flushIfLarge = [&]
+        {
+            if (out.size() > (1 << 20))
+            {
+                std::fwrite(out.data(), 1, out.size(), file);
+                out.clear();
+            }
+        };
+
+        uint64_t end = 0;
+        for (const auto &s : spans())
+        {
+            separator();
+            out += "{\"ph\":\"X\",\"pid\":1,\"tid\":";
+            appendInt(out, s.thread);
+            out += ",\"name\":";
+            appendJsonString(out, s.name);
+            out += ",\"ts\":";
+            appendMicros(out, s.start);
+            out += ",\"dur\":";
+            appendMicros(out, s.duration);
+            out += '}';
+            end = std::max(end, s.start + s.duration);
+            flushIfLarge();
+        }
+
+        // Counters as one sample each at the end of the trace.
+        for (const auto &m : summarize())
+        {
+            if (m.kind != Kind::Counter)
+                continue;
+            separator();
+            out += "{\"ph\":\"C\",\"pid\":1,\"tid\":0,\"name\":";
+            appendJsonString(out, m.name.c_str());
+            out += ",\"ts\":";
+            appendMicros(out, end);
+            out += ",\"args\":{\"value\":";
+            appendInt(out, static_cast<int64_t>(m.total));
+            out += "}}";
+        }
+        out += "]}\n";
+
+        bool ok = std::fwrite(out.data(), 1, out.size(), file) == out.size();
+        ok = std::fclose(file) == 0 && ok;
+        if (!ok)
+            throw std::runtime_error("Failed to write trace file: " + path);
+    }
+
+    void writeSummary(std::FILE *out)
+    {
+        auto rows = summarize();
+        if (rows.empty())
+            return;
+
+        std::fprintf(out, "%-32s %-9s %10s %12s %10s %10s %10s\n", "metric", "kind", "count", "total", "p50", "p99", "max");
+        for (const auto &m : rows)
+        {
+            const char *kind = m.kind == Kind::Timer ? "timer(ms)" : m.kind == Kind::Counter ? "counter" : "histogram";
+            if (m.kind == Kind::Counter)
+                std::fprintf(out, "%-32s %-9s %10s %12.0f\n", m.name.c_str(), kind, "", m.total);
+            else
+                std::fprintf(out, "%-32s %-9s %10llu %12.3f %10.3f %10.3f %10.3f\n", m.name.c_str(), kind,
+                             static_cast<unsigned long long>(m.count), m.total, m.p50, m.p99, m.max);
+        }
+        if (uint64_t dropped = droppedSpans())
+            std::fprintf(out, "(%llu spans dropped from the trace; totals are complete)\n",
+                         static_cast<unsigned long long>(dropped));
+    }
+
+    void reset()
+    {
+        for (const auto &b : allBuffers())
+        {
+            std::lock_guard<std::mutex> lock(b->mutex);
+            b->spans.clear();
+            b->dropped = 0;
+            b->timers.clear();
+            b->values.clear();
+            b->counters.clear();
+        }
+    }
+}
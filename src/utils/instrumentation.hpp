@@ -0,0 +1,114 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// Scoped timers, counters and value histograms for hot paths.
+//
+// The TRADEIQ_* macros compile to nothing unless TRADEIQ_INSTRUMENTATION is
+// non-zero (CMake option of the same name). When compiled in, recording is
+// still off until setEnabled(true), so an idle probe costs one relaxed load.
+// Each thread records into its own buffer; buffers outlive their threads so a
+// summary or trace can be exported after workers have joined.
+//
+// Names must be string literals (or otherwise outlive the process).
+namespace Instrumentation
+{
+    void setEnabled(bool enabled);
+    bool enabled();
+
+    // Monotonic nanoseconds since the first call in this process.
+    uint64_t nowNanos();
+
+    void recordSpan(const char *name, uint64_t startNanos, uint64_t durationNanos);
+    void addCounter(const char *name, int64_t delta);
+    void recordValue(const char *name, double value);
+
+    struct Span
+    {
+        const char *name;
+        uint64_t start;
+        uint64_t duration;
+        uint32_t thread;
+    };
+
+    enum class Kind : uint8_t
+    {
+        Timer,
+        Counter,
+        Histogram
+    };
+
+    // Timer values are in milliseconds. p50/p99 are approximate (about 10%
+    // relative error) because they come from log-linear buckets.
+    struct MetricSummary
+    {
+        std::string name;
+        Kind kind = Kind::Timer;
+        uint64_t count = 0;
+        double total = 0.0;
+        double min = 0.0;
+        double max = 0.0;
+        double p50 = 0.0;
+        double p99 = 0.0;
+    };
+
+    std::vector<MetricSummary> summarize();
+    std::vector<Span> spans();
+    uint64_t droppedSpans();
+
+    // Chrome trace-event JSON (chrome://tracing, Perfetto).
+    void writeChromeTrace(const std::string &path);
+    void writeSummary(std::FILE *out);
+
+    void reset();
+
+    class ScopedTimer
+    {
+    public:
+        explicit ScopedTimer(const char *name)
+            : name_(enabled() ? name : nullptr), start_(name_ ? nowNanos() : 0) {}
+
+        ~ScopedTimer()
+        {
+            if (name_)
+                recordSpan(name_, start_, nowNanos() - start_);
+        }
+
+        ScopedTimer(const ScopedTimer &) = delete;
+        ScopedTimer &operator=(const ScopedTimer &) = delete;
+
+    private:
+        const char *name_;
+        uint64_t start_;
+    };
+}
+
+#ifndef TRADEIQ_INSTRUMENTATION
+#define TRADEIQ_INSTRUMENTATION 0
+#endif
+
+#define TRADEIQ_CONCAT_INNER(a, b) a##b
+#define TRADEIQ_CONCAT(a, b) TRADEIQ_CONCAT_INNER(a, b)
+
+#if TRADEIQ_INSTRUMENTATION
+#define TRADEIQ_TIMED_SCOPE(name) ::Instrumentation::ScopedTimer TRADEIQ_CONCAT(tradeiqTimer_, __LINE__)(name)
+#define TRADEIQ_COUNTER(name, delta)                      \
+    do                                                    \
+    {                                                     \
+        if (::Instrumentation::enabled())                 \
+            ::Instrumentation::addCounter(name, (delta)); \
+    } while (0)
+#define TRADEIQ_HISTOGRAM(name, value)                     \
+    do                                                     \
+    {                                                      \
+        if (::Instrumentation::enabled())                  \
+            ::Instrumentation::recordValue(name, (value)); \
+    } while (0)
+#else
+#define TRADEIQ_TIMED_SCOPE(name) ((void)0)
+#define TRADEIQ_COUNTER(name, delta) ((void)0)
+#define TRADEIQ_HISTOGRAM(name, value) ((void)0)
+#endif
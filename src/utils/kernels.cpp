@@ -0,0 +1,91 @@
+#include "kernels_impl.hpp"
+#include "cpu_dispatch.hpp"
+
+#include <type_traits>
+
+namespace Kernels
+{
+    namespace detail
+    {
+        constinit const Table<float> kBaselineFloat = makeTable<float>();
+        constinit const Table<double> kBaselineDouble = makeTable<double>();
+    }
+
+    namespace
+    {
+        template <typename T>
+        const detail::Table<T> &table()
+        {
+            constexpr bool isFloat = std::is_same_v<T, float>;
+            switch (CpuDispatch::active())
+            {
+#if TRADEIQ_CPU_DISPATCH
+            case CpuDispatch::Isa::AVX512:
+                if constexpr (isFloat)
+                    return detail::kAvx512Float;
+                else
+                    return detail::kAvx512Double;
+            case CpuDispatch::Isa::AVX2:
+                if constexpr (isFloat)
+                    return detail::kAvx2Float;
+                else
+                    return detail::kAvx2Double;
+#endif
+            default:
+                if constexpr (isFloat)
+                    return detail::kBaselineFloat;
+                else
+                    return detail::kBaselineDouble;
+            }
+        }
+    }
+
+    template <typename T>
+    std::array<T, 2> sumAndMismatches(const T *x, size_t n)
+    {
+        return table<T>().sumAndMismatches(x, n);
+    }
+
+    template <typename T>
+    std::array<T, 4> centralSums(const T *x, size_t n, T mean, int order)
+    {
+        return table<T>().centralSums(x, n, mean, order);
+    }
+
+    template <typename T>
+    T dot(const T *x, const T *y, size_t n)
+    {
+        return table<T>().dot(x, y, n);
+    }
+
+    template <typename T>
+    std::array<T, 3> centredCrossSums(const T *x, const T *y, size_t n)
+    {
+        return table<T>().centredCrossSums(x, y, n);
+    }
+
+    template <typename T>
+    T quadraticForm(const std::vector<T> *rows, const T *w, size_t n)
+    {
+        return table<T>().quadraticForm(rows, w, n);
+    }
+
+    template <typename T>
+    void rollingMoments(const T *x, size_t n, size_t w, T *mean, T *m2)
+    {
+        table<T>().rollingMoments(x, n, w, mean, m2);
+    }
+
+#define TRADEIQ_KERNELS_INSTANTIATE(T)                                                  \
+    template std::array<T, 2> sumAndMismatches<T>(const T *, size_t);                   \
+    template std::array<T, 4> centralSums<T>(const T *, size_t, T, int);                \
+    template T dot<T>(const T *, const T *, size_t);                                    \
+    template std::array<T, 3> centredCrossSums<T>(const T *, const T *, size_t);        \
+    template T quadraticForm<T>(const std::vector<T> *, const T *, size_t);             \
+    template void rollingMoments<T>(const T *, size_t, size_t, T *, T *);
+
+    TRADEIQ_KERNELS_INSTANTIATE(float)
+    TRADEIQ_KERNELS_INSTANTIATE(double)
+
+#undef TRADEIQ_KERNELS_INSTANTIATE
+}
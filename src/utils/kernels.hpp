@@ -0,0 +1,44 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+// Hot numeric kernels behind runtime CPU dispatch (see cpu_dispatch.hpp).
+//
+// Each call goes through a table of function pointers for the active
+// instruction-set level; the bodies (kernels_impl.hpp) are compiled once per
+// level. Sums are Summation::reduce pairwise reductions, so every level
+// produces the same bits.
+namespace Kernels
+{
+    // {sum of x, number of elements != x[0]}.
+    template <typename T>
+    std::array<T, 2> sumAndMismatches(const T *x, size_t n);
+
+    // {sum d, sum d^2, sum d^3, sum d^4} for d = x - mean, up to `order` (2..4);
+    // higher entries are zero.
+    template <typename T>
+    std::array<T, 4> centralSums(const T *x, size_t n, T mean, int order);
+
+    template <typename T>
+    T dot(const T *x, const T *y, size_t n);
+
+    // Two-pass centred cross sums {sum dx dy, sum dx^2, sum dy^2}.
+    template <typename T>
+    std::array<T, 3> centredCrossSums(const T *x, const T *y, size_t n);
+
+    // w' C w for the n x n matrix given as rows.
+    template <typename T>
+    T quadraticForm(const std::vector<T> *rows, const T *w, size_t n);
+
+    // For every full window of `w` values: its mean and sum of squared
+    // deviations, written to mean[i] (if non-null) and m2[i] for
+    // i < n - w + 1. Sums are kept on data shifted by the mean at the last
+    // rebuild, so they stay on the scale of the variance instead of mean^2;
+    // each step is an O(1) add/remove, the sums are rebuilt every `w` steps
+    // so rounding cannot accumulate, and a run of w equal values reports
+    // exactly zero.
+    template <typename T>
+    void rollingMoments(const T *x, size_t n, size_t w, T *mean, T *m2);
+}
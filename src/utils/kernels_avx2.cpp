@@ -0,0 +1,12 @@
+// Compiled with -mavx2 -mfma when TRADEIQ_CPU_DISPATCH is on.
+#if TRADEIQ_CPU_DISPATCH
+
+#include "kernels_impl.hpp"
+
+namespace Kernels::detail
+{
+    constinit const Table<float> kAvx2Float = makeTable<float>();
+    constinit const Table<double> kAvx2Double = makeTable<double>();
+}
+
+#endif
@@ -0,0 +1,12 @@
+// Compiled with -mavx512{f,dq,vl,bw} when TRADEIQ_CPU_DISPATCH is on.
+#if TRADEIQ_CPU_DISPATCH
+
+#include "kernels_impl.hpp"
+
+namespace Kernels::detail
+{
+    constinit const Table<float> kAvx512Float = makeTable<float>();
+    constinit const Table<double> kAvx512Double = makeTable<double>();
+}
+
+#endif
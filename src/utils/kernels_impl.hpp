@@ -0,0 +1,177 @@
+#pragma once
+
+// Kernel bodies and dispatch tables. Included only by kernels*.cpp, each of
+// which is compiled for one instruction-set level.
+//
+// The bodies sit in an unnamed namespace, so every level's translation unit
+// gets private copies, and the Summation templates they instantiate take
+// local lambdas and are private too. Keep it that way: a shared inline
+// function with floating-point code and external linkage (std::abs,
+// KahanSum::add) would be emitted once per level, and an unoptimized build's
+// linker could hand baseline callers the AVX copy.
+
+#include "kernels.hpp"
+#include "summation.hpp"
+
+#include <algorithm>
+
+namespace Kernels::detail
+{
+    template <typename T>
+    struct Table
+    {
+        std::array<T, 2> (*sumAndMismatches)(const T *, size_t);
+        std::array<T, 4> (*centralSums)(const T *, size_t, T, int);
+        T (*dot)(const T *, const T *, size_t);
+        std::array<T, 3> (*centredCrossSums)(const T *, const T *, size_t);
+        T (*quadraticForm)(const std::vector<T> *, const T *, size_t);
+        void (*rollingMoments)(const T *, size_t, size_t, T *, T *);
+    };
+
+    extern const Table<float> kBaselineFloat;
+    extern const Table<double> kBaselineDouble;
+#if TRADEIQ_CPU_DISPATCH
+    extern const Table<float> kAvx2Float;
+    extern const Table<double> kAvx2Double;
+    extern const Table<float> kAvx512Float;
+    extern const Table<double> kAvx512Double;
+#endif
+
+    namespace
+    {
+        template <typename T>
+        std::array<T, 2> sumAndMismatches(const T *x, size_t n)
+        {
+            if (n == 0)
+                return {T(0), T(0)};
+            const T first = x[0];
+            return Summation::reduce<2, T>(n, [x, first](size_t i) {
+                return std::array<T, 2>{x[i], x[i] != first ? T(1) : T(0)};
+            });
+        }
+
+        template <int Order, typename T>
+        std::array<T, 4> centralSumsOf(const T *x, size_t n, T mean)
+        {
+            const auto s = Summation::reduce<Order, T>(n, [x, mean](size_t i) {
+                T d = x[i] - mean;
+                T d2 = d * d;
+                std::array<T, Order> v;
+                v[0] = d;
+                v[1] = d2;
+                if constexpr (Order >= 3)
+                    v[2] = d2 * d;
+                if constexpr (Order >= 4)
+                    v[3] = d2 * d2;
+                return v;
+            });
+            std::array<T, 4> out{};
+            for (int k = 0; k < Order; ++k)
+                out[k] = s[k];
+            return out;
+        }
+
+        template <typename T>
+        std::array<T, 4> centralSums(const T *x, size_t n, T mean, int order)
+        {
+            if (order <= 2)
+                return centralSumsOf<2>(x, n, mean);
+            if (order == 3)
+                return centralSumsOf<3>(x, n, mean);
+            return centralSumsOf<4>(x, n, mean);
+        }
+
+        template <typename T>
+        T dot(const T *x, const T *y, size_t n)
+        {
+            return Summation::reduce<1, T>(n, [x, y](size_t i) { return std::array<T, 1>{x[i] * y[i]}; })[0];
+        }
+
+        template <typename T>
+        std::array<T, 3> centredCrossSums(const T *x, const T *y, size_t n)
+        {
+            const auto sums = Summation::reduce<2, T>(n, [x, y](size_t i) { return std::array<T, 2>{x[i], y[i]}; });
+            const T meanX = sums[0] / static_cast<T>(n);
+            const T meanY = sums[1] / static_cast<T>(n);
+            return Summation::reduce<3, T>(n, [x, y, meanX, meanY](size_t i) {
+                T dx = x[i] - meanX;
+                T dy = y[i] - meanY;
+                return std::array<T, 3>{dx * dy, dx * dx, dy * dy};
+            });
+        }
+
+        template <typename T>
+        T quadraticForm(const std::vector<T> *rows, const T *w, size_t n)
+        {
+            return Summation::reduce<1, T>(n, [rows, w, n](size_t i) {
+                return std::array<T, 1>{w[i] * dot(rows[i].data(), w, n)};
+            })[0];
+        }
+
+        template <typename T>
+        void rollingMoments(const T *x, size_t n, size_t w, T *mean, T *m2)
+        {
+            if (w == 0 || n < w)
+                return;
+
+            const T width = static_cast<T>(w);
+            size_t run = 1;
+            for (size_t j = 1; j < w; ++j)
+                run = x[j] == x[j - 1] ? run + 1 : 1;
+
+            const size_t windows = n - w + 1;
+            for (size_t start = 0; start < windows;)
+            {
+                T shift = 0;
+                for (size_t j = 0; j < w; ++j)
+                    shift += x[start + j];
+                shift /= width;
+
+                T s1 = 0, s2 = 0;
+                for (size_t j = 0; j < w; ++j)
+                {
+                    T d = x[start + j] - shift;
+                    s1 += d;
+                    s2 += d * d;
+                }
+
+                const size_t stop = std::min(start + w, windows);
+                for (size_t i = start; i < stop; ++i)
+                {
+                    // The run tracks the newest value on every step, including
+                    // the first window of each rebuilt block.
+                    if (i > 0)
+                        run = x[i + w - 1] == x[i + w - 2] ? run + 1 : 1;
+                    if (i > start)
+                    {
+                        T added = x[i + w - 1] - shift;
+                        T removed = x[i - 1] - shift;
+                        s1 += added - removed;
+                        s2 += (added - removed) * (added + removed);
+                    }
+                    if (run >= w)
+                    {
+                        if (mean)
+                            mean[i] = x[i];
+                        m2[i] = T(0);
+                    }
+                    else
+                    {
+                        T m = s2 - s1 * s1 / width;
+                        if (mean)
+                            mean[i] = shift + s1 / width;
+                        m2[i] = m > 0 ? m : T(0);
+                    }
+                }
+                start = stop;
+            }
+        }
+
+        template <typename T>
+        constexpr Table<T> makeTable()
+        {
+            return {&sumAndMismatches<T>, &centralSums<T>, &dot<T>, &centredCrossSums<T>, &quadraticForm<T>,
+                    &rollingMoments<T>};
+        }
+    }
+}
@@ -1,123 +1,137 @@
 
 #include "math_utils.hpp"
+#include "../stats/moments.hpp"
+#include "summation.hpp"
 #include <algorithm>
 #include <cmath>
-#include <numeric>
-#include <unordered_set>
 
 namespace MathUtils
 {
 
-    double mean(const std::vector<double> &data)
+    template <typename T>
+    T mean(const std::vector<T> &data)
     {
         if (data.empty())
             throw std::invalid_argument("Data is empty.");
-        return std::accumulate(data.begin(), data.end(), 0.0) / data.size();
+        return Summation::sum<T>(data.begin(), data.end()) / static_cast<T>(data.size());
     }
 
-    double median(std::vector<double> data)
+    template <typename T>
+    T median(std::vector<T> data)
     {
         if (data.empty())
             throw std::invalid_argument("Data is empty.");
         std::sort(data.begin(), data.end());
         size_t n = data.size();
-        return (n % 2 == 0) ? (data[n / 2 - 1] + data[n / 2]) / 2.0 : data[n / 2];
+        return (n % 2 == 0) ? (data[n / 2 - 1] + data[n / 2]) / T(2) : data[n / 2];
     }
 
-    double variance(const std::vector<double> &data, bool sample)
+    template <typename T>
+    T variance(const std::vector<T> &data, bool sample)
     {
         if (data.size() < (sample ? 2 : 1))
             throw std::invalid_argument("Not enough data.");
-        double m = mean(data);
-        double sum = 0.0;
-        for (double d : data)
-        {
-            double diff = d - m;
-            sum += diff * diff;
-        }
-        return sum / (sample ? data.size() - 1 : data.size());
+        auto m = Stats::Moments::summarize<2>(data);
+        return Stats::Moments::variance(m, sample ? Stats::Moments::Estimator::Sample
+                                                  : Stats::Moments::Estimator::Population);
     }
 
-    double standardDeviation(const std::vector<double> &data, bool sample)
+    template <typename T>
+    T standardDeviation(const std::vector<T> &data, bool sample)
     {
         return std::sqrt(variance(data, sample));
     }
 
-    double min(const std::vector<double> &data)
+    template <typename T>
+    T min(const std::vector<T> &data)
     {
         if (data.empty())
             throw std::invalid_argument("Data is empty.");
         return *std::min_element(data.begin(), data.end());
     }
 
-    double max(const std::vector<double> &data)
+    template <typename T>
+    T max(const std::vector<T> &data)
     {
         if (data.empty())
             throw std::invalid_argument("Data is empty.");
         return *std::max_element(data.begin(), data.end());
     }
 
-    double skewness(const std::vector<double> &data)
+    template <typename T>
+    T skewness(const std::vector<T> &data)
     {
         if (data.size() < 3)
             throw std::invalid_argument("Need at least 3 data points.");
-
-        double m = mean(data);
-        double sd = standardDeviation(data, true);
-        double skew = 0.0;
-        for (double d : data)
-        {
-            skew += std::pow((d - m) / sd, 3);
-        }
-        return skew * (static_cast<double>(data.size()) / ((data.size() - 1) * (data.size() - 2)));
+        auto m = Stats::Moments::summarize<3>(data);
+        return Stats::Moments::skewness(m, Stats::Moments::Estimator::Unbiased);
     }
 
-    double kurtosis(const std::vector<double> &data)
+    template <typename T>
+    T kurtosis(const std::vector<T> &data)
     {
         if (data.size() < 4)
             throw std::invalid_argument("Need at least 4 data points.");
-        double m = mean(data);
-        double sd = standardDeviation(data, true);
-        double k = 0.0;
-        for (double d : data)
-        {
-            k += std::pow((d - m) / sd, 4);
-        }
-        double n = static_cast<double>(data.size());
-        return (n * (n + 1) * k - 3 * std::pow(n - 1, 2)) / ((n - 1) * (n - 2) * (n - 3));
+        auto m = Stats::Moments::summarize<4>(data);
+
+        // Historical normalization, kept for compatibility. For the standard
+        // bias-corrected G2 use Moments::excessKurtosis(m, Estimator::Unbiased).
+        T n = static_cast<T>(data.size());
+        T var = m.m2 / (n - 1);
+        T k = m.m4 / (var * var);
+        return (n * (n + 1) * k - 3 * (n - 1) * (n - 1)) / ((n - 1) * (n - 2) * (n - 3));
     }
 
-    double percentile(std::vector<double> data, double p)
+    template <typename T>
+    T percentile(std::vector<T> data, std::type_identity_t<T> p)
     {
         if (data.empty())
             throw std::invalid_argument("Data is empty.");
         if (p < 0.0 || p > 100.0)
             throw std::invalid_argument("Percentile must be between 0 and 100.");
         std::sort(data.begin(), data.end());
-        double rank = (p / 100.0) * (data.size() - 1);
+        T rank = (p / T(100)) * static_cast<T>(data.size() - 1);
         size_t lower = static_cast<size_t>(rank);
         size_t upper = lower + 1;
-        double weight = rank - lower;
+        T weight = rank - static_cast<T>(lower);
         return upper < data.size()
-                   ? data[lower] * (1.0 - weight) + data[upper] * weight
+                   ? data[lower] * (T(1) - weight) + data[upper] * weight
                    : data[lower];
     }
 
-    std::vector<double> zScoreNormalize(const std::vector<double> &data)
+    template <typename T>
+    std::vector<T> zScoreNormalize(const std::vector<T> &data)
     {
         if (data.empty())
             throw std::invalid_argument("Data is empty.");
-        double m = mean(data);
-        double sd = standardDeviation(data);
-        if (sd == 0.0)
+        T m = mean(data);
+        T sd = standardDeviation(data);
+        if (sd == 0)
             throw std::domain_error("Standard deviation is zero.");
-        std::vector<double> result;
+        std::vector<T> result;
         result.reserve(data.size());
-        for (double d : data)
+        for (T d : data)
         {
             result.push_back((d - m) / sd);
         }
         return result;
     }
 
-}
\ No newline at end of file
+#define TRADEIQ_MATH_UTILS_INSTANTIATE(T)                                   \
+    template T mean<T>(const std::vector<T> &);                             \
+    template T median<T>(std::vector<T>);                                   \
+    template T variance<T>(const std::vector<T> &, bool);                   \
+    template T standardDeviation<T>(const std::vector<T> &, bool);          \
+    template T min<T>(const std::vector<T> &);                              \
+    template T max<T>(const std::vector<T> &);                              \
+    template T skewness<T>(const std::vector<T> &);                         \
+    template T kurtosis<T>(const std::vector<T> &);                         \
+    template T percentile<T>(std::vector<T>, std::type_identity_t<T>);      \
+    template std::vector<T> zScoreNormalize<T>(const std::vector<T> &);
+
+    TRADEIQ_MATH_UTILS_INSTANTIATE(float)
+    TRADEIQ_MATH_UTILS_INSTANTIATE(double)
+
+#undef TRADEIQ_MATH_UTILS_INSTANTIATE
+
+}
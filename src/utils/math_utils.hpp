@@ -2,16 +2,19 @@
 
 #include <vector>
 #include <stdexcept>
+#include <type_traits>
 
+// Templated on the value type; float and double are instantiated in math_utils.cpp.
+// Reductions go through the pairwise/compensated primitives in summation.hpp.
 namespace MathUtils {
-    double mean(const std::vector<double>& data);
-    double median(std::vector<double> data);
-    double variance(const std::vector<double>& data, bool sample = false);
-    double standardDeviation(const std::vector<double>& data, bool sample = false);
-    double min(const std::vector<double>& data);
-    double max(const std::vector<double>& data);
-    double skewness(const std::vector<double>& data);
-    double kurtosis(const std::vector<double>& data);
-    double percentile(std::vector<double> data, double percentile); // percentile in [0, 100]
-    std::vector<double> zScoreNormalize(const std::vector<double>& data);
-}
\ No newline at end of file
+    template <typename T = double> T mean(const std::vector<T>& data);
+    template <typename T = double> T median(std::vector<T> data);
+    template <typename T = double> T variance(const std::vector<T>& data, bool sample = false);
+    template <typename T = double> T standardDeviation(const std::vector<T>& data, bool sample = false);
+    template <typename T = double> T min(const std::vector<T>& data);
+    template <typename T = double> T max(const std::vector<T>& data);
+    template <typename T = double> T skewness(const std::vector<T>& data);
+    template <typename T = double> T kurtosis(const std::vector<T>& data);
+    template <typename T = double> T percentile(std::vector<T> data, std::type_identity_t<T> percentile); // percentile in [0, 100]
+    template <typename T = double> std::vector<T> zScoreNormalize(const std::vector<T>& data);
+}
@@ -0,0 +1,183 @@
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <span>
+#include <type_traits>
+
+// Summation primitives shared by MathUtils and the Stats kernels.
+//
+// reduce() is the bulk path: the range is split pairwise down to blocks of
+// kBlock elements, and each block is summed in kLanes independent lanes that
+// the compiler turns into SIMD adds. Error grows with log(n) rather than n, at
+// the speed of a plain vectorized loop. sum(), sumSquaredDeviations() and
+// variance() are built on it.
+//
+// Accumulator<T> is the streaming path for sums that cannot be expressed as a
+// reduction over an index (running drawdown state, nested loops). It is
+// Neumaier-compensated.
+namespace Summation
+{
+    inline constexpr size_t kLanes = 8;
+    inline constexpr size_t kBlock = 256;
+
+    template <typename T>
+    class PlainSum
+    {
+    public:
+        void add(T x) { sum_ += x; }
+        T value() const { return sum_; }
+
+    private:
+        T sum_ = 0;
+    };
+
+    // Neumaier (improved Kahan) summation. After each step the correction is
+    // renormalized into the running sum, so it stays within one ulp of it:
+    // plain Neumaier lets the correction itself drift over millions of
+    // same-sign float terms.
+    template <typename T>
+    class KahanSum
+    {
+    public:
+        void add(T x)
+        {
+            T t = sum_ + x;
+            comp_ += std::abs(sum_) >= std::abs(x) ? (sum_ - t) + x : (x - t) + sum_;
+            sum_ = t;
+            t = sum_ + comp_;
+            comp_ -= t - sum_;
+            sum_ = t;
+        }
+        T value() const { return sum_ + comp_; }
+
+    private:
+        T sum_ = 0;
+        T comp_ = 0;
+    };
+
+    template <typename T>
+    using Accumulator = KahanSum<T>;
+
+// Left to the loop vectorizer, GCC vectorizes reduceBlock across groups of
+// kLanes indices and transposes the lanes through shuffles. The SLP
+// vectorizer instead maps each lane onto a vector slot, so the adds stay plain
+// vector adds that scale with the vector width (the sums are the same).
+#if defined(__GNUC__) && !defined(__clang__)
+#define TRADEIQ_LANE_VECTORIZE __attribute__((optimize("no-tree-loop-vectorize")))
+#else
+#define TRADEIQ_LANE_VECTORIZE
+#endif
+
+    namespace detail
+    {
+        template <size_t K, typename T, typename F>
+        TRADEIQ_LANE_VECTORIZE std::array<T, K> reduceBlock(size_t begin, size_t end, const F &f)
+        {
+            T lanes[K][kLanes] = {};
+            size_t i = begin;
+            for (; i + kLanes <= end; i += kLanes)
+            {
+                for (size_t l = 0; l < kLanes; ++l)
+                {
+                    const std::array<T, K> v = f(i + l);
+                    for (size_t k = 0; k < K; ++k)
+                        lanes[k][l] += v[k];
+                }
+            }
+
+            std::array<T, K> out;
+            for (size_t k = 0; k < K; ++k)
+            {
+                const T *a = lanes[k];
+                out[k] = ((a[0] + a[1]) + (a[2] + a[3])) + ((a[4] + a[5]) + (a[6] + a[7]));
+            }
+            for (; i < end; ++i)
+            {
+                const std::array<T, K> v = f(i);
+                for (size_t k = 0; k < K; ++k)
+                    out[k] += v[k];
+            }
+            return out;
+        }
+
+        // Where reduceRange splits a range longer than kBlock.
+        inline size_t splitPoint(size_t begin, size_t end)
+        {
+            return begin + ((end - begin) / 2 + kLanes - 1) / kLanes * kLanes;
+        }
+
+        template <size_t K, typename T, typename F>
+        std::array<T, K> reduceRange(size_t begin, size_t end, const F &f)
+        {
+            if (end - begin <= kBlock)
+                return reduceBlock<K, T>(begin, end, f);
+            const size_t half = splitPoint(begin, end) - begin;
+            std::array<T, K> lo = reduceRange<K, T>(begin, begin + half, f);
+            const std::array<T, K> hi = reduceRange<K, T>(begin + half, end, f);
+            for (size_t k = 0; k < K; ++k)
+                lo[k] += hi[k];
+            return lo;
+        }
+    }
+
+    // Sums K terms per index: f(i) returns std::array<T, K>. Keep f branch-free
+    // (selects rather than early returns) so the block loop vectorizes.
+    template <size_t K, typename T, typename F>
+    std::array<T, K> reduce(size_t n, const F &f)
+    {
+        static_assert(K >= 1, "reduce needs at least one output");
+        return detail::reduceRange<K, T>(0, n, f);
+    }
+
+    template <typename T>
+    T sum(std::span<const T> data)
+    {
+        const T *p = data.data();
+        return reduce<1, T>(data.size(), [p](size_t i) { return std::array<T, 1>{p[i]}; })[0];
+    }
+
+    template <typename T, typename It>
+    T sum(It first, It last)
+    {
+        if constexpr (std::contiguous_iterator<It> && std::is_same_v<std::iter_value_t<It>, T>)
+        {
+            return sum(std::span<const T>(std::to_address(first), static_cast<size_t>(last - first)));
+        }
+        else
+        {
+            Accumulator<T> acc;
+            for (; first != last; ++first)
+                acc.add(static_cast<T>(*first));
+            return acc.value();
+        }
+    }
+
+    // Corrected two-pass sum of squared deviations (Chan, Golub & LeVeque):
+    // the second term removes the error left by rounding in `mean`. Clamped so
+    // it is never negative.
+    template <typename T>
+    T sumSquaredDeviations(std::span<const T> data, T mean)
+    {
+        if (data.empty())
+            return 0;
+        const T *p = data.data();
+        auto s = reduce<2, T>(data.size(), [p, mean](size_t i) {
+            T d = p[i] - mean;
+            return std::array<T, 2>{d, d * d};
+        });
+        T ss = s[1] - s[0] * s[0] / static_cast<T>(data.size());
+        return ss > 0 ? ss : T(0);
+    }
+
+    // Two-pass variance; divides by n - 1 when `sample`. Callers check size.
+    template <typename T>
+    T variance(std::span<const T> data, bool sample)
+    {
+        const T n = static_cast<T>(data.size());
+        return sumSquaredDeviations(data, sum(data) / n) / (sample ? n - 1 : n);
+    }
+}
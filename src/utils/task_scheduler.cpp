@@ -0,0 +1,224 @@
+#include "utils/task_scheduler.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <limits>
+#include <string>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace Tasks
+{
+    namespace
+    {
+        // Identifies the pool and queue of the current thread, so tasks it
+        // spawns go to its own deque.
+        thread_local const void *tlsPool = nullptr;
+        thread_local size_t tlsQueue = 0;
+
+        unsigned defaultThreads()
+        {
+            if (const char *env = std::getenv("TRADEIQ_THREADS"))
+            {
+                try
+                {
+                    const unsigned long n = std::stoul(env);
+                    if (n > 0)
+                        return static_cast<unsigned>(n);
+                }
+                catch (const std::exception &)
+                {
+                }
+            }
+            return std::max(1u, std::thread::hardware_concurrency());
+        }
+
+        void pinToCpu(size_t cpu)
+        {
+#ifdef __linux__
+            const unsigned cpus = std::max(1u, std::thread::hardware_concurrency());
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            CPU_SET(cpu % cpus, &set);
+            pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#else
+            (void)cpu;
+#endif
+        }
+
+        std::unique_ptr<TaskScheduler> &globalSlot()
+        {
+            static std::unique_ptr<TaskScheduler> pool;
+            return pool;
+        }
+
+        std::mutex globalMutex;
+    }
+
+    TaskScheduler::TaskScheduler(SchedulerOptions options)
+    {
+        const unsigned threads = options.threads ? options.threads : defaultThreads();
+        for (unsigned i = 0; i < threads; ++i)
+            queues_.push_back(std::make_unique<Queue>());
+        for (unsigned i = 0; i + 1 < threads; ++i)
+            workers_.emplace_back([this, i, pin = options.pinThreads] { workerLoop(i, pin); });
+    }
+
+    TaskScheduler::~TaskScheduler()
+    {
+        {
+            std::lock_guard<std::mutex> lock(sleepMutex_);
+            stop_ = true;
+        }
+        wake_.notify_all();
+        for (auto &t : workers_)
+            t.join();
+    }
+
+    TaskScheduler &TaskScheduler::global()
+    {
+        std::lock_guard<std::mutex> lock(globalMutex);
+        auto &pool = globalSlot();
+        if (!pool)
+            pool = std::make_unique<TaskScheduler>();
+        return *pool;
+    }
+
+    void TaskScheduler::configureGlobal(SchedulerOptions options)
+    {
+        std::lock_guard<std::mutex> lock(globalMutex);
+        auto &pool = globalSlot();
+        pool.reset();
+        pool = std::make_unique<TaskScheduler>(options);
+    }
+
+    void TaskScheduler::run(size_t count, size_t grain, void (*invoke)(void *, size_t, size_t), void *ctx)
+    {
+        const size_t chunks = (count + grain - 1) / grain;
+        Job job{invoke, ctx, count, grain, {chunks}, {}, std::numeric_limits<size_t>::max(), nullptr};
+
+        const size_t self = tlsPool == this ? tlsQueue : workers_.size();
+        if (workers_.empty() || chunks == 1)
+            execute({&job, 0, chunks}, self);
+        else
+            push({&job, 0, chunks}, self);
+
+        // Help with any pending work (ours or not) until our chunks are done.
+        while (job.pending.load(std::memory_order_acquire) != 0)
+        {
+            Task task;
+            if (tryTake(self, task))
+                execute(task, self);
+            else
+                std::this_thread::yield();
+        }
+
+        if (job.error)
+            std::rethrow_exception(job.error);
+    }
+
+    void TaskScheduler::execute(Task task, size_t self)
+    {
+        Job &job = *task.job;
+        while (task.end - task.begin > 1 && !workers_.empty())
+        {
+            const size_t mid = task.begin + (task.end - task.begin) / 2;
+            push({task.job, mid, task.end}, self);
+            task.end = mid;
+        }
+
+        for (size_t c = task.begin; c < task.end; ++c)
+        {
+            const size_t begin = c * job.grain;
+            const size_t end = std::min(job.count, begin + job.grain);
+            try
+            {
+                job.invoke(job.ctx, begin, end);
+            }
+            catch (...)
+            {
+                std::lock_guard<std::mutex> lock(job.errorMutex);
+                if (c < job.errorChunk)
+                {
+                    job.errorChunk = c;
+                    job.error = std::current_exception();
+                }
+            }
+        }
+        job.pending.fetch_sub(task.end - task.begin, std::memory_order_acq_rel);
+    }
+
+    void TaskScheduler::push(Task task, size_t self)
+    {
+        {
+            Queue &q = *queues_[self];
+            std::lock_guard<std::mutex> lock(q.mutex);
+            q.tasks.push_back(task);
+        }
+        // Pairs with the sleepers_/epoch_ order in workerLoop (both seq_cst).
+        epoch_.fetch_add(1);
+        if (sleepers_.load() != 0)
+        {
+            std::lock_guard<std::mutex> lock(sleepMutex_);
+            wake_.notify_one();
+        }
+    }
+
+    // Own deque from the back (newest, smallest), then the others from the
+    // front (oldest, largest).
+    bool TaskScheduler::tryTake(size_t self, Task &task)
+    {
+        {
+            Queue &q = *queues_[self];
+            std::lock_guard<std::mutex> lock(q.mutex);
+            if (!q.tasks.empty())
+            {
+                task = q.tasks.back();
+                q.tasks.pop_back();
+                return true;
+            }
+        }
+        const size_t n = queues_.size();
+        for (size_t k = 1; k < n; ++k)
+        {
+            Queue &q = *queues_[(self + k) % n];
+            std::lock_guard<std::mutex> lock(q.mutex);
+            if (!q.tasks.empty())
+            {
+                task = q.tasks.front();
+                q.tasks.pop_front();
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void TaskScheduler::workerLoop(size_t self, bool pin)
+    {
+        tlsPool = this;
+        tlsQueue = self;
+        if (pin)
+            pinToCpu(self);
+
+        while (true)
+        {
+            const uint64_t seen = epoch_.load();
+            Task task;
+            if (tryTake(self, task))
+            {
+                execute(task, self);
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(sleepMutex_);
+            sleepers_.fetch_add(1);
+            wake_.wait(lock, [&] { return stop_ || epoch_.load() != seen; });
+            sleepers_.fetch_sub(1);
+            if (stop_)
+                return;
+        }
+    }
+}
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Work-stealing pool shared by the library's parallel loops.
+//
+// parallelFor() splits [0, count) into chunks of `grain` indices and pushes
+// the whole chunk range as one task. Whoever runs a task halves it, pushes
+// the upper half onto its own deque and keeps the lower half, so a busy
+// thread works depth-first on adjacent chunks while idle threads steal the
+// largest pending halves from the front of other deques. The calling thread
+// takes part, so nested loops (a parallel kernel inside a parallel per-asset
+// loop) cannot deadlock and a one-thread pool runs everything inline.
+//
+// Which thread runs a chunk is not deterministic, so anything order-sensitive
+// must be combined by chunk index afterwards (see Execution::reduce).
+namespace Tasks
+{
+    struct SchedulerOptions
+    {
+        unsigned threads = 0;    // including the caller; 0 = TRADEIQ_THREADS or hardware concurrency
+        bool pinThreads = false; // pin worker k to CPU k (Linux)
+    };
+
+    class TaskScheduler
+    {
+    public:
+        explicit TaskScheduler(SchedulerOptions options = {});
+        ~TaskScheduler();
+
+        TaskScheduler(const TaskScheduler &) = delete;
+        TaskScheduler &operator=(const TaskScheduler &) = delete;
+
+        // Threads that run chunks, counting the caller.
+        unsigned concurrency() const { return static_cast<unsigned>(workers_.size()) + 1; }
+
+        // Calls fn(begin, end) for consecutive ranges of at most `grain`
+        // indices covering [0, count). Returns once every range has run. If
+        // any throw, the exception from the lowest range is rethrown.
+        template <typename Fn>
+        void parallelForChunks(size_t count, size_t grain, Fn &&fn)
+        {
+            if (count == 0)
+                return;
+            grain = grain ? grain : 1;
+            auto invoke = [](void *ctx, size_t begin, size_t end) { (*static_cast<Fn *>(ctx))(begin, end); };
+            run(count, grain, invoke, &fn);
+        }
+
+        template <typename Fn>
+        void parallelFor(size_t count, Fn &&fn, size_t grain = 1)
+        {
+            parallelForChunks(count, grain, [&fn](size_t begin, size_t end) {
+                for (size_t i = begin; i < end; ++i)
+                    fn(i);
+            });
+        }
+
+        // The process-wide pool, created on first use.
+        static TaskScheduler &global();
+
+        // Replaces the global pool. Not safe while it is running work.
+        static void configureGlobal(SchedulerOptions options);
+
+    private:
+        struct Job
+        {
+            void (*invoke)(void *, size_t, size_t);
+            void *ctx;
+            size_t count;
+            size_t grain;
+            std::atomic<size_t> pending;
+            std::mutex errorMutex;
+            size_t errorChunk;
+            std::exception_ptr error;
+        };
+
+        // Chunks [begin, end) of one job.
+        struct Task
+        {
+            Job *job;
+            size_t begin;
+            size_t end;
+        };
+
+        struct Queue
+        {
+            std::mutex mutex;
+            std::deque<Task> tasks;
+        };
+
+        void run(size_t count, size_t grain, void (*invoke)(void *, size_t, size_t), void *ctx);
+        void execute(Task task, size_t self);
+        void push(Task task, size_t self);
+        bool tryTake(size_t self, Task &task);
+        void workerLoop(size_t self, bool pin);
+
+        // Queue workers_.size() is shared by threads outside the pool.
+        std::vector<std::unique_ptr<Queue>> queues_;
+        std::vector<std::thread> workers_;
+
+        std::mutex sleepMutex_;
+        std::condition_variable wake_;
+        std::atomic<uint64_t> epoch_{0};
+        std::atomic<unsigned> sleepers_{0};
+        bool stop_ = false;
+    };
+}
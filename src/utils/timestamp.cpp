@@ -0,0 +1,216 @@
+#include "timestamp.hpp"
+#include <algorithm>
+#include <bit>
+#include <charconv>
+#include <cstring>
+#include <stdexcept>
+
+namespace Timestamp
+{
+    namespace
+    {
+        constexpr int64_t kMillisPerDay = 86400000LL;
+
+        // Writes `v` zero-padded to at least `width` digits, as "%0*lld" does.
+        char *writePadded(char *p, int64_t v, int width)
+        {
+            char digits[24];
+            char *end = std::to_chars(digits, digits + sizeof digits, v).ptr;
+            const char *first = digits;
+            if (*first == '-')
+            {
+                *p++ = *first++;
+                --width;
+            }
+            for (int n = static_cast<int>(end - first); n < width; ++n)
+                *p++ = '0';
+            return std::copy(first, static_cast<const char *>(end), p);
+        }
+
+        // Little-endian loads: text[0] lands in the lowest byte.
+        uint64_t load64(const char *p)
+        {
+            uint64_t v;
+            std::memcpy(&v, p, sizeof v);
+            if constexpr (std::endian::native == std::endian::big)
+                v = __builtin_bswap64(v);
+            return v;
+        }
+
+        uint64_t load16(const char *p)
+        {
+            return static_cast<uint64_t>(static_cast<uint8_t>(p[0])) |
+                   static_cast<uint64_t>(static_cast<uint8_t>(p[1])) << 8;
+        }
+
+        // All eight bytes are ASCII digits.
+        bool allDigits(uint64_t v)
+        {
+            return ((v & 0xF0F0F0F0F0F0F0F0) | (((v + 0x0606060606060606) & 0xF0F0F0F0F0F0F0F0) >> 4)) ==
+                   0x3333333333333333;
+        }
+
+        // Eight digits -> four two-digit values, one in the low byte of each
+        // 16-bit lane: lane k holds 10 * digit[2k] + digit[2k + 1].
+        uint64_t digitPairs(uint64_t v)
+        {
+            return (((v & 0x0F0F0F0F0F0F0F0F) * 2561) >> 8) & 0x00FF00FF00FF00FF;
+        }
+
+        unsigned lane(uint64_t pairs, unsigned k)
+        {
+            return static_cast<unsigned>(pairs >> (16 * k)) & 0xFF;
+        }
+
+        unsigned daysInMonth(unsigned year, unsigned month)
+        {
+            static constexpr uint8_t kDays[12] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+            const bool leap = year % 4 == 0 && (year % 100 != 0 || year % 400 == 0);
+            return kDays[month - 1] + (month == 2 && leap);
+        }
+
+        // "YYYY-MM-DD": "YYYY" and "MM" come from one load, "DD" from a
+        // second, and are packed into a single word of eight digits.
+        bool parseDate(const char *p, int64_t &days)
+        {
+            const uint64_t head = load64(p); // "YYYY-MM-"
+            if (((head >> 32) & 0xFF) != '-' || (head >> 56) != '-')
+                return false;
+            const uint64_t packed = (head & 0xFFFFFFFF) | ((head >> 40) & 0xFFFF) << 32 | load16(p + 8) << 48;
+            if (!allDigits(packed))
+                return false;
+            const uint64_t pairs = digitPairs(packed);
+            const unsigned year = lane(pairs, 0) * 100 + lane(pairs, 1);
+            const unsigned month = lane(pairs, 2), day = lane(pairs, 3);
+            if (month - 1 >= 12 || day - 1 >= daysInMonth(year, month))
+                return false;
+            days = daysFromCivil(year, month, day);
+            return true;
+        }
+
+        // "HH:MM:SS.mmm": hours, minutes, seconds and the first two digits of
+        // the milliseconds share one packed word.
+        bool parseTime(const char *p, int64_t &millis)
+        {
+            const uint64_t hms = load64(p); // "HH:MM:SS"
+            if (((hms >> 16) & 0xFF) != ':' || ((hms >> 40) & 0xFF) != ':' || p[8] != '.')
+                return false;
+            const uint64_t packed = (hms & 0xFFFF) | ((hms >> 24) & 0xFFFF) << 16 | (hms >> 48) << 32 | load16(p + 9) << 48;
+            const unsigned last = static_cast<unsigned char>(p[11]) - '0';
+            if (!allDigits(packed) || last > 9)
+                return false;
+            const uint64_t pairs = digitPairs(packed);
+            const unsigned h = lane(pairs, 0), m = lane(pairs, 1), sec = lane(pairs, 2);
+            if (h >= 24 || m >= 60 || sec >= 60)
+                return false;
+            millis = h * 3600000LL + m * 60000LL + sec * 1000LL + lane(pairs, 3) * 10 + last;
+            return true;
+        }
+
+        [[noreturn]] void unsupported(std::string_view s)
+        {
+            throw std::invalid_argument("Unsupported timestamp: " + std::string(s));
+        }
+    }
+
+    int64_t daysFromCivil(int64_t y, unsigned m, unsigned d)
+    {
+        y -= m <= 2;
+        const int64_t era = (y >= 0 ? y : y - 399) / 400;
+        const unsigned yoe = static_cast<unsigned>(y - era * 400);
+        const unsigned doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+        const unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+        return era * 146097 + static_cast<int64_t>(doe) - 719468;
+    }
+
+    void civilFromDays(int64_t z, int64_t &y, unsigned &m, unsigned &d)
+    {
+        z += 719468;
+        const int64_t era = (z >= 0 ? z : z - 146096) / 146097;
+        const unsigned doe = static_cast<unsigned>(z - era * 146097);
+        const unsigned yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+        const unsigned doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+        const unsigned mp = (5 * doy + 2) / 153;
+        d = doy - (153 * mp + 2) / 5 + 1;
+        m = mp < 10 ? mp + 3 : mp - 9;
+        y = static_cast<int64_t>(yoe) + era * 400 + (m <= 2);
+    }
+
+    bool tryParseIsoMillis(std::string_view s, int64_t &epochMillis, Format *format) noexcept
+    {
+        int64_t days = 0, millis = 0;
+        if (s.size() == 10)
+        {
+            if (!parseDate(s.data(), days))
+                return false;
+        }
+        else if (s.size() == 24 && s[10] == 'T' && s[23] == 'Z')
+        {
+            if (!parseDate(s.data(), days) || !parseTime(s.data() + 11, millis))
+                return false;
+        }
+        else
+        {
+            return false;
+        }
+        epochMillis = days * kMillisPerDay + millis;
+        if (format)
+            *format = s.size() == 10 ? Format::DateOnly : Format::IsoMillis;
+        return true;
+    }
+
+    int64_t parseIsoMillis(std::string_view s, Format *format)
+    {
+        int64_t ms;
+        if (!tryParseIsoMillis(s, ms, format))
+            unsupported(s);
+        return ms;
+    }
+
+    int64_t parseEpochDays(std::string_view s)
+    {
+        const int64_t ms = parseIsoMillis(s);
+        return ms >= 0 ? ms / kMillisPerDay : (ms - kMillisPerDay + 1) / kMillisPerDay;
+    }
+
+    int64_t parseEpochNanos(std::string_view s)
+    {
+        return parseIsoMillis(s) * 1000000LL;
+    }
+
+    bool isValidDate(std::string_view s) noexcept
+    {
+        int64_t days;
+        return s.size() == 10 && parseDate(s.data(), days);
+    }
+
+    std::string formatIsoMillis(int64_t ms, Format format)
+    {
+        int64_t days = ms >= 0 ? ms / kMillisPerDay : (ms - kMillisPerDay + 1) / kMillisPerDay;
+        int64_t rem = ms - days * kMillisPerDay;
+        int64_t y;
+        unsigned m, d;
+        civilFromDays(days, y, m, d);
+
+        // Room for any int64 year plus the fixed-width remainder.
+        char buf[48];
+        char *p = writePadded(buf, y, 4);
+        *p++ = '-';
+        p = writePadded(p, m, 2);
+        *p++ = '-';
+        p = writePadded(p, d, 2);
+        if (format != Format::DateOnly)
+        {
+            *p++ = 'T';
+            p = writePadded(p, rem / 3600000, 2);
+            *p++ = ':';
+            p = writePadded(p, rem / 60000 % 60, 2);
+            *p++ = ':';
+            p = writePadded(p, rem / 1000 % 60, 2);
+            *p++ = '.';
+            p = writePadded(p, rem % 1000, 3);
+            *p++ = 'Z';
+        }
+        return std::string(buf, p);
+    }
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+// Conversions between Tiingo date strings and epoch-based integers.
+namespace Timestamp
+{
+    enum class Format : uint8_t
+    {
+        DateOnly = 0,  // "2023-01-03"
+        IsoMillis = 1, // "2023-01-03T00:00:00.000Z"
+    };
+
+    int64_t daysFromCivil(int64_t year, unsigned month, unsigned day);
+    void civilFromDays(int64_t days, int64_t &year, unsigned &month, unsigned &day);
+
+    // Allocation-free parse of either format above. The digits of each field
+    // group are checked and combined eight at a time inside one 64-bit word
+    // (SWAR), and month, day and time fields are range-checked. Returns false
+    // rather than throwing, so it is safe on untrusted input.
+    bool tryParseIsoMillis(std::string_view text, int64_t &epochMillis, Format *format = nullptr) noexcept;
+
+    // Throws std::invalid_argument on anything other than the two formats above.
+    int64_t parseIsoMillis(std::string_view text, Format *format = nullptr);
+    int64_t parseEpochDays(std::string_view text);  // the calendar day, time of day dropped
+    int64_t parseEpochNanos(std::string_view text);
+
+    // True for a real calendar date written "YYYY-MM-DD".
+    bool isValidDate(std::string_view text) noexcept;
+    std::string formatIsoMillis(int64_t epochMillis, Format format = Format::IsoMillis);
+}
@@ -0,0 +1,326 @@
+/*
+ShardedCacheStore::put / get
+ShardedCacheStore manifest persistence
+ShardedCacheStore checksum validation
+ShardedCacheStore::putHistory / getHistory
+TiingoClient::setCacheStore
+TiingoClient::fetchAdjustedHistory (incremental extension)
+ShardedCacheStore::latestHistory
+ShardedCacheStore frequency in keys, pre-v3 manifests
+TiingoClient::fetchBars JSON cache per frequency
+*/
+
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <fstream>
+
+#include "api/cache_store.hpp"
+#include "api/tiingo_client.hpp"
+
+namespace fs = std::filesystem;
+
+namespace {
+
+class CacheStoreTest : public ::testing::Test {
+protected:
+    std::string dir = (fs::temp_directory_path() / "tradeiq_cache_store_test").string();
+
+    void SetUp() override { fs::remove_all(dir); }
+    void TearDown() override { fs::remove_all(dir); }
+};
+
+PriceSeries sampleSeries(const std::string& ticker) {
+    return PriceSeries(ticker,
+                       {"2023-01-03T00:00:00.000Z", "2023-01-04T00:00:00.000Z", "2023-01-05T00:00:00.000Z"},
+                       {125.07, 126.36, 125.02});
+}
+
+class CountingHttpClient : public HttpClient {
+public:
+    int calls = 0;
+    std::string get(const std::string&) override {
+        ++calls;
+        return R"([{"date":"2023-01-03T00:00:00.000Z","adjClose":100.5},
+                   {"date":"2023-01-04T00:00:00.000Z","adjClose":101.25}])";
+    }
+};
+
+}
+
+TEST_F(CacheStoreTest, PutThenGetRoundTrips) {
+    ShardedCacheStore store(dir, 4);
+    store.put("AAPL", "2023-01-01", "2023-01-06", sampleSeries("AAPL"));
+
+    auto loaded = store.get("AAPL", "2023-01-01", "2023-01-06");
+    ASSERT_TRUE(loaded.has_value());
+    EXPECT_EQ(loaded->getTicker(), "AAPL");
+    EXPECT_EQ(loaded->getDates(), sampleSeries("AAPL").getDates());
+    EXPECT_EQ(loaded->getPrices(), sampleSeries("AAPL").getPrices());
+}
+
+TEST_F(CacheStoreTest, MissingKeyReturnsNullopt) {
+    ShardedCacheStore store(dir);
+    EXPECT_FALSE(store.get("NOPE", "2023-01-01", "2023-01-02").has_value());
+}
+
+TEST_F(CacheStoreTest, DateOnlyFormatPreserved) {
+    ShardedCacheStore store(dir);
+    PriceSeries ps("X", {"2020-02-28", "2020-02-29", "2020-03-02"}, {1.0, 2.0, 3.0});
+    store.put("X", "a", "b", ps);
+    EXPECT_EQ(store.get("X", "a", "b")->getDates(), ps.getDates());
+}
+
+TEST_F(CacheStoreTest, UnparseableDatesThrow) {
+    ShardedCacheStore store(dir);
+    PriceSeries ps("X", {"", ""}, {1.0, 2.0});
+    EXPECT_THROW(store.put("X", "a", "b", ps), std::invalid_argument);
+}
+
+TEST_F(CacheStoreTest, ManifestSurvivesReopen) {
+    {
+        ShardedCacheStore store(dir, 2);
+        for (int i = 0; i < 20; ++i)
+            store.put("T" + std::to_string(i), "2023-01-01", "2023-01-06", sampleSeries("T"));
+        EXPECT_EQ(store.size(), 20u);
+    }
+
+    ShardedCacheStore reopened(dir, 8); // shard count comes from the manifest
+    EXPECT_EQ(reopened.numShards(), 2u);
+    EXPECT_EQ(reopened.size(), 20u);
+    auto entry = reopened.describe("T7", "2023-01-01", "2023-01-06");
+    ASSERT_TRUE(entry.has_value());
+    EXPECT_EQ(entry->count, 3u);
+    EXPECT_LT(entry->firstTimestamp, entry->lastTimestamp);
+    EXPECT_EQ(reopened.get("T7", "2023-01-01", "2023-01-06")->getPrices().size(), 3u);
+
+    // Only the manifest and one file per shard are on disk.
+    size_t files = std::distance(fs::directory_iterator(dir), fs::directory_iterator{});
+    EXPECT_LE(files, 3u);
+}
+
+TEST_F(CacheStoreTest, LaterPutSupersedesEarlier) {
+    ShardedCacheStore store(dir);
+    store.put("A", "s", "e", PriceSeries("A", {"2023-01-03"}, {1.0}));
+    store.put("A", "s", "e", PriceSeries("A", {"2023-01-03", "2023-01-04"}, {1.0, 2.0}));
+    EXPECT_EQ(store.get("A", "s", "e")->getPrices().size(), 2u);
+}
+
+TEST_F(CacheStoreTest, CorruptBlockIsDetected) {
+    {
+        ShardedCacheStore store(dir, 1);
+        store.put("A", "s", "e", sampleSeries("A"));
+    }
+    {
+        std::fstream seg(fs::path(dir) / "segment-00.seg", std::ios::in | std::ios::out | std::ios::binary);
+        seg.seekp(12);
+        seg.put('\x7f');
+    }
+    ShardedCacheStore store(dir);
+    EXPECT_THROW(store.get("A", "s", "e"), std::runtime_error);
+}
+
+TEST_F(CacheStoreTest, TiingoClientUsesStoreInsteadOfJsonFiles) {
+    auto http = std::make_shared<CountingHttpClient>();
+    TiingoClient client("dummy", http);
+    client.setCacheStore(std::make_shared<ShardedCacheStore>(dir));
+    fs::remove(".cache/STORED_2023-01-03_2023-01-04.json");
+
+    auto first = client.fetchDailyPrices("STORED", "2023-01-03", "2023-01-04");
+    auto second = client.fetchDailyPrices("STORED", "2023-01-03", "2023-01-04");
+
+    EXPECT_EQ(http->calls, 1);
+    EXPECT_EQ(first.getPrices(), second.getPrices());
+    EXPECT_EQ(first.getDates(), second.getDates());
+    EXPECT_FALSE(fs::exists(".cache/STORED_2023-01-03_2023-01-04.json"));
+}
+
+TEST_F(CacheStoreTest, HistoryRoundTripsWithActions) {
+    ShardedCacheStore store(dir);
+    AdjustedHistory h("AAPL", {"2023-01-03", "2023-01-04", "2023-01-05"}, {100.0, 99.0, 49.5},
+                      {{1, 1.0, 1.0}, {2, 0.0, 2.0}});
+    store.putHistory("s", "e", h);
+
+    auto loaded = store.getHistory("AAPL", "s", "e");
+    ASSERT_TRUE(loaded.has_value());
+    EXPECT_EQ(loaded->getRawCloses(), h.getRawCloses());
+    ASSERT_EQ(loaded->getActions().size(), 2u);
+    EXPECT_EQ(loaded->getActions()[1].index, 2u);
+    EXPECT_EQ(loaded->getActions()[1].splitFactor, 2.0);
+    EXPECT_EQ(loaded->getAdjustedCloses(), h.getAdjustedCloses());
+
+    EXPECT_FALSE(store.get("AAPL", "s", "e").has_value()); // stored separately
+}
+
+TEST_F(CacheStoreTest, TiingoClientParsesCorporateActions) {
+    class ActionsHttpClient : public HttpClient {
+    public:
+        std::string get(const std::string&) override {
+            return R"([{"date":"2023-01-03T00:00:00.000Z","close":100.0,"adjClose":49.5,"divCash":0.0,"splitFactor":1.0},
+                       {"date":"2023-01-04T00:00:00.000Z","close":99.0,"adjClose":49.5,"divCash":1.0,"splitFactor":1.0},
+                       {"date":"2023-01-05T00:00:00.000Z","close":50.0,"adjClose":50.0,"divCash":0.0,"splitFactor":2.0}])";
+        }
+    };
+
+    TiingoClient client("dummy", std::make_shared<ActionsHttpClient>());
+    client.setCacheStore(std::make_shared<ShardedCacheStore>(dir));
+    fs::remove(".cache/ACTIONS_2023-01-03_2023-01-05.json");
+
+    AdjustedHistory h = client.fetchAdjustedHistory("ACTIONS", "2023-01-03", "2023-01-05");
+    ASSERT_EQ(h.getActions().size(), 2u);
+    EXPECT_EQ(h.getActions()[0].index, 1u);
+    EXPECT_EQ(h.getActions()[0].dividend, 1.0);
+    EXPECT_NEAR(h.getAdjustedCloses()[0], 100.0 * 0.99 * 0.5, 1e-9);
+    EXPECT_NEAR(h.getAdjustedCloses()[2], 50.0, 1e-12);
+}
+
+TEST_F(CacheStoreTest, LongerHistoryRequestAppendsToStoredOne) {
+    // Serves the rows dated within the URL's [startDate, endDate].
+    class RangeHttpClient : public HttpClient {
+    public:
+        std::vector<std::string> urls;
+        std::string get(const std::string& url) override {
+            urls.push_back(url);
+            const std::string from = url.substr(url.find("startDate=") + 10, 10);
+            const std::string to = url.substr(url.find("endDate=") + 8, 10);
+            const std::vector<std::string> rows = {
+                R"({"date":"2023-01-03T00:00:00.000Z","close":100.0})",
+                R"({"date":"2023-01-04T00:00:00.000Z","close":99.0,"divCash":1.0})",
+                R"({"date":"2023-01-05T00:00:00.000Z","close":50.0,"splitFactor":2.0})",
+                R"({"date":"2023-01-06T00:00:00.000Z","close":51.0})"};
+            std::string body = "[";
+            for (const auto& row : rows) {
+                const std::string day = row.substr(9, 10);
+                if (day >= from && day <= to)
+                    body += (body.size() > 1 ? "," : "") + row;
+            }
+            return body + "]";
+        }
+    };
+
+    auto http = std::make_shared<RangeHttpClient>();
+    TiingoClient client("dummy", http);
+    auto store = std::make_shared<ShardedCacheStore>(dir);
+    client.setCacheStore(store);
+    for (const char* f : {".cache/EXT_2023-01-03_2023-01-04.json", ".cache/EXT_2023-01-04_2023-01-06.json",
+                          ".cache/EXT_2023-01-03_2023-01-06.json"})
+        fs::remove(f);
+
+    AdjustedHistory first = client.fetchAdjustedHistory("EXT", "2023-01-03", "2023-01-04");
+    EXPECT_EQ(first.getDates().size(), 2u);
+    EXPECT_FALSE(store->latestHistory("EXT", "2023-01-03", "2023-01-04").has_value());
+
+    std::string storedEnd;
+    ASSERT_TRUE(store->latestHistory("EXT", "2023-01-03", "2023-01-06", &storedEnd).has_value());
+    EXPECT_EQ(storedEnd, "2023-01-04");
+
+    AdjustedHistory extended = client.fetchAdjustedHistory("EXT", "2023-01-03", "2023-01-06");
+    ASSERT_EQ(http->urls.size(), 2u);
+    EXPECT_NE(http->urls[1].find("startDate=2023-01-04&endDate=2023-01-06"), std::string::npos);
+
+    AdjustedHistory full("EXT", extended.getDates(), extended.getRawCloses(),
+                         {{1, 1.0, 1.0}, {2, 0.0, 2.0}});
+    ASSERT_EQ(extended.getDates().size(), 4u);
+    EXPECT_EQ(extended.getActions().size(), 2u);
+    for (size_t i = 0; i < 4; ++i)
+        EXPECT_NEAR(extended.getAdjustedCloses()[i], full.getAdjustedCloses()[i], 1e-12);
+
+    // The extended history is stored under its own key and served from there.
+    client.fetchAdjustedHistory("EXT", "2023-01-03", "2023-01-06");
+    EXPECT_EQ(http->urls.size(), 2u);
+}
+
+TEST_F(CacheStoreTest, FrequenciesAreStoredSeparately) {
+    ShardedCacheStore store(dir);
+    store.put("A", "2023-01-03", "2023-01-05", sampleSeries("A"));
+    EXPECT_TRUE(store.contains("A", "2023-01-03", "2023-01-05"));
+    EXPECT_FALSE(store.contains("A", "2023-01-03", "2023-01-05", "intraday"));
+    EXPECT_FALSE(store.get("A", "2023-01-03", "2023-01-05", "intraday").has_value());
+
+    PriceSeries bars("A", {"2023-01-03T14:30:00.000Z", "2023-01-03T14:35:00.000Z"}, {1.0, 2.0});
+    store.put("A", "2023-01-03", "2023-01-05", bars, "intraday");
+    EXPECT_EQ(store.get("A", "2023-01-03", "2023-01-05", "intraday")->getPrices(), bars.getPrices());
+    EXPECT_EQ(store.get("A", "2023-01-03", "2023-01-05")->getPrices(), sampleSeries("A").getPrices());
+    EXPECT_EQ(store.size(), 2u);
+}
+
+TEST_F(CacheStoreTest, TiingoClientKeepsDailyAndIntradayApart) {
+    auto http = std::make_shared<CountingHttpClient>();
+    TiingoClient client("dummy", http);
+    client.setCacheStore(std::make_shared<ShardedCacheStore>(dir));
+    fs::remove(".cache/FREQ_2023-01-03_2023-01-04.json");
+
+    client.fetchDailyPrices("FREQ", "2023-01-03", "2023-01-04", "daily");
+    client.fetchDailyPrices("FREQ", "2023-01-03", "2023-01-04", "intraday");
+    client.fetchDailyPrices("FREQ", "2023-01-03", "2023-01-04", "intraday");
+    EXPECT_EQ(http->calls, 2);
+}
+
+TEST_F(CacheStoreTest, ManifestsWithoutFrequencyAreDropped) {
+    fs::create_directories(dir);
+    {
+        // A v2 manifest with one entry whose key has no frequency.
+        std::ofstream out(fs::path(dir) / "manifest.idx", std::ios::binary);
+        auto pod = [&](auto v) { out.write(reinterpret_cast<const char*>(&v), sizeof(v)); };
+        const std::string key = "A_2023-01-03_2023-01-05";
+        pod(uint32_t{0x4D514954});
+        pod(uint32_t{2});
+        pod(uint32_t{4});
+        pod(uint32_t{1});
+        pod(static_cast<uint16_t>(key.size()));
+        out.write(key.data(), static_cast<std::streamsize>(key.size()));
+        pod(uint32_t{0});
+        pod(uint64_t{0});
+        pod(uint32_t{0});
+        pod(uint32_t{0});
+        pod(int64_t{0});
+        pod(int64_t{0});
+        pod(uint64_t{0});
+        pod(uint8_t{0});
+        pod(uint8_t{0});
+    }
+    {
+        ShardedCacheStore store(dir);
+        EXPECT_EQ(store.numShards(), 4u);
+        EXPECT_EQ(store.size(), 0u);
+        store.put("A", "2023-01-03", "2023-01-05", sampleSeries("A"));
+    }
+    ShardedCacheStore reopened(dir);
+    EXPECT_EQ(reopened.size(), 1u);
+    EXPECT_TRUE(reopened.contains("A", "2023-01-03", "2023-01-05"));
+}
+
+TEST_F(CacheStoreTest, BarJsonCacheIsPerFrequency) {
+    class BarsHttpClient : public HttpClient {
+    public:
+        int calls = 0;
+        std::string get(const std::string& url) override {
+            ++calls;
+            if (url.find("/iex/") != std::string::npos)
+                return R"([{"date":"2023-01-03T14:30:00.000Z","close":10.0},
+                           {"date":"2023-01-03T14:35:00.000Z","close":10.5}])";
+            return R"([{"date":"2023-01-03T00:00:00.000Z","close":20.0}])";
+        }
+    };
+
+    const std::vector<std::string> files = {".cache/BARS_2023-01-03_2023-01-03.json",
+                                            ".cache/BARS_2023-01-03_2023-01-03_intraday.json"};
+    for (const auto& f : files)
+        fs::remove(f);
+
+    auto http = std::make_shared<BarsHttpClient>();
+    TiingoClient client("dummy", http);
+    auto daily = client.fetchBars("BARS", "2023-01-03", "2023-01-03", "daily");
+    auto intraday = client.fetchBars("BARS", "2023-01-03", "2023-01-03", "intraday");
+    ASSERT_EQ(daily.size(), 1u);
+    ASSERT_EQ(intraday.size(), 2u);
+    EXPECT_EQ(http->calls, 2);
+
+    EXPECT_EQ(client.fetchBars("BARS", "2023-01-03", "2023-01-03", "intraday").size(), 2u);
+    EXPECT_EQ(client.fetchBars("BARS", "2023-01-03", "2023-01-03", "daily").size(), 1u);
+    EXPECT_EQ(http->calls, 2);
+
+    for (const auto& f : files) {
+        EXPECT_TRUE(fs::exists(f)) << f;
+        fs::remove(f);
+    }
+}
@@ -0,0 +1,133 @@
+/*
+PriceCache::getOrLoad
+PriceCache::find
+PriceCache eviction
+TiingoClient::setPriceCache (request coalescing)
+*/
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "api/price_cache.hpp"
+#include "api/tiingo_client.hpp"
+
+namespace fs = std::filesystem;
+
+namespace {
+
+PriceSeries makeSeries(const std::string& ticker, size_t n) {
+    std::vector<std::string> dates(n, "2023-01-03T00:00:00.000Z");
+    std::vector<double> prices(n, 100.0);
+    return PriceSeries(ticker, dates, prices);
+}
+
+class SlowCountingHttpClient : public HttpClient {
+public:
+    std::atomic<int> calls{0};
+
+    std::string get(const std::string&) override {
+        ++calls;
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        return R"([{"date":"2023-01-03T00:00:00.000Z","adjClose":100.0},
+                   {"date":"2023-01-04T00:00:00.000Z","adjClose":101.0}])";
+    }
+};
+
+}
+
+TEST(PriceCacheTest, SecondLookupIsHit) {
+    PriceCache cache;
+    int loads = 0;
+    auto loader = [&] { ++loads; return makeSeries("A", 3); };
+
+    auto first = cache.getOrLoad("A", loader);
+    auto second = cache.getOrLoad("A", loader);
+
+    EXPECT_EQ(loads, 1);
+    EXPECT_EQ(first.get(), second.get());
+
+    auto s = cache.stats();
+    EXPECT_EQ(s.misses, 1u);
+    EXPECT_EQ(s.hits, 1u);
+    EXPECT_EQ(s.entries, 1u);
+}
+
+TEST(PriceCacheTest, FindMissReturnsNull) {
+    PriceCache cache;
+    EXPECT_EQ(cache.find("nope"), nullptr);
+    EXPECT_EQ(cache.stats().misses, 1u);
+}
+
+TEST(PriceCacheTest, EvictsLeastRecentlyUsed) {
+    size_t oneEntry = PriceCache::estimateBytes(makeSeries("A", 100));
+    PriceCache cache(oneEntry * 2 + oneEntry / 2);
+
+    cache.getOrLoad("A", [] { return makeSeries("A", 100); });
+    cache.getOrLoad("B", [] { return makeSeries("B", 100); });
+    cache.find("A"); // A is now most recent
+    cache.getOrLoad("C", [] { return makeSeries("C", 100); });
+
+    EXPECT_NE(cache.find("A"), nullptr);
+    EXPECT_EQ(cache.find("B"), nullptr);
+    EXPECT_NE(cache.find("C"), nullptr);
+    EXPECT_EQ(cache.stats().evictions, 1u);
+    EXPECT_LE(cache.stats().bytes, cache.maxBytes());
+}
+
+TEST(PriceCacheTest, LoaderExceptionIsNotCached) {
+    PriceCache cache;
+    EXPECT_THROW(cache.getOrLoad("X", []() -> PriceSeries { throw std::runtime_error("boom"); }),
+                 std::runtime_error);
+
+    auto ok = cache.getOrLoad("X", [] { return makeSeries("X", 2); });
+    EXPECT_EQ(ok->getPrices().size(), 2u);
+}
+
+TEST(PriceCacheTest, ConcurrentRequestsShareOneLoad) {
+    PriceCache cache;
+    std::atomic<int> loads{0};
+    auto loader = [&] {
+        ++loads;
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        return makeSeries("A", 10);
+    };
+
+    std::vector<std::thread> threads;
+    std::vector<PriceCache::SeriesPtr> results(8);
+    for (size_t i = 0; i < results.size(); ++i)
+        threads.emplace_back([&, i] { results[i] = cache.getOrLoad("A", loader); });
+    for (auto& t : threads)
+        t.join();
+
+    EXPECT_EQ(loads.load(), 1);
+    for (const auto& r : results)
+        EXPECT_EQ(r.get(), results[0].get());
+
+    auto s = cache.stats();
+    EXPECT_EQ(s.misses, 1u);
+    EXPECT_EQ(s.hits + s.coalesced, results.size() - 1);
+}
+
+TEST(PriceCacheTest, TiingoClientCoalescesConcurrentFetches) {
+    fs::remove(".cache/COALESCE_2023-01-03_2023-01-04.json");
+
+    auto http = std::make_shared<SlowCountingHttpClient>();
+    TiingoClient client("dummy", http);
+    client.setPriceCache(std::make_shared<PriceCache>());
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 4; ++i)
+        threads.emplace_back([&] { client.fetchDailyPrices("COALESCE", "2023-01-03", "2023-01-04"); });
+    for (auto& t : threads)
+        t.join();
+
+    EXPECT_EQ(http->calls.load(), 1);
+    EXPECT_EQ(client.getPriceCache()->stats().misses, 1u);
+
+    fs::remove(".cache/COALESCE_2023-01-03_2023-01-04.json");
+}
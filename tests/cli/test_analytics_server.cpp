@@ -0,0 +1,327 @@
+/*
+QueryEngine (from a Universe or from loaded shared series)
+QueryEngine::parse
+QueryEngine::answer (matches the batch metrics, date ranges, errors, ping/stats)
+QueryEngine::answerBatch (distinct misses computed once, result cache, LRU eviction)
+AnalyticsServer (Unix socket round trip, pipelined requests, unread responses, stop)
+BatchCli::parseArgs --serve
+*/
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <TestHelpers.hpp>
+
+#include "cli/analytics_server.hpp"
+#include "cli/batch_runner.hpp"
+#include "utils/timestamp.hpp"
+
+namespace fs = std::filesystem;
+
+namespace {
+
+constexpr int64_t kFirstDay = 19358;  // 2023-01-01
+
+std::string date(int64_t day) {
+    return Timestamp::formatIsoMillis(day * 86400000LL, Timestamp::Format::DateOnly);
+}
+
+// Closes on weekdays only, starting 2023-01-02.
+PriceSeries dated(const std::string& ticker, size_t length, unsigned seed) {
+    PriceSeries walk = generateRandomWalkSeries(ticker, length, 100.0, 0.0004, 0.015, seed);
+    std::vector<std::string> dates;
+    for (int64_t day = kFirstDay + 1; dates.size() < length; ++day)
+        if ((day + 4) % 7 >= 1 && (day + 4) % 7 <= 5)  // Monday..Friday; 1970-01-01 was a Thursday
+            dates.push_back(date(day));
+    return PriceSeries(ticker, std::move(dates), walk.getPrices());
+}
+
+Universe universe() {
+    Universe u;
+    u.insert(dated("AAPL", 300, 1));
+    u.insert(dated("MSFT", 300, 2));
+    u.insert(dated("SPY", 120, 3));
+    return u;
+}
+
+std::vector<std::vector<std::string>> rows(const std::string& response) {
+    std::vector<std::vector<std::string>> out;
+    std::stringstream lines(response);
+    std::string line;
+    while (std::getline(lines, line) && !line.empty()) {
+        std::vector<std::string> cells;
+        std::stringstream cellStream(line);
+        std::string cell;
+        while (std::getline(cellStream, cell, ','))
+            cells.push_back(cell);
+        out.push_back(cells);
+    }
+    return out;
+}
+
+// The closes of `series` dated within [from, to].
+PriceSeries slice(const PriceSeries& series, const std::string& from, const std::string& to) {
+    std::vector<double> prices;
+    for (size_t i = 0; i < series.getDates().size(); ++i)
+        if (series.getDates()[i] >= from && series.getDates()[i] <= to)
+            prices.push_back(series.getPrices()[i]);
+    return PriceSeries(series.getTicker(), std::move(prices));
+}
+
+}
+
+TEST(QueryEngineTest, ParsesRequests) {
+    ServerQuery q = QueryEngine::parse("sharpe,volatility AAPL,MSFT 2023-02-01 2023-06-30");
+    EXPECT_EQ(q.tickers, (std::vector<std::string>{"AAPL", "MSFT"}));
+    ASSERT_EQ(q.metrics.size(), 2u);
+    EXPECT_EQ(BatchRunner::availableMetrics()[q.metrics[0]], "sharpe");
+    EXPECT_EQ(q.firstDay, Timestamp::parseEpochDays("2023-02-01"));
+    EXPECT_EQ(q.lastDay, Timestamp::parseEpochDays("2023-06-30"));
+
+    q = QueryEngine::parse("* SPY\r");
+    EXPECT_EQ(q.metrics.size(), BatchRunner::availableMetrics().size());
+    EXPECT_EQ(q.firstDay, INT64_MIN);
+
+    for (const char* bad : {"", "sharpe", "alpha AAPL", "sharpe AAPL 2023-02-30", "sharpe AAPL 2023-03-01 2023-02-01",
+                            "sharpe AAPL 2023-01-01 2023-02-01 extra", ", AAPL"})
+        EXPECT_THROW(QueryEngine::parse(bad), std::invalid_argument) << bad;
+}
+
+TEST(QueryEngineTest, AnswersMatchBatchMetrics) {
+    Universe u = universe();
+    QueryEngine engine(u);
+    EXPECT_EQ(engine.tickers(), 3u);
+    EXPECT_EQ(engine.bars(), 720u);
+
+    const std::string response = engine.answer("* AAPL,SPY 2023-02-01 2023-09-15");
+    ASSERT_EQ(response.substr(response.size() - 2), "\n\n");
+    const auto table = rows(response);
+    ASSERT_EQ(table.size(), 3u);
+    ASSERT_EQ(table[0].size(), 1 + BatchRunner::availableMetrics().size());
+    EXPECT_EQ(table[0][0], "ticker");
+    EXPECT_EQ(table[0][4], "sharpe");
+
+    for (size_t r = 1; r < table.size(); ++r) {
+        const auto expected = BatchCli::metricValues(slice(u.at(table[r][0]), "2023-02-01", "2023-09-15"), 0.01);
+        for (size_t m = 0; m < expected.size(); ++m)
+            EXPECT_EQ(std::stod(table[r][m + 1]), expected[m]) << table[r][0] << " " << m;
+    }
+
+    // Whole history by default; too little data reads as nan.
+    auto whole = rows(engine.answer("observations MSFT"));
+    EXPECT_EQ(whole[1][1], "299");
+    auto empty = rows(engine.answer("observations,sharpe SPY 2024-01-01"));
+    EXPECT_EQ(empty[1][1], "0");
+    EXPECT_EQ(empty[1][2], "nan");
+}
+
+TEST(QueryEngineTest, BuildsFromLoadedSeriesWithoutUniverse) {
+    Universe u = universe();
+    QueryEngine fromUniverse(u);
+
+    std::vector<std::shared_ptr<const PriceSeries>> loaded;
+    for (const auto& series : u)
+        loaded.push_back(std::make_shared<const PriceSeries>(series));
+    loaded.insert(loaded.begin() + 1, nullptr);  // a ticker that failed to load
+    loaded.push_back(std::make_shared<const PriceSeries>(dated("AAPL", 50, 99)));  // repeated: first wins
+    QueryEngine fromLoaded(loaded);
+
+    EXPECT_EQ(fromLoaded.tickers(), fromUniverse.tickers());
+    EXPECT_EQ(fromLoaded.bars(), fromUniverse.bars());
+    for (const char* q : {"* AAPL,MSFT,SPY", "sharpe,max_drawdown AAPL 2023-03-01 2023-09-30", "observations SPY"})
+        EXPECT_EQ(fromLoaded.answer(q), fromUniverse.answer(q)) << q;
+}
+
+TEST(QueryEngineTest, ErrorsAndControlRequests) {
+    Universe u = universe();
+    QueryEngine engine(u);
+    EXPECT_EQ(engine.answer("sharpe QQQ"), "error: Unknown ticker: QQQ\n\n");
+    EXPECT_EQ(engine.answer("alpha AAPL").rfind("error: Unknown metric: alpha", 0), 0u);
+    EXPECT_EQ(engine.answer("ping"), "pong\n\n");
+    const auto stats = rows(engine.answer("stats"));
+    ASSERT_EQ(stats.size(), 2u);
+    EXPECT_EQ(stats[1][0], "3");
+    EXPECT_EQ(stats[1][1], "720");
+
+    Universe unordered;
+    unordered.insert(PriceSeries("X", {"2023-01-04", "2023-01-03"}, {1.0, 2.0}));
+    EXPECT_THROW(QueryEngine{unordered}, std::invalid_argument);
+    Universe undated;
+    undated.insert(PriceSeries("X", std::vector<double>{1.0, 2.0}));
+    EXPECT_THROW(QueryEngine{undated}, std::invalid_argument);
+}
+
+TEST(QueryEngineTest, CachesByResolvedRange) {
+    Universe u = universe();
+    QueryEngine engine(u);
+    const std::string first = engine.answer("sharpe AAPL 2023-03-06 2023-06-30");
+    EXPECT_EQ(engine.cacheStats().misses, 1u);
+    EXPECT_EQ(engine.answer("sharpe AAPL 2023-03-06 2023-06-30"), first);
+    // Saturday to Sunday covers the same bars as the Monday to Friday inside.
+    EXPECT_EQ(engine.answer("sharpe AAPL 2023-03-04 2023-07-02"), first);
+    // Another metric over the same bars is also a hit: entries hold every metric.
+    engine.answer("volatility AAPL 2023-03-06 2023-06-30");
+    EXPECT_EQ(engine.cacheStats().hits, 3u);
+    EXPECT_EQ(engine.cacheStats().misses, 1u);
+    EXPECT_EQ(engine.cacheStats().entries, 1u);
+}
+
+TEST(QueryEngineTest, BatchComputesEachMissOnce) {
+    Universe u = universe();
+    QueryEngine engine(u);
+    const auto responses = engine.answerBatch({"sharpe AAPL,MSFT", "volatility MSFT,AAPL", "bogus", "sharpe SPY", "ping"});
+    ASSERT_EQ(responses.size(), 5u);
+    EXPECT_EQ(rows(responses[0]).size(), 3u);
+    EXPECT_EQ(rows(responses[1])[1][0], "MSFT");
+    EXPECT_EQ(responses[2].rfind("error:", 0), 0u);
+    EXPECT_EQ(responses[4], "pong\n\n");
+    EXPECT_EQ(engine.cacheStats().misses, 3u);
+    EXPECT_EQ(engine.cacheStats().hits, 0u);
+    EXPECT_EQ(responses[0], engine.answer("sharpe AAPL,MSFT"));
+    EXPECT_EQ(engine.cacheStats().hits, 2u);
+}
+
+TEST(QueryEngineTest, LeastRecentlyUsedEntriesAreEvicted) {
+    Universe u = universe();
+    QueryEngineOptions options;
+    options.cacheEntries = 2;
+    QueryEngine engine(u, options);
+    engine.answer("sharpe AAPL");
+    engine.answer("sharpe MSFT");
+    engine.answer("sharpe AAPL");  // AAPL is now the most recent
+    engine.answer("sharpe SPY");   // evicts MSFT
+    EXPECT_EQ(engine.cacheStats().entries, 2u);
+    const auto before = engine.cacheStats();
+    engine.answer("sharpe AAPL");
+    engine.answer("sharpe MSFT");
+    EXPECT_EQ(engine.cacheStats().hits, before.hits + 1);
+    EXPECT_EQ(engine.cacheStats().misses, before.misses + 1);
+
+    options.cacheEntries = 0;
+    QueryEngine uncached(u, options);
+    uncached.answer("sharpe AAPL");
+    uncached.answer("sharpe AAPL");
+    EXPECT_EQ(uncached.cacheStats().hits, 0u);
+    EXPECT_EQ(uncached.cacheStats().entries, 0u);
+}
+
+TEST(AnalyticsServerTest, AnswersOverUnixSocket) {
+    Universe u = universe();
+    QueryEngine engine(u);
+    const std::string path = (fs::temp_directory_path() / "tradeiq_server_test.sock").string();
+    AnalyticsServer server(engine, path);
+    std::thread loop([&] { server.run(); });
+
+    const int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    ASSERT_GE(fd, 0);
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    std::snprintf(addr.sun_path, sizeof(addr.sun_path), "%s", path.c_str());
+    ASSERT_EQ(::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)), 0);
+
+    // Two pipelined requests in one write, the second split across writes.
+    const std::string part1 = "sharpe AAPL 2023-03-01 2023-06-30\nmax_drawdown SP";
+    const std::string part2 = "Y\n";
+    ASSERT_EQ(::write(fd, part1.data(), part1.size()), static_cast<ssize_t>(part1.size()));
+    ASSERT_EQ(::write(fd, part2.data(), part2.size()), static_cast<ssize_t>(part2.size()));
+    ::shutdown(fd, SHUT_WR);
+
+    std::string received;
+    char buf[4096];
+    ssize_t n;
+    while ((n = ::read(fd, buf, sizeof(buf))) > 0)
+        received.append(buf, static_cast<size_t>(n));
+    ::close(fd);
+
+    EXPECT_EQ(received, engine.answer("sharpe AAPL 2023-03-01 2023-06-30") + engine.answer("max_drawdown SPY"));
+    EXPECT_EQ(server.requestsServed(), 2u);
+
+    server.stop();
+    loop.join();
+    EXPECT_THROW(AnalyticsServer(engine, std::string(200, 'x')), std::runtime_error);
+}
+
+TEST(AnalyticsServerTest, ClientThatDoesNotReadIsThrottledNotDropped) {
+    Universe u = universe();
+    QueryEngine engine(u);
+    const std::string path = (fs::temp_directory_path() / "tradeiq_server_backlog.sock").string();
+    AnalyticsServer server(engine, path);
+    std::thread loop([&] { server.run(); });
+
+    auto connectClient = [&] {
+        const int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        sockaddr_un addr{};
+        addr.sun_family = AF_UNIX;
+        std::snprintf(addr.sun_path, sizeof(addr.sun_path), "%s", path.c_str());
+        EXPECT_EQ(::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)), 0);
+        return fd;
+    };
+
+    // Well over the server's pending-response cap in total.
+    const std::string request = "* AAPL,MSFT,SPY\n";
+    const std::string response = engine.answer("* AAPL,MSFT,SPY");
+    const size_t count = (16u << 20) / response.size();
+    const int greedy = connectClient();
+    std::thread writer([&] {
+        std::string all;
+        for (size_t i = 0; i < count; ++i)
+            all += request;
+        for (size_t off = 0; off < all.size();) {
+            const ssize_t n = ::write(greedy, all.data() + off, all.size() - off);
+            if (n <= 0)
+                break;
+            off += static_cast<size_t>(n);
+        }
+        ::shutdown(greedy, SHUT_WR);
+    });
+
+    // Another client is still served while the first one's responses pile up.
+    const int other = connectClient();
+    ASSERT_EQ(::write(other, "ping\n", 5), 5);
+    char buf[1 << 16];
+    std::string pong;
+    ssize_t n;
+    while (pong.size() < 6 && (n = ::read(other, buf, sizeof(buf))) > 0)
+        pong.append(buf, static_cast<size_t>(n));
+    EXPECT_EQ(pong, "pong\n\n");
+    ::close(other);
+
+    // Nothing was dropped once the first client reads.
+    size_t received = 0;
+    while ((n = ::read(greedy, buf, sizeof(buf))) > 0)
+        received += static_cast<size_t>(n);
+    writer.join();
+    ::close(greedy);
+    EXPECT_EQ(received, count * response.size());
+
+    server.stop();
+    loop.join();
+}
+
+TEST(AnalyticsServerTest, RefusesToReplaceRegularFile) {
+    Universe u = universe();
+    QueryEngine engine(u);
+    const fs::path path = fs::temp_directory_path() / "tradeiq_server_not_a_socket";
+    { std::ofstream(path) << "data"; }
+    EXPECT_THROW(AnalyticsServer(engine, path.string()), std::runtime_error);
+    EXPECT_TRUE(fs::exists(path));
+    fs::remove(path);
+}
+
+TEST(BatchCliTest, ParsesServeSocket) {
+    BatchConfig cfg = BatchCli::parseArgs(std::vector<std::string>{"--serve", "/tmp/tradeiq.sock", "--tickers", "A,B"});
+    EXPECT_EQ(cfg.serveSocket, "/tmp/tradeiq.sock");
+    EXPECT_THROW(BatchCli::parseArgs(std::vector<std::string>{"--serve"}), std::invalid_argument);
+}
@@ -0,0 +1,171 @@
+/*
+BatchCli::parseArgs
+BatchCli::readUniverse
+BatchRunner::run (load, align, compute, correlation, calendar)
+BatchRunner::write
+*/
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+#include "cli/batch_runner.hpp"
+
+namespace fs = std::filesystem;
+
+namespace {
+
+std::shared_ptr<const PriceSeries> makeSeries(const std::string& ticker, std::vector<std::string> dates,
+                                              std::vector<double> prices) {
+    return std::make_shared<const PriceSeries>(ticker, dates, prices);
+}
+
+}
+
+TEST(BatchCliTest, DefaultsMatchLegacyMain) {
+    BatchConfig cfg = BatchCli::parseArgs(std::vector<std::string>{});
+    EXPECT_EQ(cfg.tickers, std::vector<std::string>{"AAPL"});
+    EXPECT_EQ(cfg.startDate, "2023-01-01");
+    EXPECT_EQ(cfg.endDate, "2023-12-31");
+    EXPECT_EQ(cfg.format, "table");
+    EXPECT_EQ(cfg.cacheDir, ".cache/store");
+}
+
+TEST(BatchCliTest, ParsesAllOptions) {
+    BatchConfig cfg = BatchCli::parseArgs(std::vector<std::string>{
+        "--tickers", "MSFT, GOOG", "--start", "2022-01-01", "--end", "2022-06-30", "--metrics", "sharpe,max_drawdown",
+        "--threads", "3", "--format", "csv", "--out", "x.csv", "--risk-free", "0.02", "--offline", "--cache-dir", "/tmp/prices"});
+    EXPECT_EQ(cfg.tickers, (std::vector<std::string>{"MSFT", "GOOG"}));
+    EXPECT_EQ(cfg.metrics, (std::vector<std::string>{"sharpe", "max_drawdown"}));
+    EXPECT_EQ(cfg.threads, 3u);
+    EXPECT_EQ(cfg.output, "x.csv");
+    EXPECT_DOUBLE_EQ(cfg.riskFreeRate, 0.02);
+    EXPECT_TRUE(cfg.offline);
+    EXPECT_EQ(cfg.cacheDir, "/tmp/prices");
+    EXPECT_TRUE(BatchCli::parseArgs(std::vector<std::string>{"--cache-dir", ""}).cacheDir.empty());
+}
+
+TEST(BatchCliTest, RejectsBadArguments) {
+    using Args = std::vector<std::string>;
+    EXPECT_THROW(BatchCli::parseArgs(Args{"--bogus"}), std::invalid_argument);
+    EXPECT_THROW(BatchCli::parseArgs(Args{"--start"}), std::invalid_argument);
+    EXPECT_THROW(BatchCli::parseArgs(Args{"--threads", "-1"}), std::invalid_argument);
+    EXPECT_THROW(BatchCli::parseArgs(Args{"--metrics", "alpha"}), std::invalid_argument);
+    EXPECT_THROW(BatchCli::parseArgs(Args{"--format", "xml"}), std::invalid_argument);
+    EXPECT_THROW(BatchCli::parseArgs(Args{"--format", "columnar"}), std::invalid_argument);
+    EXPECT_THROW(BatchCli::parseArgs(Args{"--calendar", "lse"}), std::invalid_argument);
+}
+
+TEST(BatchCliTest, ReadsUniverseFile) {
+    fs::path path = fs::temp_directory_path() / "tradeiq_universe_test.txt";
+    std::ofstream(path) << "# large caps\nAAPL\nMSFT, GOOG  # inline comment\n\n";
+    EXPECT_EQ(BatchCli::readUniverse(path.string()), (std::vector<std::string>{"AAPL", "MSFT", "GOOG"}));
+    fs::remove(path);
+    EXPECT_THROW(BatchCli::readUniverse(path.string()), std::runtime_error);
+}
+
+TEST(BatchRunnerTest, ComputesMetricsAndRecordsFailures) {
+    BatchConfig cfg;
+    cfg.tickers = {"UP", "BAD", "FLAT"};
+    cfg.metrics = {"observations", "total_return", "max_drawdown"};
+    cfg.threads = 2;
+
+    std::atomic<int> calls{0};
+    BatchRunner runner(cfg, [&](const std::string& t) -> std::shared_ptr<const PriceSeries> {
+        ++calls;
+        if (t == "BAD")
+            throw std::runtime_error("HTTP 404");
+        if (t == "UP")
+            return makeSeries(t, {"d1", "d2", "d3"}, {100.0, 90.0, 120.0});
+        return makeSeries(t, {"d1", "d2"}, {50.0, 50.0});
+    });
+
+    BatchResult result = runner.run();
+    EXPECT_EQ(calls.load(), 3);
+    ASSERT_EQ(result.metrics.rows(), 2u);
+    EXPECT_EQ(result.metrics.column("ticker").text, (std::vector<std::string>{"UP", "FLAT"}));
+    EXPECT_EQ(result.metrics.column("observations").i64, (std::vector<int64_t>{2, 1}));
+    EXPECT_NEAR(result.metrics.column("total_return").f64[0], 0.2, 1e-12);
+    EXPECT_NEAR(result.metrics.column("max_drawdown").f64[0], 0.1, 1e-12);
+    ASSERT_EQ(result.failed.size(), 1u);
+    EXPECT_EQ(result.failed[0], "BAD: HTTP 404");
+
+    std::vector<std::string> stages;
+    for (const auto& t : result.timings)
+        stages.push_back(t.stage);
+    EXPECT_EQ(stages, (std::vector<std::string>{"load", "align", "compute"}));
+}
+
+TEST(BatchRunnerTest, CorrelationUsesCommonDates) {
+    BatchConfig cfg;
+    cfg.tickers = {"A", "B"};
+    cfg.correlationOutput = "unused";
+    BatchRunner runner(cfg, [](const std::string& t) {
+        if (t == "A")
+            return makeSeries(t, {"2023-01-02", "2023-01-03", "2023-01-04", "2023-01-05"}, {1.0, 2.0, 1.0, 2.0});
+        return makeSeries(t, {"2023-01-03", "2023-01-04", "2023-01-05", "2023-01-06"}, {4.0, 2.0, 4.0, 9.0});
+    });
+
+    BatchResult result = runner.run();
+    EXPECT_EQ(result.commonDates, (std::vector<std::string>{"2023-01-03", "2023-01-04", "2023-01-05"}));
+    ASSERT_EQ(result.correlation.size(), 2u);
+    EXPECT_NEAR(result.correlation[0][1], 1.0, 1e-12);
+    EXPECT_EQ(result.labels, (std::vector<std::string>{"A", "B"}));
+}
+
+TEST(BatchRunnerTest, CalendarAnnualizesBySessionsAndReportsGaps) {
+    BatchConfig cfg = BatchCli::parseArgs(std::vector<std::string>{"--calendar", "nyse"});
+    cfg.tickers = {"A", "B"};
+    cfg.metrics = {"volatility"};
+    // A skips Friday 2023-01-06; B spans MLK Day (2023-01-16), which is not a gap.
+    auto loader = [](const std::string& t) {
+        if (t == "A")
+            return makeSeries(t, {"2023-01-03T00:00:00.000Z", "2023-01-04T00:00:00.000Z", "2023-01-05T00:00:00.000Z",
+                                  "2023-01-09T00:00:00.000Z", "2023-01-10T00:00:00.000Z"},
+                              {100.0, 101.0, 99.0, 102.0, 101.0});
+        return makeSeries(t, {"2023-01-13", "2023-01-17", "2023-01-18"}, {100.0, 101.0, 99.0});
+    };
+
+    BatchResult withCalendar = BatchRunner(cfg, loader).run();
+    EXPECT_EQ(withCalendar.gaps, (std::vector<std::string>{"A: 1 missing sessions"}));
+
+    cfg.calendar.clear();
+    BatchResult fixed = BatchRunner(cfg, loader).run();
+    EXPECT_TRUE(fixed.gaps.empty());
+
+    // 2023 had 250 NYSE sessions, so volatility scales by sqrt(250), not sqrt(252).
+    const auto& calVol = withCalendar.metrics.column("volatility").f64;
+    const auto& fixedVol = fixed.metrics.column("volatility").f64;
+    ASSERT_EQ(calVol.size(), 2u);
+    for (size_t r = 0; r < 2; ++r)
+        EXPECT_NEAR(calVol[r] / fixedVol[r], std::sqrt(250.0 / 252.0), 1e-12);
+}
+
+TEST(BatchRunnerTest, WritesCsvAndCorrelation) {
+    fs::path dir = fs::temp_directory_path() / "tradeiq_batch_test";
+    fs::create_directories(dir);
+
+    BatchConfig cfg;
+    cfg.tickers = {"A", "B"};
+    cfg.metrics = {"total_return"};
+    cfg.format = "csv";
+    cfg.output = (dir / "metrics.csv").string();
+    cfg.correlationOutput = (dir / "corr.csv").string();
+    BatchRunner runner(cfg, [](const std::string& t) {
+        return makeSeries(t, {"d1", "d2", "d3"}, {1.0, t == "A" ? 2.0 : 0.5, 1.0});
+    });
+
+    BatchResult result = runner.run();
+    runner.write(result);
+    EXPECT_EQ(result.timings.back().stage, "export");
+
+    std::ifstream metrics(cfg.output);
+    std::stringstream ss;
+    ss << metrics.rdbuf();
+    EXPECT_EQ(ss.str(), "ticker,total_return\nA,0\nB,0\n");
+    EXPECT_TRUE(fs::exists(cfg.correlationOutput));
+    fs::remove_all(dir);
+}
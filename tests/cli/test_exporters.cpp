@@ -0,0 +1,131 @@
+/*
+Export::BufferedWriter
+Export::writeCsv (table, matrix)
+Export::writeColumnar / readColumnar / readColumnarMatrix
+*/
+
+#include <gtest/gtest.h>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+#include "cli/exporters.hpp"
+
+namespace fs = std::filesystem;
+
+namespace {
+
+std::string slurp(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    std::stringstream ss;
+    ss << in.rdbuf();
+    return ss.str();
+}
+
+}
+
+class ExportersTest : public ::testing::Test {
+protected:
+    std::string dir = (fs::temp_directory_path() / "tradeiq_exporters_test").string();
+
+    void SetUp() override {
+        fs::remove_all(dir);
+        fs::create_directories(dir);
+    }
+    void TearDown() override { fs::remove_all(dir); }
+
+    std::string path(const std::string& name) const { return (fs::path(dir) / name).string(); }
+};
+
+TEST_F(ExportersTest, CsvMatrixWithLabels) {
+    std::vector<std::vector<double>> m = {{1.0, 0.25}, {0.25, 1.0}};
+    Export::writeCsv(path("m.csv"), m, {"AAPL", "MSFT"});
+    EXPECT_EQ(slurp(path("m.csv")), ",AAPL,MSFT\nAAPL,1,0.25\nMSFT,0.25,1\n");
+}
+
+TEST_F(ExportersTest, CsvDoublesRoundTripExactly) {
+    std::vector<std::vector<double>> m = {{0.1 + 0.2, 1.0 / 3.0, -1e-300}};
+    Export::writeCsv(path("m.csv"), m);
+
+    std::string text = slurp(path("m.csv"));
+    std::stringstream ss(text);
+    std::string cell;
+    for (double expected : m[0]) {
+        std::getline(ss, cell, expected == m[0].back() ? '\n' : ',');
+        EXPECT_EQ(std::stod(cell), expected);
+    }
+}
+
+TEST_F(ExportersTest, CsvTableQuotesAndFixedPrecision) {
+    Export::ResultTable table;
+    table.addColumn("ticker", std::vector<std::string>{"A,B", "say \"hi\""});
+    table.addColumn("n", std::vector<int64_t>{1, -2});
+    table.addColumn("sharpe", std::vector<double>{1.23456, 2.0});
+
+    Export::CsvOptions opts;
+    opts.precision = 2;
+    Export::writeCsv(path("t.csv"), table, opts);
+    EXPECT_EQ(slurp(path("t.csv")), "ticker,n,sharpe\n\"A,B\",1,1.23\n\"say \"\"hi\"\"\",-2,2.00\n");
+}
+
+TEST_F(ExportersTest, MismatchedColumnLengthsThrow) {
+    Export::ResultTable table;
+    table.addColumn("a", std::vector<double>{1.0, 2.0});
+    EXPECT_THROW(table.addColumn("b", std::vector<double>{1.0}), std::invalid_argument);
+    EXPECT_THROW(table.column("missing"), std::out_of_range);
+    EXPECT_THROW(Export::writeCsv(path("m.csv"), {{1.0, 2.0}, {3.0}}, {}), std::invalid_argument);
+}
+
+TEST_F(ExportersTest, ColumnarTableRoundTrip) {
+    Export::ResultTable table;
+    table.addColumn("date", std::vector<std::string>{"2023-01-03", "", "2023-01-05"});
+    table.addColumn("ts", std::vector<int64_t>{1672704000000, 1672790400000, 1672876800000});
+    table.addColumn("close", std::vector<double>{125.07, 126.36, 125.02});
+    Export::writeColumnar(path("t.tiqc"), table);
+
+    auto back = Export::readColumnar(path("t.tiqc"));
+    ASSERT_EQ(back.rows(), 3u);
+    ASSERT_EQ(back.columns().size(), 3u);
+    EXPECT_EQ(back.column("date").text, table.column("date").text);
+    EXPECT_EQ(back.column("ts").i64, table.column("ts").i64);
+    EXPECT_EQ(back.column("close").f64, table.column("close").f64);
+}
+
+TEST_F(ExportersTest, ColumnarMatrixIsAlignedRowMajor) {
+    std::vector<std::vector<double>> m = {{1.0, 2.0, 3.0}, {4.0, 5.0, 6.0}};
+    Export::writeColumnar(path("m.tiqc"), m, {"A", "B"});
+
+    auto back = Export::readColumnarMatrix(path("m.tiqc"));
+    EXPECT_EQ(back.rows, 2u);
+    EXPECT_EQ(back.cols, 3u);
+    EXPECT_EQ(back.labels, (std::vector<std::string>{"A", "B"}));
+    EXPECT_EQ(back.values, (std::vector<double>{1.0, 2.0, 3.0, 4.0, 5.0, 6.0}));
+
+    // The data block is a plain aligned array at the advertised offset.
+    std::string bytes = slurp(path("m.tiqc"));
+    EXPECT_EQ(bytes.substr(0, 7), "TIQCOL1");
+    size_t offset = bytes.size() - 6 * sizeof(double);
+    EXPECT_EQ(offset % 64, 0u);
+    double last;
+    std::memcpy(&last, bytes.data() + offset + 5 * sizeof(double), sizeof(double));
+    EXPECT_EQ(last, 6.0);
+}
+
+TEST_F(ExportersTest, ReadRejectsForeignFiles) {
+    std::ofstream(path("bad.tiqc")) << "not columnar at all";
+    EXPECT_THROW(Export::readColumnar(path("bad.tiqc")), std::runtime_error);
+    EXPECT_THROW(Export::readColumnar(path("missing.tiqc")), std::runtime_error);
+}
+
+TEST_F(ExportersTest, WriterHandlesPayloadsLargerThanBuffer) {
+    {
+        Export::BufferedWriter out(path("big.txt"), 64);
+        std::string chunk(1000, 'x');
+        out.write("ab");
+        out.write(chunk);
+        out.writeDouble(1.5);
+        EXPECT_EQ(out.bytesWritten(), 1005u);
+    }
+    EXPECT_EQ(fs::file_size(path("big.txt")), 1005u);
+}
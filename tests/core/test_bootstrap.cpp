@@ -0,0 +1,182 @@
+/*
+resampleIndices
+bootstrapRatios (single series and batched, several tiles per pass or one)
+*/
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "stats/bootstrap.hpp"
+#include "stats/drawdowns.hpp"
+#include "stats/ratios.hpp"
+#include "stats/returns.hpp"
+#include "utils/math_utils.hpp"
+
+using namespace Stats::Bootstrap;
+
+namespace {
+
+std::vector<double> makeReturns(size_t n, double mu, double sigma, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::normal_distribution<double> dist(mu, sigma);
+    std::vector<double> r(n);
+    for (auto& x : r)
+        x = dist(rng);
+    return r;
+}
+
+void expectSameInterval(const Interval& a, const Interval& b) {
+    EXPECT_DOUBLE_EQ(a.estimate, b.estimate);
+    EXPECT_DOUBLE_EQ(a.lower, b.lower);
+    EXPECT_DOUBLE_EQ(a.upper, b.upper);
+}
+
+void expectSameIntervals(const RatioIntervals& a, const RatioIntervals& b) {
+    expectSameInterval(a.sharpe, b.sharpe);
+    expectSameInterval(a.sortino, b.sortino);
+    expectSameInterval(a.omega, b.omega);
+    expectSameInterval(a.maxDrawdown, b.maxDrawdown);
+    expectSameInterval(a.calmar, b.calmar);
+}
+
+}
+
+TEST(BootstrapTest, BlockIndicesAreCircularRuns) {
+    Options options;
+    options.scheme = Scheme::Block;
+    options.blockLength = 5;
+    std::vector<uint32_t> idx;
+    resampleIndices(103, 7, options, idx);
+
+    ASSERT_EQ(idx.size(), 103);
+    for (size_t t = 0; t + 1 < idx.size(); ++t) {
+        EXPECT_LT(idx[t], 103u);
+        if (t % 5 != 4) {
+            EXPECT_EQ(idx[t + 1], (idx[t] + 1) % 103);
+        }
+    }
+}
+
+TEST(BootstrapTest, IndicesAreReproducibleAndDifferAcrossResamples) {
+    Options options;
+    std::vector<uint32_t> a, b, c;
+    resampleIndices(500, 3, options, a);
+    resampleIndices(500, 3, options, b);
+    resampleIndices(500, 4, options, c);
+    EXPECT_EQ(a, b);
+    EXPECT_NE(a, c);
+}
+
+TEST(BootstrapTest, StationaryMeanBlockLength) {
+    Options options;
+    options.blockLength = 10;
+    std::vector<uint32_t> idx;
+    size_t breaks = 0, steps = 0;
+    for (size_t b = 0; b < 50; ++b) {
+        resampleIndices(2000, b, options, idx);
+        for (size_t t = 1; t < idx.size(); ++t, ++steps)
+            breaks += idx[t] != (idx[t - 1] + 1) % 2000;
+    }
+    EXPECT_NEAR(static_cast<double>(steps) / static_cast<double>(breaks), 10.0, 0.5);
+}
+
+TEST(BootstrapTest, EstimatesMatchStatsRatios) {
+    auto r = makeReturns(750, 0.0004, 0.01, 1);
+    Options options;
+    options.resamples = 50;
+    options.riskFreeRate = 0.0001;
+    auto ci = bootstrapRatios(r, options);
+
+    std::vector<double> wealth{1.0};
+    for (double x : r)
+        wealth.push_back(wealth.back() * (1.0 + x));
+    double mean = MathUtils::mean(r);
+    double mdd = Stats::Drawdowns::computeMaxDrawdown(wealth);
+    double annual = Stats::Returns::computeAnnualizedReturn(wealth.back() - 1.0, 750, 252);
+
+    EXPECT_NEAR(ci.sharpe.estimate, Stats::Ratios::computeSharpeRatio(mean, MathUtils::variance(r, true), 0.0001), 1e-12);
+    EXPECT_NEAR(ci.sortino.estimate, Stats::Ratios::computeSortinoRatio(mean, 0.0001, r), 1e-12);
+    EXPECT_NEAR(ci.omega.estimate, Stats::Ratios::computeOmegaRatio(r, 0.0), 1e-12);
+    EXPECT_NEAR(ci.maxDrawdown.estimate, mdd, 1e-12);
+    EXPECT_NEAR(ci.calmar.estimate, Stats::Ratios::computeCalmarRatio(annual, mdd), 1e-10);
+}
+
+TEST(BootstrapTest, IntervalsBracketEstimateAndWidenWithConfidence) {
+    auto r = makeReturns(1000, 0.0005, 0.01, 2);
+    Options options;
+    options.resamples = 2000;
+    options.confidence = 0.9;
+    auto narrow = bootstrapRatios(r, options);
+    options.confidence = 0.99;
+    auto wide = bootstrapRatios(r, options);
+
+    for (auto* ci : {&narrow.sharpe, &narrow.omega, &narrow.maxDrawdown, &narrow.calmar}) {
+        EXPECT_LT(ci->lower, ci->estimate);
+        EXPECT_GT(ci->upper, ci->estimate);
+    }
+    EXPECT_LT(wide.sharpe.lower, narrow.sharpe.lower);
+    EXPECT_GT(wide.sharpe.upper, narrow.sharpe.upper);
+    EXPECT_GE(narrow.maxDrawdown.lower, 0.0);
+}
+
+TEST(BootstrapTest, ResultsDoNotDependOnThreadCount) {
+    std::vector<std::vector<double>> panel;
+    for (unsigned s = 0; s < 20; ++s)
+        panel.push_back(makeReturns(300, 0.0003, 0.01 + 0.001 * s, 10 + s));
+    Options options;
+    options.resamples = 500;
+    options.threads = 1;
+    auto serial = bootstrapRatios(panel, options);
+    options.threads = 4;
+    auto parallel = bootstrapRatios(panel, options);
+
+    ASSERT_EQ(serial.size(), panel.size());
+    for (size_t s = 0; s < panel.size(); ++s)
+        expectSameIntervals(serial[s], parallel[s]);
+
+    // Batched strategies see the same resamples as a lone series.
+    expectSameIntervals(serial[17], bootstrapRatios(panel[17], options));
+}
+
+TEST(BootstrapTest, TilesMatchLoneSeriesWithinAndAcrossPasses) {
+    std::vector<std::vector<double>> panel;
+    for (unsigned s = 0; s < 40; ++s)
+        panel.push_back(makeReturns(24, 0.0005, 0.01 + 0.0005 * s, 50 + s));
+    Options options;
+    options.blockLength = 4;
+    // 500 resamples fit all three tiles in one pass; 40000 need one pass per tile.
+    for (size_t resamples : {500u, 40000u}) {
+        options.resamples = resamples;
+        auto batched = bootstrapRatios(panel, options);
+        ASSERT_EQ(batched.size(), panel.size());
+        for (size_t s : {0u, 15u, 16u, 39u})
+            expectSameIntervals(batched[s], bootstrapRatios(panel[s], options));
+    }
+}
+
+TEST(BootstrapTest, NoDownsideGivesInfiniteSortino) {
+    std::vector<double> r(100, 0.001);
+    Options options;
+    options.resamples = 20;
+    auto ci = bootstrapRatios(r, options);
+    EXPECT_TRUE(std::isinf(ci.sortino.estimate));
+    EXPECT_TRUE(std::isinf(ci.sortino.upper));
+    EXPECT_DOUBLE_EQ(ci.maxDrawdown.upper, 0.0);
+}
+
+TEST(BootstrapTest, InvalidInputsThrow) {
+    Options options;
+    EXPECT_THROW(bootstrapRatios(std::vector<double>{0.01}, options), std::invalid_argument);
+    EXPECT_THROW(bootstrapRatios(std::vector<std::vector<double>>{{0.01, 0.02}, {0.01}}, options), std::invalid_argument);
+    options.blockLength = 0;
+    EXPECT_THROW(bootstrapRatios(std::vector<double>{0.01, 0.02}, options), std::invalid_argument);
+    options = {};
+    options.confidence = 1.0;
+    EXPECT_THROW(bootstrapRatios(std::vector<double>{0.01, 0.02}, options), std::invalid_argument);
+    options = {};
+    options.resamples = 0;
+    EXPECT_THROW(bootstrapRatios(std::vector<double>{0.01, 0.02}, options), std::invalid_argument);
+}
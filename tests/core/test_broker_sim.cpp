@@ -0,0 +1,192 @@
+/*
+ObjectPool
+EventQueue
+BrokerSim::FillModel
+BrokerSim::Ledger
+BrokerSim::Simulator (market/limit orders, cancel, latency)
+*/
+
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <vector>
+
+#include "core/broker_sim.hpp"
+#include "core/event_queue.hpp"
+#include "core/object_pool.hpp"
+
+using namespace BrokerSim;
+
+namespace {
+
+struct TestEvent {
+    int64_t time;
+    uint64_t seq;
+};
+
+std::vector<Bar> flatBars(std::vector<double> opens, int64_t step = 86400000) {
+    std::vector<Bar> bars;
+    for (size_t i = 0; i < opens.size(); ++i)
+        bars.push_back(Bar{static_cast<int64_t>(i) * step, opens[i], opens[i] + 1.0, opens[i] - 1.0, opens[i], 1000.0});
+    return bars;
+}
+
+}
+
+TEST(ObjectPoolTest, ReusesReleasedSlots) {
+    ObjectPool<Order, 4> pool;
+    Order* a = pool.acquire();
+    pool.release(a);
+    Order* b = pool.acquire();
+    EXPECT_EQ(a, b);
+    EXPECT_EQ(pool.live(), 1u);
+    EXPECT_EQ(pool.capacity(), 4u);
+
+    std::vector<Order*> many;
+    for (int i = 0; i < 9; ++i)
+        many.push_back(pool.acquire());
+    EXPECT_EQ(pool.capacity(), 12u);
+    for (auto* o : many)
+        pool.release(o);
+    EXPECT_EQ(pool.live(), 1u);
+}
+
+TEST(EventQueueTest, PopsByTimeThenSequence) {
+    EventQueue<TestEvent> q;
+    q.push({5, 0});
+    q.push({1, 1});
+    q.push({5, 2});
+    q.push({3, 3});
+    q.push({1, 4});
+
+    std::vector<std::pair<int64_t, uint64_t>> order;
+    while (!q.empty()) {
+        auto e = q.pop();
+        order.emplace_back(e.time, e.seq);
+    }
+    std::vector<std::pair<int64_t, uint64_t>> expected = {{1, 1}, {1, 4}, {3, 3}, {5, 0}, {5, 2}};
+    EXPECT_EQ(order, expected);
+    EXPECT_THROW(q.pop(), std::out_of_range);
+}
+
+TEST(FillModelTest, SlippageAndCommission) {
+    FillModel m;
+    m.slippageBps = 10.0;
+    m.commissionPerShare = 0.01;
+    m.minCommission = 1.0;
+    EXPECT_NEAR(m.executionPrice(Side::Buy, 100.0), 100.1, 1e-12);
+    EXPECT_NEAR(m.executionPrice(Side::Sell, 100.0), 99.9, 1e-12);
+    EXPECT_NEAR(m.commission(50.0), 1.0, 1e-12);
+    EXPECT_NEAR(m.commission(500.0), 5.0, 1e-12);
+}
+
+TEST(LedgerTest, TracksAverageCostAndRealizedPnl) {
+    Ledger ledger(1000.0);
+    ledger.resize(1);
+    ledger.apply(Fill{1, 0, Side::Buy, 10.0, 10.0, 0.0, 0});
+    ledger.apply(Fill{2, 0, Side::Buy, 10.0, 20.0, 0.0, 0});
+    EXPECT_NEAR(ledger.averageCost(0), 15.0, 1e-12);
+    EXPECT_NEAR(ledger.cash(), 700.0, 1e-12);
+
+    ledger.apply(Fill{3, 0, Side::Sell, 25.0, 30.0, 1.0, 0}); // close 20, flip short 5
+    EXPECT_NEAR(ledger.realizedPnl(), 20.0 * 15.0, 1e-12);
+    EXPECT_NEAR(ledger.position(0), -5.0, 1e-12);
+    EXPECT_NEAR(ledger.averageCost(0), 30.0, 1e-12);
+    EXPECT_NEAR(ledger.cash(), 700.0 + 750.0 - 1.0, 1e-12);
+    EXPECT_NEAR(ledger.equity({30.0}), 1449.0 - 150.0, 1e-12);
+}
+
+TEST(SimulatorTest, MarketOrderFillsAtNextBarOpen) {
+    Simulator sim(10000.0);
+    uint32_t s = sim.addSymbol("AAA", flatBars({100.0, 105.0, 110.0}));
+
+    bool submitted = false;
+    sim.run([&](Simulator& sm, uint32_t symbol, const Bar&) {
+        if (!submitted) {
+            sm.submitOrder(symbol, Side::Buy, 10.0);
+            submitted = true;
+        }
+    });
+
+    ASSERT_EQ(sim.fills().size(), 1u);
+    EXPECT_NEAR(sim.fills()[0].price, 105.0, 1e-12);
+    EXPECT_NEAR(sim.ledger().position(s), 10.0, 1e-12);
+    EXPECT_NEAR(sim.ledger().cash(), 10000.0 - 1050.0, 1e-12);
+    EXPECT_NEAR(sim.ledger().equity(sim.marks()), 10000.0 + 50.0, 1e-12);
+    EXPECT_EQ(sim.workingOrders(), 0u);
+}
+
+TEST(SimulatorTest, LimitOrderWaitsUntilPriceTrades) {
+    Simulator sim(10000.0);
+    sim.addSymbol("AAA", flatBars({100.0, 100.0, 95.0, 90.0}));
+
+    bool submitted = false;
+    sim.run([&](Simulator& sm, uint32_t symbol, const Bar&) {
+        if (!submitted) {
+            sm.submitOrder(symbol, Side::Buy, 1.0, OrderType::Limit, 96.0);
+            submitted = true;
+        }
+    });
+
+    ASSERT_EQ(sim.fills().size(), 1u);
+    EXPECT_EQ(sim.fills()[0].timestamp, 2 * 86400000LL);
+    EXPECT_NEAR(sim.fills()[0].price, 95.0, 1e-12); // gapped through the limit, filled at the open
+}
+
+TEST(SimulatorTest, CancelledOrderNeverFills) {
+    Simulator sim(10000.0);
+    sim.addSymbol("AAA", flatBars({100.0, 100.0, 50.0}));
+
+    uint64_t id = 0;
+    sim.run([&](Simulator& sm, uint32_t symbol, const Bar& bar) {
+        if (id == 0) {
+            id = sm.submitOrder(symbol, Side::Buy, 1.0, OrderType::Limit, 60.0);
+        } else if (bar.timestamp == 86400000) {
+            EXPECT_TRUE(sm.cancelOrder(id));
+        }
+    });
+
+    EXPECT_TRUE(sim.fills().empty());
+    EXPECT_FALSE(sim.cancelOrder(id));
+    EXPECT_EQ(sim.workingOrders(), 0u);
+}
+
+TEST(SimulatorTest, BarsFromMultipleSymbolsInterleaveByTime) {
+    Simulator sim(0.0);
+    sim.addSymbol("A", flatBars({1.0, 2.0, 3.0}, 10));
+    sim.addSymbol("B", flatBars({1.0, 2.0}, 15));
+
+    std::vector<std::pair<int64_t, uint32_t>> seen;
+    sim.run([&](Simulator&, uint32_t symbol, const Bar& bar) { seen.emplace_back(bar.timestamp, symbol); });
+
+    std::vector<std::pair<int64_t, uint32_t>> expected = {{0, 0}, {0, 1}, {10, 0}, {15, 1}, {20, 0}};
+    EXPECT_EQ(seen, expected);
+    EXPECT_EQ(sim.eventsProcessed(), 5u);
+}
+
+TEST(SimulatorTest, LatencyDelaysOrderActivation) {
+    FillModel model;
+    model.latency = 2 * 86400000LL;
+    Simulator sim(10000.0, model);
+    sim.addSymbol("AAA", flatBars({100.0, 101.0, 102.0, 103.0}));
+
+    bool submitted = false;
+    sim.run([&](Simulator& sm, uint32_t symbol, const Bar&) {
+        if (!submitted) {
+            sm.submitOrder(symbol, Side::Buy, 1.0);
+            submitted = true;
+        }
+    });
+
+    ASSERT_EQ(sim.fills().size(), 1u);
+    EXPECT_NEAR(sim.fills()[0].price, 102.0, 1e-12); // live at t=2, first eligible bar is day 2
+    EXPECT_EQ(sim.fills()[0].timestamp, 2 * 86400000LL);
+}
+
+TEST(SimulatorTest, InvalidInputsThrow) {
+    Simulator sim(0.0);
+    EXPECT_THROW(sim.submitOrder(0, Side::Buy, 1.0), std::out_of_range);
+    sim.addSymbol("A", flatBars({1.0}));
+    EXPECT_THROW(sim.submitOrder(0, Side::Buy, 0.0), std::invalid_argument);
+    EXPECT_THROW(sim.submitOrder(0, Side::Buy, 1.0, OrderType::Limit, 0.0), std::invalid_argument);
+    EXPECT_THROW(sim.addSymbol("B", {Bar{5}, Bar{1}}), std::invalid_argument);
+}
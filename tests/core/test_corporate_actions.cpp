@@ -0,0 +1,113 @@
+/*
+CorporateActions::computeAdjustmentFactors
+AdjustedHistory::appendBar
+AdjustedHistory::setAction
+AdjustedHistory::toPriceSeries
+*/
+
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <vector>
+
+#include "core/corporate_actions.hpp"
+
+using namespace CorporateActions;
+
+TEST(CorporateActionsTest, NoEventsMeansUnitFactors) {
+    auto f = computeAdjustmentFactors({10.0, 11.0, 12.0}, {});
+    EXPECT_EQ(f, std::vector<double>({1.0, 1.0, 1.0}));
+}
+
+TEST(CorporateActionsTest, SplitHalvesEarlierPrices) {
+    std::vector<double> raw = {100.0, 102.0, 50.0, 51.0};
+    auto f = computeAdjustmentFactors(raw, {{2, 0.0, 2.0}});
+    EXPECT_NEAR(f[0], 0.5, 1e-12);
+    EXPECT_NEAR(f[1], 0.5, 1e-12);
+    EXPECT_NEAR(f[2], 1.0, 1e-12);
+    EXPECT_NEAR(f[3], 1.0, 1e-12);
+}
+
+TEST(CorporateActionsTest, DividendScalesByPreviousClose) {
+    auto f = computeAdjustmentFactors({100.0, 99.0}, {{1, 1.0, 1.0}});
+    EXPECT_NEAR(f[0], 0.99, 1e-12);
+    EXPECT_NEAR(f[1], 1.0, 1e-12);
+}
+
+TEST(CorporateActionsTest, EventsCompoundBackwards) {
+    std::vector<double> raw = {100.0, 100.0, 50.0, 50.0};
+    auto f = computeAdjustmentFactors(raw, {{1, 1.0, 1.0}, {2, 0.0, 2.0}});
+    EXPECT_NEAR(f[0], 0.99 * 0.5, 1e-12);
+    EXPECT_NEAR(f[1], 0.5, 1e-12);
+}
+
+TEST(CorporateActionsTest, EventOnFirstBarIsIgnored) {
+    auto f = computeAdjustmentFactors({100.0, 101.0}, {{0, 1.0, 2.0}});
+    EXPECT_EQ(f, std::vector<double>({1.0, 1.0}));
+}
+
+TEST(CorporateActionsTest, InvalidInputsThrow) {
+    EXPECT_THROW(computeAdjustmentFactors({1.0}, {{3, 1.0, 1.0}}), std::out_of_range);
+    EXPECT_THROW(computeAdjustmentFactors({1.0, 2.0}, {{1, 0.0, 0.0}}), std::invalid_argument);
+}
+
+TEST(AdjustedHistoryTest, IncrementalAppendMatchesFullRecompute) {
+    AdjustedHistory incremental("AAPL");
+    incremental.appendBar("2023-01-03", 100.0);
+    incremental.appendBar("2023-01-04", 101.0);
+    incremental.appendBar("2023-01-05", 100.5, 0.25);
+    incremental.appendBar("2023-01-06", 50.0, 0.0, 2.0);
+    incremental.appendBar("2023-01-09", 51.0);
+
+    AdjustedHistory full("AAPL", incremental.getDates(), incremental.getRawCloses(), incremental.getActions());
+
+    auto a = incremental.getAdjustedCloses();
+    auto b = full.getAdjustedCloses();
+    ASSERT_EQ(a.size(), b.size());
+    for (size_t i = 0; i < a.size(); ++i)
+        EXPECT_NEAR(a[i], b[i], 1e-12);
+    EXPECT_NEAR(a.back(), 51.0, 1e-12); // latest bar is never adjusted
+}
+
+TEST(AdjustedHistoryTest, RevisedActionRecomputes) {
+    AdjustedHistory h("X", {"d0", "d1", "d2"}, {100.0, 100.0, 100.0}, {{1, 1.0, 1.0}});
+    EXPECT_NEAR(h.getAdjustedCloses()[0], 99.0, 1e-12);
+
+    h.setAction(1, 2.0, 1.0); // revised dividend
+    EXPECT_NEAR(h.getAdjustedCloses()[0], 98.0, 1e-12);
+
+    h.setAction(1, 0.0, 1.0); // removed
+    EXPECT_TRUE(h.getActions().empty());
+    EXPECT_NEAR(h.getAdjustedCloses()[0], 100.0, 1e-12);
+}
+
+TEST(AdjustedHistoryTest, ToPriceSeriesUsesAdjustedCloses) {
+    AdjustedHistory h("X", {"d0", "d1"}, {100.0, 50.0}, {{1, 0.0, 2.0}});
+    PriceSeries adjusted = h.toPriceSeries();
+    PriceSeries raw = h.toRawPriceSeries();
+    EXPECT_EQ(adjusted.getTicker(), "X");
+    EXPECT_NEAR(adjusted.getPrices()[0], 50.0, 1e-12);
+    EXPECT_NEAR(raw.getPrices()[0], 100.0, 1e-12);
+}
+
+TEST(AdjustedHistoryTest, MismatchedLengthsThrow) {
+    EXPECT_THROW(AdjustedHistory("X", {"d0"}, {1.0, 2.0}), std::invalid_argument);
+}
+
+TEST(AdjustedHistoryTest, RejectedEventLeavesHistoryUnchanged) {
+    AdjustedHistory h("X");
+    EXPECT_THROW(h.appendBar("d0", 100.0, 0.0, -1.0), std::invalid_argument);
+    EXPECT_TRUE(h.getDates().empty());
+
+    h.appendBar("d0", 100.0);
+    h.appendBar("d1", 100.0, 1.0);
+    EXPECT_THROW(h.appendBar("d2", 50.0, 0.0, 0.0), std::invalid_argument);
+    EXPECT_THROW(h.setAction(1, 0.0, -2.0), std::invalid_argument);
+    EXPECT_EQ(h.getDates().size(), 2u);
+    EXPECT_EQ(h.getRawCloses().size(), 2u);
+    ASSERT_EQ(h.getActions().size(), 1u);
+    EXPECT_EQ(h.getActions()[0].dividend, 1.0);
+    EXPECT_NEAR(h.getAdjustedCloses()[0], 99.0, 1e-12);
+
+    h.appendBar("d2", 50.0, 0.0, 2.0);
+    EXPECT_NEAR(h.getAdjustedCloses()[0], 49.5, 1e-12);
+}
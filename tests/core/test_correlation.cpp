@@ -1,6 +1,7 @@
 /*
 covarianceMatrix
 computeCorrelationMatrix
+computeCovarianceMatrix
 computeBeta
 computeAlpha (both overloads)
 */
@@ -74,3 +75,28 @@ TEST(CorrelationTest, ZeroVarianceAsset) {
     EXPECT_NEAR(corr[1][0], 0.0, 1e-6);
     EXPECT_NEAR(corr[0][0], 1.0, 1e-6);
 }
+
+TEST(CorrelationTest, CovarianceMatrixMatchesManual) {
+    std::vector<std::vector<double>> r = {{0.01, -0.02, 0.03, 0.00, 0.015},
+                                          {0.02, -0.01, 0.01, 0.005, 0.01, 0.4}};
+    auto cov = computeCovarianceMatrix(r);
+
+    // The second series is truncated to the common length of 5.
+    double ma = 0.007, mb = 0.007;
+    double sab = 0.0, saa = 0.0;
+    for (size_t i = 0; i < 5; ++i) {
+        sab += (r[0][i] - ma) * (r[1][i] - mb);
+        saa += (r[0][i] - ma) * (r[0][i] - ma);
+    }
+    ASSERT_EQ(cov.size(), 2);
+    EXPECT_NEAR(cov[0][0], saa / 4.0, 1e-15);
+    EXPECT_NEAR(cov[0][1], sab / 4.0, 1e-15);
+    EXPECT_DOUBLE_EQ(cov[0][1], cov[1][0]);
+
+    auto population = computeCovarianceMatrix(r, false);
+    EXPECT_NEAR(population[0][0], saa / 5.0, 1e-15);
+}
+
+TEST(CorrelationTest, CovarianceMatrixTooShortThrows) {
+    EXPECT_THROW(computeCovarianceMatrix(std::vector<std::vector<double>>{{0.01}, {0.02, 0.03}}), std::invalid_argument);
+}
@@ -2,12 +2,18 @@
 computeMaxDrawdown
 computeAverageDrawdown
 computeMaxRecoveryTime
+computeRollingMin / computeRollingMax
+computeRollingMaxDrawdown (series and panel)
+computeRollingCalmar (series and panel)
 */
 
 #include <gtest/gtest.h>
 #include "stats/drawdowns.hpp"
 #include <vector>
 #include <cmath>
+#include <algorithm>
+#include <random>
+#include <stdexcept>
 
 using namespace Stats::Drawdowns;
 
@@ -85,3 +91,82 @@ TEST(DrawdownsTest, AverageDrawdown_Empty) {
     std::vector<double> returns;
     EXPECT_NEAR(computeAverageDrawdown(returns), 0.0, 1e-6);
 }
+
+namespace {
+
+std::vector<double> randomWealth(size_t n, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::normal_distribution<double> dist(0.0002, 0.02);
+    std::vector<double> w{1.0};
+    for (size_t i = 1; i < n; ++i)
+        w.push_back(w.back() * (1.0 + dist(rng)));
+    return w;
+}
+
+std::vector<double> slice(const std::vector<double>& x, size_t start, size_t w) {
+    return std::vector<double>(x.begin() + start, x.begin() + start + w);
+}
+
+}
+
+TEST(DrawdownsTest, RollingMinMax_MatchBruteForce) {
+    std::vector<double> x = {3, 1, 4, 1, 5, 9, 2, 6, 5, 3, 5};
+    auto lo = computeRollingMin(x, 3);
+    auto hi = computeRollingMax(x, 3);
+    ASSERT_EQ(lo.size(), x.size() - 2);
+    for (size_t i = 0; i < lo.size(); ++i) {
+        auto s = slice(x, i, 3);
+        EXPECT_EQ(lo[i], *std::min_element(s.begin(), s.end()));
+        EXPECT_EQ(hi[i], *std::max_element(s.begin(), s.end()));
+    }
+    EXPECT_EQ(computeRollingMax(x, 1), x);
+    EXPECT_TRUE(computeRollingMin(x, 12).empty());
+    EXPECT_TRUE(computeRollingMin(x, 0).empty());
+}
+
+TEST(DrawdownsTest, RollingMaxDrawdown_MatchesPerWindow) {
+    auto wealth = randomWealth(700, 3);
+    for (size_t w : {1u, 2u, 7u, 63u, 252u, 700u}) {
+        auto rolling = computeRollingMaxDrawdown(wealth, w);
+        ASSERT_EQ(rolling.size(), wealth.size() - w + 1);
+        for (size_t i = 0; i < rolling.size(); ++i)
+            ASSERT_DOUBLE_EQ(rolling[i], computeMaxDrawdown(slice(wealth, i, w))) << "w=" << w << " i=" << i;
+    }
+}
+
+TEST(DrawdownsTest, RollingCalmar_MatchesPerWindow) {
+    auto wealth = randomWealth(400, 4);
+    auto calmar = computeRollingCalmar(wealth, 126, 252);
+    ASSERT_EQ(calmar.size(), 275);
+    for (size_t i = 0; i < calmar.size(); i += 17) {
+        double total = wealth[i + 125] / wealth[i] - 1.0;
+        double annual = std::pow(1.0 + total, 252.0 / 125.0) - 1.0;
+        EXPECT_NEAR(calmar[i], annual / computeMaxDrawdown(slice(wealth, i, 126)), 1e-9);
+    }
+    EXPECT_TRUE(computeRollingCalmar(wealth, 1, 252).empty());
+}
+
+TEST(DrawdownsTest, RollingPanel_MatchesSingleColumn) {
+    std::vector<std::vector<double>> panel;
+    for (unsigned c = 0; c < 11; ++c)
+        panel.push_back(randomWealth(300, 10 + c));
+
+    auto mdd = computeRollingMaxDrawdown(panel, 60);
+    auto calmar = computeRollingCalmar(panel, 60, 252);
+    ASSERT_EQ(mdd.size(), panel.size());
+    for (size_t c = 0; c < panel.size(); ++c) {
+        EXPECT_EQ(mdd[c], computeRollingMaxDrawdown(panel[c], 60));
+        EXPECT_EQ(calmar[c], computeRollingCalmar(panel[c], 60, 252));
+    }
+
+    panel[3].pop_back();
+    EXPECT_THROW(computeRollingMaxDrawdown(panel, 60), std::invalid_argument);
+}
+
+TEST(DrawdownsTest, RollingMaxDrawdown_Float) {
+    auto wealth = randomWealth(200, 5);
+    std::vector<float> wf(wealth.begin(), wealth.end());
+    auto rolling = computeRollingMaxDrawdown(wf, 50);
+    for (size_t i = 0; i < rolling.size(); ++i)
+        EXPECT_FLOAT_EQ(rolling[i], computeMaxDrawdown(std::vector<float>(wf.begin() + i, wf.begin() + i + 50)));
+}
@@ -0,0 +1,187 @@
+/*
+correlationDistance
+cluster
+quasiDiagonalOrder
+recursiveBisectionWeights
+computeHRPWeights (both overloads)
+*/
+
+#include <gtest/gtest.h>
+#include <TestHelpers.hpp>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "stats/hrp.hpp"
+
+using namespace Stats::HRP;
+
+namespace {
+
+using Matrix = std::vector<std::vector<double>>;
+
+Matrix lineDistances(const std::vector<double>& x) {
+    Matrix d(x.size(), std::vector<double>(x.size()));
+    for (size_t i = 0; i < x.size(); ++i)
+        for (size_t j = 0; j < x.size(); ++j)
+            d[i][j] = std::abs(x[i] - x[j]);
+    return d;
+}
+
+// O(N^3) reference: repeatedly merge the closest pair of live clusters.
+std::vector<double> naiveMergeDistances(Matrix d, Linkage linkage) {
+    const size_t n = d.size();
+    std::vector<double> size(n, 1.0), out;
+    std::vector<bool> live(n, true);
+    for (size_t step = 0; step + 1 < n; ++step) {
+        size_t a = 0, b = 0;
+        double best = std::numeric_limits<double>::infinity();
+        for (size_t i = 0; i < n; ++i)
+            for (size_t j = i + 1; j < n; ++j)
+                if (live[i] && live[j] && d[i][j] < best) {
+                    best = d[i][j];
+                    a = i;
+                    b = j;
+                }
+        out.push_back(best);
+        for (size_t c = 0; c < n; ++c) {
+            if (!live[c] || c == a || c == b)
+                continue;
+            double v = linkage == Linkage::Single ? std::min(d[a][c], d[b][c])
+                                                  : (size[a] * d[a][c] + size[b] * d[b][c]) / (size[a] + size[b]);
+            d[a][c] = d[c][a] = v;
+        }
+        live[b] = false;
+        size[a] += size[b];
+    }
+    return out;
+}
+
+// Two blocks of assets: strongly correlated within a block, weakly across.
+Matrix blockCorrelation(size_t n) {
+    Matrix c(n, std::vector<double>(n));
+    for (size_t i = 0; i < n; ++i)
+        for (size_t j = 0; j < n; ++j)
+            c[i][j] = i == j ? 1.0 : (i % 2 == j % 2 ? 0.8 : 0.1);
+    return c;
+}
+
+}
+
+TEST(HRPTest, CorrelationDistance) {
+    auto d = correlationDistance({{1.0, -1.0, 0.0}, {-1.0, 1.0, 0.5}, {0.0, 0.5, 1.0}});
+    EXPECT_DOUBLE_EQ(d[0][0], 0.0);
+    EXPECT_DOUBLE_EQ(d[0][1], 1.0);
+    EXPECT_DOUBLE_EQ(d[0][2], std::sqrt(0.5));
+    EXPECT_DOUBLE_EQ(d[1][2], 0.5);
+}
+
+TEST(HRPTest, SingleLinkageOnLine) {
+    auto tree = cluster(lineDistances({0.0, 1.0, 3.0, 7.0}), Linkage::Single);
+    ASSERT_EQ(tree.merges.size(), 3);
+    EXPECT_EQ(tree.merges[0].left, 0);
+    EXPECT_EQ(tree.merges[0].right, 1);
+    EXPECT_DOUBLE_EQ(tree.merges[0].distance, 1.0);
+    EXPECT_EQ(tree.merges[1].left, 2);
+    EXPECT_EQ(tree.merges[1].right, 4);
+    EXPECT_DOUBLE_EQ(tree.merges[1].distance, 2.0);
+    EXPECT_EQ(tree.merges[2].left, 3);
+    EXPECT_EQ(tree.merges[2].right, 5);
+    EXPECT_DOUBLE_EQ(tree.merges[2].distance, 4.0);
+    EXPECT_EQ(tree.merges[2].size, 4);
+}
+
+TEST(HRPTest, AverageLinkageOnLine) {
+    auto tree = cluster(lineDistances({0.0, 1.0, 3.0, 7.0}), Linkage::Average);
+    ASSERT_EQ(tree.merges.size(), 3);
+    EXPECT_DOUBLE_EQ(tree.merges[1].distance, 2.5);
+    EXPECT_DOUBLE_EQ(tree.merges[2].distance, 17.0 / 3.0);
+}
+
+TEST(HRPTest, NearestNeighbourChainMatchesNaiveLinkage) {
+    std::mt19937 rng(5);
+    std::uniform_real_distribution<double> coord(0.0, 1.0);
+    std::vector<std::array<double, 3>> points(40);
+    for (auto& p : points)
+        p = {coord(rng), coord(rng), coord(rng)};
+    Matrix d(points.size(), std::vector<double>(points.size()));
+    for (size_t i = 0; i < points.size(); ++i)
+        for (size_t j = 0; j < points.size(); ++j)
+            d[i][j] = std::hypot(points[i][0] - points[j][0], points[i][1] - points[j][1], points[i][2] - points[j][2]);
+
+    for (Linkage linkage : {Linkage::Single, Linkage::Average}) {
+        auto tree = cluster(d, linkage);
+        auto expected = naiveMergeDistances(d, linkage);
+        ASSERT_EQ(tree.merges.size(), expected.size());
+        for (size_t i = 0; i < expected.size(); ++i)
+            EXPECT_NEAR(tree.merges[i].distance, expected[i], 1e-12);
+        EXPECT_EQ(tree.merges.back().size, points.size());
+    }
+}
+
+TEST(HRPTest, QuasiDiagonalOrderGroupsBlocks) {
+    auto order = quasiDiagonalOrder(cluster(correlationDistance(blockCorrelation(10)), Linkage::Average));
+
+    std::vector<size_t> sorted = order;
+    std::sort(sorted.begin(), sorted.end());
+    std::vector<size_t> all(10);
+    std::iota(all.begin(), all.end(), 0);
+    EXPECT_EQ(sorted, all);
+
+    // Each parity block is contiguous, so parity changes exactly once.
+    int changes = 0;
+    for (size_t i = 1; i < order.size(); ++i)
+        changes += (order[i] % 2) != (order[i - 1] % 2);
+    EXPECT_EQ(changes, 1);
+}
+
+TEST(HRPTest, BisectionOnDiagonalCovarianceIsInverseVariance) {
+    auto w = recursiveBisectionWeights({{1.0, 0.0}, {0.0, 4.0}}, {0, 1});
+    EXPECT_NEAR(w[0], 0.8, 1e-12);
+    EXPECT_NEAR(w[1], 0.2, 1e-12);
+}
+
+TEST(HRPTest, WeightsArePositiveAndSumToOne) {
+    const size_t n = 12;
+    Matrix corr = blockCorrelation(n);
+    Matrix cov(n, std::vector<double>(n));
+    for (size_t i = 0; i < n; ++i)
+        for (size_t j = 0; j < n; ++j)
+            cov[i][j] = corr[i][j] * 0.01 * (1.0 + 0.1 * i) * 0.01 * (1.0 + 0.1 * j);
+
+    for (Linkage linkage : {Linkage::Single, Linkage::Average}) {
+        auto w = computeHRPWeights(cov, corr, linkage);
+        ASSERT_EQ(w.size(), n);
+        EXPECT_NEAR(std::accumulate(w.begin(), w.end(), 0.0), 1.0, 1e-12);
+        for (double x : w)
+            EXPECT_GT(x, 0.0);
+        // Lower-volatility assets get more weight within a block.
+        EXPECT_GT(w[0], w[10]);
+    }
+}
+
+TEST(HRPTest, WeightsFromPriceSeries) {
+    std::vector<PriceSeries> assets = {generateRandomWalkSeries("A", 300, 100.0, 0.0002, 0.01, 1),
+                                       generateRandomWalkSeries("B", 300, 100.0, 0.0002, 0.02, 2),
+                                       generateRandomWalkSeries("C", 300, 100.0, 0.0002, 0.015, 3)};
+    auto w = computeHRPWeights(assets);
+    ASSERT_EQ(w.size(), 3);
+    EXPECT_NEAR(std::accumulate(w.begin(), w.end(), 0.0), 1.0, 1e-12);
+}
+
+TEST(HRPTest, SingleAssetGetsFullWeight) {
+    EXPECT_EQ(computeHRPWeights({{0.04}}, {{1.0}}), std::vector<double>({1.0}));
+}
+
+TEST(HRPTest, InvalidInputsThrow) {
+    EXPECT_THROW(cluster({}), std::invalid_argument);
+    EXPECT_THROW(cluster({{0.0, 1.0}, {1.0}}), std::invalid_argument);
+    EXPECT_THROW(recursiveBisectionWeights({{1.0, 0.0}, {0.0, 1.0}}, {0}), std::invalid_argument);
+    EXPECT_THROW(recursiveBisectionWeights({{0.0, 0.0}, {0.0, 1.0}}, {0, 1}), std::invalid_argument);
+    EXPECT_THROW(computeHRPWeights({{1.0}}, {{1.0, 0.0}, {0.0, 1.0}}), std::invalid_argument);
+}
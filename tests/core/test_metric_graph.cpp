@@ -0,0 +1,280 @@
+/*
+MetricGraph::Graph::add / emplace (dependency order, duplicate and unknown inputs)
+MetricGraph::Graph::append / update (incremental results match the batch functions)
+MetricGraph::Returns / WealthIndex / RollingVolatility / DrawdownState / Covariance
+MetricGraph::Graph::saveCheckpoint / loadCheckpoint (resume, mismatches, damage)
+*/
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <TestHelpers.hpp>
+
+#include "core/metric_graph.hpp"
+#include "stats/correlation.hpp"
+#include "stats/drawdowns.hpp"
+#include "stats/volatility.hpp"
+#include "utils/timestamp.hpp"
+
+namespace fs = std::filesystem;
+using namespace MetricGraph;
+
+namespace {
+
+constexpr int64_t kFirstDay = 19000;
+
+std::vector<std::string> tickers(size_t n) {
+    std::vector<std::string> out;
+    for (size_t i = 0; i < n; ++i) {
+        std::string s = "T";
+        s += std::to_string(i);
+        out.push_back(s);
+    }
+    return out;
+}
+
+std::vector<PriceSeries> panel(size_t n, size_t length) {
+    std::vector<PriceSeries> out;
+    for (size_t i = 0; i < n; ++i)
+        out.push_back(generateRandomWalkSeries("T" + std::to_string(i), length, 50.0 + static_cast<double>(i), 0.0003,
+                                               0.012 + 0.002 * static_cast<double>(i), 100 + static_cast<unsigned>(i)));
+    return out;
+}
+
+void feed(Graph& graph, const std::vector<PriceSeries>& series, size_t from, size_t to) {
+    std::vector<double> closes(series.size());
+    for (size_t t = from; t < to; ++t) {
+        for (size_t i = 0; i < series.size(); ++i)
+            closes[i] = series[i].getPrices()[t];
+        graph.append(kFirstDay + static_cast<int64_t>(t), closes);
+    }
+}
+
+void expectNear(double actual, double expected) {
+    EXPECT_NEAR(actual, expected, 1e-12 * std::max(1.0, std::abs(expected)));
+}
+
+std::string checkpointPath(const char* name) {
+    return (fs::temp_directory_path() / name).string();
+}
+
+}
+
+TEST(MetricGraphTest, NodesNeedTheirInputsFirst) {
+    Graph g(tickers(2));
+    EXPECT_THROW(g.emplace<WealthIndex>(), std::invalid_argument);  // no "returns" yet
+    g.emplace<Returns>();
+    EXPECT_THROW(g.emplace<Returns>(), std::invalid_argument);      // duplicate name
+    g.emplace<WealthIndex>();
+    EXPECT_THROW(g.emplace<RollingVolatility>("vol", 1), std::invalid_argument);
+    EXPECT_THROW(g.node("vol"), std::invalid_argument);
+    EXPECT_THROW(g.get<Covariance>("wealth"), std::invalid_argument);
+    EXPECT_THROW(Graph({}), std::invalid_argument);
+
+    ASSERT_EQ(g.nodes().size(), 3u);
+    EXPECT_EQ(g.nodes()[0]->name(), "prices");
+    EXPECT_EQ(g.node("wealth").inputs(), std::vector<std::string>{"returns"});
+
+    g.append(kFirstDay, {10.0, 20.0});
+    EXPECT_THROW(g.emplace<DrawdownState>(), std::invalid_argument);  // graph already has bars
+}
+
+TEST(MetricGraphTest, AppendRejectsBadBarsWithoutChangingState) {
+    Graph g = Graph::standard(tickers(2), {3});
+    g.append(kFirstDay, {10.0, 20.0});
+    g.append(kFirstDay + 1, {11.0, 19.0});
+    EXPECT_THROW(g.append(kFirstDay + 2, {11.0}), std::invalid_argument);
+    EXPECT_THROW(g.append(kFirstDay + 1, {11.0, 19.0}), std::invalid_argument);
+    EXPECT_THROW(g.append(kFirstDay + 2, {11.0, 0.0}), std::invalid_argument);
+    EXPECT_THROW(g.append(kFirstDay + 2, {NAN, 19.0}), std::invalid_argument);
+
+    EXPECT_EQ(g.bars(), 2u);
+    EXPECT_EQ(g.lastDay(), kFirstDay + 1);
+    expectNear(g.values("returns")[0], 0.1);
+    expectNear(g.values("wealth")[1], 0.95);
+}
+
+TEST(MetricGraphTest, IncrementalMatchesBatch) {
+    const size_t n = 6, length = 400, window = 21;
+    const auto series = panel(n, length);
+    Graph g = Graph::standard(tickers(n), {window}, true);
+
+    std::vector<std::vector<double>> returns(n);
+    for (size_t i = 0; i < n; ++i)
+        returns[i] = series[i].getDailyReturns();
+
+    std::vector<std::vector<double>> wealth(n, std::vector<double>{1.0});
+    for (size_t t = 0; t < length; ++t) {
+        feed(g, series, t, t + 1);
+        EXPECT_EQ(g.node("returns").ready(), t >= 1);
+        EXPECT_EQ(g.node("rolling_vol_21").ready(), t >= window);
+        if (t == 0)
+            continue;
+
+        for (size_t i = 0; i < n; ++i) {
+            expectNear(g.values("returns")[i], returns[i][t - 1]);
+            wealth[i].push_back(wealth[i].back() * (1.0 + returns[i][t - 1]));
+            expectNear(g.values("wealth")[i], wealth[i].back());
+            expectNear(g.values("drawdown")[i], Stats::Drawdowns::computeMaxDrawdown(wealth[i]));
+        }
+        if (t % 37 == 0 && t >= window) {
+            for (size_t i = 0; i < n; ++i) {
+                std::vector<double> seen(returns[i].begin(), returns[i].begin() + static_cast<long>(t));
+                expectNear(g.values("rolling_vol_21")[i], Stats::Volatility::computeRollingVolatility(seen, window).back());
+            }
+        }
+    }
+
+    const auto& dd = g.get<DrawdownState>("drawdown");
+    for (size_t i = 0; i < n; ++i) {
+        double peak = 0.0;
+        for (double w : wealth[i])
+            peak = std::max(peak, w);
+        expectNear(dd.peak()[i], peak);
+        expectNear(dd.current()[i], (peak - wealth[i].back()) / peak);
+    }
+
+    const auto& cov = g.get<Covariance>("covariance");
+    EXPECT_EQ(cov.count(), length - 1);
+    const auto expected = Stats::Correlation::computeCovarianceMatrix(returns, true);
+    const auto actual = cov.matrix();
+    for (size_t i = 0; i < n; ++i) {
+        expectNear(cov.values()[i], expected[i][i]);
+        for (size_t j = 0; j < n; ++j)
+            EXPECT_NEAR(actual[i][j], expected[i][j], 1e-15);
+    }
+}
+
+TEST(MetricGraphTest, RollingVolatilityOfConstantReturnsIsZero) {
+    Graph g(tickers(1));
+    g.emplace<Returns>();
+    g.emplace<RollingVolatility>("vol", 5);
+    double p = 100.0;
+    for (int t = 0; t < 40; ++t, p *= 1.01)
+        g.append(kFirstDay + t, {p});
+    EXPECT_NEAR(g.values("vol")[0], 0.0, 1e-15);
+}
+
+TEST(MetricGraphTest, UpdateAppendsOnlyNewDates) {
+    const size_t n = 3, length = 60;
+    auto raw = panel(n, length);
+    std::vector<std::string> dates;
+    for (size_t t = 0; t < length; ++t)
+        dates.push_back(Timestamp::formatIsoMillis((kFirstDay + static_cast<int64_t>(2 * t)) * 86400000LL,
+                                                   Timestamp::Format::DateOnly));
+    std::vector<PriceSeries> dated;
+    for (const auto& s : raw)
+        dated.emplace_back(s.getTicker(), dates, s.getPrices());
+
+    Graph g = Graph::standard(tickers(n), {10});
+    std::vector<PriceSeries> head;
+    for (const auto& s : dated)
+        head.emplace_back(s.getTicker(), std::vector<std::string>(dates.begin(), dates.begin() + 40),
+                          std::vector<double>(s.getPrices().begin(), s.getPrices().begin() + 40));
+    EXPECT_EQ(g.update(head), 40u);
+    EXPECT_EQ(g.update(dated), 20u);
+    EXPECT_EQ(g.update(dated), 0u);
+    EXPECT_EQ(g.bars(), length);
+    EXPECT_EQ(g.lastDay(), kFirstDay + 2 * static_cast<int64_t>(length - 1));
+
+    Graph whole = Graph::standard(tickers(n), {10});
+    feed(whole, raw, 0, length);
+    for (const char* name : {"returns", "wealth", "drawdown", "rolling_vol_10"})
+        EXPECT_EQ(g.values(name), whole.values(name)) << name;
+
+    std::vector<PriceSeries> wrongOrder = {dated[1], dated[0], dated[2]};
+    EXPECT_THROW(g.update(wrongOrder), std::invalid_argument);
+}
+
+TEST(MetricGraphTest, CheckpointResumesExactly) {
+    const size_t n = 4, length = 300;
+    const auto series = panel(n, length);
+    const std::string path = checkpointPath("tradeiq_metric_graph.ckpt");
+
+    Graph uninterrupted = Graph::standard(tickers(n), {21, 63}, true);
+    feed(uninterrupted, series, 0, length);
+
+    {
+        Graph first = Graph::standard(tickers(n), {21, 63}, true);
+        feed(first, series, 0, 170);
+        first.saveCheckpoint(path);
+    }
+    Graph resumed = Graph::standard(tickers(n), {21, 63}, true);
+    resumed.loadCheckpoint(path);
+    EXPECT_EQ(resumed.bars(), 170u);
+    EXPECT_EQ(resumed.lastDay(), kFirstDay + 169);
+    feed(resumed, series, 170, length);
+
+    for (const auto& node : uninterrupted.nodes()) {
+        EXPECT_EQ(resumed.node(node->name()).ready(), node->ready()) << node->name();
+        EXPECT_EQ(resumed.values(node->name()), node->values()) << node->name();
+    }
+    EXPECT_EQ(resumed.get<Covariance>("covariance").matrix(), uninterrupted.get<Covariance>("covariance").matrix());
+    EXPECT_EQ(resumed.get<DrawdownState>("drawdown").current(), uninterrupted.get<DrawdownState>("drawdown").current());
+    fs::remove(path);
+}
+
+TEST(MetricGraphTest, CheckpointMismatchLeavesGraphUnchanged) {
+    const auto series = panel(3, 50);
+    const std::string path = checkpointPath("tradeiq_metric_graph_mismatch.ckpt");
+    {
+        Graph g = Graph::standard(tickers(3), {5, 10});
+        feed(g, series, 0, 50);
+        g.saveCheckpoint(path);
+    }
+
+    Graph otherWindow(tickers(3));
+    otherWindow.emplace<Returns>();
+    otherWindow.emplace<WealthIndex>();
+    otherWindow.emplace<DrawdownState>();
+    otherWindow.emplace<RollingVolatility>("rolling_vol_5", 5);
+    otherWindow.emplace<RollingVolatility>("rolling_vol_10", 11);
+    feed(otherWindow, series, 0, 20);
+    const auto before = otherWindow.values("rolling_vol_5");
+    EXPECT_THROW(otherWindow.loadCheckpoint(path), std::runtime_error);
+    EXPECT_EQ(otherWindow.bars(), 20u);
+    EXPECT_EQ(otherWindow.values("rolling_vol_5"), before);
+    feed(otherWindow, series, 20, 21);  // still usable
+
+    Graph fewerTickers = Graph::standard(tickers(2), {5, 10});
+    EXPECT_THROW(fewerTickers.loadCheckpoint(path), std::runtime_error);
+    Graph fewerNodes = Graph::standard(tickers(3), {5});
+    EXPECT_THROW(fewerNodes.loadCheckpoint(path), std::runtime_error);
+    fs::remove(path);
+}
+
+TEST(MetricGraphTest, DamagedCheckpointIsRejected) {
+    const std::string path = checkpointPath("tradeiq_metric_graph_damaged.ckpt");
+    {
+        Graph g = Graph::standard(tickers(2), {5});
+        feed(g, panel(2, 30), 0, 30);
+        g.saveCheckpoint(path);
+    }
+    std::string bytes;
+    {
+        std::ifstream in(path, std::ios::binary);
+        bytes.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+    auto rewrite = [&](const std::string& content) {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out.write(content.data(), static_cast<std::streamsize>(content.size()));
+    };
+
+    Graph g = Graph::standard(tickers(2), {5});
+    std::string flipped = bytes;
+    flipped[bytes.size() / 2] ^= 0x40;
+    rewrite(flipped);
+    EXPECT_THROW(g.loadCheckpoint(path), std::runtime_error);
+    rewrite(bytes.substr(0, bytes.size() - 3));
+    EXPECT_THROW(g.loadCheckpoint(path), std::runtime_error);
+    rewrite("TIQM");
+    EXPECT_THROW(g.loadCheckpoint(path), std::runtime_error);
+    fs::remove(path);
+    EXPECT_THROW(g.loadCheckpoint(path), std::runtime_error);
+    EXPECT_EQ(g.bars(), 0u);
+}
@@ -0,0 +1,103 @@
+/*
+Moments::summarize
+Moments::variance / skewness / excessKurtosis (Population, Sample, Unbiased)
+Wrappers: Stats::Utils, Stats::Distribution, MathUtils
+*/
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "stats/distribution.hpp"
+#include "stats/moments.hpp"
+#include "stats/utils.hpp"
+#include "utils/math_utils.hpp"
+
+using namespace Stats::Moments;
+
+namespace {
+
+const std::vector<double> kData = {0.02, -0.01, 0.03, 0.05, -0.04, 0.01, 0.0, -0.02};
+
+}
+
+TEST(MomentsTest, SummaryMatchesDefinition) {
+    auto s = summarize<4>(kData);
+    double mean = 0.0;
+    for (double x : kData)
+        mean += x;
+    mean /= kData.size();
+
+    double m2 = 0, m3 = 0, m4 = 0;
+    for (double x : kData) {
+        m2 += std::pow(x - mean, 2);
+        m3 += std::pow(x - mean, 3);
+        m4 += std::pow(x - mean, 4);
+    }
+    EXPECT_EQ(s.count, kData.size());
+    EXPECT_FALSE(s.constant);
+    EXPECT_NEAR(s.mean, mean, 1e-15);
+    EXPECT_NEAR(s.m2, m2, 1e-15);
+    EXPECT_NEAR(s.m3, m3, 1e-15);
+    EXPECT_NEAR(s.m4, m4, 1e-15);
+}
+
+TEST(MomentsTest, ConstantInputDetectedWithoutVariancePass) {
+    std::vector<double> same(1000, 0.1);
+    auto s = summarize<4>(same);
+    EXPECT_TRUE(s.constant);
+    EXPECT_EQ(s.mean, 0.1);
+    EXPECT_EQ(s.m2, 0.0);
+
+    EXPECT_TRUE(summarize<2>(std::vector<double>{}).constant);
+    EXPECT_FALSE(summarize<2>(std::vector<double>{1.0, 1.0, 1.0 + 1e-15}).constant);
+}
+
+TEST(MomentsTest, EstimatorsDifferOnlyInNormalization) {
+    auto s = summarize<4>(kData);
+    const double n = static_cast<double>(kData.size());
+
+    EXPECT_NEAR(variance(s, Estimator::Sample), variance(s, Estimator::Population) * n / (n - 1), 1e-15);
+    EXPECT_DOUBLE_EQ(variance(s, Estimator::Unbiased), variance(s, Estimator::Sample));
+
+    double g1 = skewness(s, Estimator::Population);
+    double G1 = skewness(s, Estimator::Unbiased);
+    EXPECT_NEAR(G1, g1 * std::sqrt(n * (n - 1)) / (n - 2), 1e-12);
+
+    double g2 = excessKurtosis(s, Estimator::Population);
+    double G2 = excessKurtosis(s, Estimator::Unbiased);
+    EXPECT_NEAR(G2, ((n + 1) * g2 + 6) * (n - 1) / ((n - 2) * (n - 3)), 1e-12);
+}
+
+TEST(MomentsTest, FloatInstantiation) {
+    std::vector<float> data(kData.begin(), kData.end());
+    auto sf = summarize<4>(data);
+    auto sd = summarize<4>(kData);
+    EXPECT_NEAR(skewness(sf, Estimator::Population), skewness(sd, Estimator::Population), 1e-4);
+}
+
+TEST(MomentsTest, WrappersKeepTheirNormalizations) {
+    auto s = summarize<4>(kData);
+    EXPECT_DOUBLE_EQ(Stats::Utils::computeSkewness(kData), skewness(s, Estimator::Population));
+    EXPECT_DOUBLE_EQ(Stats::Distribution::computeSkewness(kData), skewness(s, Estimator::Unbiased));
+    EXPECT_DOUBLE_EQ(Stats::Utils::computeKurtosis(kData), excessKurtosis(s, Estimator::Population));
+    EXPECT_DOUBLE_EQ(Stats::Distribution::computeKurtosis(kData), excessKurtosis(s, Estimator::Population));
+    EXPECT_NEAR(MathUtils::skewness(kData), skewness(s, Estimator::Unbiased), 1e-12);
+    EXPECT_DOUBLE_EQ(MathUtils::variance(kData, true), variance(s, Estimator::Sample));
+    EXPECT_DOUBLE_EQ(MathUtils::variance(kData), variance(s, Estimator::Population));
+}
+
+TEST(MomentsTest, WrappersKeepTheirExceptions) {
+    std::vector<double> same(10, 0.3);
+    EXPECT_THROW(Stats::Utils::computeSkewness(same), std::invalid_argument);
+    EXPECT_THROW(Stats::Distribution::computeSkewness(same), std::invalid_argument);
+    EXPECT_THROW(Stats::Distribution::computeSkewness({}), std::invalid_argument);
+    EXPECT_THROW(Stats::Distribution::computeSkewness({1.0}), std::invalid_argument);
+    EXPECT_TRUE(std::isnan(Stats::Utils::computeKurtosis(same)));
+    EXPECT_TRUE(std::isnan(Stats::Distribution::computeKurtosis(same)));
+    EXPECT_TRUE(std::isnan(MathUtils::skewness(same)));
+    EXPECT_EQ(MathUtils::variance(same, true), 0.0);
+    EXPECT_THROW(MathUtils::variance({1.0}, true), std::invalid_argument);
+    EXPECT_THROW(MathUtils::kurtosis({1.0, 2.0, 3.0}), std::invalid_argument);
+}
@@ -0,0 +1,156 @@
+/*
+decompose
+decomposeTopK
+riskContributions
+componentRiskContributions
+*/
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "stats/correlation.hpp"
+#include "stats/pca.hpp"
+
+using namespace Stats::PCA;
+
+namespace {
+
+using Matrix = std::vector<std::vector<double>>;
+
+// Sample covariance of a factor model: k factors with decaying volatility plus
+// idiosyncratic noise, so the spectrum has k clear leading eigenvalues.
+Matrix factorCovariance(size_t n, size_t k, size_t t, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::normal_distribution<double> dist(0.0, 1.0);
+    Matrix loadings(n, std::vector<double>(k));
+    for (auto& row : loadings)
+        for (auto& x : row)
+            x = dist(rng);
+
+    Matrix returns(n, std::vector<double>(t));
+    std::vector<double> f(k);
+    for (size_t s = 0; s < t; ++s) {
+        for (size_t j = 0; j < k; ++j)
+            f[j] = 0.02 * dist(rng) / static_cast<double>(j + 1);
+        for (size_t i = 0; i < n; ++i) {
+            double r = 0.002 * dist(rng);
+            for (size_t j = 0; j < k; ++j)
+                r += loadings[i][j] * f[j];
+            returns[i][s] = r;
+        }
+    }
+    return Stats::Correlation::computeCovarianceMatrix(returns);
+}
+
+double portfolioVariance(const Matrix& cov, const std::vector<double>& w) {
+    double v = 0.0;
+    for (size_t i = 0; i < w.size(); ++i)
+        for (size_t j = 0; j < w.size(); ++j)
+            v += w[i] * cov[i][j] * w[j];
+    return v;
+}
+
+void expectEigenPairs(const Matrix& cov, const Decomposition& d, double tol) {
+    const size_t n = cov.size();
+    for (size_t c = 0; c < d.components(); ++c) {
+        double norm = 0.0;
+        for (size_t i = 0; i < n; ++i) {
+            double av = 0.0;
+            for (size_t j = 0; j < n; ++j)
+                av += cov[i][j] * d.loadings[j][c];
+            EXPECT_NEAR(av, d.eigenvalues[c] * d.loadings[i][c], tol * d.eigenvalues[0]);
+            norm += d.loadings[i][c] * d.loadings[i][c];
+        }
+        EXPECT_NEAR(norm, 1.0, 1e-10);
+    }
+}
+
+}
+
+TEST(PCATest, TwoByTwoClosedForm) {
+    Matrix cov = {{2.0, 1.0}, {1.0, 2.0}};
+    auto d = decompose(cov);
+
+    ASSERT_EQ(d.components(), 2);
+    EXPECT_NEAR(d.eigenvalues[0], 3.0, 1e-12);
+    EXPECT_NEAR(d.eigenvalues[1], 1.0, 1e-12);
+    EXPECT_NEAR(d.loadings[0][0], std::sqrt(0.5), 1e-12);
+    EXPECT_NEAR(d.loadings[1][0], std::sqrt(0.5), 1e-12);
+    EXPECT_NEAR(d.totalVariance, 4.0, 1e-12);
+    EXPECT_NEAR(d.explainedVarianceRatio[0], 0.75, 1e-12);
+}
+
+TEST(PCATest, FullDecompositionSatisfiesEigenEquation) {
+    Matrix cov = factorCovariance(40, 3, 500, 1);
+    auto d = decompose(cov);
+
+    expectEigenPairs(cov, d, 1e-10);
+    for (size_t c = 1; c < d.components(); ++c)
+        EXPECT_GE(d.eigenvalues[c - 1], d.eigenvalues[c]);
+    double ratios = std::accumulate(d.explainedVarianceRatio.begin(), d.explainedVarianceRatio.end(), 0.0);
+    EXPECT_NEAR(ratios, 1.0, 1e-10);
+    // Covariance is positive semi-definite.
+    EXPECT_GT(d.eigenvalues.back(), -1e-15);
+}
+
+TEST(PCATest, TopKMatchesFullDecomposition) {
+    Matrix cov = factorCovariance(80, 5, 400, 2);
+    auto full = decompose(cov);
+    auto top = decomposeTopK(cov, 5);
+
+    ASSERT_EQ(top.components(), 5);
+    ASSERT_EQ(top.loadings.size(), 80);
+    EXPECT_NEAR(top.totalVariance, full.totalVariance, 1e-15);
+    for (size_t c = 0; c < 5; ++c) {
+        EXPECT_NEAR(top.eigenvalues[c], full.eigenvalues[c], 1e-8 * full.eigenvalues[0]);
+        EXPECT_NEAR(top.explainedVarianceRatio[c], full.explainedVarianceRatio[c], 1e-8);
+        for (size_t i = 0; i < 80; ++i)
+            EXPECT_NEAR(top.loadings[i][c], full.loadings[i][c], 1e-5);
+    }
+    expectEigenPairs(cov, top, 1e-6);
+}
+
+TEST(PCATest, TopKFallsBackToFullOnSmallMatrices) {
+    Matrix cov = {{4.0, 1.0, 0.0}, {1.0, 3.0, 0.5}, {0.0, 0.5, 1.0}};
+    auto full = decompose(cov);
+    auto top = decomposeTopK(cov, 2);
+
+    ASSERT_EQ(top.components(), 2);
+    ASSERT_EQ(top.loadings[0].size(), 2);
+    EXPECT_DOUBLE_EQ(top.eigenvalues[0], full.eigenvalues[0]);
+    EXPECT_DOUBLE_EQ(top.eigenvalues[1], full.eigenvalues[1]);
+}
+
+TEST(PCATest, RiskContributionsSumToVolatility) {
+    Matrix cov = factorCovariance(30, 2, 300, 3);
+    std::vector<double> w(30);
+    for (size_t i = 0; i < w.size(); ++i)
+        w[i] = (i % 3 == 0 ? -0.5 : 1.0) / 30.0;
+
+    auto rc = riskContributions(cov, w);
+    double vol = std::sqrt(portfolioVariance(cov, w));
+    EXPECT_NEAR(std::accumulate(rc.begin(), rc.end(), 0.0), vol, 1e-12);
+
+    // Component contributions of a full decomposition sum to the variance.
+    auto cc = componentRiskContributions(decompose(cov), w);
+    EXPECT_NEAR(std::accumulate(cc.begin(), cc.end(), 0.0), vol * vol, 1e-12);
+}
+
+TEST(PCATest, ZeroWeightsGiveZeroContributions) {
+    Matrix cov = {{1.0, 0.0}, {0.0, 1.0}};
+    auto rc = riskContributions(cov, {0.0, 0.0});
+    EXPECT_EQ(rc, std::vector<double>({0.0, 0.0}));
+}
+
+TEST(PCATest, InvalidInputsThrow) {
+    Matrix ragged = {{1.0, 0.0}, {0.0}};
+    EXPECT_THROW(decompose(ragged), std::invalid_argument);
+    EXPECT_THROW(decomposeTopK({{1.0}}, 0), std::invalid_argument);
+    EXPECT_THROW(decomposeTopK({{1.0}}, 2), std::invalid_argument);
+    EXPECT_THROW(riskContributions({{1.0}}, {0.5, 0.5}), std::invalid_argument);
+    EXPECT_THROW(componentRiskContributions(decompose({{1.0}}), {0.5, 0.5}), std::invalid_argument);
+}
@@ -0,0 +1,129 @@
+/*
+RollingOrderStatistics
+computeRollingQuantile
+computeRollingQuantiles
+computeRollingMedian
+computeRollingVaR
+computeRollingCVaR
+computeRollingPercentileRank
+*/
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "stats/quantiles.hpp"
+#include "utils/math_utils.hpp"
+
+using namespace Stats::Quantiles;
+
+namespace {
+
+std::vector<double> makeReturns(size_t n, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::normal_distribution<double> dist(0.0003, 0.01);
+    std::vector<double> r(n);
+    for (auto& x : r)
+        x = dist(rng);
+    // Rounded so windows contain ties.
+    for (size_t i = 0; i < n; i += 7)
+        r[i] = 0.001;
+    return r;
+}
+
+std::vector<double> window(const std::vector<double>& x, size_t start, size_t w) {
+    return std::vector<double>(x.begin() + start, x.begin() + start + w);
+}
+
+}
+
+TEST(QuantilesTest, OrderStatisticsTrackInsertAndEvict) {
+    std::vector<double> x = {5.0, 1.0, 4.0, 1.0, 3.0};
+    RollingOrderStatistics<double> s{std::span<const double>(x)};
+    for (size_t i = 0; i < x.size(); ++i)
+        s.insert(i);
+    EXPECT_EQ(s.size(), 5);
+    EXPECT_DOUBLE_EQ(s.kth(0), 1.0);
+    EXPECT_DOUBLE_EQ(s.kth(1), 1.0);
+    EXPECT_DOUBLE_EQ(s.kth(4), 5.0);
+    EXPECT_EQ(s.countAtOrBelow(1.0), 2);
+    EXPECT_EQ(s.countAtOrBelow(3.5), 3);
+
+    s.evict(1);
+    s.evict(0);
+    EXPECT_EQ(s.size(), 3);
+    EXPECT_DOUBLE_EQ(s.kth(0), 1.0);
+    EXPECT_DOUBLE_EQ(s.kth(2), 4.0);
+    EXPECT_THROW(s.kth(3), std::out_of_range);
+}
+
+TEST(QuantilesTest, RollingQuantileMatchesMathUtilsExactly) {
+    auto r = makeReturns(600, 1);
+    for (size_t w : {1u, 2u, 20u, 251u}) {
+        for (double p : {0.0, 5.0, 33.3, 50.0, 99.0, 100.0}) {
+            auto rolling = computeRollingQuantile(r, w, p);
+            ASSERT_EQ(rolling.size(), r.size() - w + 1);
+            for (size_t i = 0; i < rolling.size(); ++i)
+                ASSERT_EQ(rolling[i], MathUtils::percentile(window(r, i, w), p)) << "w=" << w << " p=" << p << " i=" << i;
+        }
+    }
+}
+
+TEST(QuantilesTest, MultipleQuantilesAndMedian) {
+    auto r = makeReturns(300, 2);
+    auto qs = computeRollingQuantiles(r, 50, {1.0, 50.0, 99.0});
+    auto median = computeRollingMedian(r, 50);
+    ASSERT_EQ(qs.size(), 3);
+    EXPECT_EQ(qs[1], median);
+    EXPECT_EQ(qs[0], computeRollingQuantile(r, 50, 1.0));
+    for (size_t i = 0; i < median.size(); ++i)
+        EXPECT_EQ(median[i], MathUtils::median(window(r, i, 50)));
+}
+
+TEST(QuantilesTest, FloatMatchesMathUtils) {
+    auto d = makeReturns(200, 3);
+    std::vector<float> f(d.begin(), d.end());
+    auto rolling = computeRollingQuantile(f, 30, 5.0f);
+    for (size_t i = 0; i < rolling.size(); ++i)
+        EXPECT_EQ(rolling[i], MathUtils::percentile(std::vector<float>(f.begin() + i, f.begin() + i + 30), 5.0f));
+}
+
+TEST(QuantilesTest, VaRAndCVaR) {
+    auto r = makeReturns(500, 4);
+    auto var = computeRollingVaR(r, 100, 0.95);
+    auto cvar = computeRollingCVaR(r, 100, 0.95);
+    ASSERT_EQ(var.size(), 401);
+    ASSERT_EQ(cvar.size(), 401);
+    for (size_t i = 0; i < var.size(); ++i) {
+        auto win = window(r, i, 100);
+        EXPECT_EQ(var[i], -MathUtils::percentile(win, 100.0 * (1.0 - 0.95)));
+        std::sort(win.begin(), win.end());
+        double worst = 0.0;
+        for (size_t j = 0; j < 5; ++j)
+            worst += win[j];
+        EXPECT_NEAR(cvar[i], -worst / 5.0, 1e-15);
+        EXPECT_GE(cvar[i], var[i]);
+    }
+}
+
+TEST(QuantilesTest, PercentileRank) {
+    std::vector<double> x = {1.0, 3.0, 2.0, 2.0, 5.0, 0.5};
+    auto rank = computeRollingPercentileRank(x, 3);
+    ASSERT_EQ(rank.size(), 4);
+    EXPECT_NEAR(rank[0], 200.0 / 3.0, 1e-12);  // {1, 3, 2}: 2 is at or above two values
+    EXPECT_NEAR(rank[1], 200.0 / 3.0, 1e-12);  // {3, 2, 2}
+    EXPECT_NEAR(rank[2], 100.0, 1e-12);        // {2, 2, 5}
+    EXPECT_NEAR(rank[3], 100.0 / 3.0, 1e-12);  // {2, 5, 0.5}
+}
+
+TEST(QuantilesTest, EdgeCasesAndErrors) {
+    std::vector<double> x = {0.1, 0.2};
+    EXPECT_TRUE(computeRollingQuantile(x, 3, 50.0).empty());
+    EXPECT_TRUE(computeRollingMedian(x, 0).empty());
+    EXPECT_THROW(computeRollingQuantile(x, 2, 101.0), std::invalid_argument);
+    EXPECT_THROW(computeRollingQuantiles(x, 2, {50.0, -1.0}), std::invalid_argument);
+    EXPECT_THROW(computeRollingVaR(x, 2, 1.0), std::invalid_argument);
+    EXPECT_THROW(computeRollingCVaR(x, 2, 0.0), std::invalid_argument);
+}
@@ -0,0 +1,180 @@
+/*
+regressOnFactors
+rollingRegressOnFactors (incl. low-volatility and near-perfect fits)
+*/
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "stats/regression.hpp"
+
+using namespace Stats::Regression;
+
+namespace {
+
+std::vector<std::vector<double>> makeFactors(size_t k, size_t t, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::normal_distribution<double> dist(0.0003, 0.01);
+    std::vector<std::vector<double>> f(k, std::vector<double>(t));
+    for (auto& series : f)
+        for (auto& x : series)
+            x = dist(rng);
+    return f;
+}
+
+std::vector<double> combine(const std::vector<std::vector<double>>& factors, double alpha,
+                            const std::vector<double>& betas, double noise, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::normal_distribution<double> eps(0.0, noise);
+    std::vector<double> y(factors[0].size());
+    for (size_t i = 0; i < y.size(); ++i) {
+        y[i] = alpha + (noise > 0 ? eps(rng) : 0.0);
+        for (size_t k = 0; k < factors.size(); ++k)
+            y[i] += betas[k] * factors[k][i];
+    }
+    return y;
+}
+
+}
+
+TEST(RegressionTest, RecoversExactCoefficients) {
+    auto f = makeFactors(3, 200, 1);
+    auto y = combine(f, 0.0004, {1.2, -0.5, 0.3}, 0.0, 0);
+    auto fit = regressOnFactors({y}, f);
+
+    ASSERT_EQ(fit.assets, 1u);
+    ASSERT_EQ(fit.factors, 3u);
+    EXPECT_NEAR(fit.alphas[0], 0.0004, 1e-12);
+    EXPECT_NEAR(fit.beta(0, 0), 1.2, 1e-10);
+    EXPECT_NEAR(fit.beta(0, 1), -0.5, 1e-10);
+    EXPECT_NEAR(fit.beta(0, 2), 0.3, 1e-10);
+    EXPECT_NEAR(fit.rSquared[0], 1.0, 1e-12);
+}
+
+TEST(RegressionTest, SingleFactorMatchesClosedForm) {
+    auto f = makeFactors(1, 500, 2);
+    auto y = combine(f, 0.0002, {0.8}, 0.005, 3);
+    auto fit = regressOnFactors({y}, f);
+
+    const auto& x = f[0];
+    const double n = static_cast<double>(x.size());
+    double mx = 0, my = 0;
+    for (size_t i = 0; i < x.size(); ++i) {
+        mx += x[i];
+        my += y[i];
+    }
+    mx /= n;
+    my /= n;
+    double sxx = 0, sxy = 0, syy = 0;
+    for (size_t i = 0; i < x.size(); ++i) {
+        sxx += (x[i] - mx) * (x[i] - mx);
+        sxy += (x[i] - mx) * (y[i] - my);
+        syy += (y[i] - my) * (y[i] - my);
+    }
+    double beta = sxy / sxx;
+    double alpha = my - beta * mx;
+    double ssr = syy - beta * sxy;
+    double sigma2 = ssr / (n - 2);
+    double betaT = beta / std::sqrt(sigma2 / sxx);
+    double alphaT = alpha / std::sqrt(sigma2 * (1.0 / n + mx * mx / sxx));
+
+    EXPECT_NEAR(fit.beta(0, 0), beta, 1e-10);
+    EXPECT_NEAR(fit.alphas[0], alpha, 1e-12);
+    EXPECT_NEAR(fit.betaTStat(0, 0), betaT, 1e-6 * std::abs(betaT));
+    EXPECT_NEAR(fit.alphaTStats[0], alphaT, 1e-6 * std::abs(alphaT));
+    EXPECT_NEAR(fit.rSquared[0], 1.0 - ssr / syy, 1e-10);
+}
+
+TEST(RegressionTest, BatchedMatchesPerAssetFits) {
+    auto f = makeFactors(2, 300, 4);
+    std::vector<std::vector<double>> assets = {combine(f, 0.001, {0.9, 0.1}, 0.004, 5),
+                                               combine(f, -0.0005, {-0.3, 1.4}, 0.01, 6),
+                                               combine(f, 0.0, {0.0, 0.0}, 0.01, 7)};
+    auto batched = regressOnFactors(assets, f);
+    for (size_t a = 0; a < assets.size(); ++a) {
+        auto single = regressOnFactors({assets[a]}, f);
+        EXPECT_DOUBLE_EQ(batched.alphas[a], single.alphas[0]);
+        EXPECT_DOUBLE_EQ(batched.beta(a, 1), single.beta(0, 1));
+        EXPECT_DOUBLE_EQ(batched.rSquared[a], single.rSquared[0]);
+    }
+}
+
+TEST(RegressionTest, RollingMatchesBatchedOnEveryWindow) {
+    const size_t t = 260, window = 40;
+    auto f = makeFactors(2, t, 8);
+    std::vector<std::vector<double>> assets = {combine(f, 0.0003, {1.1, -0.2}, 0.006, 9),
+                                               combine(f, 0.0, {0.4, 0.7}, 0.012, 10)};
+    auto rolling = rollingRegressOnFactors(assets, f, window);
+    ASSERT_EQ(rolling.windows, t - window + 1);
+
+    for (size_t w = 0; w < rolling.windows; w += 7) {
+        std::vector<std::vector<double>> fw, aw;
+        for (auto& s : f)
+            fw.emplace_back(s.begin() + w, s.begin() + w + window);
+        for (auto& s : assets)
+            aw.emplace_back(s.begin() + w, s.begin() + w + window);
+        auto batched = regressOnFactors(aw, fw);
+        for (size_t a = 0; a < assets.size(); ++a) {
+            EXPECT_NEAR(rolling.alpha(w, a), batched.alphas[a], 1e-10) << w;
+            EXPECT_NEAR(rolling.beta(w, a, 0), batched.beta(a, 0), 1e-8) << w;
+            EXPECT_NEAR(rolling.beta(w, a, 1), batched.beta(a, 1), 1e-8) << w;
+            EXPECT_NEAR(rolling.rSquared[w * 2 + a], batched.rSquared[a], 1e-8) << w;
+            EXPECT_NEAR(rolling.betaTStats[(w * 2 + a) * 2], batched.betaTStat(a, 0),
+                        1e-6 * std::abs(batched.betaTStat(a, 0))) << w;
+        }
+    }
+}
+
+TEST(RegressionTest, RollingSmallResidualsMatchBatched) {
+    const size_t t = 300, window = 60;
+    auto f = makeFactors(2, t, 12);
+    // A large mean over a tiny spread, and a fit that is exact to ~1e-9.
+    std::vector<std::vector<double>> assets = {combine(f, 0.02, {0.001, -0.0005}, 1e-7, 13),
+                                               combine(f, 0.0004, {0.9, 0.3}, 1e-9, 14)};
+    auto rolling = rollingRegressOnFactors(assets, f, window);
+
+    for (size_t w = 0; w < rolling.windows; w += 5) {
+        std::vector<std::vector<double>> fw, aw;
+        for (auto& s : f)
+            fw.emplace_back(s.begin() + w, s.begin() + w + window);
+        for (auto& s : assets)
+            aw.emplace_back(s.begin() + w, s.begin() + w + window);
+        auto batched = regressOnFactors(aw, fw);
+        for (size_t a = 0; a < assets.size(); ++a) {
+            const size_t idx = w * 2 + a;
+            EXPECT_NEAR(rolling.alphaTStats[idx], batched.alphaTStats[a],
+                        1e-6 * std::abs(batched.alphaTStats[a])) << w << " " << a;
+            for (size_t k = 0; k < 2; ++k)
+                EXPECT_NEAR(rolling.betaTStats[idx * 2 + k], batched.betaTStat(a, k),
+                            1e-6 * std::abs(batched.betaTStat(a, k))) << w << " " << a;
+            EXPECT_NEAR(1.0 - rolling.rSquared[idx], 1.0 - batched.rSquared[a],
+                        1e-6 * (1.0 - batched.rSquared[a])) << w << " " << a;
+        }
+    }
+}
+
+TEST(RegressionTest, RollingFlagsCollinearWindowsAsNaN) {
+    std::vector<std::vector<double>> f = {std::vector<double>(30, 0.0)};
+    for (size_t i = 20; i < 30; ++i)
+        f[0][i] = 0.01 * static_cast<double>(i % 3) - 0.01;
+    std::vector<double> y(30, 0.001);
+    auto rolling = rollingRegressOnFactors({y}, f, 5);
+    EXPECT_TRUE(std::isnan(rolling.alpha(0, 0)));
+    EXPECT_FALSE(std::isnan(rolling.beta(rolling.windows - 1, 0, 0)));
+}
+
+TEST(RegressionTest, RejectsBadShapesAndSingularFactors) {
+    auto f = makeFactors(2, 50, 11);
+    std::vector<double> shortSeries(49, 0.0);
+    EXPECT_THROW(regressOnFactors({shortSeries}, f), std::invalid_argument);
+    EXPECT_THROW(regressOnFactors({}, f), std::invalid_argument);
+    EXPECT_THROW(regressOnFactors({std::vector<double>(2)}, {{0.1, 0.2}, {0.3, 0.1}}), std::invalid_argument);
+    EXPECT_THROW(rollingRegressOnFactors({f[0]}, {f[1]}, 2), std::invalid_argument);
+    EXPECT_THROW(rollingRegressOnFactors({f[0]}, {f[1]}, 51), std::invalid_argument);
+
+    std::vector<std::vector<double>> constant = {f[0], std::vector<double>(50, 0.02)};
+    EXPECT_THROW(regressOnFactors({f[1]}, constant), std::runtime_error);
+}
@@ -0,0 +1,165 @@
+/*
+Series::returns
+Series::view
+Series::prices
+operators + - * / and unary minus
+map
+cumprod
+cumsum
+drop
+rolling sum / mean / variance / stddev
+collect
+sum / mean / moments / variance / stddev / min / max / last
+*/
+
+#include <gtest/gtest.h>
+#include <TestHelpers.hpp>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+#include "core/series.hpp"
+#include "stats/returns.hpp"
+#include "stats/volatility.hpp"
+#include "utils/math_utils.hpp"
+
+static_assert(Series::Expression<Series::View>);
+static_assert(Series::Expression<decltype((1.0 + Series::View({})).cumprod())>);
+static_assert(!Series::Expression<std::vector<double>>);
+
+namespace {
+
+class SeriesTest : public ::testing::Test {
+protected:
+    PriceSeries ps = generateRandomWalkSeries("TEST", 600, 100.0, 0.0004, 0.012, 3);
+    std::vector<double> daily = Stats::Returns::computeDailyReturns(ps);
+};
+
+}
+
+TEST_F(SeriesTest, ReturnsMatchEagerDailyReturns) {
+    auto lazy = Series::returns(ps).collect();
+    ASSERT_EQ(lazy.size(), daily.size());
+    for (size_t i = 0; i < daily.size(); ++i)
+        EXPECT_EQ(lazy[i], daily[i]);
+
+    EXPECT_EQ(Series::prices(ps).size(), ps.getPrices().size());
+    EXPECT_EQ(Series::prices(ps).last(), ps.getPrices().back());
+}
+
+TEST_F(SeriesTest, ReturnsThrowOnZeroPriceWhenEvaluated) {
+    std::vector<double> prices = {10.0, 0.0, 5.0};
+    auto r = Series::returns(prices);
+    EXPECT_EQ(r.size(), 2u);
+    EXPECT_THROW(r.collect(), std::invalid_argument);
+}
+
+TEST_F(SeriesTest, CumprodOfGrossReturnsIsWealth) {
+    auto wealth = (1.0 + Series::returns(ps)).cumprod().collect();
+    const auto &prices = ps.getPrices();
+    ASSERT_EQ(wealth.size(), prices.size() - 1);
+    for (size_t i = 0; i < wealth.size(); ++i)
+        EXPECT_NEAR(wealth[i], prices[i + 1] / prices[0], 1e-12 * wealth[i]);
+}
+
+TEST_F(SeriesTest, CumsumIsCompensated) {
+    std::vector<double> x(100000, 0.1);
+    auto c = Series::view(x).cumsum();
+    EXPECT_DOUBLE_EQ(c.last(), 10000.0);
+    EXPECT_NEAR(c.collect()[9], 1.0, 1e-15);
+}
+
+TEST_F(SeriesTest, RollingStddevMatchesEagerVolatility) {
+    const double rf = 0.0001;
+    std::vector<double> excess(daily.size());
+    for (size_t i = 0; i < daily.size(); ++i)
+        excess[i] = daily[i] - rf;
+
+    auto eager = Stats::Volatility::computeRollingVolatility(excess, 20);
+    auto lazy = (Series::returns(ps) - rf).rolling(20).stddev().collect();
+    ASSERT_EQ(lazy.size(), eager.size());
+    for (size_t i = 0; i < eager.size(); ++i)
+        EXPECT_NEAR(lazy[i], eager[i], 1e-12 * eager[i]);
+}
+
+TEST_F(SeriesTest, RollingSumMeanAndVariance) {
+    const size_t w = 7;
+    auto sums = Series::view(daily).rolling(w).sum().collect();
+    auto means = Series::view(daily).rolling(w).mean().collect();
+    auto vars = Series::view(daily).rolling(w).variance().collect();
+    ASSERT_EQ(means.size(), daily.size() - w + 1);
+    for (size_t i = 0; i < means.size(); i += 13) {
+        std::vector<double> window(daily.begin() + i, daily.begin() + i + w);
+        EXPECT_NEAR(means[i], MathUtils::mean(window), 1e-15);
+        EXPECT_NEAR(sums[i], MathUtils::mean(window) * w, 1e-14);
+        EXPECT_NEAR(vars[i], MathUtils::variance(window, true), 1e-16);
+    }
+}
+
+TEST_F(SeriesTest, RollingConstantWindowsAreExactlyZero) {
+    std::vector<double> x = {0.1, 0.1, 0.1, 0.1, 0.3, 0.3, 0.3, 0.3};
+    auto sd = Series::view(x).rolling(3).stddev().collect();
+    ASSERT_EQ(sd.size(), 6u);
+    EXPECT_EQ(sd[0], 0.0);
+    EXPECT_EQ(sd[1], 0.0);
+    EXPECT_GT(sd[2], 0.0);
+    EXPECT_EQ(sd[5], 0.0);
+    EXPECT_EQ(Series::view(x).rolling(3).mean().collect()[0], 0.1);
+}
+
+TEST_F(SeriesTest, RollingShorterThanWindowIsEmpty) {
+    std::vector<double> x = {1.0, 2.0};
+    EXPECT_TRUE(Series::view(x).rolling(3).mean().collect().empty());
+    EXPECT_THROW(Series::view(x).rolling(0), std::invalid_argument);
+    EXPECT_THROW(Series::view(x).rolling(1).stddev(), std::invalid_argument);
+    EXPECT_THROW(Series::view(x).rolling(3).mean().sum(), std::invalid_argument);
+}
+
+TEST_F(SeriesTest, ReductionsMatchMathUtils) {
+    auto r = Series::returns(ps);
+    auto m = r.moments();
+    EXPECT_EQ(m.count, daily.size());
+    EXPECT_NEAR(m.mean, MathUtils::mean(daily), 1e-16);
+    EXPECT_NEAR(m.variance, MathUtils::variance(daily, true), 1e-16);
+    EXPECT_NEAR(r.stddev(), std::sqrt(MathUtils::variance(daily, true)), 1e-15);
+    EXPECT_NEAR(r.sum(), MathUtils::mean(daily) * daily.size(), 1e-14);
+    EXPECT_EQ(r.min(), MathUtils::min(daily));
+    EXPECT_EQ(r.max(), MathUtils::max(daily));
+    EXPECT_EQ(r.last(), daily.back());
+
+    std::vector<double> empty;
+    EXPECT_THROW(Series::view(empty).mean(), std::invalid_argument);
+    std::vector<double> one = {2.5};
+    EXPECT_EQ(Series::view(one).variance(), 0.0);
+}
+
+TEST_F(SeriesTest, ScalarAndElementwiseOperators) {
+    std::vector<double> a = {1.0, 2.0, 4.0};
+    std::vector<double> b = {2.0, 4.0, 8.0};
+    auto va = Series::view(a);
+    auto vb = Series::view(b);
+
+    EXPECT_EQ((va + vb).collect(), (std::vector<double>{3.0, 6.0, 12.0}));
+    EXPECT_EQ((vb - va).collect(), (std::vector<double>{1.0, 2.0, 4.0}));
+    EXPECT_EQ((va * vb).collect(), (std::vector<double>{2.0, 8.0, 32.0}));
+    EXPECT_EQ((vb / va).collect(), (std::vector<double>{2.0, 2.0, 2.0}));
+    EXPECT_EQ((va * 2.0 + 1.0).collect(), (std::vector<double>{3.0, 5.0, 9.0}));
+    EXPECT_EQ((8.0 / va).collect(), (std::vector<double>{8.0, 4.0, 2.0}));
+    EXPECT_EQ((10.0 - va).collect(), (std::vector<double>{9.0, 8.0, 6.0}));
+    EXPECT_EQ((-va).collect(), (std::vector<double>{-1.0, -2.0, -4.0}));
+    EXPECT_EQ(va.map([](double x) { return x * x; }).collect(), (std::vector<double>{1.0, 4.0, 16.0}));
+}
+
+TEST_F(SeriesTest, SizeMismatchThrowsAndDropRealigns) {
+    auto r = Series::returns(ps);
+    auto vol = r.rolling(20).stddev();
+    EXPECT_THROW(r / vol, std::invalid_argument);
+
+    auto ratio = (r.drop(19) / vol).collect();
+    auto v = vol.collect();
+    ASSERT_EQ(ratio.size(), v.size());
+    EXPECT_EQ(ratio[0], daily[19] / v[0]);
+    EXPECT_EQ(ratio.back(), daily.back() / v.back());
+
+    EXPECT_EQ(r.drop(daily.size() + 5).size(), 0u);
+}
@@ -0,0 +1,113 @@
+/*
+ReturnThresholds
+CaptureThresholds
+computeOmegaCurve
+computeSortinoCurve
+computeUpsideCaptureCurve
+computeDownsideCaptureCurve
+*/
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "stats/capture.hpp"
+#include "stats/ratios.hpp"
+#include "stats/thresholds.hpp"
+
+using namespace Stats::Thresholds;
+
+namespace {
+
+std::vector<double> makeReturns(size_t n, double mu, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::normal_distribution<double> dist(mu, 0.01);
+    std::vector<double> r(n);
+    for (auto& x : r)
+        x = dist(rng);
+    return r;
+}
+
+std::vector<double> marGrid() {
+    std::vector<double> t;
+    for (int i = -50; i <= 50; ++i)
+        t.push_back(0.0004 * i);
+    return t;
+}
+
+void expectRelNear(double a, double b, double tol) {
+    if (std::isinf(b)) {
+        EXPECT_EQ(a, b);
+        return;
+    }
+    EXPECT_NEAR(a, b, tol * std::max(std::abs(b), 1e-12));
+}
+
+}
+
+TEST(ThresholdsTest, OmegaCurveMatchesFullScan) {
+    auto r = makeReturns(2000, 0.0004, 1);
+    auto grid = marGrid();
+    auto curve = computeOmegaCurve(r, grid);
+    ASSERT_EQ(curve.size(), grid.size());
+    for (size_t i = 0; i < grid.size(); ++i)
+        expectRelNear(curve[i], Stats::Ratios::computeOmegaRatio(r, grid[i]), 1e-10);
+}
+
+TEST(ThresholdsTest, SortinoCurveMatchesFullScan) {
+    auto r = makeReturns(2000, 0.0004, 2);
+    auto grid = marGrid();
+    auto curve = computeSortinoCurve(0.0004, r, grid);
+    for (size_t i = 0; i < grid.size(); ++i)
+        expectRelNear(curve[i], Stats::Ratios::computeSortinoRatio(0.0004, grid[i], r), 1e-9);
+}
+
+TEST(ThresholdsTest, ThresholdsOnDataPointsAndBeyondRange) {
+    std::vector<double> r = {-0.02, -0.01, 0.0, 0.0, 0.01, 0.03};
+    ReturnThresholds<double> t(r);
+    for (double tau : {-0.05, -0.01, 0.0, 0.01, 0.05}) {
+        expectRelNear(t.omega(tau), Stats::Ratios::computeOmegaRatio(r, tau), 1e-12);
+        expectRelNear(t.sortino(0.001, tau), Stats::Ratios::computeSortinoRatio(0.001, tau, r), 1e-12);
+    }
+    EXPECT_TRUE(std::isinf(t.omega(-0.05)));
+    EXPECT_DOUBLE_EQ(t.omega(0.05), 0.0);
+    EXPECT_DOUBLE_EQ(t.downsideDeviation(-0.05), 0.0);
+}
+
+TEST(ThresholdsTest, CaptureCurvesMatchCaptureAtZeroAndScanElsewhere) {
+    auto b = makeReturns(1500, 0.0003, 3);
+    auto p = makeReturns(1500, 0.0005, 4);
+    for (size_t i = 0; i < p.size(); ++i)
+        p[i] = 0.5 * p[i] + 0.8 * b[i];
+
+    CaptureThresholds<double> c(p, b);
+    expectRelNear(c.upside(0.0), Stats::Capture::computeUpsideCaptureRatio(p, b), 1e-12);
+    expectRelNear(c.downside(0.0), Stats::Capture::computeDownsideCaptureRatio(p, b), 1e-12);
+
+    auto grid = marGrid();
+    auto up = computeUpsideCaptureCurve(p, b, grid);
+    auto down = computeDownsideCaptureCurve(p, b, grid);
+    for (size_t i = 0; i < grid.size(); ++i) {
+        double pu = 0, bu = 0, pd = 0, bd = 0;
+        for (size_t j = 0; j < b.size(); ++j) {
+            if (b[j] > grid[i]) { pu += p[j]; bu += b[j]; }
+            if (b[j] < grid[i]) { pd += p[j]; bd += b[j]; }
+        }
+        expectRelNear(up[i], bu == 0 ? 0.0 : pu / bu, 1e-9);
+        expectRelNear(down[i], bd == 0 ? 0.0 : pd / bd, 1e-9);
+    }
+}
+
+TEST(ThresholdsTest, FloatCurves) {
+    auto d = makeReturns(1000, 0.0004, 5);
+    std::vector<float> f(d.begin(), d.end());
+    auto curve = computeOmegaCurve(f, {0.0f, 0.001f});
+    expectRelNear(curve[0], Stats::Ratios::computeOmegaRatio(d, 0.0), 1e-4);
+    expectRelNear(curve[1], Stats::Ratios::computeOmegaRatio(d, static_cast<double>(0.001f)), 1e-4);
+}
+
+TEST(ThresholdsTest, MismatchedCaptureThrows) {
+    EXPECT_THROW(CaptureThresholds<double>({0.1, 0.2}, {0.1}), std::invalid_argument);
+}
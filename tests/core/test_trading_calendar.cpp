@@ -0,0 +1,126 @@
+/*
+TradingCalendar::nyse (sessions per year, holidays, half days, special closures)
+TradingCalendar::isSession / isHoliday / isHalfDay
+TradingCalendar::sessionOnOrAfter / sessionOnOrBefore
+TradingCalendar::sessionsBetween / addSessions
+TradingCalendar::sessionsInYear / sessionsPerYear
+TradingCalendar::findGaps
+Custom holiday lists and range errors
+*/
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "core/trading_calendar.hpp"
+#include "utils/timestamp.hpp"
+
+namespace {
+
+int64_t day(int y, unsigned m, unsigned d) {
+    return Timestamp::daysFromCivil(y, m, d);
+}
+
+const TradingCalendar& nyse() {
+    return TradingCalendar::nyse();
+}
+
+}
+
+TEST(TradingCalendarTest, NyseSessionsPerYear) {
+    EXPECT_EQ(nyse().sessionsInYear(2001), 248);
+    EXPECT_EQ(nyse().sessionsInYear(2012), 250);
+    EXPECT_EQ(nyse().sessionsInYear(2018), 251);
+    EXPECT_EQ(nyse().sessionsInYear(2021), 252);
+    EXPECT_EQ(nyse().sessionsInYear(2022), 251);
+    EXPECT_EQ(nyse().sessionsInYear(2023), 250);
+    EXPECT_EQ(nyse().sessionsInYear(2024), 252);
+    EXPECT_DOUBLE_EQ(nyse().sessionsPerYear(day(2023, 3, 1), day(2024, 6, 30)), 251.0);
+}
+
+TEST(TradingCalendarTest, NyseHolidaysAndHalfDays) {
+    EXPECT_TRUE(nyse().isHoliday(day(2024, 3, 29)));   // Good Friday
+    EXPECT_TRUE(nyse().isHoliday(day(2023, 1, 16)));   // MLK Day
+    EXPECT_TRUE(nyse().isHoliday(day(2022, 6, 20)));   // Juneteenth, observed Monday
+    EXPECT_FALSE(nyse().isHoliday(day(2021, 6, 18)));  // before Juneteenth became a market holiday
+    EXPECT_TRUE(nyse().isHoliday(day(2020, 7, 3)));    // July 4 on a Saturday
+    EXPECT_TRUE(nyse().isHoliday(day(2021, 12, 24)));  // Christmas on a Saturday
+    EXPECT_TRUE(nyse().isSession(day(2021, 12, 31)));  // New Year's Day on a Saturday is not observed
+    EXPECT_TRUE(nyse().isHoliday(day(2012, 10, 29)));  // Hurricane Sandy
+    EXPECT_TRUE(nyse().isHoliday(day(2025, 1, 9)));    // Carter funeral
+    EXPECT_FALSE(nyse().isHoliday(day(2023, 1, 7)));   // a Saturday is closed but not a holiday
+    EXPECT_FALSE(nyse().isSession(day(2023, 1, 7)));
+
+    EXPECT_TRUE(nyse().isHalfDay(day(2023, 7, 3)));
+    EXPECT_TRUE(nyse().isHalfDay(day(2023, 11, 24)));
+    EXPECT_TRUE(nyse().isHalfDay(day(2024, 12, 24)));
+    EXPECT_TRUE(nyse().isSession(day(2024, 12, 24)));
+    EXPECT_FALSE(nyse().isHalfDay(day(2023, 7, 5)));
+}
+
+TEST(TradingCalendarTest, RollingAndStepping) {
+    const int64_t sat = day(2023, 12, 23), fri = day(2023, 12, 22);
+    EXPECT_EQ(nyse().sessionOnOrAfter(sat), day(2023, 12, 26));  // Christmas Monday closed
+    EXPECT_EQ(nyse().sessionOnOrBefore(sat), fri);
+    EXPECT_EQ(nyse().sessionOnOrBefore(fri), fri);
+
+    EXPECT_EQ(nyse().addSessions(fri, 1), day(2023, 12, 26));
+    EXPECT_EQ(nyse().addSessions(sat, 1), day(2023, 12, 26));
+    EXPECT_EQ(nyse().addSessions(sat, 0), day(2023, 12, 26));
+    EXPECT_EQ(nyse().addSessions(sat, -1), fri);
+    EXPECT_EQ(nyse().addSessions(day(2023, 12, 26), -1), fri);
+    EXPECT_EQ(nyse().addSessions(day(2023, 1, 3), 249), day(2023, 12, 29));
+}
+
+TEST(TradingCalendarTest, CountsMatchDayByDayWalk) {
+    std::mt19937 rng(3);
+    std::uniform_int_distribution<int64_t> pick(day(2000, 1, 1), day(2030, 12, 31));
+    for (int i = 0; i < 300; ++i) {
+        int64_t a = pick(rng), b = pick(rng);
+        if (a > b)
+            std::swap(a, b);
+        b = std::min(b, a + 800);
+        int64_t walked = 0;
+        for (int64_t d = a; d < b; ++d)
+            walked += nyse().isSession(d);
+        ASSERT_EQ(nyse().sessionsBetween(a, b), walked);
+        EXPECT_EQ(nyse().sessionsBetween(b, a), -walked);
+
+        const int64_t s = nyse().sessionOnOrAfter(a);
+        const int64_t n = nyse().sessionsBetween(s, b);
+        if (n > 0) {
+            EXPECT_EQ(nyse().sessionsBetween(s, nyse().addSessions(s, n)), n);
+        }
+    }
+}
+
+TEST(TradingCalendarTest, FindsGapsInObservations) {
+    // Tue, Wed, (Thu, Fri missing), Tue after MLK Monday, Wed.
+    std::vector<int64_t> observed = {day(2023, 1, 10), day(2023, 1, 11), day(2023, 1, 17), day(2023, 1, 18)};
+    auto gaps = nyse().findGaps(observed);
+    ASSERT_EQ(gaps.size(), 1u);
+    EXPECT_EQ(gaps[0].index, 2u);
+    EXPECT_EQ(gaps[0].missing, 2);
+
+    EXPECT_TRUE(nyse().findGaps({day(2023, 1, 13), day(2023, 1, 17)}).empty());
+    EXPECT_THROW(nyse().findGaps({day(2023, 1, 13), day(2023, 1, 13)}), std::invalid_argument);
+}
+
+TEST(TradingCalendarTest, CustomHolidaysAndRange) {
+    TradingCalendar cal(2024, 2024, {day(2024, 1, 1), day(2023, 12, 25)}, {day(2024, 1, 2), day(2024, 1, 6)});
+    EXPECT_EQ(cal.firstDay(), day(2024, 1, 1));
+    EXPECT_EQ(cal.lastDay(), day(2024, 12, 31));
+    EXPECT_TRUE(cal.isHoliday(day(2024, 1, 1)));
+    EXPECT_TRUE(cal.isHalfDay(day(2024, 1, 2)));
+    EXPECT_FALSE(cal.isHalfDay(day(2024, 1, 6))); // Saturday stays closed
+    EXPECT_EQ(cal.sessionsInYear(2024), 261);
+    EXPECT_EQ(cal.sessionsBetween(day(2024, 1, 1), cal.lastDay() + 1), 261);
+
+    EXPECT_THROW(cal.isSession(day(2023, 12, 31)), std::out_of_range);
+    EXPECT_THROW(cal.sessionsInYear(2025), std::out_of_range);
+    EXPECT_THROW(cal.addSessions(day(2024, 12, 31), 1), std::out_of_range);
+    EXPECT_THROW(cal.sessionOnOrBefore(day(2024, 1, 1)), std::out_of_range);
+    EXPECT_THROW(TradingCalendar(2025, 2024, {}), std::invalid_argument);
+}
@@ -0,0 +1,149 @@
+/*
+Universe::insert / find / contains / at / operator[] / symbol
+Universe::reserve and growth past the initial table
+Universe::release
+PriceSeries sink constructors (buffers moved, not copied)
+TiingoClient::fetchMultipleDailyPrices
+*/
+
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "api/cache_store.hpp"
+#include "api/tiingo_client.hpp"
+#include "core/universe.hpp"
+
+namespace fs = std::filesystem;
+
+namespace {
+
+PriceSeries makeSeries(const std::string& ticker, double first, size_t n = 3) {
+    std::vector<double> prices(n);
+    for (size_t i = 0; i < n; ++i)
+        prices[i] = first + static_cast<double>(i);
+    return PriceSeries(ticker, std::move(prices));
+}
+
+std::string ticker(const char* prefix, size_t i) {
+    std::string s = prefix;
+    s += std::to_string(i);
+    return s;
+}
+
+// Serves two closes for every ticker except "EMPTY", which gets no rows.
+class FakeHttpClient : public HttpClient {
+public:
+    std::string get(const std::string& url) override {
+        if (url.find("/daily/EMPTY/") != std::string::npos)
+            return "[]";
+        return R"([{"date":"2023-01-03T00:00:00.000Z","adjClose":10.0},
+                   {"date":"2023-01-04T00:00:00.000Z","adjClose":11.0}])";
+    }
+};
+
+}
+
+static_assert(!std::is_copy_constructible_v<Universe>);
+static_assert(std::is_nothrow_move_constructible_v<Universe>);
+
+TEST(UniverseTest, InsertAssignsDenseIdsInOrder) {
+    Universe u;
+    EXPECT_TRUE(u.empty());
+    EXPECT_EQ(u.insert(makeSeries("AAPL", 100)), 0u);
+    EXPECT_EQ(u.insert(makeSeries("MSFT", 200)), 1u);
+    EXPECT_EQ(u.insert(makeSeries("SPY", 300)), 2u);
+
+    ASSERT_EQ(u.size(), 3u);
+    EXPECT_EQ(u.find("MSFT"), 1u);
+    EXPECT_EQ(u.symbol(2), "SPY");
+    EXPECT_DOUBLE_EQ(u[0].getPrices()[0], 100.0);
+    EXPECT_DOUBLE_EQ(u.at("SPY").getPrices()[2], 302.0);
+    EXPECT_FALSE(u.find("QQQ").has_value());
+    EXPECT_FALSE(u.contains("AAP"));
+    EXPECT_THROW(u.at("QQQ"), std::out_of_range);
+
+    std::vector<std::string> order;
+    for (const auto& s : u)
+        order.push_back(s.getTicker());
+    EXPECT_EQ(order, (std::vector<std::string>{"AAPL", "MSFT", "SPY"}));
+}
+
+TEST(UniverseTest, ReinsertReplacesAndKeepsId) {
+    Universe u;
+    u.insert(makeSeries("AAPL", 1));
+    u.insert(makeSeries("MSFT", 2));
+    EXPECT_EQ(u.insert(makeSeries("AAPL", 50, 5)), 0u);
+    EXPECT_EQ(u.size(), 2u);
+    EXPECT_EQ(u.at("AAPL").getPrices().size(), 5u);
+    EXPECT_DOUBLE_EQ(u.at("AAPL").getPrices()[0], 50.0);
+}
+
+TEST(UniverseTest, FindOnEmptyUniverse) {
+    Universe u;
+    EXPECT_FALSE(u.find("AAPL").has_value());
+    u.reserve(0);
+    EXPECT_FALSE(u.find("AAPL").has_value());
+}
+
+TEST(UniverseTest, ManyTickersSurviveGrowth) {
+    for (size_t reserved : {size_t{0}, size_t{5000}}) {
+        Universe u;
+        u.reserve(reserved);
+        for (size_t i = 0; i < 5000; ++i)
+            ASSERT_EQ(u.insert(makeSeries(ticker("T", i), static_cast<double>(i), 1)), i);
+        for (size_t i = 0; i < 5000; ++i) {
+            const auto id = u.find(ticker("T", i));
+            ASSERT_TRUE(id.has_value());
+            EXPECT_EQ(*id, i);
+            EXPECT_DOUBLE_EQ(u[*id].getPrices()[0], static_cast<double>(i));
+        }
+        EXPECT_FALSE(u.contains("T5000"));
+    }
+}
+
+TEST(UniverseTest, SeriesAreMovedNotCopied) {
+    std::vector<double> prices = {1.0, 2.0, 3.0};
+    std::vector<std::string> dates = {"2023-01-03", "2023-01-04", "2023-01-05"};
+    const double* pricesData = prices.data();
+    const std::string* datesData = dates.data();
+
+    Universe u;
+    const auto id = u.insert(PriceSeries("AAPL", std::move(dates), std::move(prices)));
+    EXPECT_EQ(u[id].getPrices().data(), pricesData);
+    EXPECT_EQ(u[id].getDates().data(), datesData);
+
+    // Growing the universe moves series, it does not copy them.
+    for (int i = 0; i < 100; ++i)
+        u.insert(makeSeries(ticker("X", static_cast<size_t>(i)), 1));
+    EXPECT_EQ(u.at("AAPL").getPrices().data(), pricesData);
+
+    Universe moved = std::move(u);
+    EXPECT_EQ(moved.at("AAPL").getPrices().data(), pricesData);
+
+    std::vector<PriceSeries> released = moved.release();
+    EXPECT_TRUE(moved.empty());
+    EXPECT_FALSE(moved.contains("AAPL"));
+    ASSERT_EQ(released.size(), 101u);
+    EXPECT_EQ(released[0].getPrices().data(), pricesData);
+}
+
+TEST(UniverseTest, FetchMultipleDailyPricesSkipsFailures) {
+    const std::string dir = (fs::temp_directory_path() / "tradeiq_universe_test").string();
+    fs::remove_all(dir);
+    {
+        TiingoClient client("KEY", std::make_shared<FakeHttpClient>());
+        client.setCacheStore(std::make_shared<ShardedCacheStore>(dir, 2));
+        Universe u = client.fetchMultipleDailyPrices({"UNIV_A", "EMPTY", "UNIV_B"}, "2023-01-01", "2023-01-06");
+
+        ASSERT_EQ(u.size(), 2u);
+        EXPECT_EQ(u.symbol(0), "UNIV_A");
+        EXPECT_EQ(u.symbol(1), "UNIV_B");
+        EXPECT_EQ(u.at("UNIV_B").getPrices(), (std::vector<double>{10.0, 11.0}));
+        EXPECT_FALSE(u.contains("EMPTY"));
+    }
+    fs::remove_all(dir);
+}
@@ -0,0 +1,127 @@
+/*
+ScratchArena (alignment, reset, growth)
+Stats scratch overloads (no upstream allocations after warm-up)
+*/
+
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <memory_resource>
+#include <TestHelpers.hpp>
+
+#include "stats/correlation.hpp"
+#include "stats/volatility.hpp"
+#include "utils/arena.hpp"
+
+namespace {
+
+// Forwards to new/delete and counts calls.
+class CountingResource : public std::pmr::memory_resource {
+public:
+    size_t allocations = 0;
+    size_t deallocations = 0;
+
+private:
+    void* do_allocate(size_t bytes, size_t align) override {
+        ++allocations;
+        return std::pmr::new_delete_resource()->allocate(bytes, align);
+    }
+    void do_deallocate(void* p, size_t bytes, size_t align) override {
+        ++deallocations;
+        std::pmr::new_delete_resource()->deallocate(p, bytes, align);
+    }
+    bool do_is_equal(const memory_resource& other) const noexcept override { return this == &other; }
+};
+
+}
+
+TEST(ScratchArenaTest, RespectsAlignment) {
+    ScratchArena arena(1024);
+    EXPECT_NE(arena.allocate(3, 1), nullptr);
+    void* p = arena.allocate(64, 64);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(p) % 64, 0u);
+    EXPECT_NE(arena.allocate(1, 1), nullptr);
+    void* q = arena.allocate(8, alignof(double));
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(q) % alignof(double), 0u);
+}
+
+TEST(ScratchArenaTest, ResetKeepsChunks) {
+    CountingResource upstream;
+    {
+        ScratchArena arena(1024, &upstream);
+        for (int round = 0; round < 5; ++round) {
+            arena.reset();
+            for (int i = 0; i < 100; ++i)
+                EXPECT_NE(arena.allocate(100, 8), nullptr);
+        }
+        size_t afterWarmup = upstream.allocations;
+        EXPECT_GT(arena.chunkCount(), 1u);
+        EXPECT_GE(arena.capacity(), 100u * 100u);
+
+        arena.reset();
+        EXPECT_EQ(arena.bytesUsed(), 0u);
+        for (int i = 0; i < 100; ++i)
+            EXPECT_NE(arena.allocate(100, 8), nullptr);
+        EXPECT_EQ(upstream.allocations, afterWarmup);
+    }
+    EXPECT_EQ(upstream.deallocations, upstream.allocations);
+}
+
+TEST(ScratchArenaTest, OversizedRequestGetsOwnChunk) {
+    ScratchArena arena(1024);
+    void* p = arena.allocate(1 << 20, 16);
+    EXPECT_NE(p, nullptr);
+    EXPECT_GE(arena.capacity(), size_t(1 << 20));
+}
+
+TEST(ScratchArenaTest, MetricEvaluationIsAllocationFreeAfterWarmup) {
+    std::vector<double> returns;
+    for (int i = 0; i < 500; ++i)
+        returns.push_back(0.01 * ((i * 37) % 11 - 5) / 5.0);
+    std::vector<PriceSeries> assets = {generateSeriesFromReturns("A", returns),
+                                       generateInverseSeriesFromReturns("B", returns),
+                                       generateSeriesFromReturns("C", std::vector<double>(returns.rbegin(), returns.rend()))};
+
+    CountingResource upstream;
+    CountingResource fallback;
+    std::pmr::memory_resource* previous = std::pmr::set_default_resource(&fallback);
+
+    ScratchArena arena(4096, &upstream);
+    size_t warmAllocations = 0;
+    for (int run = 0; run < 3; ++run) {
+        arena.reset();
+        auto vol = Stats::Volatility::computeRollingVolatility(returns, 20, &arena);
+        auto sharpe = Stats::Volatility::computeRollingSharpe(returns, 20, 0.0, &arena);
+        auto corr = Stats::Correlation::computeCorrelationMatrix(assets, &arena);
+
+        ASSERT_EQ(vol.size(), returns.size() - 19);
+        ASSERT_EQ(sharpe.size(), returns.size() - 19);
+        ASSERT_EQ(corr.size(), 3u);
+        EXPECT_NEAR(corr[0][1], -1.0, 1e-6);
+        if (run == 0)
+            warmAllocations = upstream.allocations;
+    }
+    std::pmr::set_default_resource(previous);
+
+    EXPECT_GT(warmAllocations, 0u);
+    EXPECT_EQ(upstream.allocations, warmAllocations);
+    EXPECT_EQ(fallback.allocations, 0u);
+}
+
+TEST(ScratchArenaTest, ScratchOverloadsMatchHeapVersions) {
+    std::vector<double> returns = {0.01, -0.02, 0.015, -0.005, 0.01, 0.02, -0.01};
+    ScratchArena arena;
+
+    auto heapSharpe = Stats::Volatility::computeRollingSharpe(returns, 3, 0.001);
+    auto arenaSharpe = Stats::Volatility::computeRollingSharpe(returns, 3, 0.001, &arena);
+    EXPECT_EQ(std::vector<double>(arenaSharpe.begin(), arenaSharpe.end()), heapSharpe);
+
+    auto heapVol = Stats::Volatility::computeRollingVolatility(returns, 3);
+    auto arenaVol = Stats::Volatility::computeRollingVolatility(returns, 3, &arena);
+    EXPECT_EQ(std::vector<double>(arenaVol.begin(), arenaVol.end()), heapVol);
+
+    std::vector<PriceSeries> assets = {generateSeriesFromReturns("A", returns),
+                                       generateSeriesFromReturns("B", {0.02, 0.01, -0.01, 0.0, 0.03, -0.02, 0.01})};
+    auto heapCorr = Stats::Correlation::computeCorrelationMatrix(assets);
+    auto arenaCorr = Stats::Correlation::computeCorrelationMatrix(assets, &arena);
+    EXPECT_EQ(arenaCorr[0][1], heapCorr[0][1]);
+}
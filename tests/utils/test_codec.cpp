@@ -0,0 +1,64 @@
+/*
+Codec::encodeTimestamps / decodeTimestamps
+Codec::encodeDoubles / decodeDoubles
+Codec::checksum
+*/
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "utils/codec.hpp"
+
+TEST(CodecTest, TimestampsRoundTrip) {
+    std::vector<int64_t> ts = {1672704000000, 1672790400000, 1672876800000, 1673222400000, -5, 0};
+    std::string encoded = Codec::encodeTimestamps(ts);
+    auto decoded = Codec::decodeTimestamps(reinterpret_cast<const uint8_t*>(encoded.data()), encoded.size(), ts.size());
+    EXPECT_EQ(decoded, ts);
+}
+
+TEST(CodecTest, RegularTimestampsCompressToAboutOneBytePerRow) {
+    std::vector<int64_t> ts;
+    for (int i = 0; i < 1000; ++i)
+        ts.push_back(1672704000000 + i * 300000LL); // 5-minute bars
+    std::string encoded = Codec::encodeTimestamps(ts);
+    EXPECT_LT(encoded.size(), ts.size() + 16);
+}
+
+TEST(CodecTest, DoublesRoundTripBitExact) {
+    std::vector<double> v = {125.07, 126.36, 126.36, 125.02, 0.0, -0.0, 1e-300,
+                             std::numeric_limits<double>::infinity(), 129.62, 130.15};
+    std::string encoded = Codec::encodeDoubles(v);
+    auto decoded = Codec::decodeDoubles(reinterpret_cast<const uint8_t*>(encoded.data()), encoded.size(), v.size());
+    ASSERT_EQ(decoded.size(), v.size());
+    for (size_t i = 0; i < v.size(); ++i)
+        EXPECT_EQ(std::signbit(decoded[i]), std::signbit(v[i]));
+    for (size_t i = 0; i < v.size(); ++i)
+        EXPECT_EQ(decoded[i], v[i]);
+}
+
+TEST(CodecTest, RepeatedDoublesCompress) {
+    std::vector<double> v(1000, 101.25);
+    std::string encoded = Codec::encodeDoubles(v);
+    EXPECT_LT(encoded.size(), 140u); // 8 bytes + 1 bit per repeat
+}
+
+TEST(CodecTest, EmptyInputs) {
+    EXPECT_TRUE(Codec::encodeDoubles({}).empty());
+    EXPECT_TRUE(Codec::encodeTimestamps({}).empty());
+    EXPECT_TRUE(Codec::decodeDoubles(nullptr, 0, 0).empty());
+}
+
+TEST(CodecTest, TruncatedStreamThrows) {
+    std::vector<double> v = {1.0, 2.0, 3.0};
+    std::string encoded = Codec::encodeDoubles(v);
+    EXPECT_THROW(Codec::decodeDoubles(reinterpret_cast<const uint8_t*>(encoded.data()), 4, v.size()), std::runtime_error);
+}
+
+TEST(CodecTest, ChecksumDetectsChange) {
+    std::string a = "AAPL";
+    std::string b = "AAPM";
+    EXPECT_EQ(Codec::checksum(a.data(), a.size()), Codec::checksum(a.data(), a.size()));
+    EXPECT_NE(Codec::checksum(a.data(), a.size()), Codec::checksum(b.data(), b.size()));
+}
@@ -0,0 +1,163 @@
+/*
+CpuDispatch::name / parse
+CpuDispatch::detected / supported / force / reset / ScopedIsa
+Kernels equivalence across instruction-set levels:
+  sumAndMismatches, centralSums (via Moments::summarize and MathUtils)
+  dot (computeCovarianceMatrix)
+  centredCrossSums (computeCorrelationMatrix)
+  quadraticForm (computePortfolioVariance)
+  rollingMoments (rolling volatility, Sharpe, standard deviation)
+*/
+
+#include <gtest/gtest.h>
+#include <TestHelpers.hpp>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "stats/correlation.hpp"
+#include "stats/moments.hpp"
+#include "stats/ratios.hpp"
+#include "stats/volatility.hpp"
+#include "utils/cpu_dispatch.hpp"
+#include "utils/kernels.hpp"
+#include "utils/math_utils.hpp"
+
+using CpuDispatch::Isa;
+
+namespace {
+
+const Isa kLevels[] = {Isa::Baseline, Isa::AVX2, Isa::AVX512};
+
+template <typename T>
+std::vector<T> makeData(size_t n, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::normal_distribution<double> dist(0.0005, 0.01);
+    std::vector<T> v(n);
+    for (auto &x : v)
+        x = static_cast<T>(dist(rng));
+    return v;
+}
+
+// Everything the dispatched kernels feed, evaluated at the active level.
+template <typename T>
+std::vector<T> evaluateAll() {
+    std::vector<T> out;
+    for (size_t n : {1u, 7u, 8u, 9u, 255u, 257u, 1003u, 10007u}) {
+        auto x = makeData<T>(n, static_cast<unsigned>(n));
+        auto y = makeData<T>(n, static_cast<unsigned>(n + 1));
+
+        auto s = Stats::Moments::summarize<4>(x);
+        out.insert(out.end(), {s.mean, s.m2, s.m3, s.m4});
+        auto c = Kernels::centralSums(x.data(), n, s.mean, 3);
+        out.insert(out.end(), c.begin(), c.end());
+        out.push_back(Kernels::dot(x.data(), y.data(), n));
+        auto cross = Kernels::centredCrossSums(x.data(), y.data(), n);
+        out.insert(out.end(), cross.begin(), cross.end());
+
+        for (size_t w : {2u, 5u, 20u}) {
+            auto vol = Stats::Volatility::computeRollingVolatility(x, w);
+            auto sharpe = Stats::Volatility::computeRollingSharpe(x, static_cast<int>(w), T(0.0001));
+            out.insert(out.end(), vol.begin(), vol.end());
+            out.insert(out.end(), sharpe.begin(), sharpe.end());
+        }
+        auto sd = Stats::Volatility::computeRollingStandardDeviation(x, true);
+        out.insert(out.end(), sd.begin(), sd.end());
+    }
+
+    std::vector<std::vector<T>> cov(37, std::vector<T>(37));
+    auto entries = makeData<T>(37 * 37, 5);
+    for (size_t i = 0; i < 37; ++i)
+        for (size_t j = 0; j < 37; ++j)
+            cov[i][j] = entries[i * 37 + j];
+    out.push_back(Stats::Ratios::computePortfolioVariance(cov, makeData<T>(37, 6)));
+    return out;
+}
+
+std::vector<double> evaluateMatrices() {
+    std::vector<double> out;
+    std::vector<std::vector<double>> returns;
+    std::vector<PriceSeries> assets;
+    for (unsigned a = 0; a < 13; ++a) {
+        returns.push_back(makeData<double>(301 + a, 40 + a));
+        assets.push_back(generateRandomWalkSeries("A", 250 + a, 100.0, 0.0004, 0.01, 60 + a));
+    }
+    for (const auto &row : Stats::Correlation::computeCovarianceMatrix(returns))
+        out.insert(out.end(), row.begin(), row.end());
+    for (const auto &row : Stats::Correlation::computeCorrelationMatrix(assets))
+        out.insert(out.end(), row.begin(), row.end());
+    return out;
+}
+
+}
+
+TEST(CpuDispatchTest, NamesRoundTrip) {
+    for (Isa isa : kLevels)
+        EXPECT_EQ(CpuDispatch::parse(CpuDispatch::name(isa)), isa);
+    EXPECT_EQ(CpuDispatch::parse("AVX2"), Isa::AVX2);
+    EXPECT_THROW(CpuDispatch::parse("sse9"), std::invalid_argument);
+}
+
+TEST(CpuDispatchTest, ForceAndRestore) {
+    EXPECT_TRUE(CpuDispatch::supported(Isa::Baseline));
+    EXPECT_TRUE(CpuDispatch::supported(CpuDispatch::detected()));
+    EXPECT_TRUE(CpuDispatch::supported(CpuDispatch::active()));
+
+    const Isa before = CpuDispatch::active();
+    {
+        CpuDispatch::ScopedIsa scoped(Isa::Baseline);
+        EXPECT_EQ(CpuDispatch::active(), Isa::Baseline);
+    }
+    EXPECT_EQ(CpuDispatch::active(), before);
+
+    if (!CpuDispatch::supported(Isa::AVX512)) {
+        EXPECT_THROW(CpuDispatch::force(Isa::AVX512), std::invalid_argument);
+        EXPECT_EQ(CpuDispatch::active(), before);
+    }
+
+    CpuDispatch::force(Isa::Baseline);
+    CpuDispatch::reset();
+    EXPECT_EQ(CpuDispatch::active(), before);
+}
+
+TEST(CpuDispatchTest, EveryLevelIsBitIdenticalToBaseline) {
+    std::vector<float> floatRef;
+    std::vector<double> doubleRef, matrixRef;
+    {
+        CpuDispatch::ScopedIsa scoped(Isa::Baseline);
+        floatRef = evaluateAll<float>();
+        doubleRef = evaluateAll<double>();
+        matrixRef = evaluateMatrices();
+    }
+
+    for (Isa isa : kLevels) {
+        if (isa == Isa::Baseline || !CpuDispatch::supported(isa))
+            continue;
+        SCOPED_TRACE(CpuDispatch::name(isa));
+        CpuDispatch::ScopedIsa scoped(isa);
+        EXPECT_EQ(evaluateAll<float>(), floatRef);
+        EXPECT_EQ(evaluateAll<double>(), doubleRef);
+        EXPECT_EQ(evaluateMatrices(), matrixRef);
+    }
+}
+
+TEST(CpuDispatchTest, KernelsMatchScalarDefinitions) {
+    auto x = makeData<double>(1001, 1);
+    auto y = makeData<double>(1001, 2);
+    double dot = 0.0;
+    for (size_t i = 0; i < x.size(); ++i)
+        dot += x[i] * y[i];
+    EXPECT_NEAR(Kernels::dot(x.data(), y.data(), x.size()), dot, 1e-15);
+
+    auto s = Kernels::sumAndMismatches(x.data(), x.size());
+    EXPECT_NEAR(s[0], MathUtils::mean(x) * 1001, 1e-14);
+    EXPECT_EQ(s[1], 1000.0);
+
+    std::vector<double> flat(9, 0.25);
+    std::vector<double> mean(5), m2(5);
+    Kernels::rollingMoments(flat.data(), flat.size(), 5, mean.data(), m2.data());
+    for (size_t i = 0; i < 5; ++i) {
+        EXPECT_EQ(mean[i], 0.25);
+        EXPECT_EQ(m2[i], 0.0);
+    }
+}
@@ -0,0 +1,117 @@
+/*
+Instrumentation::ScopedTimer / recordSpan
+Instrumentation::addCounter / recordValue
+Instrumentation::summarize
+Instrumentation::writeChromeTrace
+*/
+
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+#include "../external/json.hpp"
+#include "utils/instrumentation.hpp"
+
+namespace fs = std::filesystem;
+
+class InstrumentationTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        Instrumentation::reset();
+        Instrumentation::setEnabled(true);
+    }
+    void TearDown() override {
+        Instrumentation::setEnabled(false);
+        Instrumentation::reset();
+    }
+
+    static const Instrumentation::MetricSummary* find(const std::vector<Instrumentation::MetricSummary>& rows,
+                                                      const std::string& name) {
+        for (const auto& r : rows)
+            if (r.name == name)
+                return &r;
+        return nullptr;
+    }
+};
+
+TEST_F(InstrumentationTest, DisabledScopesRecordNothing) {
+    Instrumentation::setEnabled(false);
+    { Instrumentation::ScopedTimer t("test.disabled"); }
+    EXPECT_TRUE(Instrumentation::spans().empty());
+}
+
+TEST_F(InstrumentationTest, MergesAcrossThreads) {
+    auto work = [] {
+        for (int i = 0; i < 100; ++i) {
+            Instrumentation::ScopedTimer t("test.span");
+            Instrumentation::addCounter("test.counter", 2);
+        }
+    };
+    std::thread a(work), b(work);
+    a.join();
+    b.join();
+
+    auto rows = Instrumentation::summarize();
+    auto* span = find(rows, "test.span");
+    auto* counter = find(rows, "test.counter");
+    ASSERT_NE(span, nullptr);
+    ASSERT_NE(counter, nullptr);
+    EXPECT_EQ(span->kind, Instrumentation::Kind::Timer);
+    EXPECT_EQ(span->count, 200u);
+    EXPECT_EQ(counter->total, 400.0);
+    EXPECT_EQ(Instrumentation::spans().size(), 200u);
+}
+
+TEST_F(InstrumentationTest, HistogramQuantilesAreApproximate) {
+    for (int i = 1; i <= 1000; ++i)
+        Instrumentation::recordValue("test.values", static_cast<double>(i));
+
+    auto rows = Instrumentation::summarize();
+    auto* h = find(rows, "test.values");
+    ASSERT_NE(h, nullptr);
+    EXPECT_EQ(h->count, 1000u);
+    EXPECT_DOUBLE_EQ(h->min, 1.0);
+    EXPECT_DOUBLE_EQ(h->max, 1000.0);
+    EXPECT_NEAR(h->p50, 500.0, 50.0);
+    EXPECT_NEAR(h->p99, 990.0, 99.0);
+    EXPECT_DOUBLE_EQ(h->total, 500500.0);
+}
+
+TEST_F(InstrumentationTest, MacrosFollowBuildFlag) {
+    {
+        TRADEIQ_TIMED_SCOPE("test.macro");
+        TRADEIQ_COUNTER("test.macro_counter", 1);
+        TRADEIQ_HISTOGRAM("test.macro_values", 3.0);
+    }
+    auto rows = Instrumentation::summarize();
+#if TRADEIQ_INSTRUMENTATION
+    EXPECT_NE(find(rows, "test.macro"), nullptr);
+    EXPECT_NE(find(rows, "test.macro_counter"), nullptr);
+    EXPECT_NE(find(rows, "test.macro_values"), nullptr);
+#else
+    EXPECT_TRUE(rows.empty());
+#endif
+}
+
+TEST_F(InstrumentationTest, WritesChromeTraceJson) {
+    Instrumentation::recordSpan("test.\"quoted\"", 1000, 2500);
+    Instrumentation::addCounter("test.bytes", 42);
+
+    fs::path path = fs::temp_directory_path() / "tradeiq_trace_test.json";
+    Instrumentation::writeChromeTrace(path.string());
+
+    std::ifstream in(path);
+    auto trace = nlohmann::json::parse(in);
+    fs::remove(path);
+
+    const auto& events = trace.at("traceEvents");
+    ASSERT_EQ(events.size(), 2u);
+    EXPECT_EQ(events[0]["ph"], "X");
+    EXPECT_EQ(events[0]["name"], "test.\"quoted\"");
+    EXPECT_DOUBLE_EQ(events[0]["ts"].get<double>(), 1.0);
+    EXPECT_DOUBLE_EQ(events[0]["dur"].get<double>(), 2.5);
+    EXPECT_EQ(events[1]["ph"], "C");
+    EXPECT_EQ(events[1]["args"]["value"], 42);
+}
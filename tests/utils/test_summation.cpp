@@ -0,0 +1,150 @@
+/*
+Summation::reduce / sum (pairwise, lane-blocked)
+Summation::KahanSum (streaming compensated)
+Summation::sumSquaredDeviations / variance (corrected two-pass)
+Rolling volatility and Sharpe on low-volatility series
+*/
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <vector>
+
+#include "stats/volatility.hpp"
+#include "utils/math_utils.hpp"
+#include "utils/summation.hpp"
+
+namespace {
+
+// A T-bill-like series: large level, tiny day-to-day variation.
+std::vector<double> lowVolSeries(size_t n, double level, double amplitude) {
+    std::vector<double> v(n);
+    for (size_t i = 0; i < n; ++i)
+        v[i] = level + amplitude * std::sin(static_cast<double>(i) * 0.37);
+    return v;
+}
+
+double referenceVariance(const double* x, size_t n, bool sample) {
+    long double mean = 0;
+    for (size_t i = 0; i < n; ++i)
+        mean += x[i];
+    mean /= n;
+    long double ss = 0;
+    for (size_t i = 0; i < n; ++i)
+        ss += (x[i] - mean) * (x[i] - mean);
+    return static_cast<double>(ss / (sample ? n - 1 : n));
+}
+
+}
+
+TEST(SummationTest, ReduceMatchesSequentialForAllBlockShapes) {
+    for (size_t n : {0u, 1u, 7u, 8u, 9u, 255u, 256u, 257u, 1000u, 4099u}) {
+        std::vector<double> v(n);
+        for (size_t i = 0; i < n; ++i)
+            v[i] = static_cast<double>(i % 17);
+        double expected = 0;
+        for (double x : v)
+            expected += x;
+
+        auto r = Summation::reduce<2, double>(n, [&](size_t i) { return std::array<double, 2>{v[i], 1.0}; });
+        EXPECT_EQ(r[0], expected) << n;
+        EXPECT_EQ(r[1], static_cast<double>(n)) << n;
+        EXPECT_EQ(Summation::sum<double>(v.begin(), v.end()), expected) << n;
+    }
+}
+
+TEST(SummationTest, PairwiseFloatSumStaysBounded) {
+    const size_t n = 4000000;
+    std::vector<float> tenths(n, 0.1f);
+    const double exact = static_cast<double>(0.1f) * n;
+
+    float naive = 0.0f;
+    for (float x : tenths)
+        naive += x;
+    float pairwise = Summation::sum<float>(tenths.begin(), tenths.end());
+
+    EXPECT_GT(std::abs(naive - exact) / exact, 1e-3);
+    EXPECT_LT(std::abs(pairwise - exact) / exact, 1e-6);
+}
+
+TEST(SummationTest, KahanSumSurvivesLongRunsAndCancellation) {
+    Summation::KahanSum<float> run;
+    for (int i = 0; i < 4000000; ++i)
+        run.add(0.1f);
+    EXPECT_LT(std::abs(run.value() - 400000.0) / 400000.0, 1e-7);
+
+    Summation::KahanSum<float> k;
+    k.add(1e8f);
+    for (int i = 0; i < 9; ++i)
+        k.add(1.0f);
+    k.add(-1e8f);
+    EXPECT_EQ(k.value(), 9.0f);
+}
+
+TEST(SummationTest, TwoPassVarianceSurvivesLargeOffset) {
+    auto v = lowVolSeries(10000, 1e6, 1e-4);
+    double expected = referenceVariance(v.data(), v.size(), true);
+
+    double n = static_cast<double>(v.size());
+    double sum = 0, sumSq = 0;
+    for (double x : v) {
+        sum += x;
+        sumSq += x * x;
+    }
+    double textbook = (sumSq - sum * sum / n) / (n - 1);
+
+    EXPECT_GT(std::abs(textbook - expected) / expected, 1.0);
+    EXPECT_NEAR(Summation::variance(std::span<const double>(v), true), expected, expected * 1e-6);
+    EXPECT_NEAR(MathUtils::variance(v, true), expected, expected * 1e-6);
+    EXPECT_GE(Summation::sumSquaredDeviations(std::span<const double>(v), 1e6 + 1.0), 0.0);
+}
+
+TEST(SummationTest, RollingVolatilityStableOnLowVolSeries) {
+    auto v = lowVolSeries(5000, 100.0, 1e-6);
+    const size_t w = 20;
+    auto vol = Stats::Volatility::computeRollingVolatility(v, w);
+    ASSERT_EQ(vol.size(), v.size() - w + 1);
+    for (size_t i = 0; i < vol.size(); ++i) {
+        double expected = std::sqrt(referenceVariance(v.data() + i, w, true));
+        ASSERT_FALSE(std::isnan(vol[i])) << i;
+        EXPECT_NEAR(vol[i], expected, expected * 1e-5) << i;
+    }
+}
+
+TEST(SummationTest, SlidingWindowDoesNotDrift) {
+    std::vector<double> v(1000000);
+    for (size_t i = 0; i < v.size(); ++i)
+        v[i] = 0.0005 + 0.01 * std::sin(static_cast<double>(i) * 0.7) * std::cos(static_cast<double>(i) * 0.013);
+    const size_t w = 63;
+    auto vol = Stats::Volatility::computeRollingVolatility(v, w);
+    const size_t last = vol.size() - 1;
+    double expected = std::sqrt(referenceVariance(v.data() + last, w, true));
+    EXPECT_NEAR(vol[last], expected, expected * 1e-12);
+}
+
+TEST(SummationTest, ConstantWindowsReportZeroAfterNoisyData) {
+    std::vector<double> v = {0.013, -0.021, 0.007, 0.3, 0.1, 0.1, 0.1, 0.1, 0.1};
+    auto vol = Stats::Volatility::computeRollingVolatility(v, 3);
+    auto sharpe = Stats::Volatility::computeRollingSharpe(v, 3, 0.01);
+    EXPECT_EQ(vol.back(), 0.0);
+    EXPECT_EQ(vol[vol.size() - 3], 0.0);
+    EXPECT_EQ(sharpe.back(), 0.0);
+}
+
+TEST(SummationTest, VaryingWindowAfterConstantBlockBoundary) {
+    // Window 2 ({5,5,5}) is constant; window 3 ({5,5,9}) starts the second
+    // rebuild block and must not inherit the constant run.
+    std::vector<double> v = {0, 1, 5, 5, 5, 9};
+    auto vol = Stats::Volatility::computeRollingVolatility(v, 3);
+    auto sharpe = Stats::Volatility::computeRollingSharpe(v, 3, 0.0);
+    ASSERT_EQ(vol.size(), 4u);
+    EXPECT_EQ(vol[2], 0.0);
+    EXPECT_NEAR(vol[3], std::sqrt(16.0 / 3.0), 1e-12);
+    EXPECT_EQ(sharpe[2], 0.0);
+    EXPECT_GT(sharpe[3], 0.0);
+
+    std::vector<float> f = {0, 1, 5, 5, 5, 9, 9, 9, 2};
+    auto fvol = Stats::Volatility::computeRollingVolatility(f, 3);
+    EXPECT_NEAR(fvol[3], std::sqrt(16.0f / 3.0f), 1e-5f);
+    EXPECT_EQ(fvol[5], 0.0f);
+    EXPECT_GT(fvol[6], 0.0f);
+}
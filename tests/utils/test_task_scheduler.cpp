@@ -0,0 +1,238 @@
+/*
+Tasks::TaskScheduler::parallelFor / parallelForChunks
+Tasks::TaskScheduler::configureGlobal
+Execution::forEach / map / reduce
+Policy overloads against their sequential results:
+  computeDailyReturns, computeCorrelationMatrix, computeCovarianceMatrix,
+  computeAnnualizedVolatility, computeRollingVolatility, computeRollingSharpe,
+  computeMaxDrawdown, computeRollingMaxDrawdown
+*/
+
+#include <gtest/gtest.h>
+#include <TestHelpers.hpp>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "stats/correlation.hpp"
+#include "stats/drawdowns.hpp"
+#include "stats/returns.hpp"
+#include "stats/volatility.hpp"
+#include "utils/execution.hpp"
+#include "utils/summation.hpp"
+#include "utils/task_scheduler.hpp"
+
+using Tasks::SchedulerOptions;
+using Tasks::TaskScheduler;
+
+namespace {
+
+// Replaces the global pool for one test and restores the default after.
+struct ScopedGlobalPool {
+    explicit ScopedGlobalPool(unsigned threads) { TaskScheduler::configureGlobal({threads}); }
+    ~ScopedGlobalPool() { TaskScheduler::configureGlobal({}); }
+};
+
+bool sameBits(double a, double b) {
+    return std::memcmp(&a, &b, sizeof a) == 0;
+}
+
+template <typename T>
+void expectSameBits(const std::vector<T> &a, const std::vector<T> &b) {
+    ASSERT_EQ(a.size(), b.size());
+    for (size_t i = 0; i < a.size(); ++i)
+        EXPECT_TRUE(sameBits(a[i], b[i]) || (std::isnan(a[i]) && std::isnan(b[i]))) << i;
+}
+
+template <typename T>
+void expectSameBits(const std::vector<std::vector<T>> &a, const std::vector<std::vector<T>> &b) {
+    ASSERT_EQ(a.size(), b.size());
+    for (size_t i = 0; i < a.size(); ++i)
+        expectSameBits(a[i], b[i]);
+}
+
+std::vector<PriceSeries> makeUniverse(size_t assets, size_t days) {
+    std::vector<PriceSeries> out;
+    for (size_t a = 0; a < assets; ++a)
+        out.push_back(generateRandomWalkSeries("A" + std::to_string(a), days, 100.0, 0.0004, 0.012,
+                                               static_cast<unsigned>(a + 1)));
+    return out;
+}
+
+std::vector<std::vector<double>> wealthOf(const std::vector<std::vector<double>> &returns) {
+    std::vector<std::vector<double>> out;
+    for (const auto &r : returns) {
+        std::vector<double> w(r.size());
+        double v = 1.0;
+        for (size_t i = 0; i < r.size(); ++i)
+            w[i] = v *= 1.0 + r[i];
+        out.push_back(std::move(w));
+    }
+    return out;
+}
+
+}
+
+TEST(TaskSchedulerTest, EveryIndexRunsExactlyOnce) {
+    for (unsigned threads : {1u, 2u, 4u, 7u}) {
+        TaskScheduler pool({threads});
+        EXPECT_EQ(pool.concurrency(), threads);
+        for (size_t grain : {1u, 3u, 64u}) {
+            std::vector<std::atomic<int>> hits(1000);
+            pool.parallelFor(hits.size(), [&](size_t i) { hits[i].fetch_add(1); }, grain);
+            for (size_t i = 0; i < hits.size(); ++i)
+                ASSERT_EQ(hits[i].load(), 1) << "threads=" << threads << " grain=" << grain << " i=" << i;
+        }
+    }
+}
+
+TEST(TaskSchedulerTest, ChunksCoverRangeWithinGrain) {
+    TaskScheduler pool({3});
+    std::vector<std::atomic<int>> hits(101);
+    pool.parallelForChunks(hits.size(), 10, [&](size_t begin, size_t end) {
+        EXPECT_LE(end - begin, 10u);
+        EXPECT_EQ(begin % 10, 0u);
+        for (size_t i = begin; i < end; ++i)
+            hits[i].fetch_add(1);
+    });
+    for (auto &h : hits)
+        EXPECT_EQ(h.load(), 1);
+
+    bool called = false;
+    pool.parallelForChunks(0, 10, [&](size_t, size_t) { called = true; });
+    EXPECT_FALSE(called);
+}
+
+TEST(TaskSchedulerTest, NestedLoopsComplete) {
+    TaskScheduler pool({4});
+    std::vector<std::atomic<int>> hits(32 * 50);
+    pool.parallelFor(32, [&](size_t outer) {
+        pool.parallelFor(50, [&](size_t inner) { hits[outer * 50 + inner].fetch_add(1); });
+    });
+    for (auto &h : hits)
+        EXPECT_EQ(h.load(), 1);
+}
+
+TEST(TaskSchedulerTest, RethrowsExceptionFromLowestChunk) {
+    TaskScheduler pool({4});
+    std::atomic<int> ran{0};
+    try {
+        pool.parallelFor(200, [&](size_t i) {
+            ran.fetch_add(1);
+            if (i == 37 || i == 150)
+                throw std::runtime_error(std::to_string(i));
+        });
+        FAIL() << "expected an exception";
+    } catch (const std::runtime_error &e) {
+        EXPECT_STREQ(e.what(), "37");
+    }
+    EXPECT_EQ(ran.load(), 200);
+
+    // The pool is still usable afterwards.
+    std::atomic<int> after{0};
+    pool.parallelFor(10, [&](size_t) { after.fetch_add(1); });
+    EXPECT_EQ(after.load(), 10);
+}
+
+TEST(TaskSchedulerTest, SingleThreadRunsInlineInOrder) {
+    TaskScheduler pool({1});
+    const auto caller = std::this_thread::get_id();
+    std::vector<size_t> order;
+    pool.parallelFor(20, [&](size_t i) {
+        EXPECT_EQ(std::this_thread::get_id(), caller);
+        order.push_back(i);
+    });
+    ASSERT_EQ(order.size(), 20u);
+    for (size_t i = 0; i < order.size(); ++i)
+        EXPECT_EQ(order[i], i);
+}
+
+TEST(TaskSchedulerTest, ConfigureGlobalSetsConcurrency) {
+    {
+        ScopedGlobalPool pool(3);
+        EXPECT_EQ(TaskScheduler::global().concurrency(), 3u);
+    }
+    EXPECT_GE(TaskScheduler::global().concurrency(), 1u);
+}
+
+TEST(ExecutionTest, ForEachAndMapAgreeAcrossPolicies) {
+    ScopedGlobalPool pool(4);
+    auto square = [](size_t i) { return static_cast<double>(i) * static_cast<double>(i); };
+    const auto a = Execution::map(Execution::seq, 500, square);
+    EXPECT_EQ(Execution::map(Execution::par, 500, square), a);
+    EXPECT_EQ(Execution::map(Execution::par_unseq, 500, square), a);
+
+    std::vector<int> out(300, 0);
+    Execution::forEach(Execution::par_unseq, out.size(), [&](size_t i) { out[i] = static_cast<int>(i) + 1; }, 16);
+    for (size_t i = 0; i < out.size(); ++i)
+        EXPECT_EQ(out[i], static_cast<int>(i) + 1);
+}
+
+TEST(ExecutionTest, ReduceIsBitIdenticalToSummation) {
+    std::mt19937 rng(9);
+    std::normal_distribution<double> dist(0.0, 1.0);
+    std::vector<double> x(300000);
+    for (auto &v : x)
+        v = dist(rng) * std::exp(3.0 * dist(rng));
+
+    for (unsigned threads : {1u, 2u, 5u}) {
+        ScopedGlobalPool pool(threads);
+        for (size_t n : {size_t{0}, size_t{7}, size_t{40000}, size_t{65537}, size_t{300000}}) {
+            auto f = [&](size_t i) { return std::array<double, 2>{x[i], x[i] * x[i]}; };
+            const auto expected = Summation::reduce<2, double>(n, f);
+            const auto par = Execution::reduce<2, double>(Execution::par, n, f);
+            const auto unseq = Execution::reduce<2, double>(Execution::par_unseq, n, f);
+            for (size_t k = 0; k < 2; ++k) {
+                EXPECT_TRUE(sameBits(par[k], expected[k])) << "threads=" << threads << " n=" << n;
+                EXPECT_TRUE(sameBits(unseq[k], expected[k])) << "threads=" << threads << " n=" << n;
+            }
+        }
+    }
+}
+
+TEST(ExecutionTest, StatsPolicyOverloadsMatchSequential) {
+    const auto universe = makeUniverse(9, 400);
+    std::vector<std::vector<double>> returns;
+    for (const auto &s : universe)
+        returns.push_back(Stats::Returns::computeDailyReturns(s));
+    const auto wealth = wealthOf(returns);
+
+    ScopedGlobalPool pool(4);
+    expectSameBits(Stats::Returns::computeDailyReturns(Execution::par, universe), returns);
+    expectSameBits(Stats::Returns::computeDailyReturns(Execution::par_unseq, universe), returns);
+
+    const auto corr = Stats::Correlation::computeCorrelationMatrix(universe);
+    expectSameBits(Stats::Correlation::computeCorrelationMatrix(Execution::par, universe), corr);
+    expectSameBits(Stats::Correlation::computeCorrelationMatrix(Execution::par_unseq, universe), corr);
+
+    const auto cov = Stats::Correlation::computeCovarianceMatrix(returns);
+    expectSameBits(Stats::Correlation::computeCovarianceMatrix(Execution::par, returns), cov);
+    expectSameBits(Stats::Correlation::computeCovarianceMatrix(Execution::seq, returns, false),
+                   Stats::Correlation::computeCovarianceMatrix(returns, false));
+
+    std::vector<double> vol;
+    std::vector<std::vector<double>> rollingVol, rollingSharpe, rollingDd;
+    std::vector<double> maxDd;
+    for (size_t c = 0; c < returns.size(); ++c) {
+        vol.push_back(Stats::Volatility::computeAnnualizedVolatility(returns[c], 252));
+        rollingVol.push_back(Stats::Volatility::computeRollingVolatility(returns[c], 20));
+        rollingSharpe.push_back(Stats::Volatility::computeRollingSharpe(returns[c], 20, 0.0001));
+        maxDd.push_back(Stats::Drawdowns::computeMaxDrawdown(wealth[c]));
+        rollingDd.push_back(Stats::Drawdowns::computeRollingMaxDrawdown(wealth[c], 60));
+    }
+    expectSameBits(Stats::Volatility::computeAnnualizedVolatility(Execution::par, returns, 252), vol);
+    expectSameBits(Stats::Volatility::computeRollingVolatility(Execution::par, returns, 20), rollingVol);
+    expectSameBits(Stats::Volatility::computeRollingSharpe(Execution::par_unseq, returns, 20, 0.0001), rollingSharpe);
+    expectSameBits(Stats::Drawdowns::computeMaxDrawdown(Execution::par, wealth), maxDd);
+    expectSameBits(Stats::Drawdowns::computeRollingMaxDrawdown(Execution::par, wealth, 60), rollingDd);
+}
+
+TEST(ExecutionTest, PolicyOverloadsPropagateErrors) {
+    ScopedGlobalPool pool(3);
+    std::vector<std::vector<double>> returns = {{0.01, 0.02, -0.01}, {0.01}};
+    EXPECT_THROW(Stats::Correlation::computeCovarianceMatrix(Execution::par, returns), std::invalid_argument);
+}
@@ -0,0 +1,97 @@
+/*
+Timestamp::tryParseIsoMillis / parseIsoMillis
+Timestamp::parseEpochDays / parseEpochNanos
+Timestamp::isValidDate
+Timestamp::formatIsoMillis round trip, padding of out-of-range years
+*/
+
+#include <gtest/gtest.h>
+#include <random>
+#include <stdexcept>
+#include <string>
+
+#include "utils/timestamp.hpp"
+
+using namespace Timestamp;
+
+TEST(TimestampTest, ParsesBothFormats) {
+    Format f;
+    EXPECT_EQ(parseIsoMillis("2023-01-03", &f), daysFromCivil(2023, 1, 3) * 86400000LL);
+    EXPECT_EQ(f, Format::DateOnly);
+    EXPECT_EQ(parseIsoMillis("2023-01-03T14:30:15.250Z", &f),
+              daysFromCivil(2023, 1, 3) * 86400000LL + ((14 * 60 + 30) * 60 + 15) * 1000LL + 250);
+    EXPECT_EQ(f, Format::IsoMillis);
+    EXPECT_EQ(parseIsoMillis("1970-01-01T00:00:00.000Z"), 0);
+    EXPECT_EQ(parseIsoMillis("1969-12-31T23:59:59.999Z"), -1);
+}
+
+TEST(TimestampTest, RoundTripsRandomInstants) {
+    std::mt19937_64 rng(11);
+    std::uniform_int_distribution<int64_t> day(daysFromCivil(1900, 1, 1), daysFromCivil(2099, 12, 31));
+    std::uniform_int_distribution<int64_t> ms(0, 86399999);
+    for (int i = 0; i < 20000; ++i) {
+        const int64_t t = day(rng) * 86400000LL + ms(rng);
+        EXPECT_EQ(parseIsoMillis(formatIsoMillis(t)), t);
+        const int64_t midnight = t - t % 86400000LL - (t % 86400000LL < 0 ? 86400000LL : 0);
+        EXPECT_EQ(parseIsoMillis(formatIsoMillis(t, Format::DateOnly)), midnight);
+    }
+}
+
+TEST(TimestampTest, FormatsPaddedFields) {
+    EXPECT_EQ(formatIsoMillis(0), "1970-01-01T00:00:00.000Z");
+    EXPECT_EQ(formatIsoMillis(-1), "1969-12-31T23:59:59.999Z");
+    EXPECT_EQ(formatIsoMillis(daysFromCivil(812, 3, 4) * 86400000LL + 61005, Format::IsoMillis),
+              "0812-03-04T00:01:01.005Z");
+    EXPECT_EQ(formatIsoMillis(daysFromCivil(12345, 6, 7) * 86400000LL, Format::DateOnly), "12345-06-07");
+    EXPECT_EQ(formatIsoMillis(daysFromCivil(-1, 1, 1) * 86400000LL, Format::DateOnly), "-001-01-01");
+}
+
+TEST(TimestampTest, RejectsMalformedInput) {
+    const char* bad[] = {
+        "",
+        "2023-1-03",
+        "2023/01/03",
+        "2023-01-0x",
+        "2023-13-01",
+        "2023-00-10",
+        "2023-01-00",
+        "2023-04-31",
+        "2023-02-29",
+        "1900-02-29",
+        "2023-01-03T00:00:00.000",
+        "2023-01-03 00:00:00.000Z",
+        "2023-01-03T24:00:00.000Z",
+        "2023-01-03T12:60:00.000Z",
+        "2023-01-03T12:00:60.000Z",
+        "2023-01-03T12-00:00.000Z",
+        "2023-01-03T12:00:00,000Z",
+        "2023-01-03T12:00:00.0a0Z",
+        "2023-01-03T12:00:00.00:Z",
+        "2023-01-03T00:00:00.000Z ",
+    };
+    for (const char* s : bad) {
+        int64_t ms = 123;
+        EXPECT_FALSE(tryParseIsoMillis(s, ms)) << s;
+        EXPECT_EQ(ms, 123) << s;
+        EXPECT_THROW(parseIsoMillis(s), std::invalid_argument) << s;
+    }
+    int64_t ms;
+    EXPECT_TRUE(tryParseIsoMillis("2024-02-29", ms));
+    EXPECT_TRUE(tryParseIsoMillis("2000-02-29T23:59:59.999Z", ms));
+}
+
+TEST(TimestampTest, EpochDaysAndNanos) {
+    EXPECT_EQ(parseEpochDays("2023-01-03T23:59:59.999Z"), daysFromCivil(2023, 1, 3));
+    EXPECT_EQ(parseEpochDays("1969-12-31T12:00:00.000Z"), -1);
+    EXPECT_EQ(parseEpochNanos("1970-01-01T00:00:01.500Z"), 1500000000LL);
+    EXPECT_THROW(parseEpochDays("yesterday"), std::invalid_argument);
+}
+
+TEST(TimestampTest, IsValidDate) {
+    EXPECT_TRUE(isValidDate("2023-12-31"));
+    EXPECT_TRUE(isValidDate("2024-02-29"));
+    EXPECT_FALSE(isValidDate("2023-02-29"));
+    EXPECT_FALSE(isValidDate("2023-12-31T00:00:00.000Z"));
+    EXPECT_FALSE(isValidDate("2023-12-3"));
+    EXPECT_FALSE(isValidDate("abcd-ef-gh"));
+}